@@ -168,6 +168,8 @@ public:
 
   void run();
 
+  MemoryReport get_memory_report() const override;
+
 private:
   const RunTimeParameters::ProblemParameters    &parameters;
 
@@ -235,7 +237,9 @@ advection_diffusion(parameters.heat_equation_parameters,
                     this->computing_timer),
 cfl_number(std::numeric_limits<double>::min()),
 log_file("AdvectionDiffusion_Log.csv")
-{}
+{
+  this->container.add_entity(*scalar_field);
+}
 
 
 
@@ -443,19 +447,29 @@ void AdvectionDiffusionProblem<dim>::solve(const unsigned int &/* level */)
 
     // Snapshot stage, all time calls should be done with get_next_time()
 
-    if ((time_stepping.get_step_number() %
-          this->prm.terminal_output_frequency == 0) ||
-        (time_stepping.get_current_time() ==
-          time_stepping.get_end_time()))
+    if (!this->skip_postprocessing() &&
+        ((time_stepping.get_step_number() %
+           this->prm.terminal_output_frequency == 0) ||
+         (time_stepping.get_current_time() ==
+           time_stepping.get_end_time())))
       postprocessing();
 
-    if ((time_stepping.get_step_number() %
-          this->prm.graphical_output_frequency == 0) ||
-        (time_stepping.get_current_time() ==
-          time_stepping.get_end_time()))
+    if (!this->is_headless() &&
+        ((time_stepping.get_step_number() %
+           this->prm.graphical_output_frequency == 0) ||
+         (time_stepping.get_current_time() ==
+           time_stepping.get_end_time())))
       output();
+
+    // Prints the memory consumption if it is due
+    this->report_memory_consumption();
+
+    // Advances the benchmark mode if it is enabled
+    this->benchmark_step(time_stepping);
   }
 
+  this->finalize_benchmark();
+
   Assert(time_stepping.get_current_time() == exact_solution->get_time(),
     ExcMessage("Time mismatch between the time stepping class and the temperature function"));
 
@@ -466,6 +480,18 @@ void AdvectionDiffusionProblem<dim>::solve(const unsigned int &/* level */)
 
 
 
+template <int dim>
+MemoryReport AdvectionDiffusionProblem<dim>::get_memory_report() const
+{
+  MemoryReport report(Problem<dim>::get_memory_report());
+
+  report.add("Advection-diffusion solver", advection_diffusion.get_memory_report());
+
+  return (report);
+}
+
+
+
 template <int dim>
 void AdvectionDiffusionProblem<dim>::run()
 {
@@ -517,6 +543,8 @@ void AdvectionDiffusionProblem<dim>::run()
       solve(parameters.spatial_discretization_parameters.n_initial_global_refinements);
 
       process_solution(cycle);
+
+      advection_diffusion.reset_for_new_run();
     }
     break;
   default:
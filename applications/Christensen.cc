@@ -1,6 +1,7 @@
 #include <rotatingMHD/angular_velocity.h>
 #include <rotatingMHD/benchmark_data.h>
 #include <rotatingMHD/convection_diffusion_solver.h>
+#include <rotatingMHD/data_postprocessors.h>
 #include <rotatingMHD/finite_element_field.h>
 #include <rotatingMHD/navier_stokes_projection.h>
 #include <rotatingMHD/problem_class.h>
@@ -373,11 +374,16 @@ template <int dim>
 class Christensen : public Problem<dim>
 {
 public:
-  Christensen(const RunTimeParameters::ProblemParameters &parameters);
+  Christensen(const RunTimeParameters::ProblemParameters &parameters,
+              const bool                                 flag_restart = false);
 
   void run();
 
+  MemoryReport get_memory_report() const override;
+
 private:
+  const bool                                    flag_restart;
+
   std::ofstream                                 log_file;
 
   const double                                  inner_radius;
@@ -431,13 +437,22 @@ private:
   void output();
 
   void update_solution_vectors();
+
+  void restart();
+
+  void save_checkpoint_data(boost::archive::binary_oarchive &archive) const override;
+
+  void load_checkpoint_data(boost::archive::binary_iarchive &archive) override;
 };
 
 template <int dim>
-Christensen<dim>::Christensen(const RunTimeParameters::ProblemParameters &parameters)
+Christensen<dim>::Christensen(const RunTimeParameters::ProblemParameters &parameters,
+                              const bool                                 flag_restart)
 :
 Problem<dim>(parameters),
-log_file("Christensen_Log.csv"),
+flag_restart(flag_restart),
+log_file("Christensen_Log.csv",
+         flag_restart ? std::ios_base::app : std::ios_base::out),
 inner_radius(7./13.),
 outer_radius(20./13.),
 A(0.1),
@@ -498,13 +513,6 @@ benchmark_requests(inner_radius, outer_radius)
 
   navier_stokes.set_gravity_vector(gravity_vector);
   navier_stokes.set_angular_velocity_vector(angular_velocity);
-  make_grid(parameters.spatial_discretization_parameters.n_initial_global_refinements);
-  setup_dofs();
-  setup_constraints();
-  velocity->setup_vectors();
-  pressure->setup_vectors();
-  temperature->setup_vectors();
-  initialize();
 
   // Stores all the fields to the SolutionTransfer container
   this->container.add_entity(*velocity);
@@ -512,14 +520,72 @@ benchmark_requests(inner_radius, outer_radius)
   this->container.add_entity(*navier_stokes.phi, false);
   this->container.add_entity(*temperature, false);
 
-  log_file << "Step" << ","
-           << "Time" << ","
-           << "dt" << ","
-           << "CFL" << ","
-           << "D_norm" << ","
-           << "P_norm" << ","
-           << "H_norm" << ","
-           << std::endl;
+  this->distribute_cell_geometry_cache_memory_budget();
+
+  // Registers the fields of the graphical output. To properly showcase
+  // the velocity field (whose k-th order finite elements are one order
+  // higher than those of the pressure field), the k-th order elements
+  // are interpolated to four (k-1)-th order elements. In other words, the
+  // triangulation visualized is one global refinement finer than the
+  // actual triangulation.
+  // The spherical components of the velocity and its curl are
+  // interpolated onto the cached patches as well.
+  this->graphical_output.add_field(*velocity, "velocity");
+  this->graphical_output.add_field(
+    *velocity,
+    std::make_shared<SphericalPostprocessorVectorField<dim>>("velocity"));
+  this->graphical_output.add_field(*pressure);
+  this->graphical_output.add_field(*temperature);
+  this->graphical_output.set_patch_parameters(velocity->fe_degree(),
+                                              DataOut<dim>::curved_inner_cells);
+
+  // Registers the fields sampled by the probes
+  this->probes.add_field(*velocity);
+  this->probes.add_field(*pressure);
+  this->probes.add_field(*temperature);
+
+  if (flag_restart)
+    restart();
+  else
+  {
+    make_grid(parameters.spatial_discretization_parameters.n_initial_global_refinements);
+    setup_dofs();
+    setup_constraints();
+
+    // Accounts for the Dirichlet boundaries in the partition of the mesh
+    if (this->update_dirichlet_boundary_ids())
+    {
+      setup_dofs();
+      setup_constraints();
+    }
+    velocity->setup_vectors();
+    pressure->setup_vectors();
+    temperature->setup_vectors();
+    initialize();
+
+    log_file << "Step" << ","
+             << "Time" << ","
+             << "dt" << ","
+             << "CFL" << ","
+             << "D_norm" << ","
+             << "P_norm" << ","
+             << "H_norm" << ","
+             << std::endl;
+  }
+
+  // Streams the benchmark data to a file instead of keeping it in memory
+  if (parameters.benchmark_data_format !=
+      RunTimeParameters::BenchmarkDataFormat::text)
+    benchmark_requests.stream_to_file(
+      (std::filesystem::path(parameters.graphical_output_directory) /
+       (parameters.benchmark_data_format ==
+          RunTimeParameters::BenchmarkDataFormat::csv ?
+        "benchmark_data.csv" : "benchmark_data.bin")).string(),
+      parameters.benchmark_data_format,
+      parameters.benchmark_data_flush_frequency,
+      this->mpi_communicator,
+      (flag_restart ?
+       time_stepping.get_step_number() : numbers::invalid_unsigned_int));
 }
 
 template <int dim>
@@ -536,6 +602,10 @@ void Christensen<dim>::make_grid(const unsigned int n_global_refinements)
                              0,
                              true);
 
+  // The refinements are loaded from the checkpoint
+  if (flag_restart)
+    return;
+
   // Performs global refinements
   this->triangulation.refine_global(n_global_refinements);
 
@@ -675,7 +745,9 @@ void Christensen<dim>::postprocessing()
            << heat_equation.get_rhs_norm()
            << std::endl;
 
-  if (Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
+  if (this->prm.benchmark_data_format ==
+        RunTimeParameters::BenchmarkDataFormat::text &&
+      Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
   {
     if (!std::filesystem::exists(this->prm.graphical_output_directory))
     {
@@ -752,45 +824,7 @@ void Christensen<dim>::output()
 {
   TimerOutput::Scope  t(*this->computing_timer, "Problem: Graphical output");
 
-  // Explicit declaration of the velocity as a vector
-  std::vector<std::string> names(dim, "velocity");
-  std::vector<DataComponentInterpretation::DataComponentInterpretation>
-    component_interpretation(
-      dim, DataComponentInterpretation::component_is_part_of_vector);
-
-  // Loading the DataOut instance with the solution vectors
-  DataOut<dim>        data_out;
-  data_out.add_data_vector(velocity->get_dof_handler(),
-                           velocity->solution,
-                           names,
-                           component_interpretation);
-  data_out.add_data_vector(pressure->get_dof_handler(),
-                           pressure->solution,
-                           "Pressure");
-  data_out.add_data_vector(temperature->get_dof_handler(),
-                           temperature->solution,
-                           "Temperature");
-
-  // To properly showcase the velocity field (whose k-th order finite
-  // elements are one order higher than those of the pressure field),
-  // the k-th order elements are interpolated to four (k-1)-th order
-  // elements. In other words, the triangulation visualized in the
-  // *.pvtu file is one globl refinement finer than the actual
-  // triangulation.
-
-  data_out.build_patches(*this->mapping,
-                         velocity->fe_degree(),
-                         DataOut<dim>::curved_inner_cells);
-
-
-  // Writes the DataOut instance to the file.
-  static int out_index = 0;
-  data_out.write_vtu_with_pvtu_record(this->prm.graphical_output_directory,
-                                      "solution",
-                                      out_index,
-                                      this->mpi_communicator,
-                                      5);
-  out_index++;
+  this->graphical_output.write(time_stepping.get_current_time());
 }
 
 template <int dim>
@@ -802,14 +836,67 @@ void Christensen<dim>::update_solution_vectors()
   temperature->update_solution_vectors();
 }
 
+template <int dim>
+void Christensen<dim>::restart()
+{
+  make_grid(0);
+  this->load_checkpoint_triangulation(time_stepping);
+  setup_dofs();
+  setup_constraints();
+  velocity->setup_vectors();
+  pressure->setup_vectors();
+  temperature->setup_vectors();
+
+  // The solver has to set up the auxiliary entity phi before its
+  // solution vectors are loaded.
+  navier_stokes.setup();
+  this->load_checkpoint_fields();
+}
+
+template <int dim>
+void Christensen<dim>::save_checkpoint_data
+(boost::archive::binary_oarchive &archive) const
+{
+  // The streamed benchmark data has to be on disk before the checkpoint
+  // such that no rows are lost upon a restart
+  benchmark_requests.flush();
+
+  archive << navier_stokes;
+  archive << benchmark_requests;
+}
+
+template <int dim>
+void Christensen<dim>::load_checkpoint_data
+(boost::archive::binary_iarchive &archive)
+{
+  archive >> navier_stokes;
+  archive >> benchmark_requests;
+}
+
+template <int dim>
+MemoryReport Christensen<dim>::get_memory_report() const
+{
+  MemoryReport report(Problem<dim>::get_memory_report());
+
+  report.add("Navier-Stokes solver", navier_stokes.get_memory_report());
+  report.add("Heat equation solver", heat_equation.get_memory_report());
+
+  return (report);
+}
+
+
+
 template <int dim>
 void Christensen<dim>::run()
 {
   // Outputs the initial conditions
-  velocity->solution    = velocity->old_solution;
-  pressure->solution    = pressure->old_solution;
-  temperature->solution = temperature->old_solution;
-  output();
+  if (!flag_restart)
+  {
+    velocity->solution    = velocity->old_solution;
+    pressure->solution    = pressure->old_solution;
+    temperature->solution = temperature->old_solution;
+    output();
+  }
 
   const unsigned int n_steps = this->prm.time_discretization_parameters.n_maximum_steps;
 
@@ -835,29 +922,52 @@ void Christensen<dim>::run()
     // Advances the VSIMEXMethod instance to t^{k}
     update_solution_vectors();
     time_stepping.advance_time();
-    *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
-                 << std::endl;
+    if (!this->is_headless())
+      *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
+                   << std::endl;
+
+    // Samples the probes if it is due
+    if (!this->skip_postprocessing())
+      this->probes.sample(time_stepping.get_current_time(),
+                          time_stepping.get_step_number());
 
     // Performs post-processing
-    if ((time_stepping.get_step_number() %
-          this->prm.terminal_output_frequency == 0) ||
-        (time_stepping.get_current_time() ==
-                   time_stepping.get_end_time()))
+    if (!this->skip_postprocessing() &&
+        ((time_stepping.get_step_number() %
+           this->prm.terminal_output_frequency == 0) ||
+         (time_stepping.get_current_time() ==
+                    time_stepping.get_end_time())))
       postprocessing();
-    /*
     // Performs coarsening and refining of the triangulation
-    if (time_stepping.get_step_number() %
+    if (this->prm.spatial_discretization_parameters.adaptive_mesh_refinement &&
+        time_stepping.get_step_number() %
         this->prm.spatial_discretization_parameters.adaptive_mesh_refinement_frequency == 0)
-      this->adaptive_mesh_refinement();*/
+      this->adaptive_mesh_refinement();
 
     // Graphical output of the solution vectors
-    if ((time_stepping.get_step_number() %
-          this->prm.graphical_output_frequency == 0) ||
-        (time_stepping.get_current_time() ==
-                   time_stepping.get_end_time()))
+    if (!this->is_headless() &&
+        ((time_stepping.get_step_number() %
+           this->prm.graphical_output_frequency == 0) ||
+         (time_stepping.get_current_time() ==
+                    time_stepping.get_end_time())))
       output();
+
+    // Writes a checkpoint if it is due
+    this->checkpoint(time_stepping);
+
+    // Prints the memory consumption if it is due
+    this->report_memory_consumption();
+
+    // Advances the benchmark mode if it is enabled
+    this->benchmark_step(time_stepping);
   }
 
+  this->finalize_checkpoint();
+
+  this->finalize_benchmark();
+
+  this->graphical_output.finalize();
+
 
 
 
@@ -880,19 +990,27 @@ int main(int argc, char *argv[])
 
       Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 2);
 
-      RunTimeParameters::ProblemParameters parameter_set("Christensen.prm");
+      std::string parameter_filename("Christensen.prm");
+      bool        flag_restart = false;
+      for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--restart")
+          flag_restart = true;
+        else
+          parameter_filename = argv[i];
+
+      RunTimeParameters::ProblemParameters parameter_set(parameter_filename);
 
       switch (parameter_set.dim)
       {
         case 2:
         {
-          Christensen<2> simulation(parameter_set);
+          Christensen<2> simulation(parameter_set, flag_restart);
           simulation.run();
           break;
         }
         case 3:
         {
-          Christensen<3> simulation(parameter_set);
+          Christensen<3> simulation(parameter_set, flag_restart);
           simulation.run();
           break;
         }
@@ -359,11 +359,15 @@ template <int dim>
 class DFG : public Problem<dim>
 {
 public:
-  DFG(const RunTimeParameters::ProblemParameters &parameters);
+  DFG(const RunTimeParameters::ProblemParameters &parameters,
+      const bool                                 flag_restart = false);
 
   void run();
 
+  MemoryReport get_memory_report() const override;
+
 private:
+  const bool                flag_restart;
 
   const types::boundary_id  channel_wall_bndry_id{3};
   const types::boundary_id  cylinder_bndry_id{2};
@@ -386,6 +390,17 @@ private:
 
   double                                        cfl_number;
 
+  /*!
+   * @brief Flag indicating whether the first run until t = 350, which
+   * develops the periodic flow, was completed.
+   */
+  bool                                          flag_periodic_flow;
+
+  /*!
+   * @brief The number of steps of the second run.
+   */
+  unsigned int                                  n_remaining_steps;
+
   void make_grid();
 
   void setup_dofs();
@@ -399,12 +414,20 @@ private:
   void output();
 
   void update_solution_vectors();
+
+  void restart();
+
+  void save_checkpoint_data(boost::archive::binary_oarchive &archive) const override;
+
+  void load_checkpoint_data(boost::archive::binary_iarchive &archive) override;
 };
 
 template <int dim>
-DFG<dim>::DFG(const RunTimeParameters::ProblemParameters &parameters)
+DFG<dim>::DFG(const RunTimeParameters::ProblemParameters &parameters,
+              const bool                                 flag_restart)
 :
 Problem<dim>(parameters),
+flag_restart(flag_restart),
 velocity(std::make_shared<Entities::FE_VectorField<dim>>
          (parameters.fe_degree_velocity,
           this->triangulation,
@@ -423,18 +446,56 @@ navier_stokes(parameters.navier_stokes_parameters,
               this->computing_timer),
 benchmark_requests(parameters.Re, cylinder_bndry_id),
 velocity_initial_condition(dim),
-pressure_initial_condition()
+pressure_initial_condition(),
+flag_periodic_flow(false),
+n_remaining_steps(0)
 {
   *this->pcout << parameters << std::endl << std::endl;
-  make_grid();
-  setup_dofs();
-  setup_constraints();
-  velocity->setup_vectors();
-  pressure->setup_vectors();
-  initialize();
   this->container.add_entity(*velocity);
   this->container.add_entity(*pressure, false);
   this->container.add_entity(*navier_stokes.phi, false);
+
+  this->distribute_cell_geometry_cache_memory_budget();
+
+  this->graphical_output.add_field(*velocity, "velocity");
+  this->graphical_output.add_field(*pressure);
+  this->graphical_output.set_patch_parameters(velocity->fe_degree());
+
+  // Registers the fields sampled by the probes
+  this->probes.add_field(*velocity);
+  this->probes.add_field(*pressure);
+  if (flag_restart)
+    restart();
+  else
+  {
+    make_grid();
+    setup_dofs();
+    setup_constraints();
+
+    // Accounts for the Dirichlet boundaries in the partition of the mesh
+    if (this->update_dirichlet_boundary_ids())
+    {
+      setup_dofs();
+      setup_constraints();
+    }
+    velocity->setup_vectors();
+    pressure->setup_vectors();
+    initialize();
+  }
+
+  // Streams the benchmark data to a file instead of keeping it in memory
+  if (parameters.benchmark_data_format !=
+      RunTimeParameters::BenchmarkDataFormat::text)
+    benchmark_requests.stream_to_file(
+      (std::filesystem::path(parameters.graphical_output_directory) /
+       (parameters.benchmark_data_format ==
+          RunTimeParameters::BenchmarkDataFormat::csv ?
+        "benchmark_data.csv" : "benchmark_data.bin")).string(),
+      parameters.benchmark_data_format,
+      parameters.benchmark_data_flush_frequency,
+      this->mpi_communicator,
+      (flag_restart ?
+       time_stepping.get_step_number() : numbers::invalid_unsigned_int));
 }
 
 
@@ -473,6 +534,10 @@ void DFG<2>::make_grid()
   inner_manifold.initialize(this->triangulation);
   this->triangulation.set_manifold(1, inner_manifold);
 
+  // The refinements are loaded from the checkpoint
+  if (flag_restart)
+    return;
+
   // Perform global refinements
   this->triangulation.refine_global(prm.spatial_discretization_parameters.n_initial_global_refinements);
 
@@ -575,89 +640,134 @@ void DFG<dim>::output()
 {
   TimerOutput::Scope  t(*this->computing_timer, "Problem: Graphical output");
 
-  std::vector<std::string> names(dim, "velocity");
-  std::vector<DataComponentInterpretation::DataComponentInterpretation>
-    component_interpretation(
-      dim, DataComponentInterpretation::component_is_part_of_vector);
-
-  DataOut<dim>        data_out;
-
-  data_out.add_data_vector(velocity->get_dof_handler(),
-                           velocity->solution,
-                           names,
-                           component_interpretation);
-
-  data_out.add_data_vector(pressure->get_dof_handler(),
-                           pressure->solution,
-                           "Pressure");
+  this->graphical_output.write(time_stepping.get_current_time());
+}
 
-  data_out.build_patches(velocity->fe_degree());
+template <int dim>
+void DFG<dim>::update_solution_vectors()
+{
+  velocity->update_solution_vectors();
+  pressure->update_solution_vectors();
+}
 
-  static int out_index = 0;
+template <int dim>
+void DFG<dim>::restart()
+{
+  make_grid();
+  this->load_checkpoint_triangulation(time_stepping);
+  setup_dofs();
+  setup_constraints();
+  velocity->setup_vectors();
+  pressure->setup_vectors();
+  // The solver has to set up the auxiliary entity phi before its
+  // solution vectors are loaded.
+  navier_stokes.setup();
+  this->load_checkpoint_fields();
+}
 
-  data_out.write_vtu_with_pvtu_record(this->prm.graphical_output_directory,
-                                      "solution",
-                                      out_index,
-                                      this->mpi_communicator,
-                                      5);
+template <int dim>
+void DFG<dim>::save_checkpoint_data
+(boost::archive::binary_oarchive &archive) const
+{
+  // The streamed benchmark data has to be on disk before the checkpoint
+  // such that no rows are lost upon a restart
+  benchmark_requests.flush();
+
+  archive << navier_stokes;
+  archive << benchmark_requests;
+  archive << flag_periodic_flow;
+  archive << n_remaining_steps;
+}
 
-  out_index++;
+template <int dim>
+void DFG<dim>::load_checkpoint_data
+(boost::archive::binary_iarchive &archive)
+{
+  archive >> navier_stokes;
+  archive >> benchmark_requests;
+  archive >> flag_periodic_flow;
+  archive >> n_remaining_steps;
 }
 
 template <int dim>
-void DFG<dim>::update_solution_vectors()
+MemoryReport DFG<dim>::get_memory_report() const
 {
-  velocity->update_solution_vectors();
-  pressure->update_solution_vectors();
+  MemoryReport report(Problem<dim>::get_memory_report());
+
+  report.add("Navier-Stokes solver", navier_stokes.get_memory_report());
+
+  return (report);
 }
 
+
+
 template <int dim>
 void DFG<dim>::run()
 {
   const unsigned int n_steps = this->prm.time_discretization_parameters.n_maximum_steps;
 
-  *this->pcout << "Solving until t = 350..." << std::endl;
-
-  *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
-               << std::endl;
-  while (time_stepping.get_current_time() <= 350.0 &&
-         (n_steps > 0? time_stepping.get_step_number() < n_steps: true))
+  if (!flag_periodic_flow)
   {
-    // The VSIMEXMethod instance starts each loop at t^{k-1}
+    *this->pcout << "Solving until t = 350..." << std::endl;
 
-    // Compute CFL number
-    cfl_number = navier_stokes.get_cfl_number();
+    *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
+                 << std::endl;
+    while (time_stepping.get_current_time() <= 350.0 &&
+           (n_steps > 0? time_stepping.get_step_number() < n_steps: true))
+    {
+      // The VSIMEXMethod instance starts each loop at t^{k-1}
 
-    // Updates the time step, i.e sets the value of t^{k}
-    time_stepping.set_desired_next_step_size(
-      this->compute_next_time_step(time_stepping, cfl_number));
+      // Compute CFL number
+      cfl_number = navier_stokes.get_cfl_number();
 
-    // Updates the coefficients to their k-th value
-    time_stepping.update_coefficients();
+      // Updates the time step, i.e sets the value of t^{k}
+      time_stepping.set_desired_next_step_size(
+        this->compute_next_time_step(time_stepping, cfl_number));
 
-    // Solves the system, i.e. computes the fields at t^{k}
-    navier_stokes.solve();
+      // Updates the coefficients to their k-th value
+      time_stepping.update_coefficients();
 
-    // Advances the VSIMEXMethod instance to t^{k}
-    update_solution_vectors();
-    time_stepping.advance_time();
-    *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
-                 << std::endl;
+      // Solves the system, i.e. computes the fields at t^{k}
+      navier_stokes.solve();
 
-    // Snapshot stage, all time calls should be done with get_current_time()
-    if ((time_stepping.get_step_number() %
-          this->prm.terminal_output_frequency == 0) ||
-        (time_stepping.get_next_time() ==
-          time_stepping.get_end_time()))
-      postprocessing();
-  }
-  const unsigned int n_remaining_steps{n_steps - time_stepping.get_step_number()};
+      // Advances the VSIMEXMethod instance to t^{k}
+      update_solution_vectors();
+      time_stepping.advance_time();
+      if (!this->is_headless())
+        *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
+                     << std::endl;
+
+      // Samples the probes if it is due
+      if (!this->skip_postprocessing())
+        this->probes.sample(time_stepping.get_current_time(),
+                            time_stepping.get_step_number());
+
+      // Snapshot stage, all time calls should be done with get_current_time()
+      if (!this->skip_postprocessing() &&
+          ((time_stepping.get_step_number() %
+             this->prm.terminal_output_frequency == 0) ||
+           (time_stepping.get_next_time() ==
+             time_stepping.get_end_time())))
+        postprocessing();
+
+      this->checkpoint(time_stepping);
+
+      // Prints the memory consumption if it is due
+      this->report_memory_consumption();
+
+      // Advances the benchmark mode if it is enabled
+      this->benchmark_step(time_stepping);
+    }
+    n_remaining_steps = n_steps - time_stepping.get_step_number();
+
+    *this->pcout << "Restarting..." << std::endl;
+    time_stepping.restart();
 
-  *this->pcout << "Restarting..." << std::endl;
-  time_stepping.restart();
+    velocity->old_old_solution = velocity->solution;
+    navier_stokes.clear();
 
-  velocity->old_old_solution = velocity->solution;
-  navier_stokes.clear();
+    flag_periodic_flow = true;
+  }
 
   *this->pcout << "Solving until t = "
                << time_stepping.get_end_time()
@@ -687,24 +797,48 @@ void DFG<dim>::run()
     // Advances the VSIMEXMethod instance to t^{k}
     update_solution_vectors();
     time_stepping.advance_time();
-    *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
-                 << std::endl;
+    if (!this->is_headless())
+      *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
+                   << std::endl;
+
+    // Samples the probes if it is due
+    if (!this->skip_postprocessing())
+      this->probes.sample(time_stepping.get_current_time(),
+                          time_stepping.get_step_number());
 
     // Snapshot stage, all time calls should be done with get_current_time()
-    if ((time_stepping.get_step_number() %
-          this->prm.terminal_output_frequency == 0) ||
-        (time_stepping.get_next_time() ==
-          time_stepping.get_end_time()))
+    if (!this->skip_postprocessing() &&
+        ((time_stepping.get_step_number() %
+           this->prm.terminal_output_frequency == 0) ||
+         (time_stepping.get_next_time() ==
+           time_stepping.get_end_time())))
       postprocessing();
 
-    if ((time_stepping.get_step_number() %
-          this->prm.graphical_output_frequency == 0) ||
-        (time_stepping.get_next_time() ==
-          time_stepping.get_end_time()))
+    if (!this->is_headless() &&
+        ((time_stepping.get_step_number() %
+           this->prm.graphical_output_frequency == 0) ||
+         (time_stepping.get_next_time() ==
+           time_stepping.get_end_time())))
       output();
+
+    this->checkpoint(time_stepping);
+
+    // Prints the memory consumption if it is due
+    this->report_memory_consumption();
+
+    // Advances the benchmark mode if it is enabled
+    this->benchmark_step(time_stepping);
   }
 
-  if (Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
+  this->finalize_checkpoint();
+
+  this->finalize_benchmark();
+
+  this->graphical_output.finalize();
+
+  if (this->prm.benchmark_data_format ==
+        RunTimeParameters::BenchmarkDataFormat::text &&
+      Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
   {
     if (!std::filesystem::exists(this->prm.graphical_output_directory))
     {
@@ -787,15 +921,17 @@ int main(int argc, char *argv[])
 
       Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
 
-      std::string parameter_filename;
-      if (argc >= 2)
-        parameter_filename = argv[1];
-      else
-        parameter_filename = "DFG.prm";
+      std::string parameter_filename("DFG.prm");
+      bool        flag_restart = false;
+      for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--restart")
+          flag_restart = true;
+        else
+          parameter_filename = argv[i];
 
       RunTimeParameters::ProblemParameters parameter_set(parameter_filename);
 
-      DFG<2> simulation(parameter_set);
+      DFG<2> simulation(parameter_set, flag_restart);
 
       simulation.run();
   }
@@ -159,11 +159,16 @@ template <int dim>
 class MIT : public Problem<dim>
 {
 public:
-  MIT(const RunTimeParameters::ProblemParameters &parameters);
+  MIT(const RunTimeParameters::ProblemParameters &parameters,
+      const bool                                 flag_restart = false);
 
   void run();
 
+  MemoryReport get_memory_report() const override;
+
 private:
+  const bool                flag_restart;
+
   const types::boundary_id  left_bndry_id{1};
   const types::boundary_id  right_bndry_id{2};
   const types::boundary_id  top_bndry_id{3};
@@ -203,12 +208,20 @@ private:
   void output();
 
   void update_solution_vectors();
+
+  void restart();
+
+  void save_checkpoint_data(boost::archive::binary_oarchive &archive) const override;
+
+  void load_checkpoint_data(boost::archive::binary_iarchive &archive) override;
 };
 
 template <int dim>
-MIT<dim>::MIT(const RunTimeParameters::ProblemParameters &parameters)
+MIT<dim>::MIT(const RunTimeParameters::ProblemParameters &parameters,
+              const bool                                 flag_restart)
 :
 Problem<dim>(parameters),
+flag_restart(flag_restart),
 velocity(std::make_shared<Entities::FE_VectorField<dim>>(
               parameters.fe_degree_velocity,
               this->triangulation,
@@ -247,13 +260,6 @@ gravity_vector(parameters.time_discretization_parameters.start_time)
 
   AssertDimension(dim, 2);
   navier_stokes.set_gravity_vector(gravity_vector);
-  make_grid();
-  setup_dofs();
-  setup_constraints();
-  velocity->setup_vectors();
-  pressure->setup_vectors();
-  temperature->setup_vectors();
-  initialize();
 
   // Stores all the fields to the SolutionTransfor container
   this->container.add_entity(*velocity);
@@ -261,6 +267,53 @@ gravity_vector(parameters.time_discretization_parameters.start_time)
   this->container.add_entity(*navier_stokes.phi, false);
   this->container.add_entity(*temperature, false);
 
+  this->distribute_cell_geometry_cache_memory_budget();
+
+  // Registers the fields of the graphical output. The velocity's k-th
+  // order elements are interpolated to four (k-1)-th order elements.
+  this->graphical_output.add_field(*velocity, "velocity");
+  this->graphical_output.add_field(*pressure);
+  this->graphical_output.add_field(*temperature);
+  this->graphical_output.set_patch_parameters(velocity->fe_degree());
+
+  // Registers the fields sampled by the probes
+  this->probes.add_field(*velocity);
+  this->probes.add_field(*pressure);
+  this->probes.add_field(*temperature);
+
+  if (flag_restart)
+    restart();
+  else
+  {
+    make_grid();
+    setup_dofs();
+    setup_constraints();
+
+    // Accounts for the Dirichlet boundaries in the partition of the mesh
+    if (this->update_dirichlet_boundary_ids())
+    {
+      setup_dofs();
+      setup_constraints();
+    }
+    velocity->setup_vectors();
+    pressure->setup_vectors();
+    temperature->setup_vectors();
+    initialize();
+  }
+
+  // Streams the benchmark data to a file instead of keeping it in memory
+  if (parameters.benchmark_data_format !=
+      RunTimeParameters::BenchmarkDataFormat::text)
+    benchmark_requests.stream_to_file(
+      (std::filesystem::path(parameters.graphical_output_directory) /
+       (parameters.benchmark_data_format ==
+          RunTimeParameters::BenchmarkDataFormat::csv ?
+        "benchmark_data.csv" : "benchmark_data.bin")).string(),
+      parameters.benchmark_data_format,
+      parameters.benchmark_data_flush_frequency,
+      this->mpi_communicator,
+      (flag_restart ?
+       time_stepping.get_step_number() : numbers::invalid_unsigned_int));
 }
 
 template <>
@@ -315,6 +368,10 @@ void MIT<2>::make_grid()
 
   this->triangulation.copy_triangulation(tria);
 
+  // The refinements are loaded from the checkpoint
+  if (flag_restart)
+    return;
+
   // Performs global refinements
   this->triangulation.refine_global(prm.spatial_discretization_parameters.n_initial_global_refinements);
 
@@ -480,41 +537,7 @@ void MIT<dim>::output()
 {
   TimerOutput::Scope  t(*this->computing_timer, "Problem: Graphical output");
 
-  // Explicit declaration of the velocity as a vector
-  std::vector<std::string> names(dim, "velocity");
-  std::vector<DataComponentInterpretation::DataComponentInterpretation>
-    component_interpretation(
-      dim, DataComponentInterpretation::component_is_part_of_vector);
-
-  // Loading the DataOut instance with the solution vectors
-  DataOut<dim>        data_out;
-  data_out.add_data_vector(velocity->get_dof_handler(),
-                           velocity->solution,
-                           names,
-                           component_interpretation);
-  data_out.add_data_vector(pressure->get_dof_handler(),
-                           pressure->solution,
-                           "Pressure");
-  data_out.add_data_vector(temperature->get_dof_handler(),
-                           temperature->solution,
-                           "Temperature");
-
-  // To properly showcase the velocity field (whose k-th order finite
-  // elements are one order higher than those of the pressure field),
-  // the k-th order elements are interpolated to four (k-1)-th order
-  // elements. In other words, the triangulation visualized in the
-  // *.pvtu file is one globl refinement finer than the actual
-  // triangulation.
-  data_out.build_patches(velocity->fe_degree());
-
-  // Writes the DataOut instance to the file.
-  static int out_index = 0;
-  data_out.write_vtu_with_pvtu_record(this->prm.graphical_output_directory,
-                                      "solution",
-                                      out_index,
-                                      this->mpi_communicator,
-                                      5);
-  out_index++;
+  this->graphical_output.write(time_stepping.get_current_time());
 }
 
 template <int dim>
@@ -526,6 +549,60 @@ void MIT<dim>::update_solution_vectors()
   temperature->update_solution_vectors();
 }
 
+template <int dim>
+void MIT<dim>::restart()
+{
+  make_grid();
+  this->load_checkpoint_triangulation(time_stepping);
+
+  // The boundary conditions are applied at the time of the checkpoint
+  temperature_boundary_conditions->set_time(time_stepping.get_current_time());
+
+  setup_dofs();
+  setup_constraints();
+  velocity->setup_vectors();
+  pressure->setup_vectors();
+  temperature->setup_vectors();
+
+  // The solver has to set up the auxiliary entity phi before its
+  // solution vectors are loaded.
+  navier_stokes.setup();
+  this->load_checkpoint_fields();
+}
+
+template <int dim>
+void MIT<dim>::save_checkpoint_data
+(boost::archive::binary_oarchive &archive) const
+{
+  // The streamed benchmark data has to be on disk before the checkpoint
+  // such that no rows are lost upon a restart
+  benchmark_requests.flush();
+
+  archive << navier_stokes;
+  archive << benchmark_requests;
+}
+
+template <int dim>
+void MIT<dim>::load_checkpoint_data
+(boost::archive::binary_iarchive &archive)
+{
+  archive >> navier_stokes;
+  archive >> benchmark_requests;
+}
+
+template <int dim>
+MemoryReport MIT<dim>::get_memory_report() const
+{
+  MemoryReport report(Problem<dim>::get_memory_report());
+
+  report.add("Navier-Stokes solver", navier_stokes.get_memory_report());
+  report.add("Heat equation solver", heat_equation.get_memory_report());
+
+  return (report);
+}
+
+
+
 template <int dim>
 void MIT<dim>::run()
 {
@@ -559,11 +636,18 @@ void MIT<dim>::run()
     // Advances the VSIMEXMethod instance to t^{k}
     update_solution_vectors();
     time_stepping.advance_time();
-    *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
-                 << std::endl;
+    if (!this->is_headless())
+      *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
+                   << std::endl;
+
+    // Samples the probes if it is due
+    if (!this->skip_postprocessing())
+      this->probes.sample(time_stepping.get_current_time(),
+                          time_stepping.get_step_number());
 
     // Performs post-processing
-    postprocessing();
+    if (!this->skip_postprocessing())
+      postprocessing();
 
     // Performs coarsening and refining of the triangulation
     if (time_stepping.get_step_number() %
@@ -571,15 +655,33 @@ void MIT<dim>::run()
       this->adaptive_mesh_refinement();
 
     // Graphical output of the solution vectors
-    if ((time_stepping.get_step_number() %
-          this->prm.graphical_output_frequency == 0) ||
-        (time_stepping.get_current_time() ==
-                   time_stepping.get_end_time()))
+    if (!this->is_headless() &&
+        ((time_stepping.get_step_number() %
+           this->prm.graphical_output_frequency == 0) ||
+         (time_stepping.get_current_time() ==
+                    time_stepping.get_end_time())))
       output();
+
+    // Writes a checkpoint if it is due
+    this->checkpoint(time_stepping);
+
+    // Prints the memory consumption if it is due
+    this->report_memory_consumption();
+
+    // Advances the benchmark mode if it is enabled
+    this->benchmark_step(time_stepping);
   }
 
+  this->finalize_checkpoint();
+
+  this->finalize_benchmark();
+
+  this->graphical_output.finalize();
 
-  if (Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
+
+  if (this->prm.benchmark_data_format ==
+        RunTimeParameters::BenchmarkDataFormat::text &&
+      Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
   {
     if (!std::filesystem::exists(this->prm.graphical_output_directory))
     {
@@ -662,15 +764,17 @@ int main(int argc, char *argv[])
 
       Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
 
-      std::string parameter_filename;
-      if (argc >= 2)
-        parameter_filename = argv[1];
-      else
-        parameter_filename = "MIT.prm";
+      std::string parameter_filename("MIT.prm");
+      bool        flag_restart = false;
+      for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--restart")
+          flag_restart = true;
+        else
+          parameter_filename = argv[i];
 
       RunTimeParameters::ProblemParameters parameter_set(parameter_filename);
 
-      MIT<2> simulation(parameter_set);
+      MIT<2> simulation(parameter_set, flag_restart);
 
       simulation.run();
 
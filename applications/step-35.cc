@@ -104,6 +104,8 @@ public:
   Step35Problem(const RunTimeParameters::ProblemParameters &parameters);
 
   void run();
+
+  MemoryReport get_memory_report() const override;
 private:
   const RunTimeParameters::ProblemParameters   &parameters;
 
@@ -172,15 +174,25 @@ pressure_initial_condition(
 evaluation_point(2.0, 3.0)
 {
   *this->pcout << parameters << std::endl << std::endl;
+  this->container.add_entity(*velocity);
+  this->container.add_entity(*pressure, false);
+  this->container.add_entity(*navier_stokes.phi, false);
+
+  this->distribute_cell_geometry_cache_memory_budget();
+
   make_grid(parameters.spatial_discretization_parameters.n_initial_global_refinements);
   setup_dofs();
   setup_constraints();
+
+  // Accounts for the Dirichlet boundaries in the partition of the mesh
+  if (this->update_dirichlet_boundary_ids())
+  {
+    setup_dofs();
+    setup_constraints();
+  }
   velocity->setup_vectors();
   pressure->setup_vectors();
   initialize();
-  this->container.add_entity(*velocity);
-  this->container.add_entity(*pressure, false);
-  this->container.add_entity(*navier_stokes.phi, false);
 }
 
 template <int dim>
@@ -338,6 +350,18 @@ void Step35Problem<dim>::update_solution_vectors()
   pressure->update_solution_vectors();
 }
 
+template <int dim>
+MemoryReport Step35Problem<dim>::get_memory_report() const
+{
+  MemoryReport report(Problem<dim>::get_memory_report());
+
+  report.add("Navier-Stokes solver", navier_stokes.get_memory_report());
+
+  return (report);
+}
+
+
+
 template <int dim>
 void Step35Problem<dim>::run()
 {
@@ -366,26 +390,37 @@ void Step35Problem<dim>::run()
     // Advances the VSIMEXMethod instance to t^{k}
     update_solution_vectors();
     time_stepping.advance_time();
-    *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
-                 << std::endl;
+    if (!this->is_headless())
+      *this->pcout << static_cast<TimeDiscretization::DiscreteTime &>(time_stepping)
+                   << std::endl;
 
     // Snapshot stage
-    if (time_stepping.get_step_number() %
-         this->prm.terminal_output_frequency == 0 ||
-        time_stepping.get_current_time() == time_stepping.get_end_time())
+    if (!this->skip_postprocessing() &&
+        (time_stepping.get_step_number() %
+          this->prm.terminal_output_frequency == 0 ||
+         time_stepping.get_current_time() == time_stepping.get_end_time()))
       postprocessing();
 
     if (time_stepping.get_step_number() %
         this->prm.spatial_discretization_parameters.adaptive_mesh_refinement_frequency == 0)
       this->adaptive_mesh_refinement();
 
-    if ((time_stepping.get_step_number() %
-          this->prm.graphical_output_frequency == 0) ||
-        (time_stepping.get_current_time() ==
-                   time_stepping.get_end_time()))
+    if (!this->is_headless() &&
+        ((time_stepping.get_step_number() %
+           this->prm.graphical_output_frequency == 0) ||
+         (time_stepping.get_current_time() ==
+                    time_stepping.get_end_time())))
       output();
+
+    // Prints the memory consumption if it is due
+    this->report_memory_consumption();
+
+    // Advances the benchmark mode if it is enabled
+    this->benchmark_step(time_stepping);
   }
 
+  this->finalize_benchmark();
+
   *(this->pcout) << std::fixed;
 
 }
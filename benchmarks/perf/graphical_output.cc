@@ -0,0 +1,348 @@
+/*!
+ * @file graphical_output
+ *
+ * @brief Benchmark comparing the wall time and the size on disk of the
+ * graphical output in the VTU and the HDF5 format.
+ *
+ * @details The velocity, pressure and temperature fields of the
+ * Christensen benchmark are interpolated on a globally refined spherical
+ * shell and written several times with curved patches and the spherical
+ * postprocessor of the velocity, i.e., with the same settings as in the
+ * application. Only the first output builds the patches from scratch,
+ * the subsequent ones interpolate the fields onto the cached patches. Each format is written
+ * synchronously and through the queue of the background thread. In the
+ * latter case the measured time is the one the time loop is blocked,
+ * including the final wait for the pending outputs. The HDF5 format is
+ * only benchmarked if deal.II was configured with HDF5. Each run appends
+ * one row per configuration to the file `graphical_output.txt`.
+ *
+ * Usage: `mpirun -np N ./graphical_output [n_global_refinements] [n_outputs]`
+ */
+#include <rotatingMHD/data_postprocessors.h>
+#include <rotatingMHD/finite_element_field.h>
+#include <rotatingMHD/graphical_output.h>
+#include <rotatingMHD/run_time_parameters.h>
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/function.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace GraphicalOutputBenchmark
+{
+
+using namespace dealii;
+using namespace RMHD;
+
+/*!
+ * @brief A smooth field whose values change with time such that each
+ * output contains different data.
+ */
+template <int dim>
+class TestFunction : public Function<dim>
+{
+public:
+  TestFunction(const unsigned int n_components)
+  :
+  Function<dim>(n_components)
+  {}
+
+  virtual double value(const Point<dim>  &point,
+                       const unsigned int component = 0) const override
+  {
+    return (std::sin(point.norm() + this->get_time() + component) *
+            std::cos(point[0] * point[1]));
+  }
+};
+
+
+
+template <int dim>
+class Benchmark
+{
+public:
+  Benchmark(const unsigned int n_global_refinements,
+            const unsigned int n_outputs);
+
+  void run();
+
+private:
+  const MPI_Comm                                    mpi_communicator;
+
+  ConditionalOStream                                pcout;
+
+  parallel::distributed::Triangulation<dim>         triangulation;
+
+  std::shared_ptr<Mapping<dim>>                     mapping;
+
+  std::shared_ptr<Entities::FE_VectorField<dim>>    velocity;
+
+  std::shared_ptr<Entities::FE_ScalarField<dim>>    pressure;
+
+  std::shared_ptr<Entities::FE_ScalarField<dim>>    temperature;
+
+  const unsigned int                                n_global_refinements;
+
+  const unsigned int                                n_outputs;
+
+  void setup();
+
+  void interpolate(const double time);
+
+  void time_output(const RunTimeParameters::GraphicalOutputFormat format,
+                   const std::string                             &format_name,
+                   const unsigned int                             queue_depth);
+};
+
+
+
+template <int dim>
+Benchmark<dim>::Benchmark
+(const unsigned int n_global_refinements,
+ const unsigned int n_outputs)
+:
+mpi_communicator(MPI_COMM_WORLD),
+pcout(std::cout, Utilities::MPI::this_mpi_process(mpi_communicator) == 0),
+triangulation(mpi_communicator),
+mapping(std::make_shared<MappingQ<dim>>(4, true)),
+velocity(std::make_shared<Entities::FE_VectorField<dim>>(2,
+                                                         triangulation,
+                                                         "Velocity")),
+pressure(std::make_shared<Entities::FE_ScalarField<dim>>(1,
+                                                         triangulation,
+                                                         "Pressure")),
+temperature(std::make_shared<Entities::FE_ScalarField<dim>>(2,
+                                                            triangulation,
+                                                            "Temperature")),
+n_global_refinements(n_global_refinements),
+n_outputs(n_outputs)
+{}
+
+
+
+template <int dim>
+void Benchmark<dim>::setup()
+{
+  GridGenerator::hyper_shell(triangulation,
+                             Point<dim>(),
+                             7.0 / 13.0,
+                             20.0 / 13.0,
+                             0,
+                             true);
+  triangulation.refine_global(n_global_refinements);
+
+  velocity->setup_dofs();
+  pressure->setup_dofs();
+  temperature->setup_dofs();
+
+  velocity->setup_vectors();
+  pressure->setup_vectors();
+  temperature->setup_vectors();
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::interpolate(const double time)
+{
+  for (const auto &field:
+       std::vector<std::shared_ptr<Entities::FE_FieldBase<dim>>>{velocity,
+                                                                 pressure,
+                                                                 temperature})
+  {
+    TestFunction<dim> function(field->n_components());
+    function.set_time(time);
+
+    VectorTools::interpolate(*mapping,
+                             field->get_dof_handler(),
+                             function,
+                             field->distributed_vector);
+
+    field->solution = field->distributed_vector;
+  }
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::time_output
+(const RunTimeParameters::GraphicalOutputFormat format,
+ const std::string                             &format_name,
+ const unsigned int                             queue_depth)
+{
+  RunTimeParameters::OutputControlParameters  prm;
+
+  prm.graphical_output_format       = format;
+  prm.graphical_output_queue_depth  = queue_depth;
+  prm.graphical_output_directory    = "graphical_output_" + format_name +
+                                      "_" + std::to_string(queue_depth) + "/";
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+  {
+    std::filesystem::remove_all(prm.graphical_output_directory);
+    std::filesystem::create_directories(prm.graphical_output_directory);
+  }
+
+  MPI_Barrier(mpi_communicator);
+
+  GraphicalOutput<dim>  graphical_output(prm, triangulation, mapping);
+
+  graphical_output.add_field(*velocity, "velocity");
+  graphical_output.add_field(
+    *velocity,
+    std::make_shared<SphericalPostprocessorVectorField<dim>>("velocity"));
+  graphical_output.add_field(*pressure);
+  graphical_output.add_field(*temperature);
+  graphical_output.set_patch_parameters(velocity->fe_degree(),
+                                        DataOut<dim>::curved_inner_cells);
+
+  double  wall_time = 0.0;
+
+  for (unsigned int i = 0; i < n_outputs; ++i)
+  {
+    interpolate(0.1 * i);
+
+    Timer timer(mpi_communicator, true);
+
+    graphical_output.write(0.1 * i);
+
+    timer.stop();
+
+    wall_time += timer.wall_time();
+  }
+
+  {
+    Timer timer(mpi_communicator, true);
+
+    graphical_output.finalize();
+
+    timer.stop();
+
+    wall_time += timer.wall_time();
+  }
+
+  MPI_Barrier(mpi_communicator);
+
+  const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+  {
+    std::uintmax_t  n_bytes = 0;
+
+    for (const auto &entry:
+         std::filesystem::directory_iterator(prm.graphical_output_directory))
+      if (entry.is_regular_file())
+        n_bytes += entry.file_size();
+
+    std::cout << std::setw(8)  << format_name
+              << std::setw(8)  << queue_depth
+              << std::setw(8)  << n_ranks
+              << std::setw(14) << triangulation.n_global_active_cells()
+              << std::setw(10) << n_outputs
+              << std::setw(16) << std::scientific << std::setprecision(4)
+              << wall_time / n_outputs
+              << std::setw(16) << static_cast<double>(n_bytes) / n_outputs
+              << std::defaultfloat << std::endl;
+
+    std::ofstream file("graphical_output.txt", std::ios_base::app);
+
+    file << format_name << ' '
+         << queue_depth << ' '
+         << n_ranks << ' '
+         << triangulation.n_global_active_cells() << ' '
+         << n_outputs << ' '
+         << std::scientific << std::setprecision(6)
+         << wall_time / n_outputs << ' '
+         << n_bytes / n_outputs
+         << std::endl;
+  }
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::run()
+{
+  setup();
+
+  pcout << std::setw(8)  << "Format"
+        << std::setw(8)  << "Queue"
+        << std::setw(8)  << "Ranks"
+        << std::setw(14) << "Cells"
+        << std::setw(10) << "Outputs"
+        << std::setw(16) << "Time/output"
+        << std::setw(16) << "Bytes/output"
+        << std::endl;
+
+  time_output(RunTimeParameters::GraphicalOutputFormat::vtu, "vtu", 0);
+  time_output(RunTimeParameters::GraphicalOutputFormat::vtu, "vtu", 2);
+
+  #ifdef DEAL_II_WITH_HDF5
+    time_output(RunTimeParameters::GraphicalOutputFormat::hdf5, "hdf5", 0);
+    time_output(RunTimeParameters::GraphicalOutputFormat::hdf5, "hdf5", 2);
+  #else
+    pcout << "deal.II was configured without HDF5. The HDF5 format is "
+             "skipped." << std::endl;
+  #endif
+}
+
+} // namespace GraphicalOutputBenchmark
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+      using namespace dealii;
+      using namespace GraphicalOutputBenchmark;
+
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      const unsigned int n_global_refinements =
+        (argc >= 2 ? Utilities::string_to_int(argv[1]) : 3);
+      const unsigned int n_outputs =
+        (argc >= 3 ? Utilities::string_to_int(argv[2]) : 10);
+
+      Benchmark<3> benchmark(n_global_refinements, n_outputs);
+
+      benchmark.run();
+  }
+  catch (std::exception &exc)
+  {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+  }
+  catch (...)
+  {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,417 @@
+/*!
+ * @file pipelined_krylov
+ *
+ * @brief Benchmark comparing the time per iteration of the standard and
+ * the pipelined Krylov subspace methods.
+ *
+ * @details A Poisson problem is solved with the conjugate gradient
+ * methods and an advection-diffusion problem with the GMRES methods on a
+ * globally refined hypercube. The program is meant to be run with
+ * different numbers of MPI processes, see `scripts/pipelined_krylov.sh`.
+ * Each run appends one row per solver to the file
+ * `pipelined_krylov.txt`.
+ *
+ * Usage: `mpirun -np N ./pipelined_krylov [n_global_refinements] [fe_degree]`
+ */
+#include <rotatingMHD/global.h>
+#include <rotatingMHD/linear_solver_parameters.h>
+#include <rotatingMHD/linear_solvers.h>
+#include <rotatingMHD/utility.h>
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparsity_tools.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace PipelinedKrylovBenchmark
+{
+
+using namespace dealii;
+using namespace RMHD;
+
+template <int dim>
+class Benchmark
+{
+public:
+  Benchmark(const unsigned int n_global_refinements,
+            const unsigned int fe_degree);
+
+  void run();
+
+private:
+  const MPI_Comm                            mpi_communicator;
+
+  ConditionalOStream                        pcout;
+
+  parallel::distributed::Triangulation<dim> triangulation;
+
+  FE_Q<dim>                                 fe;
+
+  DoFHandler<dim>                           dof_handler;
+
+  AffineConstraints<double>                 constraints;
+
+  IndexSet                                  locally_owned_dofs;
+
+  IndexSet                                  locally_relevant_dofs;
+
+  LinearAlgebra::MPI::SparseMatrix          laplace_matrix;
+
+  LinearAlgebra::MPI::SparseMatrix          advection_diffusion_matrix;
+
+  LinearAlgebra::MPI::Vector                rhs;
+
+  const unsigned int                        n_global_refinements;
+
+  const unsigned int                        n_repetitions;
+
+  void setup();
+
+  void assemble();
+
+  template <typename SolveFunction>
+  void time_solver(const std::string                      &solver_name,
+                   const LinearAlgebra::MPI::SparseMatrix &matrix,
+                   const SolveFunction                    &solve_function);
+};
+
+
+
+template <int dim>
+Benchmark<dim>::Benchmark
+(const unsigned int n_global_refinements,
+ const unsigned int fe_degree)
+:
+mpi_communicator(MPI_COMM_WORLD),
+pcout(std::cout, Utilities::MPI::this_mpi_process(mpi_communicator) == 0),
+triangulation(mpi_communicator),
+fe(fe_degree),
+dof_handler(triangulation),
+n_global_refinements(n_global_refinements),
+n_repetitions(5)
+{}
+
+
+
+template <int dim>
+void Benchmark<dim>::setup()
+{
+  GridGenerator::hyper_cube(triangulation);
+  triangulation.refine_global(n_global_refinements);
+
+  dof_handler.distribute_dofs(fe);
+
+  locally_owned_dofs = dof_handler.locally_owned_dofs();
+  DoFTools::extract_locally_relevant_dofs(dof_handler,
+                                          locally_relevant_dofs);
+
+  constraints.clear();
+  constraints.reinit(locally_relevant_dofs);
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  VectorTools::interpolate_boundary_values(dof_handler,
+                                           0,
+                                           Functions::ZeroFunction<dim>(),
+                                           constraints);
+  constraints.close();
+
+  DynamicSparsityPattern  sparsity_pattern(locally_relevant_dofs);
+
+  DoFTools::make_sparsity_pattern(dof_handler,
+                                  sparsity_pattern,
+                                  constraints,
+                                  false);
+
+  SparsityTools::distribute_sparsity_pattern(sparsity_pattern,
+                                             locally_owned_dofs,
+                                             mpi_communicator,
+                                             locally_relevant_dofs);
+
+  laplace_matrix.reinit(locally_owned_dofs,
+                        locally_owned_dofs,
+                        sparsity_pattern,
+                        mpi_communicator);
+  advection_diffusion_matrix.reinit(locally_owned_dofs,
+                                    locally_owned_dofs,
+                                    sparsity_pattern,
+                                    mpi_communicator);
+
+  rhs.reinit(locally_owned_dofs, mpi_communicator);
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::assemble()
+{
+  const QGauss<dim> quadrature_formula(fe.degree + 1);
+
+  FEValues<dim> fe_values(fe,
+                          quadrature_formula,
+                          update_values|
+                          update_gradients|
+                          update_JxW_values);
+
+  const unsigned int dofs_per_cell = fe.dofs_per_cell;
+  const unsigned int n_q_points    = quadrature_formula.size();
+
+  FullMatrix<double>  local_laplace_matrix(dofs_per_cell, dofs_per_cell);
+  FullMatrix<double>  local_advection_diffusion_matrix(dofs_per_cell, dofs_per_cell);
+  Vector<double>      local_rhs(dofs_per_cell);
+
+  std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+
+  // A constant advection field yields a non-symmetric matrix
+  Tensor<1, dim>  advection_field;
+  for (unsigned int d = 0; d < dim; ++d)
+    advection_field[d] = 1.0 + d;
+
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (cell->is_locally_owned())
+    {
+      local_laplace_matrix              = 0.;
+      local_advection_diffusion_matrix  = 0.;
+      local_rhs                         = 0.;
+
+      fe_values.reinit(cell);
+
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        {
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+          {
+            const double laplace_term = fe_values.shape_grad(i, q) *
+                                        fe_values.shape_grad(j, q);
+
+            local_laplace_matrix(i, j) += laplace_term * fe_values.JxW(q);
+
+            local_advection_diffusion_matrix(i, j) +=
+              (fe_values.shape_value(i, q) * fe_values.shape_value(j, q) +
+               1e-2 * laplace_term +
+               fe_values.shape_value(i, q) * (advection_field *
+                                              fe_values.shape_grad(j, q))) *
+              fe_values.JxW(q);
+          }
+
+          local_rhs(i) += fe_values.shape_value(i, q) * fe_values.JxW(q);
+        }
+
+      cell->get_dof_indices(local_dof_indices);
+
+      constraints.distribute_local_to_global(local_laplace_matrix,
+                                             local_rhs,
+                                             local_dof_indices,
+                                             laplace_matrix,
+                                             rhs);
+      constraints.distribute_local_to_global(local_advection_diffusion_matrix,
+                                             local_dof_indices,
+                                             advection_diffusion_matrix);
+    }
+
+  laplace_matrix.compress(VectorOperation::add);
+  advection_diffusion_matrix.compress(VectorOperation::add);
+  rhs.compress(VectorOperation::add);
+}
+
+
+
+template <int dim>
+template <typename SolveFunction>
+void Benchmark<dim>::time_solver
+(const std::string                      &solver_name,
+ const LinearAlgebra::MPI::SparseMatrix &matrix,
+ const SolveFunction                    &solve_function)
+{
+  // The preconditioner is deliberately cheap such that the time per
+  // iteration is dominated by the matrix-vector product and the global
+  // reductions.
+  std::shared_ptr<LinearAlgebra::PreconditionBase>  preconditioner;
+
+  build_preconditioner(preconditioner,
+                       matrix,
+                       std::make_shared<RunTimeParameters::PreconditionJacobiParameters>());
+
+  LinearAlgebra::MPI::Vector  solution(rhs);
+
+  double        minimum_wall_time = std::numeric_limits<double>::max();
+  unsigned int  n_iterations      = 0;
+
+  for (unsigned int i = 0; i < n_repetitions; ++i)
+  {
+    solution = 0.;
+
+    SolverControl solver_control(100000, 1e-8 * rhs.l2_norm());
+
+    Timer timer(mpi_communicator, true);
+
+    solve_function(solver_control, matrix, solution, *preconditioner);
+
+    timer.stop();
+
+    minimum_wall_time = std::min(minimum_wall_time,
+                                 timer.wall_time());
+    n_iterations      = solver_control.last_step();
+  }
+
+  const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+  pcout << std::setw(20) << solver_name
+        << std::setw(8)  << n_ranks
+        << std::setw(14) << dof_handler.n_dofs()
+        << std::setw(14) << dof_handler.n_dofs() / n_ranks
+        << std::setw(12) << n_iterations
+        << std::setw(16) << std::scientific << std::setprecision(4)
+        << minimum_wall_time / std::max(n_iterations, 1U)
+        << std::defaultfloat << std::endl;
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+  {
+    std::ofstream file("pipelined_krylov.txt", std::ios_base::app);
+
+    file << solver_name << ' '
+         << n_ranks << ' '
+         << dof_handler.n_dofs() << ' '
+         << n_iterations << ' '
+         << std::scientific << std::setprecision(6)
+         << minimum_wall_time / std::max(n_iterations, 1U)
+         << std::endl;
+  }
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::run()
+{
+  setup();
+
+  assemble();
+
+  pcout << std::setw(20) << "Solver"
+        << std::setw(8)  << "Ranks"
+        << std::setw(14) << "DoFs"
+        << std::setw(14) << "DoFs/rank"
+        << std::setw(12) << "Iterations"
+        << std::setw(16) << "Time/iteration"
+        << std::endl;
+
+  time_solver("CG",
+              laplace_matrix,
+              [&](SolverControl                           &solver_control,
+                  const LinearAlgebra::MPI::SparseMatrix  &matrix,
+                  LinearAlgebra::MPI::Vector              &solution,
+                  const LinearAlgebra::PreconditionBase   &preconditioner)
+              {
+                #ifdef USE_PETSC_LA
+                  LinearAlgebra::SolverCG solver(solver_control,
+                                                 mpi_communicator);
+                #else
+                  LinearAlgebra::SolverCG solver(solver_control);
+                #endif
+                solver.solve(matrix, solution, rhs, preconditioner);
+              });
+
+  time_solver("PipelinedCG",
+              laplace_matrix,
+              [&](SolverControl                           &solver_control,
+                  const LinearAlgebra::MPI::SparseMatrix  &matrix,
+                  LinearAlgebra::MPI::Vector              &solution,
+                  const LinearAlgebra::PreconditionBase   &preconditioner)
+              {
+                PipelinedCG solver(solver_control);
+                solver.solve(matrix, solution, rhs, preconditioner);
+              });
+
+  time_solver("GMRES",
+              advection_diffusion_matrix,
+              [&](SolverControl                           &solver_control,
+                  const LinearAlgebra::MPI::SparseMatrix  &matrix,
+                  LinearAlgebra::MPI::Vector              &solution,
+                  const LinearAlgebra::PreconditionBase   &preconditioner)
+              {
+                #ifdef USE_PETSC_LA
+                  LinearAlgebra::SolverGMRES solver(solver_control,
+                                                    mpi_communicator);
+                #else
+                  LinearAlgebra::SolverGMRES solver(solver_control);
+                #endif
+                solver.solve(matrix, solution, rhs, preconditioner);
+              });
+
+  time_solver("PipelinedGMRES",
+              advection_diffusion_matrix,
+              [&](SolverControl                           &solver_control,
+                  const LinearAlgebra::MPI::SparseMatrix  &matrix,
+                  LinearAlgebra::MPI::Vector              &solution,
+                  const LinearAlgebra::PreconditionBase   &preconditioner)
+              {
+                PipelinedGMRES solver(solver_control);
+                solver.solve(matrix, solution, rhs, preconditioner);
+              });
+}
+
+} // namespace PipelinedKrylovBenchmark
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+      using namespace dealii;
+      using namespace PipelinedKrylovBenchmark;
+
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      const unsigned int n_global_refinements =
+        (argc >= 2 ? Utilities::string_to_int(argv[1]) : 6);
+      const unsigned int fe_degree =
+        (argc >= 3 ? Utilities::string_to_int(argv[2]) : 2);
+
+      Benchmark<3> benchmark(n_global_refinements, fe_degree);
+
+      benchmark.run();
+  }
+  catch (std::exception &exc)
+  {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+  }
+  catch (...)
+  {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,644 @@
+/*!
+ * @file solver_phases
+ *
+ * @brief Benchmark measuring the wall time of each assembly and solve
+ * phase of the Navier-Stokes and the heat equation solvers.
+ *
+ * @details The velocity, pressure and temperature fields are discretized
+ * with the elements \f$ Q_{k+1} \f$, \f$ Q_k \f$ and \f$ Q_{k+1} \f$ on
+ * a globally refined hypercube or spherical shell, where \f$ k \f$ is
+ * the finite element degree passed on the command line. The velocity and
+ * the temperature are initialized with smooth fields and a fixed number
+ * of time steps is performed after a warm-up of two steps, which absorbs
+ * the setup of the solvers, the Poisson pre-step and the first build of
+ * the preconditioners. The phases are timed through the sections of the
+ * TimerOutput instance shared with the solvers, i.e., the advection
+ * matrix, the right-hand sides, the CFL number, the linear solves and the
+ * pressure correction are measured exactly as in the applications. The
+ * evaluation of the velocity and the temperature at a set of points is
+ * timed by the benchmark itself.
+ *
+ * Each run appends one line per refinement level to the output file,
+ * `solver_phases.json` by default. The line is a JSON object describing
+ * the configuration, the wall time per step, the average number of
+ * iterations per step of each linear solve, the number of locally owned
+ * degrees of freedom and the memory usage per process, the memory of
+ * each matrix, vector and preconditioner as given by MemoryReport and,
+ * for each phase, the number of calls, the maximum and the average wall
+ * time over all processes, the time per call, the time per cell and the
+ * number of degrees of freedom processed per second. The quantities per process are
+ * given by their minimum, maximum and average. See
+ * `scripts/solver_phases.sh` for the sweep over the dimensions, meshes
+ * and finite element degrees and `scripts/scaling.sh` for the strong and
+ * weak scaling runs, whose tables are produced by
+ * `scripts/scaling_tables.py`.
+ *
+ * Usage: `mpirun -np N ./solver_phases [dim] [mesh] [fe_degree]
+ * [n_global_refinements] [n_steps] [output_file]`, where `mesh` is either
+ * `hyper_cube` or `hyper_shell` and `n_global_refinements` is a comma
+ * separated list of refinement levels.
+ */
+#include <rotatingMHD/convection_diffusion_solver.h>
+#include <rotatingMHD/finite_element_field.h>
+#include <rotatingMHD/memory_report.h>
+#include <rotatingMHD/navier_stokes_projection.h>
+#include <rotatingMHD/run_time_parameters.h>
+#include <rotatingMHD/time_discretization.h>
+#include <rotatingMHD/vector_tools.h>
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/function.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace SolverPhasesBenchmark
+{
+
+using namespace dealii;
+using namespace RMHD;
+
+/*!
+ * @brief A smooth field used as initial condition of the velocity and
+ * the temperature.
+ */
+template <int dim>
+class InitialCondition : public Function<dim>
+{
+public:
+  InitialCondition(const unsigned int n_components)
+  :
+  Function<dim>(n_components)
+  {}
+
+  virtual double value(const Point<dim>  &point,
+                       const unsigned int component = 0) const override
+  {
+    return (std::sin(numbers::PI * point[(component + 1) % dim]) *
+            std::cos(numbers::PI * point[component]));
+  }
+};
+
+
+
+template <int dim>
+class Benchmark
+{
+public:
+  Benchmark(const std::string  &mesh,
+            const unsigned int  fe_degree,
+            const unsigned int  n_global_refinements,
+            const unsigned int  n_steps,
+            const std::string  &output_filename);
+
+  void run();
+
+private:
+  const MPI_Comm                                    mpi_communicator;
+
+  std::shared_ptr<ConditionalOStream>               pcout;
+
+  std::shared_ptr<TimerOutput>                      computing_timer;
+
+  parallel::distributed::Triangulation<dim>         triangulation;
+
+  std::shared_ptr<Mapping<dim>>                     mapping;
+
+  std::shared_ptr<Entities::FE_VectorField<dim>>    velocity;
+
+  std::shared_ptr<Entities::FE_ScalarField<dim>>    pressure;
+
+  std::shared_ptr<Entities::FE_ScalarField<dim>>    temperature;
+
+  RunTimeParameters::NavierStokesParameters         navier_stokes_parameters;
+
+  RunTimeParameters::HeatEquationParameters         heat_equation_parameters;
+
+  TimeDiscretization::VSIMEXMethod                  time_stepping;
+
+  NavierStokesProjection<dim>                       navier_stokes;
+
+  ConvectionDiffusionSolver<dim>                    heat_equation;
+
+  std::vector<Point<dim>>                           evaluation_points;
+
+  const std::string                                 mesh;
+
+  const unsigned int                                fe_degree;
+
+  const unsigned int                                n_global_refinements;
+
+  const unsigned int                                n_steps;
+
+  const std::string                                 output_filename;
+
+  /*!
+   * @brief The number of iterations of each linear solve summed over the
+   * timed steps.
+   */
+  std::map<std::string, unsigned int>               n_iterations;
+
+  /*!
+   * @brief The wall time of the timed steps.
+   */
+  double                                            wall_time;
+
+  void make_grid();
+
+  void setup();
+
+  void time_step();
+
+  void evaluate_points();
+
+  types::global_dof_index n_dofs_of_phase(const std::string &phase) const;
+
+  void write_results() const;
+};
+
+
+
+namespace internal
+{
+  TimeDiscretization::TimeDiscretizationParameters
+  time_discretization_parameters()
+  {
+    TimeDiscretization::TimeDiscretizationParameters  prm;
+
+    prm.adaptive_time_stepping  = false;
+    prm.initial_time_step       = 1e-3;
+    prm.minimum_time_step       = 1e-3;
+    prm.maximum_time_step       = 1e-3;
+    prm.final_time              = 1e6;
+
+    return (prm);
+  }
+}  // namespace internal
+
+
+
+template <int dim>
+Benchmark<dim>::Benchmark
+(const std::string  &mesh,
+ const unsigned int  fe_degree,
+ const unsigned int  n_global_refinements,
+ const unsigned int  n_steps,
+ const std::string  &output_filename)
+:
+mpi_communicator(MPI_COMM_WORLD),
+pcout(std::make_shared<ConditionalOStream>(
+        std::cout,
+        Utilities::MPI::this_mpi_process(mpi_communicator) == 0)),
+computing_timer(std::make_shared<TimerOutput>(mpi_communicator,
+                                              *pcout,
+                                              TimerOutput::never,
+                                              TimerOutput::wall_times)),
+triangulation(mpi_communicator),
+mapping(std::make_shared<MappingQ<dim>>(fe_degree + 1, true)),
+velocity(std::make_shared<Entities::FE_VectorField<dim>>(fe_degree + 1,
+                                                         triangulation,
+                                                         "Velocity")),
+pressure(std::make_shared<Entities::FE_ScalarField<dim>>(fe_degree,
+                                                         triangulation,
+                                                         "Pressure")),
+temperature(std::make_shared<Entities::FE_ScalarField<dim>>(fe_degree + 1,
+                                                            triangulation,
+                                                            "Temperature")),
+time_stepping(internal::time_discretization_parameters()),
+navier_stokes(navier_stokes_parameters,
+              time_stepping,
+              velocity,
+              pressure,
+              mapping,
+              pcout,
+              computing_timer),
+heat_equation(heat_equation_parameters,
+              time_stepping,
+              temperature,
+              velocity,
+              mapping,
+              pcout,
+              computing_timer),
+mesh(mesh),
+fe_degree(fe_degree),
+n_global_refinements(n_global_refinements),
+n_steps(n_steps),
+output_filename(output_filename),
+wall_time(0.0)
+{
+  AssertThrow(mesh == "hyper_cube" || mesh == "hyper_shell",
+              ExcMessage("The mesh has to be either hyper_cube or hyper_shell."));
+  AssertThrow(fe_degree > 0,
+              ExcMessage("The finite element degree has to be positive."));
+
+  navier_stokes_parameters.C2 = 1e-2;
+  heat_equation_parameters.C4 = 1e-2;
+
+  // Points on a circle in the x-y plane, which lies inside both domains
+  const unsigned int n_evaluation_points = 16;
+
+  for (unsigned int i = 0; i < n_evaluation_points; ++i)
+  {
+    const double angle = 2.0 * numbers::PI * (i + 0.5) / n_evaluation_points;
+
+    Point<dim>  point;
+    point[0] = 0.75 * std::cos(angle);
+    point[1] = 0.75 * std::sin(angle);
+
+    evaluation_points.push_back(point);
+  }
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::make_grid()
+{
+  // Both meshes have homogeneous Dirichlet boundary conditions on all
+  // boundaries, the boundary indicators are either 0 or 0 and 1.
+  if (mesh == "hyper_cube")
+    GridGenerator::hyper_cube(triangulation, -1.0, 1.0);
+  else
+    GridGenerator::hyper_shell(triangulation,
+                               Point<dim>(),
+                               0.5,
+                               1.0,
+                               0,
+                               true);
+
+  triangulation.refine_global(n_global_refinements);
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::setup()
+{
+  make_grid();
+
+  velocity->setup_dofs();
+  pressure->setup_dofs();
+  temperature->setup_dofs();
+
+  velocity->setup_boundary_conditions();
+  pressure->setup_boundary_conditions();
+  temperature->setup_boundary_conditions();
+
+  for (const auto boundary_id: triangulation.get_boundary_ids())
+  {
+    velocity->set_dirichlet_boundary_condition(boundary_id);
+    temperature->set_dirichlet_boundary_condition(boundary_id);
+  }
+  pressure->set_datum_boundary_condition();
+
+  velocity->close_boundary_conditions();
+  pressure->close_boundary_conditions();
+  temperature->close_boundary_conditions();
+
+  velocity->apply_boundary_conditions();
+  pressure->apply_boundary_conditions();
+  temperature->apply_boundary_conditions();
+
+  velocity->setup_vectors();
+  pressure->setup_vectors();
+  temperature->setup_vectors();
+
+  for (const auto &field:
+       std::vector<std::shared_ptr<Entities::FE_FieldBase<dim>>>{velocity,
+                                                                 temperature})
+  {
+    InitialCondition<dim> function(field->n_components());
+
+    RMHD::VectorTools::interpolate(*mapping,
+                                   *field,
+                                   function,
+                                   field->old_solution);
+
+    field->old_old_solution = field->old_solution;
+    field->solution         = field->old_solution;
+  }
+
+  pressure->set_solution_vectors_to_zero();
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::time_step()
+{
+  // The step size is fixed but the CFL number is computed as in the
+  // applications
+  navier_stokes.get_cfl_number();
+
+  time_stepping.update_coefficients();
+
+  heat_equation.solve();
+  navier_stokes.solve();
+
+  n_iterations["Heat equation"]   += heat_equation.get_n_iterations();
+  n_iterations["Diffusion step"]  += navier_stokes.get_diffusion_step_n_iterations();
+  n_iterations["Projection step"] += navier_stokes.get_projection_step_n_iterations();
+  n_iterations["Correction step"] += navier_stokes.get_correction_step_n_iterations();
+
+  evaluate_points();
+
+  velocity->update_solution_vectors();
+  pressure->update_solution_vectors();
+  temperature->update_solution_vectors();
+
+  time_stepping.advance_time();
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::evaluate_points()
+{
+  TimerOutput::Scope  t(*computing_timer, "Benchmark: Point evaluation");
+
+  for (const auto &point: evaluation_points)
+  {
+    velocity->point_value(point, *mapping);
+    temperature->point_value(point, *mapping);
+  }
+}
+
+
+
+template <int dim>
+types::global_dof_index
+Benchmark<dim>::n_dofs_of_phase(const std::string &phase) const
+{
+  if (phase.find("Heat") != std::string::npos)
+    return (temperature->n_dofs());
+
+  if (phase.find("Projection step") != std::string::npos ||
+      phase.find("Poisson pre-step") != std::string::npos ||
+      phase.find("Pressure") != std::string::npos)
+    return (pressure->n_dofs());
+
+  if (phase.find("Point evaluation") != std::string::npos)
+    return (velocity->n_dofs() + temperature->n_dofs());
+
+  return (velocity->n_dofs());
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::write_results() const
+{
+  const std::map<std::string, double> wall_times =
+    computing_timer->get_summary_data(TimerOutput::total_wall_time);
+  const std::map<std::string, double> n_calls =
+    computing_timer->get_summary_data(TimerOutput::n_calls);
+
+  const auto n_cells = triangulation.n_global_active_cells();
+
+  const double max_wall_time = Utilities::MPI::max(wall_time,
+                                                   mpi_communicator);
+
+  Utilities::System::MemoryStats  memory_stats;
+  Utilities::System::get_memory_stats(memory_stats);
+
+  std::ostringstream  json;
+
+  // Writes the minimum, the maximum and the average over all processes
+  const auto write_min_max_avg =
+    [&](const std::string &name, const double local_value)
+    {
+      const Utilities::MPI::MinMaxAvg min_max_avg =
+        Utilities::MPI::min_max_avg(local_value, mpi_communicator);
+
+      json << ", \"" << name << "\": {\"min\": " << min_max_avg.min
+           << ", \"max\": " << min_max_avg.max
+           << ", \"avg\": " << min_max_avg.avg << "}";
+    };
+
+  json << std::scientific << std::setprecision(6)
+       << "{\"benchmark\": \"solver_phases\""
+       << ", \"dim\": " << dim
+       << ", \"mesh\": \"" << mesh << "\""
+       << ", \"fe_degree\": " << fe_degree
+       << ", \"n_global_refinements\": " << n_global_refinements
+       << ", \"n_mpi_processes\": " << Utilities::MPI::n_mpi_processes(mpi_communicator)
+       << ", \"n_threads\": " << MultithreadInfo::n_threads()
+       << ", \"n_steps\": " << n_steps
+       << ", \"n_cells\": " << n_cells
+       << ", \"n_dofs\": {\"velocity\": " << velocity->n_dofs()
+       << ", \"pressure\": " << pressure->n_dofs()
+       << ", \"temperature\": " << temperature->n_dofs() << "}"
+       << ", \"wall_time_per_step\": " << max_wall_time / n_steps;
+
+  write_min_max_avg("dofs_per_rank",
+                    velocity->get_locally_owned_dofs().n_elements() +
+                    pressure->get_locally_owned_dofs().n_elements() +
+                    temperature->get_locally_owned_dofs().n_elements());
+  write_min_max_avg("peak_memory_per_rank_MB", memory_stats.VmHWM / 1024.0);
+  write_min_max_avg("memory_per_rank_MB", memory_stats.VmRSS / 1024.0);
+
+  // The memory of the data structures of the library, reduced by
+  // MemoryReport::reduce. Its last entry is the total.
+  MemoryReport memory_report;
+  memory_report.add("Triangulation", triangulation.memory_consumption());
+  memory_report.add(velocity->name, velocity->get_memory_report());
+  memory_report.add(pressure->name, pressure->get_memory_report());
+  memory_report.add(navier_stokes.phi->name, navier_stokes.phi->get_memory_report());
+  memory_report.add(temperature->name, temperature->get_memory_report());
+  memory_report.add("Navier-Stokes solver", navier_stokes.get_memory_report());
+  memory_report.add("Heat equation solver", heat_equation.get_memory_report());
+
+  const std::vector<Utilities::MPI::MinMaxAvg> memory_data =
+    memory_report.reduce(mpi_communicator);
+
+  json << ", \"memory_report_MB\": [";
+  for (unsigned int i = 0; i < memory_data.size(); ++i)
+    json << (i == 0 ? "" : ", ")
+         << "{\"name\": \""
+         << (i < memory_report.get_entries().size()
+             ? memory_report.get_entries()[i].first
+             : std::string("Total"))
+         << "\", \"min\": " << memory_data[i].min
+         << ", \"max\": " << memory_data[i].max
+         << ", \"sum\": " << memory_data[i].sum << "}";
+  json << "]";
+
+  json << ", \"iterations_per_step\": {";
+  for (auto it = n_iterations.begin(); it != n_iterations.end(); ++it)
+    json << (it == n_iterations.begin() ? "" : ", ")
+         << "\"" << it->first << "\": "
+         << static_cast<double>(it->second) / n_steps;
+  json << "}";
+
+  json << ", \"phases\": [";
+
+  bool first_phase = true;
+
+  // The sections are stored in a map, i.e., they are traversed in the
+  // same order on all processes.
+  for (const auto &[phase, local_wall_time]: wall_times)
+  {
+    const Utilities::MPI::MinMaxAvg phase_wall_time =
+      Utilities::MPI::min_max_avg(local_wall_time, mpi_communicator);
+    const unsigned int n_phase_calls =
+      static_cast<unsigned int>(n_calls.at(phase));
+
+    if (n_phase_calls == 0)
+      continue;
+
+    const double time_per_call = phase_wall_time.max / n_phase_calls;
+
+    json << (first_phase ? "" : ", ")
+         << "{\"name\": \"" << phase << "\""
+         << ", \"n_calls\": " << n_phase_calls
+         << ", \"max_wall_time\": " << phase_wall_time.max
+         << ", \"avg_wall_time\": " << phase_wall_time.avg
+         << ", \"time_per_call\": " << time_per_call
+         << ", \"time_per_cell\": " << time_per_call / n_cells
+         << ", \"dofs_per_second\": "
+         << (time_per_call > 0.0 ? n_dofs_of_phase(phase) / time_per_call : 0.0)
+         << "}";
+
+    first_phase = false;
+  }
+
+  json << "]}";
+
+  *pcout << json.str() << std::endl;
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+  {
+    std::ofstream file(output_filename, std::ios_base::app);
+
+    file << json.str() << std::endl;
+  }
+}
+
+
+
+template <int dim>
+void Benchmark<dim>::run()
+{
+  setup();
+
+  *pcout << "Dimension " << dim
+         << ", " << mesh
+         << ", degree " << fe_degree
+         << ", " << triangulation.n_global_active_cells() << " cells"
+         << ", " << velocity->n_dofs() + pressure->n_dofs() + temperature->n_dofs()
+         << " DoFs" << std::endl;
+
+  // The warm-up includes the setup of the solvers, the Poisson pre-step
+  // and the first build of the preconditioners
+  const unsigned int n_warm_up_steps = 2;
+
+  for (unsigned int i = 0; i < n_warm_up_steps; ++i)
+    time_step();
+
+  computing_timer->reset();
+  n_iterations.clear();
+
+  Timer timer(mpi_communicator, true);
+
+  for (unsigned int i = 0; i < n_steps; ++i)
+    time_step();
+
+  timer.stop();
+  wall_time = timer.wall_time();
+
+  write_results();
+}
+
+} // namespace SolverPhasesBenchmark
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+      using namespace dealii;
+      using namespace SolverPhasesBenchmark;
+
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      const unsigned int dim =
+        (argc >= 2 ? Utilities::string_to_int(argv[1]) : 2);
+      const std::string mesh =
+        (argc >= 3 ? std::string(argv[2]) : std::string("hyper_cube"));
+      const unsigned int fe_degree =
+        (argc >= 4 ? Utilities::string_to_int(argv[3]) : 1);
+      const std::vector<int> n_global_refinements =
+        Utilities::string_to_int(
+          Utilities::split_string_list(argc >= 5 ?
+                                         std::string(argv[4]) :
+                                         std::string(dim == 2 ? "6" : "3")));
+      const unsigned int n_steps =
+        (argc >= 6 ? Utilities::string_to_int(argv[5]) : 10);
+      const std::string output_filename =
+        (argc >= 7 ? std::string(argv[6]) : std::string("solver_phases.json"));
+
+      AssertThrow(dim == 2 || dim == 3,
+                  ExcMessage("The dimension has to be either 2 or 3."));
+      AssertThrow(n_steps > 0,
+                  ExcMessage("The number of steps has to be positive."));
+
+      for (const int n_refinements: n_global_refinements)
+        if (dim == 2)
+        {
+          Benchmark<2> benchmark(mesh,
+                                 fe_degree,
+                                 n_refinements,
+                                 n_steps,
+                                 output_filename);
+          benchmark.run();
+        }
+        else
+        {
+          Benchmark<3> benchmark(mesh,
+                                 fe_degree,
+                                 n_refinements,
+                                 n_steps,
+                                 output_filename);
+          benchmark.run();
+        }
+  }
+  catch (std::exception &exc)
+  {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+  }
+  catch (...)
+  {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+  }
+  return 0;
+}
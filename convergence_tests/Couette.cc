@@ -220,7 +220,8 @@ class CouetteFlowProblem : public Problem<dim>
 {
 public:
 
-  CouetteFlowProblem(const RunTimeParameters::ProblemParameters &parameters);
+  CouetteFlowProblem(const RunTimeParameters::ProblemParameters &parameters,
+                     const ConvergenceTest::CycleDistribution   &cycle_distribution);
 
   void run();
 
@@ -228,6 +229,8 @@ private:
 
   const RunTimeParameters::ProblemParameters   &parameters;
 
+  const ConvergenceTest::CycleDistribution     &cycle_distribution;
+
   std::shared_ptr<Entities::FE_VectorField<dim>>  velocity;
 
   std::shared_ptr<Entities::FE_ScalarField<dim>>  pressure;
@@ -266,10 +269,12 @@ private:
 };
 
 template <int dim>
-CouetteFlowProblem<dim>::CouetteFlowProblem(const RunTimeParameters::ProblemParameters &parameters)
+CouetteFlowProblem<dim>::CouetteFlowProblem(const RunTimeParameters::ProblemParameters &parameters,
+                                            const ConvergenceTest::CycleDistribution   &cycle_distribution)
 :
-Problem<dim>(parameters),
+Problem<dim>(parameters, cycle_distribution.get_communicator()),
 parameters(parameters),
+cycle_distribution(cycle_distribution),
 velocity(std::make_shared<Entities::FE_VectorField<dim>>(parameters.fe_degree_velocity,
                                                        this->triangulation,
                                                        "Velocity")),
@@ -529,11 +534,14 @@ void CouetteFlowProblem<dim>::run()
   switch (parameters.convergence_test_parameters.test_type)
   {
   case ConvergenceTest::ConvergenceTestType::spatial:
-    for (unsigned int level = parameters.spatial_discretization_parameters.n_initial_global_refinements;
-         level < (parameters.spatial_discretization_parameters.n_initial_global_refinements +
-                  parameters.convergence_test_parameters.n_spatial_cycles);
-         ++level)
+    for (const auto cycle: cycle_distribution.get_cycles())
     {
+      const unsigned int level =
+        parameters.spatial_discretization_parameters.n_initial_global_refinements + cycle;
+
+      // Refines the triangulation up to the level of the cycle
+      this->triangulation.refine_global(level + 1 - this->triangulation.n_global_levels());
+
       *this->pcout  << std::setprecision(1)
                     << "Solving until t = "
                     << std::fixed << time_stepping.get_end_time()
@@ -544,15 +552,11 @@ void CouetteFlowProblem<dim>::run()
 
       solve(level);
 
-      this->triangulation.refine_global();
-
       navier_stokes.clear();
     }
     break;
   case ConvergenceTest::ConvergenceTestType::temporal:
-    for (unsigned int cycle = 0;
-         cycle < parameters.convergence_test_parameters.n_temporal_cycles;
-         ++cycle)
+    for (const auto cycle: cycle_distribution.get_cycles())
     {
       double time_step = parameters.time_discretization_parameters.initial_time_step *
                          pow(parameters.convergence_test_parameters.step_size_reduction_factor,
@@ -571,13 +575,19 @@ void CouetteFlowProblem<dim>::run()
 
       solve(parameters.spatial_discretization_parameters.n_initial_global_refinements);
 
-      navier_stokes.clear();
+      navier_stokes.reset_for_new_run();
     }
     break;
   default:
     break;
   }
 
+  // Gathers the tables of the cycles which were run concurrently
+  convergence_table.gather(cycle_distribution);
+
+  // Only the first process of the world communicator prints the table
+  this->pcout->set_condition(cycle_distribution.is_world_root());
+
   *(this->pcout) << convergence_table;
 
   std::ostringstream tablefilename;
@@ -605,7 +615,10 @@ int main(int argc, char *argv[])
     RunTimeParameters::ProblemParameters parameter_set("Couette.prm",
                                                        true);
 
-    CouetteFlowProblem<2> simulation(parameter_set);
+    ConvergenceTest::CycleDistribution cycle_distribution(
+      parameter_set.convergence_test_parameters, 2);
+
+    CouetteFlowProblem<2> simulation(parameter_set, cycle_distribution);
 
     simulation.run();
 
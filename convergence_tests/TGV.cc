@@ -202,7 +202,8 @@ class TGVProblem : public Problem<dim>
 {
 public:
 
-  TGVProblem(const RunTimeParameters::ProblemParameters &parameters);
+  TGVProblem(const RunTimeParameters::ProblemParameters &parameters,
+             const ConvergenceTest::CycleDistribution   &cycle_distribution);
 
   void run();
 
@@ -210,6 +211,8 @@ private:
 
   const RunTimeParameters::ProblemParameters   &parameters;
 
+  const ConvergenceTest::CycleDistribution     &cycle_distribution;
+
   std::ofstream                                 log_file;
 
   std::shared_ptr<Entities::FE_VectorField<dim>>  velocity;
@@ -250,10 +253,12 @@ private:
 };
 
 template <int dim>
-TGVProblem<dim>::TGVProblem(const RunTimeParameters::ProblemParameters &parameters)
+TGVProblem<dim>::TGVProblem(const RunTimeParameters::ProblemParameters &parameters,
+                            const ConvergenceTest::CycleDistribution   &cycle_distribution)
 :
-Problem<dim>(parameters),
+Problem<dim>(parameters, cycle_distribution.get_communicator()),
 parameters(parameters),
+cycle_distribution(cycle_distribution),
 log_file("TGV_Log.csv"),
 velocity(std::make_shared<Entities::FE_VectorField<dim>>(parameters.fe_degree_velocity,
                                                        this->triangulation,
@@ -412,6 +417,10 @@ void TGVProblem<dim>::postprocessing(const bool flag_point_evaluation)
 template <int dim>
 void TGVProblem<dim>::output()
 {
+  // The groups of concurrent cycles would write to the same files
+  if (cycle_distribution.is_concurrent())
+    return;
+
   TimerOutput::Scope  t(*this->computing_timer, "Problem: Graphical output");
 
   std::vector<std::string> names(dim, "velocity");
@@ -548,11 +557,14 @@ void TGVProblem<dim>::run()
   switch (parameters.convergence_test_parameters.test_type)
   {
   case ConvergenceTest::ConvergenceTestType::spatial:
-    for (unsigned int level = parameters.spatial_discretization_parameters.n_initial_global_refinements;
-         level < (parameters.spatial_discretization_parameters.n_initial_global_refinements +
-                  parameters.convergence_test_parameters.n_spatial_cycles);
-         ++level)
+    for (const auto cycle: cycle_distribution.get_cycles())
     {
+      const unsigned int level =
+        parameters.spatial_discretization_parameters.n_initial_global_refinements + cycle;
+
+      // Refines the triangulation up to the level of the cycle
+      this->triangulation.refine_global(level + 1 - this->triangulation.n_global_levels());
+
       *this->pcout  << std::setprecision(1)
                     << "Solving until t = "
                     << std::fixed << time_stepping.get_end_time()
@@ -563,15 +575,11 @@ void TGVProblem<dim>::run()
 
       solve(level);
 
-      this->triangulation.refine_global();
-
       navier_stokes.clear();
     }
     break;
   case ConvergenceTest::ConvergenceTestType::temporal:
-    for (unsigned int cycle = 0;
-         cycle < parameters.convergence_test_parameters.n_temporal_cycles;
-         ++cycle)
+    for (const auto cycle: cycle_distribution.get_cycles())
     {
       double time_step = parameters.time_discretization_parameters.initial_time_step *
                          pow(parameters.convergence_test_parameters.step_size_reduction_factor,
@@ -590,13 +598,20 @@ void TGVProblem<dim>::run()
 
       solve(parameters.spatial_discretization_parameters.n_initial_global_refinements);
 
-      navier_stokes.clear();
+      navier_stokes.reset_for_new_run();
     }
     break;
   default:
     break;
   }
 
+  // Gathers the tables of the cycles which were run concurrently
+  velocity_convergence_table.gather(cycle_distribution);
+  pressure_convergence_table.gather(cycle_distribution);
+
+  // Only the first process of the world communicator prints the tables
+  this->pcout->set_condition(cycle_distribution.is_world_root());
+
   *this->pcout << velocity_convergence_table;
   *this->pcout << pressure_convergence_table;
 
@@ -626,7 +641,10 @@ int main(int argc, char *argv[])
 
       RunTimeParameters::ProblemParameters parameter_set("TGV.prm", true);
 
-      TGVProblem<2> simulation(parameter_set);
+      ConvergenceTest::CycleDistribution cycle_distribution(
+        parameter_set.convergence_test_parameters, 2);
+
+      TGVProblem<2> simulation(parameter_set, cycle_distribution);
 
       simulation.run();
   }
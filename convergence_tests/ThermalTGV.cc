@@ -554,6 +554,8 @@ void ThermalTGVProblem<dim>::run()
       solve(parameters.spatial_discretization_parameters.n_initial_global_refinements);
 
       process_solution(cycle);
+
+      heat_equation.reset_for_new_run();
     }
     break;
   default:
@@ -379,6 +379,123 @@ enum class PreconditionerType
 
 };
 
+
+
+/*!
+ * @brief Enumeration for the different types of linear solvers.
+ */
+enum class SolverType
+{
+  /*!
+   * @brief The Krylov subspace method suited for the linear system, i.e.,
+   * the conjugate gradient method for symmetric positive definite
+   * matrices and the GMRES method otherwise.
+   */
+  Krylov,
+
+  /*!
+   * @brief Sparse direct solver. The factorization of the matrix is
+   * computed once and reused until the matrix changes.
+   *
+   * @attention This type is only meaningful for linear systems whose
+   * matrix is constant in time.
+   */
+  direct,
+
+  /*!
+   * @brief Deflated conjugate gradient method. Approximations to the
+   * eigenvectors of the smallest eigenvalues are harvested from
+   * previous solves and deflated from the subsequent ones.
+   *
+   * @attention This type is only meaningful for symmetric positive
+   * definite matrices which are constant in time.
+   */
+  deflated_CG,
+
+  /*!
+   * @brief Pipelined variant of the Krylov subspace method suited for
+   * the linear system, i.e., the pipelined conjugate gradient method for
+   * symmetric positive definite matrices and a pipelined GMRES method
+   * otherwise. The global reductions are non-blocking and overlapped
+   * with the application of the preconditioner and the matrix-vector
+   * product.
+   */
+  pipelined_Krylov
+};
+
+
+
+/*!
+ * @brief Enumeration for the error indicator used in the adaptive mesh
+ * refinement.
+ */
+enum class ErrorIndicatorType
+{
+  /*!
+   * @brief Indicator of Kelly type given by the jump of the normal
+   * derivative across the faces of each cell.
+   */
+  Kelly,
+
+  /*!
+   * @brief Indicator given by the norm of a recovered gradient scaled by
+   * \f$ h^{1+d/2} \f$. It does not require a face quadrature and is
+   * therefore cheaper than the indicator of Kelly type.
+   */
+  gradient_recovery
+};
+
+
+/*!
+ * @brief Enumeration for the file format of the graphical output.
+ */
+enum class GraphicalOutputFormat
+{
+  /*!
+   * @brief Each process writes a VTU file per output, which contains the
+   * geometry of its patches and the values of the fields. The files are
+   * indexed by a `.pvtu` record.
+   */
+  vtu,
+
+  /*!
+   * @brief All processes write collectively to a single HDF5 file per
+   * output which only contains the values of the fields. The geometry of
+   * the patches is written to a separate file once per change of the
+   * mesh. The outputs are indexed by a XDMF file.
+   */
+  hdf5
+};
+
+
+
+/*!
+ * @brief Enumeration for the file format of the time series of the
+ * benchmark requests.
+ */
+enum class BenchmarkDataFormat
+{
+  /*!
+   * @brief The time series is kept in memory and written as an org-mode
+   * table at the end of the simulation.
+   */
+  text,
+
+  /*!
+   * @brief The rows of the time series are appended to a CSV file with a
+   * header line containing the names of the columns.
+   */
+  csv,
+
+  /*!
+   * @brief The rows of the time series are appended to a binary file of
+   * double precision values. A header at the beginning of the file
+   * contains the names of the columns and the offset of the data such
+   * that the file can be memory mapped.
+   */
+  binary
+};
+
 } // namespace RunTimeParameters
 
 } // namespace RMHD
@@ -2,13 +2,19 @@
 #define INCLUDE_ROTATINGMHD_DFG_BENCHMARK_DATA_H_
 
 #include <rotatingMHD/finite_element_field.h>
+#include <rotatingMHD/integral_diagnostics.h>
+#include <rotatingMHD/time_series_writer.h>
 
 #include <deal.II/base/point.h>
 #include <deal.II/fe/mapping_q.h>
 #include <deal.II/fe/mapping_q1.h>
 #include <deal.II/base/table_handler.h>
 
+#include <boost/serialization/access.hpp>
+
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace RMHD
@@ -68,7 +74,37 @@ public:
    */
   void write_text(std::ostream  &file) const;
 
+  /*!
+   * @brief Streams the data of the subsequent calls of @ref update to the
+   * file @p file_name instead of storing it in @ref data_table.
+   *
+   * @details See @ref TimeSeriesWriter for the meaning of the arguments.
+   * The argument @p resume_step is to be set to the step number of the
+   * checkpoint if the simulation is restarted.
+   */
+  void stream_to_file(const std::string                           &file_name,
+                      const RunTimeParameters::BenchmarkDataFormat format,
+                      const unsigned int                           flush_frequency,
+                      const MPI_Comm                               mpi_communicator = MPI_COMM_WORLD,
+                      const unsigned int                           resume_step = numbers::invalid_unsigned_int);
+
+  /*!
+   * @brief Writes the buffered rows of the streamed data to the file.
+   *
+   * @details Does nothing if the data is not streamed to a file.
+   */
+  void flush() const;
+
 private:
+  friend class boost::serialization::access;
+
+  /*!
+   * @brief Serializes the accumulated data such that it is retained
+   * when restarting from a checkpoint.
+   */
+  template<typename Archive>
+  void serialize(Archive &ar, const unsigned int version);
+
   /*!
    * @brief The Reynolds number of the problem.
    *
@@ -163,6 +199,12 @@ private:
    */
   TableHandler  data_table;
 
+  /*!
+   * @brief The writer of the streamed data. It is only set if
+   * @ref stream_to_file was called.
+   */
+  std::unique_ptr<TimeSeriesWriter> time_series_writer;
+
   /*!
    * @brief This method computes the @ref pressure_difference.
    */
@@ -249,7 +291,37 @@ public:
    */
   void write_text(std::ostream  &file) const;
 
+  /*!
+   * @brief Streams the data of the subsequent calls of @ref update to the
+   * file @p file_name instead of storing it in @ref data.
+   *
+   * @details See @ref TimeSeriesWriter for the meaning of the arguments.
+   * The argument @p resume_step is to be set to the step number of the
+   * checkpoint if the simulation is restarted.
+   */
+  void stream_to_file(const std::string                           &file_name,
+                      const RunTimeParameters::BenchmarkDataFormat format,
+                      const unsigned int                           flush_frequency,
+                      const MPI_Comm                               mpi_communicator = MPI_COMM_WORLD,
+                      const unsigned int                           resume_step = numbers::invalid_unsigned_int);
+
+  /*!
+   * @brief Writes the buffered rows of the streamed data to the file.
+   *
+   * @details Does nothing if the data is not streamed to a file.
+   */
+  void flush() const;
+
 private:
+  friend class boost::serialization::access;
+
+  /*!
+   * @brief Serializes the accumulated data such that it is retained
+   * when restarting from a checkpoint.
+   */
+  template<typename Archive>
+  void serialize(Archive &ar, const unsigned int version);
+
   /*!
    * @brief A vector containing all the points at which data will be
    * sampled.
@@ -352,6 +424,12 @@ private:
    */
   TableHandler    data;
 
+  /*!
+   * @brief The writer of the streamed data. It is only set if
+   * @ref stream_to_file was called.
+   */
+  std::unique_ptr<TimeSeriesWriter>   time_series_writer;
+
   /*!
    * @brief The width of the cavity.
    * @details Given by  \f$ W = 1.0 \f$.
@@ -398,30 +476,27 @@ private:
                           const Entities::FE_ScalarField<dim>  &temperature);
 
   /*!
-   * @brief A method that computes the Nusselt number of the
-   * walls with Dirichlet boundary conditions on the temperature field.
-   * @details They are given by
+   * @brief A method that computes the Nusselt numbers of the walls with
+   * Dirichlet boundary conditions on the temperature field and the
+   * average velocity and vorticity metrics.
+   * @details The Nusselt numbers are given by
    * \f[
    * \mathit{Nu}_{1,2} = \dfrac{1}{H} \int_{\Gamma_{1,2}} \nabla \vartheta
    * \cdot \bs{n} \dint a
    * \f]
    * where the subindices 0 and 1 indicate the left and right walls
-   * respectively.
-   * */
-  void compute_wall_data(const Entities::FE_ScalarField<dim>  &temperature);
-
-  /*!
-   * @brief A method that computes the average velocity and vorticity
-   * metrics.
-   * @details They are given by
+   * respectively. The metrics are given by
    * \f[
    * \hat{u} = \sqrt{ \dfrac{1}{2HW} \int_\Omega \bs{u} \cdot \bs{u} \dint v}
    * \quad \textrm{and} \quad
    * \hat{\omega} = \sqrt{ \dfrac{1}{2HW} \int_\Omega
    * (\nabla \times \bs{u}) \cdot (\nabla \times \bs{u}) \dint v}
    * \f]
+   * All integrals are evaluated in a single loop over the cells through
+   * an @ref IntegralDiagnostics object.
    */
-  void compute_global_data(const Entities::FE_VectorField<dim>  &velocity);
+  void compute_integral_data(const Entities::FE_VectorField<dim>  &velocity,
+                             const Entities::FE_ScalarField<dim>  &temperature);
 };
 
 
@@ -466,6 +541,27 @@ public:
    */
   void write_text(std::ostream &file) const;
 
+  /*!
+   * @brief Streams the data of the subsequent calls of @ref update to the
+   * file @p file_name instead of storing it in @ref data.
+   *
+   * @details See @ref TimeSeriesWriter for the meaning of the arguments.
+   * The argument @p resume_step is to be set to the step number of the
+   * checkpoint if the simulation is restarted.
+   */
+  void stream_to_file(const std::string                           &file_name,
+                      const RunTimeParameters::BenchmarkDataFormat format,
+                      const unsigned int                           flush_frequency,
+                      const MPI_Comm                               mpi_communicator = MPI_COMM_WORLD,
+                      const unsigned int                           resume_step = numbers::invalid_unsigned_int);
+
+  /*!
+   * @brief Writes the buffered rows of the streamed data to the file.
+   *
+   * @details Does nothing if the data is not streamed to a file.
+   */
+  void flush() const;
+
 
   /*!
    * @brief Output of the benchmark data to the terminal.
@@ -475,6 +571,15 @@ public:
 
 
 private:
+  friend class boost::serialization::access;
+
+  /*!
+   * @brief Serializes the accumulated data such that it is retained
+   * when restarting from a checkpoint.
+   */
+  template<typename Archive>
+  void serialize(Archive &ar, const unsigned int version);
+
   /*!
    * @brief The number of the case to be performed.
    */
@@ -536,6 +641,12 @@ private:
    */
   TableHandler  data;
 
+  /*!
+   * @brief The writer of the streamed data. It is only set if
+   * @ref stream_to_file was called.
+   */
+  std::unique_ptr<TimeSeriesWriter> time_series_writer;
+
   /*!
    * @brief A method that computes the @ref drift_frequency, the
    * @ref mean_kinetic_energy_density and the @ref mean_magnetic_energy_density.
@@ -555,50 +666,18 @@ private:
    * \textrm{and} \qquad
    * \pd{ u_{\textrm{r}}}{\phi} > 0.
    * \f]
-   *
+   * Each process samples the radial velocity along the segments of the
+   * sampling circle passing through its locally owned and ghost cells and
+   * refines the roots where the radial velocity changes from a negative to
+   * a positive value by evaluating it in the respective cells. Among all
+   * roots, the one closest to the last sampling longitude is selected in
+   * a single reduction. If there is no last sampling longitude, the root
+   * with the smallest longitude is selected.
    */
   void find_sampling_point
   (const Entities::FE_VectorField<dim> &velocity,
    const Mapping<dim>                  &mapping);
 
-  /*!
-   * @brief A method that computes the value of the radial velocity
-   * at the given spherical coordinates
-   */
-  double compute_radial_velocity
-  (const double radius,
-   const double azimuthal_angle,
-   const double polar_angle,
-   const Entities::FE_VectorField<dim> &velocity,
-   const Mapping<dim>                  &mapping = MappingQ1<dim>()) const;
-
-  /*!
-   * @brief A method that computes a root of the radial velocity w.r.t.
-   * the longitude.
-   *
-   * @details The method is employs around the boost's
-   * bracket_and_solve_root method.
-   */
-  double compute_zero_of_radial_velocity
-  (const double       phi_guess,
-   const bool         local_slope,
-   const double       tol,
-   const unsigned int max_iter,
-   const Entities::FE_VectorField<dim> &velocity,
-   const Mapping<dim>                  &mapping = MappingQ1<dim>()) const;
-
-  /*!
-   * @brief A method that computes the value of the derivative of the
-   * radial velocity w.r.t. to the longitude at the given spherical
-   * coordinates
-   */
-  double compute_azimuthal_gradient_of_radial_velocity
-  (const double radius,
-   const double azimuthal_angle,
-   const double polar_angle,
-   const Entities::FE_VectorField<dim> &velocity,
-   const Mapping<dim>                  &mapping = MappingQ1<dim>()) const;
-
   /*!
    * @brief A method that computes the velocity vector and the temperature
    * at the @ref sample_point.
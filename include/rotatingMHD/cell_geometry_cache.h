@@ -0,0 +1,485 @@
+#ifndef INCLUDE_ROTATINGMHD_CELL_GEOMETRY_CACHE_H_
+#define INCLUDE_ROTATINGMHD_CELL_GEOMETRY_CACHE_H_
+
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_update_flags.h>
+#include <deal.II/fe/fe_values_extractors.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+/*!
+ * @class CellGeometryCache
+ *
+ * @brief Stores the geometric data of the locally owned cells of a
+ * DoFHandler for a given mapping and quadrature formula.
+ *
+ * @details The product of the Jacobian determinant and the quadrature
+ * weight and the inverse Jacobian of each quadrature point are computed
+ * once and stored in flat arrays ordered by cell and quadrature point.
+ * If the update flags contain `update_gradients` and the memory budget
+ * permits, the gradients of the shape functions in real space are
+ * stored as well. Otherwise, they are computed by @ref CachedFEValues
+ * from the gradients on the reference cell and the inverse Jacobians.
+ * The values of the shape functions do not depend on the cell and are
+ * stored once.
+ *
+ * The data remains valid as long as the triangulation and the degrees
+ * of freedom do not change. The cache is hence built for meshes which are
+ * fixed for many time steps and is discarded by
+ * @ref Entities::FE_FieldBase::setup_dofs.
+ *
+ * @attention Only primitive finite elements, e.g., `FE_Q` and `FESystem`s
+ * thereof, are supported, as the shape functions are assumed to be
+ * mapped covariantly.
+ */
+template <int dim>
+class CellGeometryCache
+{
+public:
+  /*!
+   * @brief Constructor computing the data of all locally owned cells of
+   * @p dof_handler.
+   *
+   * @details The shape gradients are only stored if @p update_flags
+   * contains `update_gradients` and the memory of the whole cache does
+   * not exceed @p memory_budget bytes.
+   */
+  CellGeometryCache(const Mapping<dim>      &mapping,
+                    const DoFHandler<dim>   &dof_handler,
+                    const Quadrature<dim>   &quadrature,
+                    const UpdateFlags        update_flags,
+                    const std::size_t        memory_budget);
+
+  /*!
+   * @brief Returns true if the cache was computed with the given mapping,
+   * quadrature formula and update flags.
+   */
+  bool matches(const Mapping<dim>     &mapping,
+               const Quadrature<dim>  &quadrature,
+               const UpdateFlags       update_flags) const;
+
+  /*!
+   * @brief Returns true if the gradients of the shape functions in real
+   * space are stored.
+   */
+  bool stores_shape_gradients() const;
+
+  /*!
+   * @brief Returns the memory consumption of the cache in bytes.
+   */
+  std::size_t memory_consumption() const;
+
+  /*!
+   * @brief Returns the finite element of the cached data.
+   */
+  const FiniteElement<dim>& get_fe() const;
+
+  /*!
+   * @brief Returns the quadrature formula of the cached data.
+   */
+  const Quadrature<dim>& get_quadrature() const;
+
+  /*!
+   * @brief Returns the number of quadrature points per cell.
+   */
+  unsigned int n_quadrature_points() const;
+
+  /*!
+   * @brief Returns the number of degrees of freedom per cell.
+   */
+  unsigned int dofs_per_cell() const;
+
+private:
+  template <int> friend class CachedFEValues;
+
+  /*!
+   * @brief The mapping with which the data was computed. It is only used
+   * to identify the cache.
+   */
+  const Mapping<dim>         *mapping;
+
+  /*!
+   * @brief The finite element of the DoFHandler.
+   */
+  const FiniteElement<dim>   *fe;
+
+  /*!
+   * @brief The quadrature formula.
+   */
+  const Quadrature<dim>       quadrature;
+
+  /*!
+   * @brief The update flags with which the cache was requested.
+   */
+  const UpdateFlags           update_flags;
+
+  const unsigned int          n_q_points;
+
+  const unsigned int          n_dofs_per_cell;
+
+  /*!
+   * @brief The vector component in which each shape function is
+   * nonzero.
+   */
+  std::vector<unsigned int>   shape_components;
+
+  /*!
+   * @brief The value of the nonzero component of each shape function at
+   * each quadrature point, indexed by `q * dofs_per_cell + i`.
+   */
+  std::vector<double>         shape_values;
+
+  /*!
+   * @brief The gradient of the nonzero component of each shape function
+   * on the reference cell, indexed as @ref shape_values.
+   */
+  std::vector<Tensor<1,dim>>  reference_shape_gradients;
+
+  /*!
+   * @brief The position of each active cell in the flat arrays, indexed
+   * by the active cell index. It is `numbers::invalid_unsigned_int` for
+   * the cells which are not locally owned.
+   */
+  std::vector<unsigned int>   cell_positions;
+
+  /*!
+   * @brief The product of the Jacobian determinant and the quadrature
+   * weight, indexed by `cell_position * n_q_points + q`.
+   */
+  std::vector<double>         JxW_values;
+
+  /*!
+   * @brief The inverse Jacobians, indexed as @ref JxW_values.
+   */
+  std::vector<Tensor<2,dim>>  inverse_jacobians;
+
+  /*!
+   * @brief The gradients of the nonzero component of each shape function
+   * in real space, indexed by
+   * `(cell_position * n_q_points + q) * dofs_per_cell + i`. It is empty if
+   * the gradients are not stored.
+   */
+  std::vector<Tensor<1,dim>>  shape_gradients;
+};
+
+
+
+/*!
+ * @class CachedFEValues
+ *
+ * @brief A lightweight replacement of `FEValues` which reads the data of a
+ * cell from a @ref CellGeometryCache.
+ *
+ * @details The methods follow the ones of `FEValues` for primitive finite
+ * elements, i.e., @ref shape_value and @ref shape_grad return the value
+ * and the gradient of the nonzero component of a shape function. The
+ * methods with a vector in their name return the value, the gradient,
+ * the divergence or the curl of a shape function of a vector valued
+ * finite element as the corresponding method of `FEValuesViews::Vector`
+ * for the first `dim` components does.
+ *
+ * Each thread requires its own instance, as the local degrees of
+ * freedom and, if the cache does not store them, the shape gradients of
+ * the current cell are stored internally.
+ */
+template <int dim>
+class CachedFEValues
+{
+public:
+  using curl_type = typename FEValuesViews::Vector<dim>::curl_type;
+
+  /*!
+   * @brief Constructor.
+   */
+  CachedFEValues(const CellGeometryCache<dim> &cache);
+
+  /*!
+   * @brief Copy constructor. The copy is not initialized on any cell.
+   */
+  CachedFEValues(const CachedFEValues<dim> &data);
+
+  /*!
+   * @brief Initializes the object for the cell @p cell, which has to be
+   * locally owned.
+   */
+  void reinit(const typename DoFHandler<dim>::active_cell_iterator &cell);
+
+  /*!
+   * @brief Returns the cache from which the data is read.
+   */
+  const CellGeometryCache<dim>& get_cache() const;
+
+  /*!
+   * @brief Returns the product of the Jacobian determinant and the
+   * quadrature weight at the quadrature point @p q.
+   */
+  double JxW(const unsigned int q) const;
+
+  /*!
+   * @brief Returns the vector component in which the shape function
+   * @p i is nonzero.
+   */
+  unsigned int shape_component(const unsigned int i) const;
+
+  /*!
+   * @brief Returns the value of the nonzero component of the shape
+   * function @p i at the quadrature point @p q.
+   */
+  double shape_value(const unsigned int i, const unsigned int q) const;
+
+  /*!
+   * @brief Returns the gradient of the nonzero component of the shape
+   * function @p i at the quadrature point @p q.
+   */
+  const Tensor<1,dim>& shape_grad(const unsigned int i,
+                                  const unsigned int q) const;
+
+  Tensor<1,dim> vector_shape_value(const unsigned int i,
+                                   const unsigned int q) const;
+
+  Tensor<2,dim> vector_shape_gradient(const unsigned int i,
+                                      const unsigned int q) const;
+
+  double vector_shape_divergence(const unsigned int i,
+                                 const unsigned int q) const;
+
+  curl_type vector_shape_curl(const unsigned int i,
+                              const unsigned int q) const;
+
+  /*!
+   * @brief Evaluates the scalar finite element function @p vector at the
+   * quadrature points.
+   */
+  template <typename VectorType>
+  void get_function_values(const VectorType    &vector,
+                           std::vector<double> &values);
+
+  /*!
+   * @brief Evaluates the gradient of the scalar finite element function
+   * @p vector at the quadrature points.
+   */
+  template <typename VectorType>
+  void get_function_gradients(const VectorType            &vector,
+                              std::vector<Tensor<1,dim>>  &gradients);
+
+  /*!
+   * @brief Evaluates the first `dim` components of the finite element
+   * function @p vector at the quadrature points.
+   */
+  template <typename VectorType>
+  void get_function_values(const VectorType            &vector,
+                           std::vector<Tensor<1,dim>>  &values);
+
+  template <typename VectorType>
+  void get_function_gradients(const VectorType            &vector,
+                              std::vector<Tensor<2,dim>>  &gradients);
+
+  template <typename VectorType>
+  void get_function_divergences(const VectorType    &vector,
+                                std::vector<double> &divergences);
+
+  template <typename VectorType>
+  void get_function_curls(const VectorType        &vector,
+                          std::vector<curl_type>  &curls);
+
+private:
+  /*!
+   * @brief The cache from which the data is read.
+   */
+  const CellGeometryCache<dim>   *cache;
+
+  /*!
+   * @brief The current cell.
+   */
+  typename DoFHandler<dim>::active_cell_iterator  cell;
+
+  /*!
+   * @brief Offset of the current cell in the arrays indexed by the
+   * quadrature point.
+   */
+  unsigned int                    q_offset;
+
+  /*!
+   * @brief Pointer to the shape gradients of the current cell. It either
+   * points into the cache or to @ref cell_shape_gradients.
+   */
+  const Tensor<1,dim>            *current_shape_gradients;
+
+  /*!
+   * @brief The shape gradients of the current cell if the cache does not
+   * store them.
+   */
+  std::vector<Tensor<1,dim>>      cell_shape_gradients;
+
+  /*!
+   * @brief The values of the local degrees of freedom.
+   */
+  Vector<double>                  local_dof_values;
+
+  /*!
+   * @brief Computes the curl from the gradient @p gradient.
+   */
+  static curl_type compute_curl(const Tensor<2,dim> &gradient);
+};
+
+
+
+// inline functions
+template <int dim>
+inline bool CellGeometryCache<dim>::stores_shape_gradients() const
+{
+  return (!shape_gradients.empty());
+}
+
+
+
+template <int dim>
+inline const FiniteElement<dim> &CellGeometryCache<dim>::get_fe() const
+{
+  return (*fe);
+}
+
+
+
+template <int dim>
+inline const Quadrature<dim> &CellGeometryCache<dim>::get_quadrature() const
+{
+  return (quadrature);
+}
+
+
+
+template <int dim>
+inline unsigned int CellGeometryCache<dim>::n_quadrature_points() const
+{
+  return (n_q_points);
+}
+
+
+
+template <int dim>
+inline unsigned int CellGeometryCache<dim>::dofs_per_cell() const
+{
+  return (n_dofs_per_cell);
+}
+
+
+
+template <int dim>
+inline const CellGeometryCache<dim> &CachedFEValues<dim>::get_cache() const
+{
+  return (*cache);
+}
+
+
+
+template <int dim>
+inline double CachedFEValues<dim>::JxW(const unsigned int q) const
+{
+  AssertIndexRange(q, cache->n_q_points);
+  return (cache->JxW_values[q_offset + q]);
+}
+
+
+
+template <int dim>
+inline unsigned int
+CachedFEValues<dim>::shape_component(const unsigned int i) const
+{
+  AssertIndexRange(i, cache->n_dofs_per_cell);
+  return (cache->shape_components[i]);
+}
+
+
+
+template <int dim>
+inline double CachedFEValues<dim>::shape_value
+(const unsigned int i,
+ const unsigned int q) const
+{
+  AssertIndexRange(i, cache->n_dofs_per_cell);
+  AssertIndexRange(q, cache->n_q_points);
+  return (cache->shape_values[q * cache->n_dofs_per_cell + i]);
+}
+
+
+
+template <int dim>
+inline const Tensor<1,dim> &CachedFEValues<dim>::shape_grad
+(const unsigned int i,
+ const unsigned int q) const
+{
+  AssertIndexRange(i, cache->n_dofs_per_cell);
+  AssertIndexRange(q, cache->n_q_points);
+  return (current_shape_gradients[q * cache->n_dofs_per_cell + i]);
+}
+
+
+
+template <int dim>
+inline Tensor<1,dim> CachedFEValues<dim>::vector_shape_value
+(const unsigned int i,
+ const unsigned int q) const
+{
+  Tensor<1,dim> value;
+
+  const unsigned int component = shape_component(i);
+  if (component < dim)
+    value[component] = shape_value(i, q);
+
+  return (value);
+}
+
+
+
+template <int dim>
+inline Tensor<2,dim> CachedFEValues<dim>::vector_shape_gradient
+(const unsigned int i,
+ const unsigned int q) const
+{
+  Tensor<2,dim> gradient;
+
+  const unsigned int component = shape_component(i);
+  if (component < dim)
+    gradient[component] = shape_grad(i, q);
+
+  return (gradient);
+}
+
+
+
+template <int dim>
+inline double CachedFEValues<dim>::vector_shape_divergence
+(const unsigned int i,
+ const unsigned int q) const
+{
+  const unsigned int component = shape_component(i);
+
+  return (component < dim ? shape_grad(i, q)[component] : 0.0);
+}
+
+
+
+template <int dim>
+inline typename CachedFEValues<dim>::curl_type
+CachedFEValues<dim>::vector_shape_curl
+(const unsigned int i,
+ const unsigned int q) const
+{
+  return (compute_curl(vector_shape_gradient(i, q)));
+}
+
+} // namespace RMHD
+
+#endif /* INCLUDE_ROTATINGMHD_CELL_GEOMETRY_CACHE_H_ */
@@ -7,10 +7,13 @@
 
 #include <rotatingMHD/finite_element_field.h>
 #include <rotatingMHD/global.h>
+#include <rotatingMHD/memory_report.h>
 #include <rotatingMHD/run_time_parameters.h>
 #include <rotatingMHD/time_discretization.h>
 #include <rotatingMHD/convection_diffusion/assembly_data.h>
 
+#include <boost/signals2/connection.hpp>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -122,6 +125,20 @@ public:
    */
   void set_source_term(Function<dim> &source_term);
 
+  /*!
+   *  @brief Prepares the solver for a new run on the same mesh, e.g.,
+   *  for the next cycle of a temporal convergence test.
+   *
+   *  @details The sparsity pattern and the constant matrices are kept.
+   *  The preconditioner, which depends on the time step size, is released
+   *  and the norm of the right hand side and the iteration count are
+   *  reset.
+   *
+   *  @attention The mesh, the degrees of freedom and the boundary
+   *  conditions of the temperature must not change.
+   */
+  void reset_for_new_run();
+
   /*!
    * @brief Computes the scalar field \f$ u \f$ at \f$ t = t_1 \f$ using a
    * first order time discretization scheme.
@@ -139,6 +156,27 @@ public:
    */
   double get_rhs_norm() const;
 
+  /*!
+   *  @brief Returns the number of iterations of the last solve.
+   */
+  unsigned int get_n_iterations() const;
+
+  /*!
+   * @brief Returns the memory in bytes which the matrices, the
+   * right-hand side vector and the preconditioner occupy on the current
+   * process.
+   * @details The sparsity pattern is stored by the matrices and is
+   * included in their entries. The entities are reported by
+   * Entities::FE_FieldBase::get_memory_report.
+   */
+  MemoryReport get_memory_report() const;
+
+  /*!
+   * @brief Returns the memory in bytes which the solver occupies on the
+   * current process.
+   */
+  std::size_t memory_consumption() const;
+
 private:
   /*!
    * @brief A reference to the parameters which control the solution process.
@@ -146,7 +184,7 @@ private:
   const RunTimeParameters::HeatEquationParameters &parameters;
 
   /*!
-   * @brief The MPI communicator which is equal to `MPI_COMM_WORLD`.
+   * @brief The MPI communicator of the triangulation of the entities.
    */
   const MPI_Comm                                 mpi_communicator;
 
@@ -249,6 +287,11 @@ private:
    */
   double                                        rhs_norm;
 
+  /*!
+   * @brief The number of iterations of the last solve.
+   */
+  unsigned int                                  n_iterations;
+
   /*!
    * @brief The preconditioner.
    */
@@ -259,6 +302,18 @@ private:
    */
   bool                                          flag_matrices_were_updated;
 
+  /*!
+   * @brief A flag indicating if the triangulation was modified since the
+   * last call of @ref setup.
+   */
+  bool                                          flag_mesh_was_modified;
+
+  /*!
+   * @brief The connection to the signal of the triangulation which sets
+   * @ref flag_mesh_was_modified. It is released together with the solver.
+   */
+  boost::signals2::scoped_connection            mesh_modification_connection;
+
   /*!
    * @brief Setup of the sparsity spatterns of the matrices.
    */
@@ -357,6 +412,12 @@ inline double ConvectionDiffusionSolver<dim>::get_rhs_norm() const
   return (rhs_norm);
 }
 
+template <int dim>
+inline unsigned int ConvectionDiffusionSolver<dim>::get_n_iterations() const
+{
+  return (n_iterations);
+}
+
 } // namespace RMHD
 
 #endif /* INCLUDE_ROTATINGMHD_HEAT_EQUATION_H_ */
@@ -3,6 +3,7 @@
 
 #include <deal.II/base/convergence_table.h>
 #include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/parameter_handler.h>
 
 #include <deal.II/numerics/vector_tools.h>
@@ -10,17 +11,60 @@
 
 #include <fstream>
 #include <string>
+#include <vector>
 
 namespace RMHD
 {
 
 using namespace dealii;
 
+namespace ConvergenceTest
+{
+  class CycleDistribution;
+}
+
 template <int dim>
 struct ConvergenceAnalysisData
 {
+  /*!
+   * @brief The discretization data and the errors of a single cycle.
+   */
+  struct Row
+  {
+    unsigned int              level;
+
+    double                    time_step;
+
+    types::global_dof_index   n_cells;
+
+    types::global_dof_index   n_dofs;
+
+    double                    h_max;
+
+    double                    L2_error;
+
+    double                    H1_error;
+
+    double                    Linfty_error;
+
+    template <class Archive>
+    void serialize(Archive &ar, const unsigned int version);
+  };
+
   ConvergenceTable                convergence_table;
 
+  /*!
+   * @brief The rows which were added to @ref convergence_table by
+   * @ref update_table.
+   */
+  std::vector<Row>                rows;
+
+  /*!
+   * @brief Flag indicating whether the convergence rates are evaluated
+   * with respect to the cell diameter or to the size of the time step.
+   */
+  bool                            flag_spatial_convergence;
+
   const std::shared_ptr<const Entities::FE_FieldBase<dim>> entity;
 
   const Function<dim>            &exact_solution;
@@ -32,6 +76,22 @@ struct ConvergenceAnalysisData
                     const double        time_step,
                     const bool          flag_spatial_convergence);
 
+  /*!
+   * @brief Gathers the rows of the cycles which were run concurrently by
+   * the groups of processes of @p cycle_distribution.
+   *
+   * @details The rows are sorted by the refinement level in a spatial
+   * convergence test and by the size of the time step in descending
+   * order in a temporal convergence test. The convergence rates are
+   * evaluated afterwards. The complete table is only available on the
+   * first process of the world communicator. Nothing is done if the
+   * cycles were not run concurrently.
+   *
+   * @attention This method is a collective operation on the world
+   * communicator of @p cycle_distribution.
+   */
+  void gather(const ConvergenceTest::CycleDistribution &cycle_distribution);
+
   /*!
    * @brief Output of the convergence table to a stream object,
    */
@@ -41,6 +101,21 @@ struct ConvergenceAnalysisData
 
   void write_text(std::string filename) const;
 
+private:
+  /*!
+   * @brief Declares and formats the columns of @ref convergence_table.
+   */
+  void declare_columns();
+
+  /*!
+   * @brief Adds the values of @p row to @ref convergence_table.
+   */
+  void add_row(const Row &row);
+
+  /*!
+   * @brief Evaluates the convergence rates of the errors.
+   */
+  void evaluate_convergence_rates();
 };
 
 template<typename Stream, int dim>
@@ -150,6 +225,15 @@ struct ConvergenceTestParameters
    * @brief Number of temporal convergence cycles.
    */
   unsigned int        n_temporal_cycles;
+
+  /*!
+   * @brief Flag indicating whether the cycles are run concurrently.
+   *
+   * @details The processes are split into groups, each of which runs a
+   * subset of the cycles. The size of the groups is proportional to the
+   * cost of their cycles. See @ref CycleDistribution.
+   */
+  bool                concurrent_cycles;
 };
 
 /*!
@@ -161,6 +245,150 @@ template<typename Stream>
 Stream& operator<<(Stream &stream, const ConvergenceTestParameters &prm);
 
 
+/*!
+ * @class CycleDistribution
+ *
+ * @brief Distributes the cycles of a convergence test over groups of
+ * processes, which run their cycles concurrently.
+ *
+ * @details The cost of a cycle is estimated by its number of degrees of
+ * freedom in a spatial convergence test, i.e., \f$ 2^{d\,i} \f$ for the
+ * cycle \f$ i \f$, and by its number of time steps in a temporal
+ * convergence test, i.e., \f$ s^{-i} \f$, where \f$ s \f$ is the
+ * reduction factor of the time step. If there are at least as many
+ * processes as cycles, each cycle is run by its own group, whose size is
+ * proportional to the cost of the cycle. Otherwise, each process forms a
+ * group and the cycles are assigned to the group with the smallest load
+ * in the order of decreasing cost.
+ *
+ * If the cycles are not run concurrently, there is a single group which
+ * runs all cycles on the world communicator.
+ *
+ * @note The groups consist of consecutive processes of the world
+ * communicator.
+ */
+class CycleDistribution
+{
+public:
+  /*!
+   * @brief Constructor which splits the communicator @p world_communicator
+   * according to the convergence test parameters @p prm of a problem of
+   * the dimension @p dim.
+   *
+   * @attention This constructor is a collective operation.
+   */
+  CycleDistribution(const ConvergenceTestParameters &prm,
+                    const unsigned int               dim,
+                    const MPI_Comm                  &world_communicator = MPI_COMM_WORLD);
+
+  CycleDistribution(const CycleDistribution &) = delete;
+
+  CycleDistribution &operator=(const CycleDistribution &) = delete;
+
+  /*!
+   * @brief Destructor which frees the communicator of the group.
+   */
+  ~CycleDistribution();
+
+  /*!
+   * @brief Returns the communicator of the group of the current process.
+   */
+  const MPI_Comm &get_communicator() const;
+
+  /*!
+   * @brief Returns the communicator which was split into the groups.
+   */
+  const MPI_Comm &get_world_communicator() const;
+
+  /*!
+   * @brief Returns the cycles run by the group of the current process in
+   * ascending order.
+   */
+  const std::vector<unsigned int> &get_cycles() const;
+
+  /*!
+   * @brief Returns the number of groups.
+   */
+  unsigned int n_groups() const;
+
+  /*!
+   * @brief Returns whether the cycles are run concurrently by several
+   * groups.
+   */
+  bool is_concurrent() const;
+
+  /*!
+   * @brief Returns whether the current process is the first process of
+   * the world communicator, which outputs the gathered results.
+   */
+  bool is_world_root() const;
+
+private:
+  /*!
+   * @brief The communicator which was split into the groups.
+   */
+  const MPI_Comm            world_communicator;
+
+  /*!
+   * @brief The communicator of the group of the current process.
+   */
+  MPI_Comm                  communicator;
+
+  /*!
+   * @brief The cycles run by the group of the current process.
+   */
+  std::vector<unsigned int> cycles;
+
+  /*!
+   * @brief The number of groups.
+   */
+  unsigned int              n_cycle_groups;
+};
+
+
+
+inline const MPI_Comm &CycleDistribution::get_communicator() const
+{
+  return (communicator);
+}
+
+
+
+inline const MPI_Comm &CycleDistribution::get_world_communicator() const
+{
+  return (world_communicator);
+}
+
+
+
+inline const std::vector<unsigned int> &CycleDistribution::get_cycles() const
+{
+  return (cycles);
+}
+
+
+
+inline unsigned int CycleDistribution::n_groups() const
+{
+  return (n_cycle_groups);
+}
+
+
+
+inline bool CycleDistribution::is_concurrent() const
+{
+  return (n_cycle_groups > 1);
+}
+
+
+
+inline bool CycleDistribution::is_world_root() const
+{
+  return (Utilities::MPI::this_mpi_process(world_communicator) == 0);
+}
+
+
+
 /*!
  * @class ConvergenceTestData
  *
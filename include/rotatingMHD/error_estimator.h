@@ -0,0 +1,108 @@
+#ifndef INCLUDE_ROTATINGMHD_ERROR_ESTIMATOR_H_
+#define INCLUDE_ROTATINGMHD_ERROR_ESTIMATOR_H_
+
+#include <rotatingMHD/basic_parameters.h>
+#include <rotatingMHD/finite_element_field.h>
+
+#include <deal.II/fe/mapping.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+/*!
+ * @class MultiFieldErrorEstimator
+ *
+ * @brief Computes a combined error indicator of several finite element
+ * fields defined on the same triangulation.
+ *
+ * @details The indicator of Kelly type of each field is given by
+ * \f[
+ *   \eta_{K,i}^2 = \frac{h_K}{24} \sum_{F \in \partial K} \int_F
+ *   \left| \left[ \frac{\partial u_i}{\partial n} \right] \right|^2 \dint{a}
+ * \f]
+ * where the sum runs over all interior faces of the cell. It coincides
+ * with the one of the KellyErrorEstimator without Neumann boundary
+ * conditions. However, the jumps of all fields are computed in a single
+ * threaded loop over the faces and each face is only visited once. The
+ * alternative indicator based on a recovered gradient is given by
+ * \f[
+ *   \eta_{K,i} = h_K^{1+d/2} \left| \nabla_h u_i \right|_K
+ * \f]
+ * where \f$ \nabla_h u_i \f$ is obtained through the
+ * DerivativeApproximation namespace.
+ *
+ * The combined indicator is the weighted mean
+ * \f[
+ *   \eta_K = \frac{\sum_i w_i \eta_{K,i} / \|\eta_i\|}{\sum_i w_i}\,,
+ * \f]
+ * where the division by the global \f$ \ell_2 \f$ norm of the indicator
+ * of each field is optional.
+ */
+template <int dim>
+class MultiFieldErrorEstimator
+{
+public:
+  /*!
+   * @brief Constructor.
+   */
+  MultiFieldErrorEstimator(const Mapping<dim> &mapping);
+
+  /*!
+   * @brief Adds the field @p field with the weight @p weight.
+   */
+  void add_field(const Entities::FE_FieldBase<dim> &field,
+                 const double                       weight = 1.0);
+
+  /*!
+   * @brief Removes all fields.
+   */
+  void clear();
+
+  /*!
+   * @brief Computes the combined indicator of the locally owned cells.
+   *
+   * @details The vector @p estimated_error_per_cell is indexed by the
+   * active cell index. The entries of cells which are not locally owned
+   * are set to zero.
+   */
+  void estimate(Vector<float>                             &estimated_error_per_cell,
+                const RunTimeParameters::ErrorIndicatorType type,
+                const bool                                 normalize) const;
+
+private:
+  /*!
+   * @brief The mapping used for the face integrals and the gradient
+   * recovery.
+   */
+  const Mapping<dim>                              &mapping;
+
+  /*!
+   * @brief Pointers to the fields.
+   */
+  std::vector<const Entities::FE_FieldBase<dim> *> fields;
+
+  /*!
+   * @brief The weight of each field.
+   */
+  std::vector<double>                             weights;
+
+  /*!
+   * @brief Computes the indicator of Kelly type of each field.
+   */
+  void compute_jump_indicators(std::vector<Vector<float>> &indicators) const;
+
+  /*!
+   * @brief Computes the indicator based on a recovered gradient of each
+   * field.
+   */
+  void compute_gradient_indicators(std::vector<Vector<float>> &indicators) const;
+};
+
+} // namespace RMHD
+
+#endif /* INCLUDE_ROTATINGMHD_ERROR_ESTIMATOR_H_ */
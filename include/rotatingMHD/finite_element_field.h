@@ -3,6 +3,8 @@
 
 #include <rotatingMHD/global.h>
 #include <rotatingMHD/boundary_conditions.h>
+#include <rotatingMHD/cell_geometry_cache.h>
+#include <rotatingMHD/memory_report.h>
 
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/quadrature_lib.h>
@@ -225,6 +227,48 @@ public:
    */
   bool is_child_entity() const;
 
+  /*!
+   * @brief Returns the @ref CellGeometryCache of the locally owned cells
+   * for the mapping @p mapping, the quadrature formula @p quadrature and
+   * the update flags @p update_flags.
+   *
+   * @details The cache is computed on the first request and reused until
+   * @ref setup_dofs or @ref clear is called.
+   *
+   * @attention This method is not thread safe. It has to be called
+   * before the loop over the cells and not inside of it.
+   */
+  const CellGeometryCache<dim>& get_cell_geometry_cache
+  (const Mapping<dim>     &mapping,
+   const Quadrature<dim>  &quadrature,
+   const UpdateFlags       update_flags) const;
+
+  /*!
+   * @brief Sets the memory in bytes which the caches of the entity may
+   * occupy.
+   *
+   * @details If a new cache would exceed the budget, it only stores the
+   * geometry of the cells but not the shape gradients. The budget does not
+   * affect caches which were already computed.
+   */
+  void set_cell_geometry_cache_memory_budget(const std::size_t memory_budget);
+
+  /*!
+   * @brief Returns the memory in bytes which the entity occupies on the
+   * current process, broken down into the degrees of freedom, the
+   * constraints, the solution vectors and the caches.
+   *
+   * @details The DoFHandler and the finite element of a child entity are
+   * shared with its parent and hence only reported by the latter.
+   */
+  MemoryReport get_memory_report() const;
+
+  /*!
+   * @brief Returns the memory in bytes which the entity occupies on the
+   * current process.
+   */
+  std::size_t memory_consumption() const;
+
 protected:
   /*!
    * @brief A flag indicating whether the entity is a child entity. This menas
@@ -289,6 +333,18 @@ protected:
    */
   IndexSet                            locally_relevant_dofs;
 
+  /*!
+   * @brief The memory in bytes which the @ref cell_geometry_caches may
+   * occupy.
+   */
+  std::size_t                         cell_geometry_cache_memory_budget;
+
+  /*!
+   * @brief The caches computed by @ref get_cell_geometry_cache.
+   */
+  mutable std::vector<std::unique_ptr<CellGeometryCache<dim>>>
+  cell_geometry_caches;
+
 private:
   /*!
    * @brief Method applying periodic boundary conditions to the @ref constraints.
@@ -385,6 +441,13 @@ inline bool FE_FieldBase<dim, VectorType>::is_child_entity() const
   return (flag_child_entity);
 }
 
+template <int dim, typename VectorType>
+inline void FE_FieldBase<dim, VectorType>::set_cell_geometry_cache_memory_budget
+(const std::size_t memory_budget)
+{
+  cell_geometry_cache_memory_budget = memory_budget;
+}
+
 template <int dim, typename VectorType>
 inline types::global_dof_index
 FE_FieldBase<dim, VectorType>::n_dofs() const
@@ -28,11 +28,13 @@ namespace LinearAlgebra
   !(defined(DEAL_II_WITH_TRILINOS) && defined(FORCE_USE_OF_TRILINOS))
   using namespace dealii::LinearAlgebraPETSc;
   using PreconditionBase = dealii::PETScWrappers::PreconditionerBase;
+  using SolverDirect = dealii::PETScWrappers::SparseDirectMUMPS;
   #define USE_PETSC_LA
 #elif defined(DEAL_II_WITH_TRILINOS)
   using namespace dealii::LinearAlgebraTrilinos;
 
   using PreconditionBase = dealii::TrilinosWrappers::PreconditionBase;
+  using SolverDirect = dealii::TrilinosWrappers::SolverDirect;
 #else
   #error DEAL_II_WITH_PETSC or DEAL_II_WITH_TRILINOS required
 #endif
@@ -0,0 +1,479 @@
+#ifndef INCLUDE_ROTATINGMHD_GRAPHICAL_OUTPUT_H_
+#define INCLUDE_ROTATINGMHD_GRAPHICAL_OUTPUT_H_
+
+#include <rotatingMHD/finite_element_field.h>
+#include <rotatingMHD/run_time_parameters.h>
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/fe/mapping.h>
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/data_postprocessor.h>
+
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/signals2/connection.hpp>
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+/*!
+ * @class GraphicalOutput
+ *
+ * @brief Writes the graphical output of a set of finite element fields
+ * defined on the same triangulation.
+ *
+ * @details The fields and, optionally, the postprocessors are registered
+ * once through @ref add_field. Each call of @ref write then builds the
+ * patches and writes them in the format specified by
+ * @ref RunTimeParameters::OutputControlParameters::graphical_output_format.
+ *
+ * - In the VTU format each process writes its patches, including their
+ * geometry, to a file and a `.pvtu` record is written for each output.
+ * - In the HDF5 format all processes write collectively to a single file
+ * per output, which only contains the values of the fields. The vertices
+ * and the connectivity of the patches are written to a separate file
+ * which is only written again if the triangulation changed. The file
+ * `solution.xdmf` indexes all outputs and can be opened by ParaView or
+ * VisIt.
+ *
+ * If @ref RunTimeParameters::OutputControlParameters::graphical_output_queue_depth
+ * is larger than zero, @ref write only copies the solution vectors. The
+ * patches are built and, in the VTU format, written by a background
+ * thread while the time loop continues. The collective write of the HDF5
+ * format is done by the main thread once the output leaves the queue.
+ * At most the given number of outputs are pending; further calls of
+ * @ref write wait for the oldest one. The queue is drained before the
+ * triangulation changes and by @ref finalize.
+ *
+ * The geometry and the connectivity of the patches only depend on the
+ * triangulation. Hence, they are computed once per change of the mesh,
+ * together with the values of the shape functions at the subdivision
+ * points and, if a postprocessor requires them, the mapped points and
+ * the inverse Jacobians of the mapping. The subsequent outputs copy the
+ * cached patches and only interpolate the fields onto them, i.e., the
+ * mapping is not evaluated again. This is only possible for primitive
+ * finite elements and postprocessors requiring values, gradients and
+ * evaluation points. Otherwise, the patches are built from scratch for
+ * each output.
+ */
+template <int dim>
+class GraphicalOutput
+{
+public:
+  /*!
+   * @brief Constructor.
+   */
+  GraphicalOutput
+  (const RunTimeParameters::OutputControlParameters &prm,
+   parallel::distributed::Triangulation<dim>        &triangulation,
+   const std::shared_ptr<Mapping<dim>>              &mapping);
+
+  /*!
+   * @brief Adds the solution of @p field to the output.
+   *
+   * @details Fields with more than one component are interpreted as
+   * vectors. If no name is passed, the name of the field is used.
+   */
+  void add_field(const Entities::FE_FieldBase<dim> &field,
+                 const std::string                 &name = "");
+
+  /*!
+   * @brief Adds the quantities computed by @p postprocessor from the
+   * solution of @p field to the output.
+   */
+  void add_field(const Entities::FE_FieldBase<dim>               &field,
+                 const std::shared_ptr<DataPostprocessor<dim>>   &postprocessor);
+
+  /*!
+   * @brief Sets the number of subdivisions of each cell and the cells
+   * whose patches are curved according to the mapping.
+   */
+  void set_patch_parameters
+  (const unsigned int                             n_subdivisions,
+   const typename DataOut<dim>::CurvedCellRegion  curved_cell_region =
+     DataOut<dim>::no_curved_cells);
+
+  /*!
+   * @brief Writes the current solution of the fields at the time
+   * @p time.
+   */
+  void write(const double time);
+
+  /*!
+   * @brief Completes all pending outputs.
+   *
+   * @details It has to be called by all processes at the end of the time
+   * loop.
+   */
+  void finalize();
+
+  /*!
+   * @brief Completes all pending outputs and removes all fields.
+   */
+  void clear();
+
+  /*!
+   * @brief Returns the number of outputs written so far.
+   */
+  unsigned int get_n_outputs() const;
+
+  /*!
+   * @brief Returns the patches of the current solution of the fields
+   * without writing them.
+   *
+   * @details If @p use_cache is true and the fields can be interpolated
+   * onto the cached patches, the patches are obtained in the same way as
+   * by @ref write after the first output on the current mesh. Otherwise,
+   * they are built from scratch by DataOut::build_patches.
+   */
+  std::vector<DataOutBase::Patch<dim, dim>> get_patches(const bool use_cache);
+
+private:
+  /*!
+   * @brief A field registered for the output.
+   */
+  struct OutputField
+  {
+    const Entities::FE_FieldBase<dim>      *field;
+
+    std::string                             name;
+
+    std::shared_ptr<DataPostprocessor<dim>> postprocessor;
+  };
+
+  using NonscalarDataRanges =
+  std::vector<std::tuple<unsigned int,
+                         unsigned int,
+                         std::string,
+                         DataComponentInterpretation::DataComponentInterpretation>>;
+
+  /*!
+   * @brief A DataOut object which exposes its patches such that they can
+   * be cached.
+   */
+  class PatchBuilder : public DataOut<dim>
+  {
+  public:
+    using DataOut<dim>::get_patches;
+
+    using DataOut<dim>::get_dataset_names;
+
+    using DataOut<dim>::get_nonscalar_data_ranges;
+  };
+
+  /*!
+   * @brief A collection of patches which is written through the
+   * interface of DataOutInterface.
+   */
+  class PatchCollection : public DataOutInterface<dim>
+  {
+  public:
+    std::vector<DataOutBase::Patch<dim, dim>> patches;
+
+    std::vector<std::string>                  dataset_names;
+
+    NonscalarDataRanges                       nonscalar_data_ranges;
+
+  protected:
+    virtual const std::vector<DataOutBase::Patch<dim, dim>> &
+    get_patches() const override;
+
+    virtual std::vector<std::string> get_dataset_names() const override;
+
+    virtual NonscalarDataRanges get_nonscalar_data_ranges() const override;
+  };
+
+  /*!
+   * @brief The values of the shape functions of a field at the
+   * subdivision points of the reference cell.
+   */
+  struct ShapeData
+  {
+    /*!
+     * @brief The first row of the data of the patches which is computed
+     * from the field.
+     */
+    unsigned int              first_data_row;
+
+    /*!
+     * @brief The vector component of each shape function.
+     */
+    std::vector<unsigned int> shape_components;
+
+    /*!
+     * @brief The values of the shape functions, indexed by the shape
+     * function and the point.
+     */
+    Table<2, double>          shape_values;
+
+    /*!
+     * @brief The gradients of the shape functions on the reference cell.
+     * They are only computed if the postprocessor of the field requires
+     * gradients.
+     */
+    Table<2, Tensor<1, dim>>  shape_gradients;
+  };
+
+  /*!
+   * @brief The patches of the last build from scratch and the data
+   * required to interpolate the fields onto them.
+   */
+  struct PatchCache
+  {
+    /*!
+     * @brief Flag indicating that the cache corresponds to the current
+     * triangulation, fields and patch parameters.
+     */
+    bool                                                        valid;
+
+    PatchCollection                                             patch_collection;
+
+    /*!
+     * @brief The locally owned active cells in the order of the patches.
+     */
+    std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+
+    /*!
+     * @brief The number of subdivision points per cell.
+     */
+    unsigned int                                                n_points;
+
+    std::vector<ShapeData>                                      shape_data;
+
+    /*!
+     * @brief The mapped subdivision points of each cell.
+     */
+    std::vector<Point<dim>>                                     evaluation_points;
+
+    /*!
+     * @brief The transpose of the inverse Jacobian of the mapping at the
+     * subdivision points of each cell, which maps the gradients on the
+     * reference cell to those on the real cell.
+     */
+    std::vector<Tensor<2, dim>>                                 covariant_transformations;
+  };
+
+  /*!
+   * @brief An output whose patches are built, or which is written, by a
+   * background thread.
+   */
+  struct PendingOutput
+  {
+    /*!
+     * @brief Copies of the solution vectors of the fields. They are
+     * referenced by @ref data.
+     */
+    std::vector<std::unique_ptr<LinearAlgebra::MPI::Vector>>  snapshots;
+
+    /*!
+     * @brief The patches to be written. Either a PatchBuilder or a
+     * PatchCollection.
+     */
+    std::unique_ptr<DataOutInterface<dim>>                    data;
+
+    unsigned int                                              index;
+
+    double                                                    time;
+
+    std::future<void>                                         task;
+  };
+
+  /*!
+   * @brief The parameters controlling the output.
+   */
+  const RunTimeParameters::OutputControlParameters &prm;
+
+  /*!
+   * @brief The MPI communicator of the triangulation.
+   */
+  const MPI_Comm                                    mpi_communicator;
+
+  /*!
+   * @brief The number of processes and the rank of this process.
+   */
+  const unsigned int                                n_mpi_processes;
+
+  const unsigned int                                this_mpi_process;
+
+  /*!
+   * @brief The triangulation on which the fields are defined.
+   */
+  const Triangulation<dim>                         &triangulation;
+
+  /*!
+   * @brief The mapping used to build the curved patches.
+   */
+  const std::shared_ptr<Mapping<dim>>               mapping;
+
+  /*!
+   * @brief The registered fields.
+   */
+  std::vector<OutputField>                          fields;
+
+  /*!
+   * @brief The number of subdivisions of each cell.
+   */
+  unsigned int                                      n_subdivisions;
+
+  /*!
+   * @brief The cells whose patches are curved.
+   */
+  typename DataOut<dim>::CurvedCellRegion           curved_cell_region;
+
+  /*!
+   * @brief The number of outputs written so far. It is used as the
+   * counter in the file names.
+   */
+  unsigned int                                      n_outputs;
+
+  /*!
+   * @brief The number of mesh files written so far.
+   */
+  unsigned int                                      n_meshes;
+
+  /*!
+   * @brief Flag indicating that the triangulation changed since the last
+   * mesh file was written.
+   */
+  bool                                              flag_mesh_changed;
+
+  /*!
+   * @brief The connection to the signal of the triangulation which is
+   * triggered by any change of the mesh.
+   */
+  boost::signals2::scoped_connection                mesh_change_connection;
+
+  /*!
+   * @brief The connections to the signals of the triangulation which are
+   * triggered before the mesh is modified. The pending outputs are
+   * completed beforehand as they access the triangulation.
+   */
+  boost::signals2::scoped_connection                pre_refinement_connection;
+
+  boost::signals2::scoped_connection                clear_connection;
+
+  /*!
+   * @brief The outputs whose patches are built or written by a
+   * background thread, from the oldest to the newest.
+   */
+  std::deque<PendingOutput>                         pending_outputs;
+
+  /*!
+   * @brief The cached patches.
+   */
+  PatchCache                                        patch_cache;
+
+  /*!
+   * @brief The entries of the XDMF file, one per output.
+   */
+  std::vector<XDMFEntry>                            xdmf_entries;
+
+  /*!
+   * @brief Adds the data vectors to @p data_out. The vectors of
+   * @p snapshots replace the solution vectors of the fields if they are
+   * not empty.
+   */
+  void add_data_vectors
+  (DataOut<dim>                                                   &data_out,
+   const std::vector<std::unique_ptr<LinearAlgebra::MPI::Vector>> &snapshots) const;
+
+  /*!
+   * @brief Builds the patches of @p data_out.
+   */
+  void build_patches(DataOut<dim> &data_out) const;
+
+  /*!
+   * @brief Returns true if the fields can be interpolated onto the cached
+   * patches.
+   */
+  bool patch_cache_is_applicable() const;
+
+  /*!
+   * @brief Builds the patches of the current solution vectors from
+   * scratch and stores them together with the data required to
+   * interpolate the fields onto them.
+   */
+  void update_patch_cache();
+
+  /*!
+   * @brief Interpolates the vectors @p vectors onto the cached patches
+   * and stores the values in @p patches, which are a copy of the
+   * cached ones.
+   */
+  void interpolate_onto_patches
+  (const std::vector<const LinearAlgebra::MPI::Vector *> &vectors,
+   std::vector<DataOutBase::Patch<dim, dim>>             &patches) const;
+
+  /*!
+   * @brief Writes the patches of @p data_out in the VTU format with a
+   * collective write of the `.pvtu` record.
+   */
+  void write_vtu(const DataOutInterface<dim> &data_out,
+                 const unsigned int           index) const;
+
+  /*!
+   * @brief Writes the patches of @p data_out in the VTU format without
+   * any communication, i.e., it may be called by a background thread.
+   * The `.pvtu` record is written by the first process.
+   */
+  void write_vtu_locally(const DataOutInterface<dim> &data_out,
+                         const unsigned int           index) const;
+
+  /*!
+   * @brief Writes the patches of @p data_out in the HDF5 format and
+   * updates the XDMF file.
+   */
+  void write_hdf5(const DataOutInterface<dim> &data_out,
+                  const double                 time,
+                  const unsigned int           index);
+
+  /*!
+   * @brief Waits for the oldest pending output, completes it and removes
+   * it from the queue.
+   */
+  void complete_pending_output();
+
+  friend class boost::serialization::access;
+
+  /*!
+   * @brief Serializes the counters and the XDMF entries such that the
+   * output continues seamlessly after a restart.
+   */
+  template <class Archive>
+  void serialize(Archive &ar, const unsigned int version);
+};
+
+
+
+template <int dim>
+inline unsigned int GraphicalOutput<dim>::get_n_outputs() const
+{
+  return (n_outputs);
+}
+
+
+
+template <int dim>
+template <class Archive>
+void GraphicalOutput<dim>::serialize(Archive &ar, const unsigned int /* version */)
+{
+  ar & n_outputs;
+  ar & n_meshes;
+  ar & xdmf_entries;
+}
+
+} // namespace RMHD
+
+#endif /* INCLUDE_ROTATINGMHD_GRAPHICAL_OUTPUT_H_ */
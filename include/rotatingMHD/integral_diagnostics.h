@@ -0,0 +1,205 @@
+#ifndef INCLUDE_ROTATINGMHD_INTEGRAL_DIAGNOSTICS_H_
+#define INCLUDE_ROTATINGMHD_INTEGRAL_DIAGNOSTICS_H_
+
+#include <rotatingMHD/finite_element_field.h>
+
+#include <deal.II/base/tensor.h>
+#include <deal.II/fe/fe_update_flags.h>
+#include <deal.II/fe/mapping.h>
+#include <deal.II/lac/vector.h>
+
+#include <functional>
+#include <set>
+#include <vector>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+/*!
+ * @class IntegralDiagnostics
+ *
+ * @brief Evaluates a set of volume and boundary integrals of several
+ * finite element fields defined on the same triangulation.
+ *
+ * @details The fields are registered through @ref add_field together
+ * with the quantities which the integrals require, i.e., their values
+ * and/or their gradients. Each integral is registered as a kernel which
+ * adds the contribution of a cell or of a boundary face to one or more
+ * integrals. All integrals are evaluated through @ref evaluate in a
+ * single threaded loop over the locally owned cells. On each cell and on
+ * each boundary face the fields are evaluated once at the quadrature
+ * points and the evaluated data is shared by all kernels. Finally, the
+ * integrals of all processes are summed up in a single reduction.
+ *
+ * The quadrature formula is a Gauss formula with \f$ p + 1 \f$ points in
+ * each direction, where \f$ p \f$ is the largest polynomial degree of the
+ * registered fields.
+ */
+template <int dim>
+class IntegralDiagnostics
+{
+public:
+  /*!
+   * @brief The fields evaluated at the quadrature points of a cell or of
+   * a face, which are passed to the kernels.
+   */
+  struct QuadraturePointData
+  {
+    /*!
+     * @brief The values of the fields indexed by the field, the
+     * quadrature point and the component.
+     */
+    std::vector<std::vector<Vector<double>>>                values;
+
+    /*!
+     * @brief The gradients of the fields indexed by the field, the
+     * quadrature point and the component.
+     */
+    std::vector<std::vector<std::vector<Tensor<1,dim>>>>    gradients;
+
+    /*!
+     * @brief The product of the Jacobian determinant and the quadrature
+     * weight of each quadrature point.
+     */
+    std::vector<double>                                     JxW;
+
+    /*!
+     * @brief The outward unit normal vector at each quadrature point.
+     * Only set on faces.
+     */
+    std::vector<Tensor<1,dim>>                              normal_vectors;
+
+    /*!
+     * @brief The boundary identifier of the face. Only set on faces.
+     */
+    types::boundary_id                                      boundary_id;
+
+    /*!
+     * @brief Returns the number of quadrature points.
+     */
+    unsigned int n_quadrature_points() const;
+  };
+
+  /*!
+   * @brief A kernel adds the contributions of a cell or of a face to the
+   * integrals starting at the pointer passed as second argument.
+   */
+  using Kernel = std::function<void(const QuadraturePointData &, double *)>;
+
+  /*!
+   * @brief Constructor.
+   */
+  IntegralDiagnostics(const Mapping<dim> &mapping);
+
+  /*!
+   * @brief Registers the field @p field. The flags @p update_flags
+   * specify if its values and/or its gradients are evaluated. Returns
+   * the index of the field in @ref QuadraturePointData.
+   */
+  unsigned int add_field(const Entities::FE_FieldBase<dim> &field,
+                         const UpdateFlags                  update_flags);
+
+  /*!
+   * @brief Registers a kernel computing @p n_integrals volume integrals.
+   * Returns the index of the first integral.
+   */
+  unsigned int add_volume_integral(const unsigned int  n_integrals,
+                                   const Kernel       &kernel);
+
+  /*!
+   * @brief Registers a kernel computing @p n_integrals integrals over the
+   * boundary faces with the given boundary identifiers. Returns the index
+   * of the first integral.
+   */
+  unsigned int add_boundary_integral
+  (const std::set<types::boundary_id> &boundary_ids,
+   const unsigned int                  n_integrals,
+   const Kernel                       &kernel);
+
+  /*!
+   * @brief Evaluates all integrals.
+   *
+   * @details This method is collective, i.e., it has to be called by
+   * all processes.
+   */
+  void evaluate();
+
+  /*!
+   * @brief Returns the value of the integral with the index @p i computed
+   * by the last call of @ref evaluate.
+   */
+  double get_integral(const unsigned int i) const;
+
+private:
+  /*!
+   * @brief A kernel together with the index of its first integral and,
+   * in case of a boundary integral, its boundary identifiers.
+   */
+  struct KernelData
+  {
+    Kernel                        kernel;
+
+    unsigned int                  first_integral;
+
+    std::set<types::boundary_id>  boundary_ids;
+  };
+
+  /*!
+   * @brief The mapping used for the integration.
+   */
+  const Mapping<dim>                                &mapping;
+
+  /*!
+   * @brief Pointers to the fields.
+   */
+  std::vector<const Entities::FE_FieldBase<dim> *>  fields;
+
+  /*!
+   * @brief The quantities evaluated for each field.
+   */
+  std::vector<UpdateFlags>                          update_flags;
+
+  /*!
+   * @brief The kernels of the volume integrals.
+   */
+  std::vector<KernelData>                           volume_kernels;
+
+  /*!
+   * @brief The kernels of the boundary integrals.
+   */
+  std::vector<KernelData>                           boundary_kernels;
+
+  /*!
+   * @brief The union of the boundary identifiers of all boundary kernels.
+   */
+  std::set<types::boundary_id>                      boundary_ids;
+
+  /*!
+   * @brief The values of the integrals.
+   */
+  std::vector<double>                               integrals;
+};
+
+
+
+template <int dim>
+inline unsigned int
+IntegralDiagnostics<dim>::QuadraturePointData::n_quadrature_points() const
+{
+  return (JxW.size());
+}
+
+
+
+template <int dim>
+inline double IntegralDiagnostics<dim>::get_integral(const unsigned int i) const
+{
+  AssertIndexRange(i, integrals.size());
+  return (integrals[i]);
+}
+
+} // namespace RMHD
+
+#endif /* INCLUDE_ROTATINGMHD_INTEGRAL_DIAGNOSTICS_H_ */
@@ -211,6 +211,30 @@ struct PreconditionILUParameters : PreconditionBaseParameters
    * using the Trilinos linear algebra package.
    */
   unsigned int  overlap;
+
+  /*!
+   * @brief Boolean flag to store and apply the factorization in single
+   * precision while the Krylov method remains in double precision.
+   *
+   * @details The factorization is an ILU(0) of the locally owned diagonal
+   * block of the matrix. Hence, the fill-in level and the overlap must be
+   * zero. The relative and absolute tolerances are not used, the diagonal
+   * is strengthened by @ref strengthen_diagonal instead.
+   *
+   * @attention This parameter is only meaningful if the library is compiled
+   * using the Trilinos linear algebra package.
+   */
+  bool          mixed_precision;
+
+  /*!
+   * @brief Factor by which the diagonal entries of the single precision
+   * factorization are strengthened. The factor multiplies the sum of the
+   * absolute values of the off-diagonal entries of the row.
+   *
+   * @attention This parameter is only meaningful if the mixed precision
+   * ILU is used.
+   */
+  double        strengthen_diagonal;
 };
 
 /*!
@@ -324,7 +348,7 @@ Stream& operator<<(Stream &stream, const PreconditionAMGParameters &prm);
  * @struct LinearSolverParameters
  *
  * @brief A structure containing all parameters relevant for the solution of
- * linear systems using a Krylov subspace method.
+ * linear systems using a Krylov subspace method or a sparse direct solver.
  *
  * @todo Proper initiation of the solver_name string without constructor
  * ambiguity. The string is included in order for the stream to print
@@ -405,6 +429,26 @@ struct LinearSolverParameters
    */
   unsigned int  n_maximum_iterations;
 
+  /*!
+   * @brief The type of the linear solver.
+   *
+   * @details If a direct solver is chosen, the tolerances and the
+   * preconditioner parameters are ignored.
+   */
+  SolverType    solver_type;
+
+  /*!
+   * @brief Dimension of the deflation space.
+   *
+   * @details The number of approximate eigenvectors which are kept
+   * between consecutive solves. Memory for four times this number of
+   * vectors is allocated by the solver.
+   *
+   * @attention This parameter is only meaningful if a deflated
+   * conjugate gradient method is used.
+   */
+  unsigned int  n_deflation_vectors;
+
   /*!
    * @brief Pointer to the parameter of the preconditioners
    */
@@ -429,6 +473,14 @@ private:
 template<typename Stream>
 Stream& operator<<(Stream &stream, const LinearSolverParameters &prm);
 
+/*!
+ * @brief Returns true if the preconditioner parameters of @p prm and
+ * @p other_prm coincide, i.e., if both yield the same preconditioner for
+ * the same matrix.
+ */
+bool have_same_preconditioner(const LinearSolverParameters &prm,
+                              const LinearSolverParameters &other_prm);
+
 } // namespace RunTimeParameters
 
 } // namespace RMHD
@@ -0,0 +1,362 @@
+#ifndef INCLUDE_ROTATINGMHD_LINEAR_SOLVERS_H_
+#define INCLUDE_ROTATINGMHD_LINEAR_SOLVERS_H_
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <rotatingMHD/global.h>
+
+#include <memory>
+#include <vector>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+/*!
+ * @class DirectSolver
+ *
+ * @brief A wrapper around the sparse direct solvers of the Trilinos
+ * (Amesos) and PETSc (MUMPS) libraries which keeps the factorization of
+ * the matrix in memory.
+ *
+ * @details The factorization is computed by @ref initialize and reused
+ * by every subsequent call of @ref solve. It has to be recomputed, i.e.
+ * @ref clear and @ref initialize have to be called again, if the matrix
+ * changes, e.g., after the mesh was refined.
+ */
+class DirectSolver
+{
+public:
+  /*!
+   * @brief Constructor.
+   */
+  DirectSolver(const MPI_Comm &mpi_communicator = MPI_COMM_WORLD);
+
+  /*!
+   * @brief Computes the factorization of the matrix @p matrix.
+   *
+   * @attention The matrix has to stay alive as long as the factorization
+   * is used.
+   */
+  void initialize(const LinearAlgebra::MPI::SparseMatrix &matrix);
+
+  /*!
+   * @brief Solves the linear system using the stored factorization.
+   */
+  void solve(LinearAlgebra::MPI::Vector       &solution,
+             const LinearAlgebra::MPI::Vector &rhs);
+
+  /*!
+   * @brief Releases the factorization.
+   */
+  void clear();
+
+  /*!
+   * @brief Returns true if a factorization was computed.
+   */
+  bool is_initialized() const;
+
+private:
+  /*!
+   * @brief The MPI communicator.
+   */
+  const MPI_Comm                                mpi_communicator;
+
+  /*!
+   * @brief The solver control object required by the constructor of the
+   * direct solvers. It is not used to control any iteration.
+   */
+  SolverControl                                 solver_control;
+
+  /*!
+   * @brief The underlying direct solver.
+   */
+  std::unique_ptr<LinearAlgebra::SolverDirect>  solver;
+
+  /*!
+   * @brief Pointer to the factorized matrix.
+   *
+   * @details The PETSc interface requires the matrix in each call of
+   * its solve method. The factorization itself is only computed in the
+   * first call.
+   */
+  const LinearAlgebra::MPI::SparseMatrix       *matrix_ptr;
+};
+
+
+
+inline bool DirectSolver::is_initialized() const
+{
+  return (solver != nullptr);
+}
+
+
+
+/*!
+ * @class DeflatedCG
+ *
+ * @brief A preconditioned conjugate gradient method which deflates a
+ * small subspace recycled from previous solves.
+ *
+ * @details The method is intended for a sequence of linear systems with
+ * the same symmetric positive definite matrix and slowly varying
+ * right-hand sides, e.g., the projection step. It implements the
+ * deflated conjugate gradient method of Saad et al. (2000). The initial
+ * guess is chosen such that its residual is orthogonal to the deflation
+ * space \f$ \mathbf{W} \f$ and all search directions are kept
+ * \f$ \mathbf{A} \f$-orthogonal to it.
+ *
+ * The first search directions of each solve are stored. After
+ * convergence a Rayleigh-Ritz procedure on the space spanned by them and
+ * the current deflation space yields approximations to the eigenvectors
+ * of the smallest eigenvalues, which become the deflation space of the
+ * next solve. The basis is \f$ \mathbf{A} \f$-orthonormal, i.e., no
+ * coarse system has to be solved.
+ *
+ * @attention The deflation space has to be cleared through @ref clear
+ * whenever the matrix changes.
+ */
+class DeflatedCG
+{
+public:
+  /*!
+   * @brief Constructor.
+   */
+  DeflatedCG(const unsigned int n_deflation_vectors = 8);
+
+  /*!
+   * @brief Sets the dimension of the deflation space. If it differs from
+   * the current one, the deflation space is cleared.
+   */
+  void set_n_deflation_vectors(const unsigned int n_deflation_vectors);
+
+  /*!
+   * @brief Solves the linear system. The convergence is controlled by
+   * @p solver_control and an exception of the type
+   * SolverControl::NoConvergence is thrown if the method fails.
+   */
+  void solve(SolverControl                           &solver_control,
+             const LinearAlgebra::MPI::SparseMatrix  &matrix,
+             LinearAlgebra::MPI::Vector              &solution,
+             const LinearAlgebra::MPI::Vector        &rhs,
+             const LinearAlgebra::PreconditionBase   &preconditioner);
+
+  /*!
+   * @brief Releases the deflation space.
+   */
+  void clear();
+
+  /*!
+   * @brief Returns the current dimension of the deflation space.
+   */
+  unsigned int size() const;
+
+  /*!
+   * @brief Returns the memory in bytes which the deflation space and the
+   * stored search directions occupy on the current process.
+   */
+  std::size_t memory_consumption() const;
+
+private:
+  /*!
+   * @brief Maximum dimension of the deflation space.
+   */
+  unsigned int                            n_deflation_vectors;
+
+  /*!
+   * @brief The \f$ \mathbf{A} \f$-orthonormal basis of the deflation
+   * space.
+   */
+  std::vector<LinearAlgebra::MPI::Vector> deflation_vectors;
+
+  /*!
+   * @brief The product of the matrix with each vector of
+   * @ref deflation_vectors.
+   */
+  std::vector<LinearAlgebra::MPI::Vector> matrix_times_deflation_vectors;
+
+  /*!
+   * @brief The search directions stored during the current solve.
+   */
+  std::vector<LinearAlgebra::MPI::Vector> search_directions;
+
+  /*!
+   * @brief The product of the matrix with each vector of
+   * @ref search_directions.
+   */
+  std::vector<LinearAlgebra::MPI::Vector> matrix_times_search_directions;
+
+  /*!
+   * @brief Subtracts the \f$ \mathbf{A} \f$-orthogonal projection onto
+   * the deflation space from @p dst, i.e.,
+   * \f$ \mathbf{d} = \mathbf{d} - \mathbf{W} (\mathbf{A}\mathbf{W})^\top \mathbf{v} \f$.
+   */
+  void deflate(LinearAlgebra::MPI::Vector       &dst,
+               const LinearAlgebra::MPI::Vector &src) const;
+
+  /*!
+   * @brief Computes the new deflation space through a Rayleigh-Ritz
+   * procedure on the span of the current deflation space and the stored
+   * search directions.
+   */
+  void update_deflation_space();
+};
+
+
+
+inline unsigned int DeflatedCG::size() const
+{
+  return (deflation_vectors.size());
+}
+
+
+
+/*!
+ * @class PipelinedCG
+ *
+ * @brief The pipelined preconditioned conjugate gradient method of
+ * Ghysels and Vanroose (2014).
+ *
+ * @details The method is mathematically equivalent to the preconditioned
+ * conjugate gradient method but only requires a single global reduction
+ * per iteration. The reduction is non-blocking and overlapped with the
+ * application of the preconditioner and the matrix-vector product. It
+ * pays off when the global reductions dominate the iteration time, i.e.,
+ * at the strong scaling limit. It requires six additional vectors
+ * compared to the standard method.
+ */
+class PipelinedCG
+{
+public:
+  /*!
+   * @brief Constructor.
+   */
+  PipelinedCG(SolverControl &solver_control);
+
+  /*!
+   * @brief Solves the linear system. An exception of the type
+   * SolverControl::NoConvergence is thrown if the method fails.
+   */
+  void solve(const LinearAlgebra::MPI::SparseMatrix  &matrix,
+             LinearAlgebra::MPI::Vector              &solution,
+             const LinearAlgebra::MPI::Vector        &rhs,
+             const LinearAlgebra::PreconditionBase   &preconditioner);
+
+private:
+  /*!
+   * @brief Reference to the object controlling the convergence.
+   */
+  SolverControl &solver_control;
+};
+
+
+
+/*!
+ * @class PipelinedGMRES
+ *
+ * @brief A restarted and right preconditioned GMRES method whose Arnoldi
+ * process requires a single, non-blocking global reduction per
+ * iteration.
+ *
+ * @details The orthogonalization is done through the classical
+ * Gram-Schmidt method and the norm of the new basis vector is obtained
+ * from the same reduction through Pythagoras' theorem. Following the
+ * idea of the p(1)-GMRES method of Ghysels et al. (2013), the image of
+ * each basis vector under the preconditioned operator is stored. The
+ * image of the next basis vector is hence computed while the reduction
+ * is in flight and corrected afterwards through the recurrence of the
+ * Arnoldi process. If cancellation in the norm is detected, a second,
+ * blocking orthogonalization pass is done.
+ *
+ * Compared to the standard GMRES method twice the number of basis
+ * vectors is stored.
+ */
+class PipelinedGMRES
+{
+public:
+  /*!
+   * @brief Constructor.
+   */
+  PipelinedGMRES(SolverControl      &solver_control,
+                 const unsigned int  n_restart_vectors = 30);
+
+  /*!
+   * @brief Solves the linear system. An exception of the type
+   * SolverControl::NoConvergence is thrown if the method fails.
+   */
+  void solve(const LinearAlgebra::MPI::SparseMatrix  &matrix,
+             LinearAlgebra::MPI::Vector              &solution,
+             const LinearAlgebra::MPI::Vector        &rhs,
+             const LinearAlgebra::PreconditionBase   &preconditioner);
+
+private:
+  /*!
+   * @brief Reference to the object controlling the convergence.
+   */
+  SolverControl       &solver_control;
+
+  /*!
+   * @brief The number of basis vectors after which the method is
+   * restarted.
+   */
+  const unsigned int  n_restart_vectors;
+};
+
+
+
+#ifndef USE_PETSC_LA
+/*!
+ * @class PreconditionMixedPrecisionILU
+ *
+ * @brief An incomplete LU preconditioner whose factorization is stored
+ * and applied in single precision.
+ *
+ * @details The ILU(0) factorization of the locally owned diagonal block
+ * of the matrix is computed from a single precision copy, i.e., the
+ * preconditioner is of block Jacobi type without overlap. The
+ * application of the preconditioner is limited by the memory bandwidth,
+ * such that halving the size of the stored entries approximately halves
+ * its cost. The Krylov method and its residuals remain in double
+ * precision.
+ *
+ * @attention Only implemented for the Trilinos library.
+ */
+class PreconditionMixedPrecisionILU : public LinearAlgebra::PreconditionBase
+{
+public:
+  /*!
+   * @brief A structure containing the parameters of the preconditioner.
+   */
+  struct AdditionalData
+  {
+    /*!
+     * @brief Constructor.
+     */
+    AdditionalData(const double strengthen_diagonal = 0.0);
+
+    /*!
+     * @brief The diagonal entries of the factorization are increased by
+     * this factor times their absolute value.
+     */
+    double strengthen_diagonal;
+  };
+
+  /*!
+   * @brief Computes the factorization of the matrix @p matrix.
+   */
+  void initialize(const LinearAlgebra::MPI::SparseMatrix &matrix,
+                  const AdditionalData &additional_data = AdditionalData());
+
+  /*!
+   * @brief Returns the memory in bytes which the factorization occupies
+   * on the current process.
+   */
+  std::size_t memory_consumption() const;
+};
+#endif
+
+} // namespace RMHD
+
+#endif /* INCLUDE_ROTATINGMHD_LINEAR_SOLVERS_H_ */
@@ -0,0 +1,92 @@
+#ifndef INCLUDE_ROTATINGMHD_MEMORY_REPORT_H_
+#define INCLUDE_ROTATINGMHD_MEMORY_REPORT_H_
+
+#include <deal.II/base/mpi.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+/*!
+ * @class MemoryReport
+ *
+ * @brief A list of named entries with the memory in bytes which the
+ * objects of the library occupy on the current process.
+ *
+ * @details The reports of nested objects are merged into the report of
+ * their owner with @ref add, whose prefix is prepended to the names of
+ * the merged entries, e.g., "Navier-Stokes solver - Velocity mass matrix".
+ * The reduction over the processes is performed by @ref reduce and
+ * @ref print, which are collective operations. They hence require that
+ * all processes add the same entries in the same order, which is the
+ * case if the entries are added regardless of their size.
+ */
+class MemoryReport
+{
+public:
+  /*!
+   * @brief Adds the entry @p name occupying @p memory bytes.
+   */
+  void add(const std::string &name, const std::size_t memory);
+
+  /*!
+   * @brief Adds the entries of @p report, whose names are prefixed by
+   * @p prefix.
+   */
+  void add(const std::string &prefix, const MemoryReport &report);
+
+  /*!
+   * @brief Returns the entries of the report.
+   */
+  const std::vector<std::pair<std::string, std::size_t>> &
+  get_entries() const;
+
+  /*!
+   * @brief Returns the memory in bytes which all entries occupy on the
+   * current process.
+   */
+  std::size_t total() const;
+
+  /*!
+   * @brief Returns the minimum, maximum, average and sum over the
+   * processes of the memory in megabytes of each entry. The last entry
+   * of the returned vector corresponds to @ref total.
+   *
+   * @attention This method is a collective operation.
+   */
+  std::vector<Utilities::MPI::MinMaxAvg>
+  reduce(const MPI_Comm &mpi_communicator) const;
+
+  /*!
+   * @brief Prints a table with the minimum, maximum and sum over the
+   * processes of the memory in megabytes of each entry.
+   *
+   * @attention This method is a collective operation.
+   */
+  template<typename Stream>
+  void print(Stream &stream, const MPI_Comm &mpi_communicator) const;
+
+private:
+  /*!
+   * @brief The names of the entries and the memory they occupy in bytes.
+   */
+  std::vector<std::pair<std::string, std::size_t>> entries;
+};
+
+
+
+inline const std::vector<std::pair<std::string, std::size_t>> &
+MemoryReport::get_entries() const
+{
+  return (entries);
+}
+
+}  // namespace RMHD
+
+#endif /* INCLUDE_ROTATINGMHD_MEMORY_REPORT_H_ */
@@ -7,10 +7,15 @@
 #include <rotatingMHD/angular_velocity.h>
 #include <rotatingMHD/finite_element_field.h>
 #include <rotatingMHD/global.h>
+#include <rotatingMHD/linear_solvers.h>
+#include <rotatingMHD/memory_report.h>
 #include <rotatingMHD/run_time_parameters.h>
 #include <rotatingMHD/time_discretization.h>
 #include <rotatingMHD/navier_stokes_projection/assembly_data.h>
 
+#include <boost/serialization/access.hpp>
+#include <boost/signals2/connection.hpp>
+
 #include <array>
 #include <memory>
 #include <string>
@@ -187,6 +192,21 @@ public:
    */
   void reset();
 
+  /*!
+   *  @brief Prepares the solver for a new run on the same mesh, e.g.,
+   *  for the next cycle of a temporal convergence test.
+   *  @details In contrast to @ref clear and @ref reset, the degrees of
+   *  freedom of \f$ \phi \f$, the sparsity patterns, the constant
+   *  matrices and the preconditioners which do not depend on the time
+   *  step size are kept. The solution vectors of \f$ \phi \f$, the
+   *  coefficients of the previous time steps, the norms and the iteration
+   *  counts are reset. The next call of @ref solve performs the Poisson
+   *  pre-step if the time stepping is at its first step.
+   *  @attention The mesh, the degrees of freedom and the boundary
+   *  conditions of the velocity and the pressure must not change.
+   */
+  void reset_for_new_run();
+
   /*!
    * @brief Performs one diffusion step
    * @attention This is just a method for testing
@@ -220,14 +240,64 @@ public:
    */
   double get_projection_step_rhs_norm() const;
 
+  /*!
+   * @brief Returns the number of iterations of the last solve of the
+   * diffusion step.
+   */
+  unsigned int get_diffusion_step_n_iterations() const;
+
+  /*!
+   * @brief Returns the number of iterations of the last solve of the
+   * projection step.
+   * @details It is zero if the projection step uses a direct solver.
+   */
+  unsigned int get_projection_step_n_iterations() const;
+
+  /*!
+   * @brief Returns the number of iterations of the last solve of the
+   * pressure correction step.
+   * @details It is zero if the standard pressure correction scheme or a
+   * direct solver is used.
+   */
+  unsigned int get_correction_step_n_iterations() const;
+
+  /*!
+   * @brief Returns the memory in bytes which the matrices, the
+   * right-hand side vectors, the preconditioners and the deflation spaces
+   * occupy on the current process.
+   * @details The sparsity patterns are stored by the matrices and are
+   * included in their entries. The entities are not included as they
+   * are reported by Entities::FE_FieldBase::get_memory_report. The
+   * memory is only meaningful after the first call of @ref solve
+   * following a modification of the mesh, as the matrices and the
+   * preconditioners are set up therein.
+   */
+  MemoryReport get_memory_report() const;
+
+  /*!
+   * @brief Returns the memory in bytes which the solver occupies on the
+   * current process.
+   */
+  std::size_t memory_consumption() const;
+
 private:
+  friend class boost::serialization::access;
+
+  /*!
+   * @brief Serializes the coefficients of the previous time steps, which
+   * are required to restart the time stepping from a checkpoint. The
+   * history of @ref phi is stored together with the other entities.
+   */
+  template<typename Archive>
+  void serialize(Archive &ar, const unsigned int version);
+
   /*!
    * @brief A reference to the parameters which control the solution process.
    */
   const RunTimeParameters::NavierStokesParameters  &parameters;
 
   /*!
-   * @brief The MPI communicator which is equal to `MPI_COMM_WORLD`.
+   * @brief The MPI communicator of the triangulation of the entities.
    */
   const MPI_Comm                          mpi_communicator;
 
@@ -404,6 +474,38 @@ private:
    */
   std::shared_ptr<LinearAlgebra::PreconditionBase> correction_step_preconditioner;
 
+  /*!
+   * @brief The direct solver of the projection step.
+   * @details The factorization of @ref phi_laplace_matrix is computed in
+   * @ref setup and is only used if a direct solver is specified in the
+   * parameters of the projection step.
+   */
+  DirectSolver                          projection_step_direct_solver;
+
+  /*!
+   * @brief The direct solver of the correction step.
+   * @details The factorization of @ref projection_mass_matrix is computed
+   * in @ref setup and is only used if a direct solver is specified in the
+   * parameters of the correction step.
+   */
+  DirectSolver                          correction_step_direct_solver;
+
+  /*!
+   * @brief The deflated conjugate gradient solver of the projection
+   * step.
+   * @details It is only used if specified in the parameters of the
+   * projection step. Its deflation space is cleared in @ref setup.
+   */
+  DeflatedCG                            projection_step_deflated_solver;
+
+  /*!
+   * @brief The deflated conjugate gradient solver of the correction
+   * step.
+   * @details It is only used if specified in the parameters of the
+   * correction step. Its deflation space is cleared in @ref setup.
+   */
+  DeflatedCG                            correction_step_deflated_solver;
+
   /*!
    * @brief The norm of the right hand side of the diffusion step.
    * @details Its value is that of the last computed pressure-correction
@@ -418,6 +520,24 @@ private:
    */
   double                                  norm_projection_rhs;
 
+  /*!
+   * @brief The number of iterations of the last solve of the diffusion
+   * step.
+   */
+  unsigned int                            n_iterations_diffusion_step;
+
+  /*!
+   * @brief The number of iterations of the last solve of the projection
+   * step.
+   */
+  unsigned int                            n_iterations_projection_step;
+
+  /*!
+   * @brief The number of iterations of the last solve of the pressure
+   * correction step.
+   */
+  unsigned int                            n_iterations_correction_step;
+
   /*!
    * @brief A flag to normalize the pressure field.
    * @details In the case of an unconstrained formulation in the
@@ -438,6 +558,48 @@ private:
    */
   bool                                  flag_matrices_were_updated;
 
+  /*!
+   * @brief A flag indicating if the constraints of \f$ \phi\f$ and of
+   * the pressure coincide.
+   * @details In this case both Laplace matrices coincide. The
+   * @ref pressure_laplace_matrix is then also used in the projection
+   * step and @ref phi_laplace_matrix remains empty. The preconditioner
+   * of the Poisson pre-step is reused in the projection step if the
+   * parameters of both preconditioners coincide.
+   */
+  bool                                  flag_shared_laplace_matrix;
+
+  /*!
+   * @brief A flag indicating if @ref phi_laplace_matrix is obtained from
+   * @ref pressure_laplace_matrix instead of being assembled.
+   * @details This is possible if the constraints of \f$ \phi\f$ only
+   * add homogeneous Dirichlet constraints to those of the pressure. See
+   * @ref patch_phi_laplace_matrix.
+   */
+  bool                                  flag_patch_phi_laplace_matrix;
+
+  /*!
+   * @brief A flag indicating if the triangulation was modified since the
+   * last call of @ref setup.
+   * @details It is set through the @ref mesh_modification_connection
+   * and triggers a call of @ref setup in @ref solve.
+   */
+  bool                                  flag_mesh_was_modified;
+
+  /*!
+   * @brief A flag indicating if @ref reset_for_new_run was called since
+   * the last call of @ref solve.
+   * @details It triggers the Poisson pre-step in @ref solve.
+   */
+  bool                                  flag_new_run;
+
+  /*!
+   * @brief The connection to the signal of the triangulation which is
+   * emitted whenever the latter changes. It is released together with
+   * the solver.
+   */
+  boost::signals2::scoped_connection    mesh_modification_connection;
+
   /*!
    * @brief A method initiating the scalar field  \f$ \phi\f$.
    * @details Extracts its locally owned and relevant degrees of freedom;
@@ -452,6 +614,31 @@ private:
    */
   void setup_matrices();
 
+  /*!
+   * @brief Compares the constraints of \f$ \phi\f$ and of the pressure
+   * and sets @ref flag_shared_laplace_matrix and
+   * @ref flag_patch_phi_laplace_matrix accordingly.
+   */
+  void compare_laplace_matrix_constraints();
+
+  /*!
+   * @brief Copies @ref pressure_laplace_matrix into
+   * @ref phi_laplace_matrix and eliminates the off-diagonal entries in
+   * the rows and columns of the degrees of freedom which are only
+   * constrained in the \f$ \phi\f$ space.
+   * @details The diagonal entries of the eliminated rows coincide with
+   * the ones which are obtained through assembly.
+   */
+  void patch_phi_laplace_matrix();
+
+  /*!
+   * @brief Returns a const reference to the Laplace matrix of
+   * \f$ \phi\f$, i.e., to @ref pressure_laplace_matrix if
+   * @ref flag_shared_laplace_matrix is set and to
+   * @ref phi_laplace_matrix otherwise.
+   */
+  const LinearAlgebra::MPI::SparseMatrix &get_phi_laplace_matrix() const;
+
   /*!
    * @brief Setup of the right-hand side and the auxiliary vector of the
    * diffusion and projection step.
@@ -738,6 +925,35 @@ inline double NavierStokesProjection<dim>::get_projection_step_rhs_norm() const
   return (norm_projection_rhs);
 }
 
+// inline functions
+template <int dim>
+inline unsigned int NavierStokesProjection<dim>::get_diffusion_step_n_iterations() const
+{
+  return (n_iterations_diffusion_step);
+}
+
+// inline functions
+template <int dim>
+inline unsigned int NavierStokesProjection<dim>::get_projection_step_n_iterations() const
+{
+  return (n_iterations_projection_step);
+}
+
+// inline functions
+template <int dim>
+inline unsigned int NavierStokesProjection<dim>::get_correction_step_n_iterations() const
+{
+  return (n_iterations_correction_step);
+}
+
+// inline functions
+template <int dim>
+inline const LinearAlgebra::MPI::SparseMatrix &
+NavierStokesProjection<dim>::get_phi_laplace_matrix() const
+{
+  return (flag_shared_laplace_matrix ? pressure_laplace_matrix: phi_laplace_matrix);
+}
+
 } // namespace RMHD
 
 #endif /* INCLUDE_ROTATINGMHD_NAVIER_STOKES_PROJECTION_H_ */
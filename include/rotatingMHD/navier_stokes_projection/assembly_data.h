@@ -4,6 +4,7 @@
 #include <deal.II/base/tensor.h>
 
 #include <rotatingMHD/assembly_data_base.h>
+#include <rotatingMHD/cell_geometry_cache.h>
 
 #include <vector>
 
@@ -66,12 +67,9 @@ namespace AdvectionMatrix
 using Copy = Generic::Matrix::Copy;
 
 template <int dim>
-struct Scratch : Generic::Matrix::Scratch<dim>
+struct Scratch : ScratchBase<dim>
 {
-  Scratch(const Mapping<dim>        &mapping,
-          const Quadrature<dim>     &quadrature_formula,
-          const FiniteElement<dim>  &fe,
-          const UpdateFlags         update_flags);
+  Scratch(const CellGeometryCache<dim>  &cache);
 
   Scratch(const Scratch<dim>    &data);
 
@@ -79,6 +77,8 @@ struct Scratch : Generic::Matrix::Scratch<dim>
       or leave it locally in each struct for readability? */
   using curl_type = typename FEValuesViews::Vector< dim >::curl_type;
 
+  CachedFEValues<dim>         fe_values;
+
   std::vector<Tensor<1,dim>>  old_velocity_values;
 
   std::vector<Tensor<1,dim>>  old_old_velocity_values;
@@ -322,18 +322,14 @@ struct Copy : CopyBase
 template <int dim>
 struct Scratch : ScratchBase<dim>
 {
-  Scratch(const Mapping<dim>        &mapping,
-          const Quadrature<dim>     &quadrature_formula,
-          const FiniteElement<dim>  &velocity_fe,
-          const UpdateFlags         velocity_update_flags,
-          const FiniteElement<dim>  &pressure_fe,
-          const UpdateFlags         pressure_update_flags);
+  Scratch(const CellGeometryCache<dim>  &velocity_cache,
+          const CellGeometryCache<dim>  &pressure_cache);
 
   Scratch(const Scratch<dim>    &data);
 
-  FEValues<dim>       velocity_fe_values;
+  CachedFEValues<dim> velocity_fe_values;
 
-  FEValues<dim>       pressure_fe_values;
+  CachedFEValues<dim> pressure_fe_values;
 
   std::vector<double> velocity_divergences;
 
@@ -0,0 +1,222 @@
+#ifndef INCLUDE_ROTATINGMHD_PROBE_NETWORK_H_
+#define INCLUDE_ROTATINGMHD_PROBE_NETWORK_H_
+
+#include <rotatingMHD/finite_element_field.h>
+#include <rotatingMHD/run_time_parameters.h>
+#include <rotatingMHD/time_series_writer.h>
+
+#include <deal.II/base/point.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/fe/mapping.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+/*!
+ * @class ProbeNetwork
+ *
+ * @brief Samples a set of finite element fields at the probes defined in
+ * @ref RunTimeParameters::ProbeParameters and writes the samples to the
+ * binary file `probes.bin` in the graphical output directory.
+ *
+ * @details The probes are located once per change of the triangulation.
+ * Each probe is assigned to the process with the lowest rank owning a
+ * cell which contains it. The owning process stores the global indices
+ * of the degrees of freedom of the cell and the values of the shape
+ * functions at the probe. Hence, a sample only consists of a dot product
+ * per probe and component, followed by a single reduction of the values
+ * of all probes and fields to the root process. The root process buffers
+ * the samples and writes them in blocks of
+ * @ref RunTimeParameters::ProbeParameters::n_buffered_samples rows, see
+ * @ref TimeSeriesWriter for the layout of the file. The columns are named
+ * `<field>_<probe>` for scalar fields and `<field>_<component>_<probe>`
+ * for vector fields. The coordinates of the probes are written to the
+ * file `probes.txt`.
+ *
+ * The shape functions are evaluated on the reference cell. Hence, the
+ * finite elements of the fields have to be primitive and their shape
+ * functions may not depend on the mapping, e.g., FE_Q and FESystem
+ * thereof.
+ */
+template <int dim>
+class ProbeNetwork
+{
+public:
+  /*!
+   * @brief Constructor.
+   */
+  ProbeNetwork(const RunTimeParameters::ProbeParameters  &prm,
+               const std::string                         &output_directory,
+               parallel::distributed::Triangulation<dim> &triangulation,
+               const std::shared_ptr<Mapping<dim>>       &mapping);
+
+  /*!
+   * @brief Registers the field @p field. It is only sampled if its name
+   * is listed in @ref RunTimeParameters::ProbeParameters::field_names or
+   * if the list is empty.
+   */
+  void add_field(const Entities::FE_FieldBase<dim> &field);
+
+  /*!
+   * @brief Samples the fields if @p step_number is a multiple of the
+   * sampling frequency.
+   *
+   * @details This method is collective, i.e., it has to be called by
+   * all processes.
+   */
+  void sample(const double time, const unsigned int step_number);
+
+  /*!
+   * @brief Writes the buffered samples to the file.
+   */
+  void flush();
+
+  /*!
+   * @brief Sets the step number of the checkpoint the simulation is
+   * restarted from. The samples of later steps are removed from the file.
+   */
+  void set_resume_step(const unsigned int step_number);
+
+  /*!
+   * @brief Returns the total number of probes.
+   */
+  unsigned int n_probes() const;
+
+private:
+  /*!
+   * @brief The data of a sampled field on the current process.
+   */
+  struct FieldData
+  {
+    /*!
+     * @brief Pointer to the field.
+     */
+    const Entities::FE_FieldBase<dim> *field;
+
+    /*!
+     * @brief The index of the first column of the field in a sample.
+     */
+    unsigned int                        first_column;
+
+    /*!
+     * @brief The global indices of the degrees of freedom of the cell of
+     * each locally owned probe stored contiguously.
+     */
+    std::vector<types::global_dof_index> dof_indices;
+
+    /*!
+     * @brief The values of the shape functions at each locally owned
+     * probe stored contiguously.
+     */
+    std::vector<double>                 shape_values;
+
+    /*!
+     * @brief The vector component of each shape function.
+     */
+    std::vector<unsigned int>           shape_components;
+  };
+
+  /*!
+   * @brief Reference to the parameters.
+   */
+  const RunTimeParameters::ProbeParameters  &prm;
+
+  /*!
+   * @brief The directory of the output files.
+   */
+  const std::string                         output_directory;
+
+  /*!
+   * @brief The MPI communicator of the triangulation.
+   */
+  const MPI_Comm                            mpi_communicator;
+
+  /*!
+   * @brief Reference to the triangulation.
+   */
+  const parallel::distributed::Triangulation<dim> &triangulation;
+
+  /*!
+   * @brief The mapping used to locate the probes.
+   */
+  std::shared_ptr<Mapping<dim>>             mapping;
+
+  /*!
+   * @brief The coordinates of all probes.
+   */
+  std::vector<Point<dim>>                   points;
+
+  /*!
+   * @brief The global indices of the locally owned probes.
+   */
+  std::vector<unsigned int>                 local_probes;
+
+  /*!
+   * @brief The sampled fields.
+   */
+  std::vector<FieldData>                    fields;
+
+  /*!
+   * @brief The values of a sample. Only the entries of the locally owned
+   * probes are non-zero before the reduction.
+   */
+  std::vector<double>                       sample_values;
+
+  /*!
+   * @brief The writer of the samples. Only created on the first sample.
+   */
+  std::unique_ptr<TimeSeriesWriter>         writer;
+
+  /*!
+   * @brief The step number of the checkpoint the simulation is restarted
+   * from.
+   */
+  unsigned int                              resume_step;
+
+  /*!
+   * @brief A flag indicating that the probes have to be located again.
+   */
+  bool                                      flag_locate_probes;
+
+  /*!
+   * @brief The connection to the signal of the triangulation which
+   * invalidates the located probes.
+   */
+  boost::signals2::scoped_connection        mesh_change_connection;
+
+  /*!
+   * @brief Constructs the points of all probe sets.
+   */
+  void create_points();
+
+  /*!
+   * @brief Locates the probes and evaluates the shape functions.
+   */
+  void locate_probes();
+
+  /*!
+   * @brief Creates the writer and the file with the coordinates of the
+   * probes.
+   */
+  void create_writer();
+};
+
+
+
+template <int dim>
+inline unsigned int ProbeNetwork<dim>::n_probes() const
+{
+  return (points.size());
+}
+
+} // namespace RMHD
+
+#endif /* INCLUDE_ROTATINGMHD_PROBE_NETWORK_H_ */
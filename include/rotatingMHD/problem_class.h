@@ -1,7 +1,11 @@
 #ifndef INCLUDE_ROTATINGMHD_PROBLEM_CLASS_H_
 #define INCLUDE_ROTATINGMHD_PROBLEM_CLASS_H_
 
+#include <rotatingMHD/error_estimator.h>
 #include <rotatingMHD/finite_element_field.h>
+#include <rotatingMHD/graphical_output.h>
+#include <rotatingMHD/memory_report.h>
+#include <rotatingMHD/probe_network.h>
 #include <rotatingMHD/time_discretization.h>
 #include <rotatingMHD/run_time_parameters.h>
 
@@ -10,10 +14,22 @@
 #include <deal.II/distributed/solution_transfer.h>
 #include <deal.II/distributed/grid_refinement.h>
 #include <deal.II/fe/mapping_q.h>
+#if DEAL_II_VERSION_GTE(9, 3, 0)
+  #include <deal.II/fe/mapping_q_cache.h>
+#endif
 #include <deal.II/grid/grid_refinement.h>
 #include <deal.II/numerics/error_estimator.h>
 #include <deal.II/numerics/solution_transfer.h>
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include <future>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+
 namespace RMHD
 {
 
@@ -77,9 +93,13 @@ public:
    * @brief Adds the passed on FE_FieldBase instance and flag to the
    * entities struct member.
    * @details If no boolean is passed, it is assumed that the entity
-   * is to be considered by the error estimation.
+   * is to be considered by the error estimation. The weight @p weight
+   * scales the contribution of the entity to the combined error
+   * indicator.
    */
-  void add_entity(Entities::FE_FieldBase<dim> &entity, bool flag = true);
+  void add_entity(Entities::FE_FieldBase<dim> &entity,
+                  bool                         flag = true,
+                  const double                 weight = 1.0);
 
   void serialize(const std::string &file_name) const;
 
@@ -88,6 +108,12 @@ public:
 
   const std::vector<FE_Field>& get_field_collection() const;
 
+  /*!
+   * @brief Returns the weight of the i-th entity in the error
+   * estimation.
+   */
+  double get_error_weight(const unsigned int i) const;
+
   std::vector<SolutionTransferType>  get_transfer_objects() const;
 
   std::vector<TransferVectorType>    get_transfer_vectors() const;
@@ -106,6 +132,11 @@ private:
    * a solution transfer
    */
   std::vector<FE_Field>  entities;
+
+  /*!
+   * @brief The weight of each entity in the error estimation.
+   */
+  std::vector<double>    error_weights;
 };
 
 template <int dim>
@@ -121,6 +152,14 @@ SolutionTransferContainer<dim>::get_field_collection() const
   return (entities);
 }
 
+template <int dim>
+inline double
+SolutionTransferContainer<dim>::get_error_weight(const unsigned int i) const
+{
+  AssertIndexRange(i, error_weights.size());
+  return (error_weights[i]);
+}
+
 
 template <int dim>
 inline bool SolutionTransferContainer<dim>::empty() const
@@ -139,12 +178,25 @@ class Problem
 public:
   /*!
    * @brief Default constructor which initializes the member variables.
+   *
+   * @details The problem is distributed over the processes of
+   * @p mpi_communicator, which is a subset of the processes if several
+   * problems run concurrently, e.g., the cycles of a convergence test.
    */
-  Problem(const RunTimeParameters::ProblemBaseParameters &prm);
+  Problem(const RunTimeParameters::ProblemBaseParameters &prm,
+          const MPI_Comm &mpi_communicator = MPI_COMM_WORLD);
+
+  /*!
+   * @brief Returns the memory in bytes which the triangulation and the
+   * entities of the @ref container occupy on the current process.
+   *
+   * @details Derived classes add the reports of their solvers.
+   */
+  virtual MemoryReport get_memory_report() const;
 
 protected:
   /*!
-   * @brief The MPI communicator which is equal to `MPI_COMM_WORLD`.
+   * @brief The MPI communicator over which the problem is distributed.
    */
   const MPI_Comm  mpi_communicator;
 
@@ -161,6 +213,11 @@ protected:
   /*!
    * @brief The shared pointer to the class describing the mapping from
    * the reference cell to the real cell.
+   *
+   * @details If
+   * @ref RunTimeParameters::ProblemBaseParameters::mapping_cache is set,
+   * it points to a `MappingQCache` which is updated by
+   * @ref update_mapping_cache whenever the triangulation changes.
    */
   std::shared_ptr<Mapping<dim>> mapping;
 
@@ -180,6 +237,19 @@ protected:
    */
   SolutionTransferContainer<dim>              container;
 
+  /*!
+   * @brief Object writing the graphical output of the fields registered
+   * through @ref GraphicalOutput::add_field.
+   */
+  GraphicalOutput<dim>                        graphical_output;
+
+  /*!
+   * @brief Object sampling the fields registered through
+   * @ref ProbeNetwork::add_field at the probes defined in the parameter
+   * file.
+   */
+  ProbeNetwork<dim>                           probes;
+
   /*!
    * @details Release all memory and return all objects to a state just like
    * after having called the default constructor.
@@ -229,6 +299,275 @@ protected:
    * @details
    */
   void adaptive_mesh_refinement();
+
+  /*!
+   * @brief Returns the estimated computational cost of @p cell relative
+   * to the one of an interior cell without hanging nodes.
+   *
+   * @details The cost is increased for each face at a Dirichlet boundary
+   * of an entity of the @ref container and for each face with hanging
+   * nodes, as the assembly of the right-hand sides loops over these
+   * faces and the constraints are more expensive to distribute. The
+   * additional costs are specified through the
+   * @ref RunTimeParameters::SpatialDiscretizationParameters.
+   */
+  virtual double compute_cell_cost
+  (const typename Triangulation<dim>::cell_iterator &cell) const;
+
+  /*!
+   * @brief Updates the boundary ids at which an entity of the
+   * @ref container has Dirichlet boundary conditions and repartitions the
+   * mesh if they changed.
+   *
+   * @details It has to be called once the boundary conditions of the
+   * entities are closed, such that the first partition of the mesh
+   * already accounts for the cost of the Dirichlet boundary faces. The
+   * mesh is only repartitioned if the cost-weighted repartitioning is
+   * enabled and more than one process is used. In this case, true is
+   * returned and the degrees of freedom and the constraints of the
+   * entities have to be set up again.
+   */
+  bool update_dirichlet_boundary_ids();
+
+  /*!
+   * @brief Computes the ratio of the maximum to the average estimated
+   * cost of the locally owned cells of each process.
+   *
+   * @details A value of one corresponds to a perfectly balanced
+   * partition. The cost of a cell is given by @ref compute_cell_cost.
+   */
+  double compute_load_imbalance() const;
+
+  /*!
+   * @brief Distributes the memory budget of the cell geometry caches
+   * evenly among the entities of the @ref container.
+   *
+   * @details It has to be called after all entities were added to the
+   * @ref container. See
+   * @ref RunTimeParameters::ProblemBaseParameters::cell_geometry_cache_memory_budget.
+   */
+  void distribute_cell_geometry_cache_memory_budget();
+
+  /*!
+   * @brief Writes a checkpoint if it is due.
+   *
+   * @details It has to be called once after each time step. A checkpoint
+   * is due every @ref RunTimeParameters::OutputControlParameters::checkpoint_frequency
+   * time steps or after
+   * @ref RunTimeParameters::OutputControlParameters::checkpoint_wall_time_interval
+   * minutes. The wall time is only checked every ten time steps, as the
+   * processes have to agree on it. The slots of the checkpoints are used
+   * in turn.
+   *
+   * Only the triangulation is written collectively. The state of the time
+   * stepping, the three solution vectors of each entity of the
+   * @ref container, the counters of the @ref graphical_output and the
+   * data of @ref save_checkpoint_data are serialized into memory and
+   * written to a file per process by a background thread. Hence the time loop is not blocked by the file
+   * system. Once all processes finished writing, the checkpoint is
+   * marked as the one to restart from. This check is done in the
+   * subsequent calls.
+   */
+  void checkpoint(const TimeDiscretization::VSIMEXMethod &time_stepping);
+
+  /*!
+   * @brief Waits for the checkpoint being written and marks it as the one
+   * to restart from.
+   *
+   * @details It has to be called at the end of the time loop.
+   */
+  void finalize_checkpoint();
+
+  /*!
+   * @brief Returns true if the time loop shall neither print the state
+   * of the time stepping nor write graphical output, i.e., in the
+   * benchmark mode.
+   *
+   * @details See @ref RunTimeParameters::ProblemBaseParameters::benchmark_mode.
+   */
+  bool is_headless() const;
+
+  /*!
+   * @brief Returns true if the time loop shall skip the postprocessing.
+   *
+   * @details See
+   * @ref RunTimeParameters::ProblemBaseParameters::benchmark_skip_postprocessing.
+   */
+  bool skip_postprocessing() const;
+
+  /*!
+   * @brief Advances the benchmark mode by one time step.
+   *
+   * @details It has to be called once after each time step and does
+   * nothing if the benchmark mode is disabled. Once the warm-up steps are
+   * completed, the terminal output is muted, the @ref computing_timer is
+   * reset and the wall time is measured. For each subsequent step the
+   * number of degrees of freedom of the entities of the @ref container is
+   * accumulated, which accounts for a change of the mesh.
+   */
+  void benchmark_step(const TimeDiscretization::DiscreteTime &time_stepping);
+
+  /*!
+   * @brief Reports the throughput of the timed steps of the benchmark
+   * mode, i.e., the degree of freedom updates per second and the steps
+   * per hour, and the wall time of each phase.
+   *
+   * @details It has to be called at the end of the time loop and does
+   * nothing if the benchmark mode is disabled.
+   */
+  void finalize_benchmark();
+
+  /*!
+   * @brief Prints the report returned by @ref get_memory_report with the
+   * minimum, maximum and sum over the processes.
+   *
+   * @details It has to be called once after each time step and does
+   * nothing if the memory report is disabled. The report is printed after
+   * the first time step and after the first time step following each
+   * call of @ref adaptive_mesh_refinement, as the solvers set up their
+   * matrices and preconditioners while solving.
+   */
+  void report_memory_consumption();
+
+  /*!
+   * @brief Loads the triangulation and the state of the time stepping
+   * from the last complete checkpoint.
+   *
+   * @details The triangulation has to contain the coarse mesh only. The
+   * degrees of freedom of the entities and the solvers have to be set up
+   * afterwards, before calling @ref load_checkpoint_fields.
+   *
+   * @attention The number of processes has to be equal to the one with
+   * which the checkpoint was written.
+   */
+  void load_checkpoint_triangulation(TimeDiscretization::VSIMEXMethod &time_stepping);
+
+  /*!
+   * @brief Loads the solution vectors of the entities of the
+   * @ref container and the data of @ref load_checkpoint_data from the
+   * checkpoint opened by @ref load_checkpoint_triangulation.
+   */
+  void load_checkpoint_fields();
+
+  /*!
+   * @brief Serializes problem specific data, e.g., the internal state of
+   * the solvers or the accumulated benchmark data, into the checkpoint.
+   */
+  virtual void save_checkpoint_data(boost::archive::binary_oarchive &archive) const;
+
+  /*!
+   * @brief Deserializes the data written by @ref save_checkpoint_data.
+   */
+  virtual void load_checkpoint_data(boost::archive::binary_iarchive &archive);
+
+private:
+  /*!
+   * @brief The boundary ids at which an entity of the @ref container has
+   * Dirichlet boundary conditions.
+   *
+   * @details It is set by @ref update_dirichlet_boundary_ids and updated
+   * before each refinement of the mesh.
+   */
+  std::set<types::boundary_id>  dirichlet_boundary_ids;
+
+  /*!
+   * @brief Returns the boundary ids at which an entity of the
+   * @ref container has Dirichlet boundary conditions.
+   */
+  std::set<types::boundary_id> collect_dirichlet_boundary_ids() const;
+
+  /*!
+   * @brief Computes the support points of the cached mapping of the
+   * current mesh.
+   *
+   * @details It is connected to the signals of the @ref triangulation
+   * emitted after its creation, refinement, repartitioning and loading.
+   * It does nothing if the mapping is not cached.
+   */
+  void update_mapping_cache();
+
+  /*!
+   * @brief Returns the weight of @p cell which is used by the
+   * triangulation for the repartitioning of the mesh.
+   */
+  unsigned int compute_cell_weight
+  (const typename Triangulation<dim>::cell_iterator &cell) const;
+
+  /*!
+   * @brief The number of checkpoints written so far. It determines the
+   * slot of the next checkpoint.
+   */
+  unsigned int                n_checkpoints;
+
+  /*!
+   * @brief Measures the wall-clock time since the last checkpoint.
+   */
+  Timer                       checkpoint_timer;
+
+  /*!
+   * @brief The result of the background thread writing the data of this
+   * process to the file system. It is valid while the checkpoint is
+   * pending.
+   */
+  std::future<bool>           checkpoint_writer;
+
+  /*!
+   * @brief The slot, step number and time of the pending checkpoint.
+   */
+  std::string                 pending_checkpoint_slot;
+
+  unsigned int                pending_checkpoint_step;
+
+  double                      pending_checkpoint_time;
+
+  /*!
+   * @brief The content of the file of this process and the archive
+   * reading from it during a restart.
+   */
+  std::unique_ptr<std::istringstream>              restart_stream;
+
+  std::unique_ptr<boost::archive::binary_iarchive> restart_archive;
+
+  /*!
+   * @brief Measures the wall time of the timed steps of the benchmark
+   * mode.
+   */
+  Timer                       benchmark_timer;
+
+  /*!
+   * @brief The number of timed steps of the benchmark mode.
+   */
+  unsigned int                n_benchmark_steps;
+
+  /*!
+   * @brief The sum of the number of degrees of freedom over the timed
+   * steps of the benchmark mode.
+   */
+  double                      n_benchmark_dof_updates;
+
+  /*!
+   * @brief A flag indicating if the timed steps of the benchmark mode
+   * have started.
+   */
+  bool                        flag_benchmark_window;
+
+  /*!
+   * @brief A flag indicating if the memory report is due, i.e., if the
+   * mesh was set up or refined since the last report.
+   */
+  bool                        flag_memory_report_due;
+
+  /*!
+   * @brief Serializes the state into memory and starts the background
+   * thread writing it.
+   */
+  void write_checkpoint(const TimeDiscretization::VSIMEXMethod &time_stepping);
+
+  /*!
+   * @brief Waits for the pending checkpoint and, if all processes
+   * succeeded, marks it as the one to restart from.
+   */
+  void commit_checkpoint();
 };
 
 // inline functions
@@ -236,6 +575,20 @@ template<int dim>
 inline void SolutionTransferContainer<dim>::clear()
 {
   entities.clear();
+  error_weights.clear();
+  error_vector_size = 0;
+}
+
+template<int dim>
+inline bool Problem<dim>::is_headless() const
+{
+  return (prm.benchmark_mode);
+}
+
+template<int dim>
+inline bool Problem<dim>::skip_postprocessing() const
+{
+  return (prm.benchmark_mode && prm.benchmark_skip_postprocessing);
 }
 
 } // namespace RMHD
@@ -9,6 +9,8 @@
 #include <deal.II/base/parameter_handler.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace RMHD
 {
@@ -104,6 +106,42 @@ struct SpatialDiscretizationParameters
    * @brief The number of initial refinement steps of cells at the boundary.
    */
   unsigned int  n_initial_boundary_refinements;
+
+  /*!
+   * @brief Boolean flag to enable the repartitioning of the mesh based on
+   * the estimated computational cost of each cell.
+   *
+   * @details If disabled, each process owns approximately the same number
+   * of cells.
+   */
+  bool          cost_weighted_repartitioning;
+
+  /*!
+   * @brief The additional cost of a cell per face at a Dirichlet
+   * boundary relative to the cost of an interior cell.
+   */
+  double        dirichlet_boundary_face_weight;
+
+  /*!
+   * @brief The additional cost of a cell per face with hanging nodes
+   * relative to the cost of an interior cell.
+   */
+  double        hanging_node_face_weight;
+
+  /*!
+   * @brief The error indicator used in the adaptive mesh refinement.
+   */
+  ErrorIndicatorType  error_indicator_type;
+
+  /*!
+   * @brief Boolean flag to normalize the error indicator of each field
+   * by its global \f$ \ell_2 \f$ norm before the weighted indicators
+   * are combined.
+   *
+   * @details Without normalization, a field of larger magnitude dominates
+   * the refinement.
+   */
+  bool                normalize_error_indicators;
 };
 
 
@@ -118,6 +156,101 @@ Stream& operator<<(Stream &stream, const SpatialDiscretizationParameters &prm);
 
 
 
+/*!
+ * @struct ProbeParameters
+ * @brief @ref ProbeParameters contains the definition of the probes at
+ * which the solution is sampled during the simulation.
+ *
+ * @details Each set of probes is given as a list whose entries are
+ * separated by semicolons. The components of a point are separated by
+ * commas.
+ * - Points: `x, y[, z]`.
+ * - Lines: `start : end : n`, i.e., @p n equidistant points between
+ * and including the points `start` and `end`.
+ * - Rings: `radius : n` in 2D and `radius : colatitude : n` in 3D, i.e.,
+ * @p n equidistant points on a circle around the origin and the
+ * \f$ z \f$-axis, respectively.
+ * - Grids: `lower corner : upper corner : n_x, n_y[, n_z]`, i.e., a
+ * tensor product grid spanning the given box including its boundary.
+ */
+struct ProbeParameters
+{
+  /*!
+   * @brief Constructor which sets up the parameters with default values.
+   */
+  ProbeParameters();
+
+  /*!
+   * @brief Static method which declares the associated parameter to the
+   * ParameterHandler object @p prm.
+   */
+  static void declare_parameters(ParameterHandler &prm);
+
+  /*!
+   * @brief Method which parses the parameters from the ParameterHandler
+   * object @p prm.
+   */
+  void parse_parameters(ParameterHandler &prm);
+
+  /*!
+   * @brief Method forwarding parameters to a stream object.
+   *
+   * @details This method does not add a `std::endl` to the stream at the end.
+   */
+  template<typename Stream>
+  friend Stream& operator<<(Stream &stream,
+                            const ProbeParameters &prm);
+
+  /*!
+   * @brief The number of time steps between two samples of the probes.
+   *
+   * @details A value of zero disables the probes.
+   */
+  unsigned int              sampling_frequency;
+
+  /*!
+   * @brief The number of samples which are buffered in memory before
+   * they are written to the file.
+   */
+  unsigned int              n_buffered_samples;
+
+  /*!
+   * @brief The names of the fields which are sampled. If empty, all
+   * fields registered to the probes are sampled.
+   */
+  std::vector<std::string>  field_names;
+
+  /*!
+   * @brief The definitions of the single points.
+   */
+  std::vector<std::string>  points;
+
+  /*!
+   * @brief The definitions of the lines.
+   */
+  std::vector<std::string>  lines;
+
+  /*!
+   * @brief The definitions of the rings.
+   */
+  std::vector<std::string>  rings;
+
+  /*!
+   * @brief The definitions of the grids.
+   */
+  std::vector<std::string>  grids;
+};
+
+/*!
+ * @brief Method forwarding parameters to a stream object.
+ *
+ * @details This method does not add a `std::endl` to the stream at the end.
+ */
+template<typename Stream>
+Stream& operator<<(Stream &stream, const ProbeParameters &prm);
+
+
+
 /*!
  * @struct OutputControlParameters
  * @brief @ref OutputControlParameters contains parameters which are
@@ -166,6 +299,74 @@ struct OutputControlParameters
    * @brief Directory where the graphical output should be written.
    */
   std::string   graphical_output_directory;
+
+  /*!
+   * @brief The file format of the graphical output.
+   */
+  GraphicalOutputFormat graphical_output_format;
+
+  /*!
+   * @brief The maximum number of graphical outputs which are built and
+   * written by a background thread while the time loop continues.
+   *
+   * @details A value of zero corresponds to a synchronous output. Each
+   * pending output keeps a copy of the solution vectors and its patches
+   * in memory.
+   *
+   * @attention The background thread reads the copies of the solution
+   * vectors. Since PETSc is not thread-safe, only a synchronous output is
+   * possible if the library is compiled using the PETSc linear algebra
+   * package.
+   */
+  unsigned int  graphical_output_queue_depth;
+
+  /*!
+   * @brief The file format of the time series of the benchmark requests.
+   */
+  BenchmarkDataFormat benchmark_data_format;
+
+  /*!
+   * @brief The number of rows of the time series of the benchmark
+   * requests after which the buffered rows are written to the file.
+   *
+   * @details Only relevant if the time series is streamed to a file,
+   * i.e., if @ref benchmark_data_format is not
+   * @ref BenchmarkDataFormat::text.
+   */
+  unsigned int  benchmark_data_flush_frequency;
+
+  /*!
+   * @brief The parameters of the probes.
+   */
+  ProbeParameters probe_parameters;
+
+  /*!
+   * @brief The number of time steps after which a checkpoint is written.
+   *
+   * @details A value of zero disables the step based checkpoints.
+   */
+  unsigned int  checkpoint_frequency;
+
+  /*!
+   * @brief The wall-clock time in minutes after which a checkpoint is
+   * written.
+   *
+   * @details A value of zero disables the time based checkpoints.
+   */
+  double        checkpoint_wall_time_interval;
+
+  /*!
+   * @brief The number of slots the checkpoints are written to in turn.
+   *
+   * @details At least two slots are required such that the last
+   * complete checkpoint is never overwritten.
+   */
+  unsigned int  n_checkpoint_slots;
+
+  /*!
+   * @brief Directory where the checkpoints should be written.
+   */
+  std::string   checkpoint_directory;
 };
 
 /*!
@@ -582,6 +783,66 @@ struct ProblemBaseParameters : public OutputControlParameters
    */
   bool                                        mapping_interior_cells;
 
+  /*!
+   * @brief Boolean indicating whether the support points of the mapping
+   * are computed once per mesh and cached.
+   *
+   * @details If set to true, the mapping is a `MappingQCache` whose
+   * support points are recomputed only after the triangulation has
+   * changed. Otherwise, they are computed from the manifolds on each
+   * call to `FEValues::reinit`.
+   */
+  bool                                        mapping_cache;
+
+  /*!
+   * @brief The memory in megabytes per process which the cell geometry
+   * caches of all entities may occupy.
+   *
+   * @details If the budget is exceeded, the caches only store the
+   * geometry of the cells but not the gradients of the shape functions.
+   * See @ref CellGeometryCache.
+   */
+  unsigned int                                cell_geometry_cache_memory_budget;
+
+  /*!
+   * @brief Boolean flag to enable the benchmark mode.
+   *
+   * @details In the benchmark mode the time loop neither prints the
+   * state of the time stepping nor writes graphical output. The first
+   * @ref benchmark_n_warm_up_steps steps are not measured. During the
+   * subsequent steps the terminal output is muted and at the end of the
+   * time loop the throughput and the wall time of each phase are
+   * reported. The number of steps is still controlled by the parameters
+   * of the time stepping.
+   */
+  bool                                        benchmark_mode;
+
+  /*!
+   * @brief Boolean flag to skip the postprocessing, i.e., the
+   * computation of the benchmark data and the sampling of the probes, in
+   * the benchmark mode.
+   */
+  bool                                        benchmark_skip_postprocessing;
+
+  /*!
+   * @brief The number of time steps performed before the timed window of
+   * the benchmark mode starts.
+   *
+   * @details The first step is always a warm-up step as it includes the
+   * setup of the solvers.
+   */
+  unsigned int                                benchmark_n_warm_up_steps;
+
+  /*!
+   * @brief Boolean flag to print the memory consumption of the
+   * triangulation, the entities and the solvers.
+   *
+   * @details The report is printed after the first time step and after
+   * the first time step following each refinement of the mesh, i.e.,
+   * once the solvers have set up their matrices and preconditioners.
+   */
+  bool                                        memory_report;
+
   /*!
    * @brief Boolean flag to enable verbose output on the terminal.
    */
@@ -0,0 +1,154 @@
+#ifndef INCLUDE_ROTATINGMHD_TIME_SERIES_WRITER_H_
+#define INCLUDE_ROTATINGMHD_TIME_SERIES_WRITER_H_
+
+#include <rotatingMHD/basic_parameters.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/numbers.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+/*!
+ * @class TimeSeriesWriter
+ *
+ * @brief Appends the rows of a time series to a file while the simulation
+ * runs.
+ *
+ * @details Only the root process of the communicator writes to the file.
+ * The rows are buffered and written to the file once the number of
+ * buffered rows reaches the flush frequency, upon a call to @ref flush and
+ * upon destruction. Two formats are supported:
+ *
+ * - CSV: A header line with the comma separated names of the columns
+ * followed by one line per row.
+ * - Binary: A header followed by the rows as contiguous double precision
+ * values in the byte order of the machine. The header consists of the
+ * eight characters `RMHDTS1\n`, the number of columns and the offset of
+ * the first row in bytes, both as 64-bit unsigned integers, and the
+ * null-terminated names of the columns. The header is padded with zeros
+ * to a multiple of eight bytes such that the rows can be memory mapped,
+ * see `python/benchmark_data.py`.
+ *
+ * If the simulation is resumed from a checkpoint, the rows written after
+ * the checkpoint are removed from the file before new rows are appended.
+ * To this end, the time series has to contain a column named `step`.
+ */
+class TimeSeriesWriter
+{
+public:
+  /*!
+   * @brief Constructor.
+   *
+   * @details Creates the file @p file_name and writes the header if
+   * @p resume_step is equal to numbers::invalid_unsigned_int or if the
+   * file does not exist. Otherwise, the header of the existing file is
+   * compared against @p column_names and all rows whose step number is
+   * larger than @p resume_step are removed.
+   */
+  TimeSeriesWriter(const std::string                             &file_name,
+                   const std::vector<std::string>                &column_names,
+                   const RunTimeParameters::BenchmarkDataFormat   format,
+                   const unsigned int                             flush_frequency,
+                   const MPI_Comm                                 mpi_communicator = MPI_COMM_WORLD,
+                   const unsigned int                             resume_step = numbers::invalid_unsigned_int);
+
+  /*!
+   * @brief Destructor. Writes the buffered rows to the file.
+   */
+  ~TimeSeriesWriter();
+
+  /*!
+   * @brief Appends a row to the time series.
+   *
+   * @details The size of @p values has to match the number of columns.
+   */
+  void add_row(const std::vector<double> &values);
+
+  /*!
+   * @brief Writes the buffered rows to the file.
+   */
+  void flush();
+
+  /*!
+   * @brief Returns the names of the columns.
+   */
+  const std::vector<std::string>& get_column_names() const;
+
+private:
+  /*!
+   * @brief The name of the file.
+   */
+  const std::string                           file_name;
+
+  /*!
+   * @brief The names of the columns.
+   */
+  const std::vector<std::string>              column_names;
+
+  /*!
+   * @brief The format of the file.
+   */
+  const RunTimeParameters::BenchmarkDataFormat format;
+
+  /*!
+   * @brief The number of rows after which the buffer is written to the
+   * file.
+   */
+  const unsigned int                          flush_frequency;
+
+  /*!
+   * @brief A flag indicating if the current process writes to the file.
+   */
+  const bool                                  flag_root_process;
+
+  /*!
+   * @brief The stream of the file. Only opened on the root process.
+   */
+  std::ofstream                               file;
+
+  /*!
+   * @brief The values of the buffered rows stored contiguously.
+   */
+  std::vector<double>                         buffer;
+
+  /*!
+   * @brief Creates the file and writes the header.
+   */
+  void create_file();
+
+  /*!
+   * @brief Verifies the header of the existing binary file and removes
+   * the rows whose step number is larger than @p resume_step.
+   */
+  void truncate_binary_file(const unsigned int resume_step) const;
+
+  /*!
+   * @brief Verifies the header of the existing CSV file and removes the
+   * rows whose step number is larger than @p resume_step.
+   */
+  void truncate_csv_file(const unsigned int resume_step) const;
+
+  /*!
+   * @brief Returns the index of the column named `step`.
+   */
+  unsigned int get_step_column() const;
+};
+
+
+
+inline const std::vector<std::string>&
+TimeSeriesWriter::get_column_names() const
+{
+  return (column_names);
+}
+
+} // namespace RMHD
+
+#endif /* INCLUDE_ROTATINGMHD_TIME_SERIES_WRITER_H_ */
@@ -11,6 +11,10 @@
 #include <rotatingMHD/global.h>
 #include <rotatingMHD/run_time_parameters.h>
 
+#include <deal.II/base/mpi.h>
+#include <deal.II/grid/tria.h>
+
+#include <cstddef>
 #include <memory>
 
 namespace RMHD
@@ -33,6 +37,27 @@ void build_preconditioner
  const bool                                            higher_order_elements = false,
  const bool                                            symmetric = true);
 
+/*!
+ * @brief Returns the memory in bytes which the preconditioner
+ * @p preconditioner occupies on the current process.
+ *
+ * @details Only the algebraic multigrid preconditioner of the Trilinos
+ * library and PreconditionMixedPrecisionILU provide an estimate of their
+ * memory consumption. Zero is returned for the remaining preconditioners.
+ */
+std::size_t preconditioner_memory_consumption
+(const std::shared_ptr<LinearAlgebra::PreconditionBase> &preconditioner);
+
+/*!
+ * @brief Returns the MPI communicator of @p triangulation if it is a
+ * parallel triangulation and `MPI_COMM_WORLD` otherwise.
+ *
+ * @details The solvers use the communicator of the triangulation of their
+ * entities, such that they are able to run on a subset of the processes.
+ */
+template <int dim>
+MPI_Comm get_mpi_communicator(const dealii::Triangulation<dim> &triangulation);
+
 }  // namespace RMHD
 
 #endif /* INCLUDE_ROTATINGMHD_UTILITY_H_ */
@@ -17,7 +17,15 @@ using NormType = dealii::VectorTools::NormType;
 
 /*!
  * Computes the error of the solution specified by the finite element field with
- * respect to the given exact solution.
+ * respect to the given exact solution in the L2-norm, the H1-seminorm, the
+ * H1-norm and the Linfty-norm.
+ *
+ * All norms are computed in a single threaded loop over the locally owned
+ * cells, in which the exact solution and its gradient are evaluated once per
+ * quadrature point. The local errors are reduced by a single collective
+ * operation. The Linfty-norm is sampled at the points of an iterated
+ * trapezoidal rule, which coincide with the support points for elements of a
+ * degree less than three.
  */
 template <int dim, typename VectorType>
 std::map<NormType, double>
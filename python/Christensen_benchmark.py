@@ -2,16 +2,32 @@ import math
 import numpy as np
 import matplotlib.pyplot as plt
 from matplotlib.ticker import (AutoMinorLocator, MultipleLocator)
+from benchmark_data import load_columns
 
-data = np.loadtxt("Christensen_Benchmark_case_0_5.txt",
-                  delimiter="|",
-                  usecols = (1, # Time
-                             2, # Mean kinetic energy density
-                             5, # Temperature at sample point
-                             6, # Azimuthal velocity at sample point
-                             8, # Drift frequency
-                             4),# Sample point longitude
-                  skiprows = 1)
+# The streamed time series ("benchmark_data.bin" or "benchmark_data.csv")
+# is read through its column names. It does not contain the drift
+# frequency, whose column is computed from the longitude below.
+data_file = "Christensen_Benchmark_case_0_5.txt"
+
+if data_file.endswith((".bin", ".csv")):
+  data = load_columns(data_file,
+                      ["time",
+                       "mean kinetic energy",
+                       "temperature",
+                       "azimuthal velocity",
+                       "longitude",
+                       "longitude"])
+  data[0, 4] = 0.0
+else:
+  data = np.loadtxt(data_file,
+                    delimiter="|",
+                    usecols = (1, # Time
+                               2, # Mean kinetic energy density
+                               5, # Temperature at sample point
+                               6, # Azimuthal velocity at sample point
+                               8, # Drift frequency
+                               4),# Sample point longitude
+                    skiprows = 1)
 
 for i in range(len(data[:,4])-1):
   data[i+1,4] = (data[i+1,5]-data[i,5])/(data[i+1,0]-data[i,0])
@@ -3,14 +3,26 @@ import numpy as np
 import matplotlib.pyplot as plt
 from matplotlib.ticker import (AutoMinorLocator, MultipleLocator)
 from scipy.signal import argrelextrema
-
-data = np.loadtxt("dfg_benchmark_3.txt",
-                  delimiter="|",
-                  usecols = (2,   # Time
-                             3,   # Pressure difference
-                             4,   # Drag coefficient
-                             5),  # Lift coefficient
-                  skiprows = 1)
+from benchmark_data import load_columns
+
+# The streamed time series ("benchmark_data.bin" or "benchmark_data.csv")
+# is read through its column names.
+data_file = "dfg_benchmark_3.txt"
+
+if data_file.endswith((".bin", ".csv")):
+  data = load_columns(data_file,
+                      ["time",
+                       "pressure difference",
+                       "drag coeff.",
+                       "lift coeff."])
+else:
+  data = np.loadtxt(data_file,
+                    delimiter="|",
+                    usecols = (2,   # Time
+                               3,   # Pressure difference
+                               4,   # Drag coefficient
+                               5),  # Lift coefficient
+                    skiprows = 1)
 
 # Create plots
 fig, ax = plt.subplots(3,1)
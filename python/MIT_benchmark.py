@@ -3,22 +3,37 @@ import numpy as np
 import matplotlib.pyplot as plt
 from matplotlib.ticker import (AutoMinorLocator, MultipleLocator)
 from scipy.signal import argrelextrema
+from benchmark_data import load_columns
 
 # Extracting time, velocity's x-component at P1, temperature at P1,
 # Nusselt number at the right wall, pressure difference between P1 and
 # P4, the average velocity metric and the average vorticity metric.
 # Note to the files: The number at the end of the file name
 # ("MIT_benchmark_R*.txt") correspond to the refinement level.
-data = np.loadtxt("MIT_benchmark_R3.txt",
-                  delimiter="|",
-                  usecols = (1,   # Time
-                             2,   # Velocity x-component
-                             4,   # Temperature
-                             11,  # Nusselt number (left wall)
-                             8,   # Pressure difference 14
-                             13,  # Average velocity metric
-                             14), # Average vorticity metric
-                  skiprows = 1)
+# The streamed time series ("benchmark_data.bin" or "benchmark_data.csv")
+# is read through its column names.
+data_file = "MIT_benchmark_R3.txt"
+
+if data_file.endswith((".bin", ".csv")):
+  data = load_columns(data_file,
+                      ["time",
+                       "velocity_x_1",
+                       "temperature_1",
+                       "Nu_left_wall",
+                       "dpressure_14",
+                       "average_velocity_metric",
+                       "average_vorticity_metric"])
+else:
+  data = np.loadtxt(data_file,
+                    delimiter="|",
+                    usecols = (1,   # Time
+                               2,   # Velocity x-component
+                               4,   # Temperature
+                               11,  # Nusselt number (left wall)
+                               8,   # Pressure difference 14
+                               13,  # Average velocity metric
+                               14), # Average vorticity metric
+                    skiprows = 1)
 
 # Initializing averange and peak-to-valley values
 results     = np.zeros(2 * len(data[0,:]) - 1)
@@ -0,0 +1,96 @@
+import os
+import numpy as np
+
+# Reader of the time series of the benchmark requests. The time series is
+# either an org-mode table ("benchmark_data.txt"), a CSV file
+# ("benchmark_data.csv") or a binary file ("benchmark_data.bin"). The
+# binary file starts with the magic string "RMHDTS1\n", the number of
+# columns and the offset of the first row (both 64-bit unsigned integers)
+# and the null-terminated names of the columns. The rows are stored as
+# contiguous double precision values and are memory mapped, i.e., only
+# the accessed columns are read from the disk.
+
+BINARY_MAGIC = b"RMHDTS1\n"
+
+
+def read_binary(file_name):
+  """Returns the names of the columns and a memory mapped array of shape
+  (n_rows, n_columns) of a binary time series."""
+  with open(file_name, "rb") as file:
+    magic = file.read(len(BINARY_MAGIC))
+    if magic != BINARY_MAGIC:
+      raise ValueError(file_name + " is not a binary time series")
+    n_columns, data_offset = np.frombuffer(file.read(16), dtype=np.uint64)
+    n_columns   = int(n_columns)
+    data_offset = int(data_offset)
+    names = file.read(data_offset - len(BINARY_MAGIC) - 16).split(b"\0")
+    names = [name.decode() for name in names[:n_columns]]
+
+  # A row which was only partially written is ignored
+  n_rows = (os.path.getsize(file_name) - data_offset) // (8 * n_columns)
+
+  if n_rows == 0:
+    return names, np.empty((0, n_columns))
+
+  return names, np.memmap(file_name,
+                          dtype=np.float64,
+                          mode="r",
+                          offset=data_offset,
+                          shape=(n_rows, n_columns))
+
+
+def read_csv(file_name):
+  """Returns the names of the columns and the array of a CSV time
+  series."""
+  with open(file_name, "r") as file:
+    names = file.readline().strip().split(",")
+
+  data = np.loadtxt(file_name, delimiter=",", skiprows=1, ndmin=2)
+
+  return names, data
+
+
+def read_org_table(file_name):
+  """Returns the names of the columns and the array of a time series
+  written as an org-mode table."""
+  with open(file_name, "r") as file:
+    names = [name.strip() for name in file.readline().split("|")[1:-1]]
+
+  data = np.loadtxt(file_name,
+                    delimiter="|",
+                    usecols=range(1, len(names) + 1),
+                    skiprows=1,
+                    ndmin=2)
+
+  return names, data
+
+
+def load_columns(file_name, columns):
+  """Returns the columns with the given names of a time series as an
+  array of shape (n_rows, len(columns)). The format is deduced from the
+  extension of the file name."""
+  if file_name.endswith(".bin"):
+    names, data = read_binary(file_name)
+  elif file_name.endswith(".csv"):
+    names, data = read_csv(file_name)
+  else:
+    names, data = read_org_table(file_name)
+
+  return np.asarray(data[:, [names.index(column) for column in columns]])
+
+
+def load_probe_signals(file_name, field_name, component=None):
+  """Returns the sampling times and the signals of all probes of a field
+  as an array of shape (n_samples, n_probes) from the file "probes.bin".
+  The component has to be specified for vector fields. The signals can
+  be passed directly to compute_spectrum."""
+  names, data = read_binary(file_name)
+
+  prefix = field_name + "_"
+  if component is not None:
+    prefix += str(component) + "_"
+
+  columns = [i for i, name in enumerate(names)
+             if name.startswith(prefix) and name[len(prefix):].isdigit()]
+
+  return np.asarray(data[:, 0]), np.asarray(data[:, columns])
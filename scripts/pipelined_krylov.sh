@@ -0,0 +1,23 @@
+#!/bin/bash
+# Runs the pipelined Krylov benchmark for an increasing number of MPI
+# processes. Usage: ./scripts/pipelined_krylov.sh [max_nproc] [n_refinements] [fe_degree]
+max_nproc=${1:-16}
+n_refinements=${2:-6}
+fe_degree=${3:-2}
+
+make -j$max_nproc pipelined_krylov
+cd benchmarks/perf
+
+rm -f pipelined_krylov.txt
+
+nproc=1
+while [ $nproc -le $max_nproc ]
+do
+   mpirun -np $nproc ./pipelined_krylov $n_refinements $fe_degree
+   nproc=$((nproc * 2))
+done
+
+echo
+echo "Time per iteration [s] versus number of processes:"
+sort -k1,1 -k2,2n pipelined_krylov.txt
+cd ../..
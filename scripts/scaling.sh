@@ -0,0 +1,27 @@
+#!/bin/bash
+# Runs the solver phases benchmark for an increasing number of MPI
+# processes and a list of refinement levels. The results are collected in
+# the file benchmarks/perf/scaling.json and summarized in strong and weak
+# scaling tables.
+# Usage: ./scripts/scaling.sh [max_nproc] [n_refinements] [dim] [mesh] [fe_degree] [n_steps]
+max_nproc=${1:-16}
+n_refinements=${2:-3,4,5}
+dim=${3:-3}
+mesh=${4:-hyper_shell}
+fe_degree=${5:-1}
+n_steps=${6:-10}
+
+make -j$max_nproc solver_phases
+cd benchmarks/perf
+
+rm -f scaling.json
+
+nproc=1
+while [ $nproc -le $max_nproc ]
+do
+   mpirun -np $nproc ./solver_phases $dim $mesh $fe_degree $n_refinements $n_steps scaling.json
+   nproc=$((nproc * 2))
+done
+
+python3 ../../scripts/scaling_tables.py scaling.json
+cd ../..
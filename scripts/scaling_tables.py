@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""Produces strong and weak scaling tables from the JSON output of the
+solver phases benchmark, see benchmarks/perf/solver_phases.cc.
+
+Each line of the input files is a JSON object describing one run. The
+strong scaling tables compare the runs with the same problem size, i.e.,
+the same dimension, mesh, finite element degree and refinement level,
+for an increasing number of MPI processes. The weak scaling tables
+compare runs with approximately the same number of degrees of freedom
+per process. The memory tables list the maximum memory per process of
+each matrix, vector and preconditioner.
+
+Usage: ./scripts/scaling_tables.py [--phases] [--memory] [--tolerance T]
+       file [file ...]
+"""
+import argparse
+import json
+import math
+from collections import defaultdict
+
+
+def load_runs(filenames):
+    runs = []
+    for filename in filenames:
+        with open(filename) as file:
+            for line in file:
+                line = line.strip()
+                if line:
+                    runs.append(json.loads(line))
+    return runs
+
+
+def phase_times(run):
+    """Maximum wall time per step of each phase."""
+    return {phase["name"]: phase["max_wall_time"] / run["n_steps"]
+            for phase in run["phases"]}
+
+
+def print_table(header, rows):
+    widths = [max(len(str(entry)) for entry in column)
+              for column in zip(header, *rows)]
+    print("| " + " | ".join(str(entry).rjust(width)
+                            for entry, width in zip(header, widths)) + " |")
+    print("|" + "|".join("-" * (width + 2) for width in widths) + "|")
+    for row in rows:
+        print("| " + " | ".join(str(entry).rjust(width)
+                                for entry, width in zip(row, widths)) + " |")
+    print()
+
+
+def scaling_table(series, efficiency, show_phases):
+    """Prints the table of a series of runs sorted by the number of
+    processes. The efficiency is computed by the given function of the
+    reference run, the run and their times per step."""
+    reference = series[0]
+    t_reference = reference["wall_time_per_step"]
+
+    phase_names = []
+    if show_phases:
+        for run in series:
+            for name in phase_times(run):
+                if name not in phase_names:
+                    phase_names.append(name)
+
+    header = ["Ranks", "Refinements", "DoFs/rank", "Memory/rank [MB]",
+              "Time/step [s]", "Speed-up", "Efficiency"]
+    header += [name + " [s]" for name in phase_names]
+
+    rows = []
+    for run in series:
+        t = run["wall_time_per_step"]
+        times = phase_times(run)
+        row = [run["n_mpi_processes"],
+               run["n_global_refinements"],
+               "%.0f" % run["dofs_per_rank"]["avg"],
+               "%.1f" % run["peak_memory_per_rank_MB"]["max"],
+               "%.4e" % t,
+               "%.2f" % (t_reference / t),
+               "%.2f" % efficiency(reference, run, t_reference, t)]
+        row += ["%.3e" % times[name] if name in times else "-"
+                for name in phase_names]
+        rows.append(row)
+
+    print_table(header, rows)
+
+
+def configuration(run):
+    return (run["dim"], run["mesh"], run["fe_degree"], run["n_threads"])
+
+
+def describe(key):
+    dim, mesh, fe_degree, n_threads = key
+    return ("dim = %d, mesh = %s, fe_degree = %d, threads per rank = %d"
+            % (dim, mesh, fe_degree, n_threads))
+
+
+def strong_scaling(runs, show_phases):
+    groups = defaultdict(list)
+    for run in runs:
+        groups[configuration(run) + (run["n_global_refinements"],)].append(run)
+
+    for key in sorted(groups):
+        series = sorted(groups[key], key=lambda run: run["n_mpi_processes"])
+        if len(series) < 2:
+            continue
+        print("Strong scaling: %s, refinements = %d" % (describe(key[:-1]),
+                                                         key[-1]))
+        print()
+        scaling_table(series,
+                      lambda reference, run, t_reference, t:
+                          t_reference * reference["n_mpi_processes"] /
+                          (t * run["n_mpi_processes"]),
+                      show_phases)
+
+
+def weak_scaling(runs, show_phases, tolerance):
+    groups = defaultdict(list)
+    for run in runs:
+        groups[configuration(run)].append(run)
+
+    for key in sorted(groups):
+        by_ranks = defaultdict(list)
+        for run in groups[key]:
+            by_ranks[run["n_mpi_processes"]].append(run)
+
+        ranks = sorted(by_ranks)
+        if len(ranks) < 2:
+            continue
+
+        # Each run of the smallest number of processes starts a series,
+        # which is continued by the run of each larger number of
+        # processes with the closest number of DoFs per process.
+        for reference in sorted(by_ranks[ranks[0]],
+                                key=lambda run: run["n_global_refinements"]):
+            dofs_per_rank = reference["dofs_per_rank"]["avg"]
+            series = [reference]
+            for n_ranks in ranks[1:]:
+                candidate = min(by_ranks[n_ranks],
+                                key=lambda run: abs(math.log(
+                                    run["dofs_per_rank"]["avg"] /
+                                    dofs_per_rank)))
+                if abs(math.log(candidate["dofs_per_rank"]["avg"] /
+                                dofs_per_rank)) <= math.log(tolerance):
+                    series.append(candidate)
+            if len(series) < 2:
+                continue
+            print("Weak scaling: %s, about %.0f DoFs per rank"
+                  % (describe(key), dofs_per_rank))
+            print()
+            # The time per step is normalized by the number of DoFs per
+            # process as the latter is only approximately constant.
+            scaling_table(series,
+                          lambda reference, run, t_reference, t:
+                              (t_reference / reference["dofs_per_rank"]["avg"]) /
+                              (t / run["dofs_per_rank"]["avg"]),
+                          show_phases)
+
+
+def memory_tables(runs):
+    groups = defaultdict(list)
+    for run in runs:
+        if "memory_report_MB" in run:
+            groups[configuration(run) + (run["n_global_refinements"],)].append(run)
+
+    for key in sorted(groups):
+        series = sorted(groups[key], key=lambda run: run["n_mpi_processes"])
+        print("Memory per rank [MB]: %s, refinements = %d" % (describe(key[:-1]),
+                                                               key[-1]))
+        print()
+
+        names = []
+        for run in series:
+            for entry in run["memory_report_MB"]:
+                if entry["name"] not in names:
+                    names.append(entry["name"])
+
+        header = ["Entry"] + ["%d ranks" % run["n_mpi_processes"]
+                              for run in series]
+        rows = []
+        for name in names:
+            row = [name]
+            for run in series:
+                maxima = {entry["name"]: entry["max"]
+                          for entry in run["memory_report_MB"]}
+                row.append("%.2f" % maxima[name] if name in maxima else "-")
+            rows.append(row)
+
+        print_table(header, rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Strong and weak scaling tables of the solver phases "
+                    "benchmark.")
+    parser.add_argument("files", nargs="+",
+                        help="JSON files written by solver_phases")
+    parser.add_argument("--phases", action="store_true",
+                        help="add the time per step of each phase")
+    parser.add_argument("--memory", action="store_true",
+                        help="add the memory per rank of each matrix, "
+                             "vector and preconditioner")
+    parser.add_argument("--tolerance", type=float, default=1.5,
+                        help="maximum ratio of the DoFs per rank of a weak "
+                             "scaling series (default: 1.5)")
+    args = parser.parse_args()
+
+    runs = load_runs(args.files)
+
+    strong_scaling(runs, args.phases)
+    weak_scaling(runs, args.phases, args.tolerance)
+    if args.memory:
+        memory_tables(runs)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,32 @@
+#!/bin/bash
+# Runs the solver phases benchmark for both dimensions, both meshes and
+# the finite element degrees 1 to 3. The results are collected in the
+# file benchmarks/perf/solver_phases.json, one JSON object per line.
+# Usage: ./scripts/solver_phases.sh [nproc] [n_refinements_2d] [n_refinements_3d] [n_steps]
+nproc=${1:-1}
+n_refinements_2d=${2:-6}
+n_refinements_3d=${3:-3}
+n_steps=${4:-10}
+
+make -j$nproc solver_phases
+cd benchmarks/perf
+
+rm -f solver_phases.json
+
+for dim in 2 3
+do
+   if [ $dim -eq 2 ]; then
+      n_refinements=$n_refinements_2d
+   else
+      n_refinements=$n_refinements_3d
+   fi
+   for mesh in hyper_cube hyper_shell
+   do
+      for fe_degree in 1 2 3
+      do
+         mpirun -np $nproc ./solver_phases $dim $mesh $fe_degree $n_refinements $n_steps
+      done
+   done
+done
+
+cd ../..
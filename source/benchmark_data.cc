@@ -5,12 +5,18 @@
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/geometric_utilities.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/fe/fe_values.h>
 
-#include <boost/math/tools/roots.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/math/tools/toms748_solve.hpp>
 
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <ostream>
 
 namespace RMHD
@@ -21,7 +27,28 @@ using namespace dealii;
 namespace BenchmarkData
 {
 
-DeclException0(ExcBoostNoConvergence);
+namespace
+{
+
+/*!
+ * @brief Reduction operation on pairs of a key and a value which selects
+ * the pair with the smallest key. Ties are broken by the smaller value.
+ */
+void minimum_proposal(void *in, void *inout, int *length, MPI_Datatype *)
+{
+  const double *in_pair     = static_cast<const double *>(in);
+  double       *inout_pair  = static_cast<double *>(inout);
+
+  for (int i = 0; i < *length; ++i, in_pair += 2, inout_pair += 2)
+    if (in_pair[0] < inout_pair[0] ||
+        (in_pair[0] == inout_pair[0] && in_pair[1] < inout_pair[1]))
+    {
+      inout_pair[0] = in_pair[0];
+      inout_pair[1] = in_pair[1];
+    }
+}
+
+} // namespace
 
 template <>
 DFGBechmarkRequests<2>::DFGBechmarkRequests
@@ -76,89 +103,80 @@ void DFGBechmarkRequests<2>::compute_drag_and_lift_coefficients
   constexpr unsigned int dim{2};
 
   const MappingQ<dim> mapping(3);
-  const QGauss<dim-1>   face_quadrature_formula(velocity.fe_degree() + 1);
-
-  FEFaceValues<dim> velocity_face_fe_values(mapping,
-                                            velocity.get_finite_element(),
-                                            face_quadrature_formula,
-                                            update_gradients|
-                                            update_JxW_values|
-                                            update_normal_vectors);
-
-  FEFaceValues<dim> pressure_face_fe_values(mapping,
-                                            pressure.get_finite_element(),
-                                            face_quadrature_formula,
-                                            update_values);
-
-  const unsigned int n_face_q_points = face_quadrature_formula.size();
 
-  const FEValuesExtractors::Vector  velocities(0);
+  IntegralDiagnostics<dim> diagnostics(mapping);
 
-  std::vector<double>         pressure_values(n_face_q_points);
-  std::vector<Tensor<1, dim>> normal_vectors(n_face_q_points);
-  std::vector<Tensor<2, dim>> velocity_gradients(n_face_q_points);
+  const unsigned int velocity_index =
+    diagnostics.add_field(velocity, update_gradients);
+  const unsigned int pressure_index =
+    diagnostics.add_field(pressure, update_values);
 
-  Tensor<1, dim>              forces;
+  const double Re_ = Re;
 
-  for (const auto &cell : velocity.get_dof_handler().active_cell_iterators())
-    if (cell->is_locally_owned() && cell->at_boundary())
-      for (const auto &face : cell->face_iterators())
-        if (face->at_boundary() && face->boundary_id() == cylinder_boundary_id)
+  // Integrals of the components of the force acting on the cylinder
+  const unsigned int force_integrals =
+    diagnostics.add_boundary_integral(
+      {cylinder_boundary_id},
+      dim,
+      [velocity_index, pressure_index, Re_](const auto &data, double *integrals)
+      {
+        for (unsigned int q = 0; q < data.n_quadrature_points(); ++q)
         {
-          velocity_face_fe_values.reinit(cell, face);
-
-          typename DoFHandler<dim>::active_cell_iterator
-          pressure_cell(&velocity.get_triangulation(),
-                        cell->level(),
-                        cell->index(),
-                        // pointer to the pressure's DoFHandler
-                        &(pressure.get_dof_handler()));
-
-          typename DoFHandler<dim>::active_face_iterator
-          pressure_face(&velocity.get_triangulation(),
-                        face->level(),
-                        face->index(),
-                        // pointer to the pressure's DoFHandler
-                        &(pressure.get_dof_handler()));
+          const std::vector<Tensor<1,dim>> &dv = data.gradients[velocity_index][q];
+          const Tensor<1,dim>              &n  = data.normal_vectors[q];
+          const double                      p  = data.values[pressure_index][q][0];
 
-          pressure_face_fe_values.reinit(pressure_cell, pressure_face);
-
-          velocity_face_fe_values[velocities].get_function_gradients(velocity.solution, velocity_gradients);
-
-          pressure_face_fe_values.get_function_values(pressure.solution, pressure_values);
-
-          normal_vectors = velocity_face_fe_values.get_normal_vectors();
-
-          for (unsigned int q = 0; q < n_face_q_points; ++q)
+          for (unsigned int i = 0; i < dim; ++i)
           {
             // The reversed signs here are due to the way how the normal
             // vector is defined in the DFG benchmark.
-            forces += (- 1.0 / Re *
-                      (normal_vectors[q] *
-                      velocity_gradients[q]
-                      +
-                      velocity_gradients[q] *
-                      normal_vectors[q])
-                      +
-                      pressure_values[q] *
-                      normal_vectors[q] ) *
-                      velocity_face_fe_values.JxW(q);
+            double traction = p * n[i];
+            for (unsigned int j = 0; j < dim; ++j)
+              traction -= 1.0 / Re_ * (n[j] * dv[j][i] + dv[i][j] * n[j]);
+
+            integrals[i] += traction * data.JxW[q];
           }
         }
+      });
 
-  // Gather the values of each processor
-  const Triangulation<dim>  &tria = velocity.get_triangulation();
-  const parallel::TriangulationBase<dim> *tria_ptr =
-      dynamic_cast<const parallel::TriangulationBase<dim> *>(&tria);
-  if (tria_ptr != nullptr)
-  {
-    forces = Utilities::MPI::sum(forces, tria_ptr->get_communicator());
-  }
+  diagnostics.evaluate();
+
+  drag_coefficient = 2.0 * diagnostics.get_integral(force_integrals);
+  lift_coefficient = 2.0 * diagnostics.get_integral(force_integrals + 1);
+}
+
+
+
+template <int dim>
+void DFGBechmarkRequests<dim>::stream_to_file
+(const std::string                           &file_name,
+ const RunTimeParameters::BenchmarkDataFormat format,
+ const unsigned int                           flush_frequency,
+ const MPI_Comm                               mpi_communicator,
+ const unsigned int                           resume_step)
+{
+  time_series_writer =
+    std::make_unique<TimeSeriesWriter>(
+      file_name,
+      std::vector<std::string>{
+       "step",
+       "time",
+       "pressure difference",
+       "drag coeff.",
+       "lift coeff."},
+      format,
+      flush_frequency,
+      mpi_communicator,
+      resume_step);
+}
 
 
 
-  drag_coefficient = 2.0 * forces[0];
-  lift_coefficient = 2.0 * forces[1];
+template <int dim>
+void DFGBechmarkRequests<dim>::flush() const
+{
+  if (time_series_writer)
+    time_series_writer->flush();
 }
 
 
@@ -171,6 +189,18 @@ void DFGBechmarkRequests<dim>::write_text(std::ostream &file) const
 
 
 
+template <int dim>
+template <typename Archive>
+void DFGBechmarkRequests<dim>::serialize(Archive &ar, const unsigned int /* version */)
+{
+  ar & pressure_difference;
+  ar & drag_coefficient;
+  ar & lift_coefficient;
+  ar & data_table;
+}
+
+
+
 template <int dim>
 void DFGBechmarkRequests<dim>::update
 (const double                         time,
@@ -181,6 +211,16 @@ void DFGBechmarkRequests<dim>::update
   compute_drag_and_lift_coefficients(velocity, pressure);
   compute_pressure_difference(pressure);
 
+  if (time_series_writer)
+  {
+    time_series_writer->add_row({static_cast<double>(step_number),
+                                 time,
+                                 pressure_difference,
+                                 drag_coefficient,
+                                 lift_coefficient});
+    return;
+  }
+
   data_table.add_value("step", step_number);
   data_table.add_value("time", time);
   data_table.add_value("pressure difference",  pressure_difference);
@@ -282,10 +322,27 @@ void MIT<dim>::update
 {
   // Compute benchmark data
   compute_point_data(velocity, pressure, temperature);
-  compute_wall_data(temperature);
-  compute_global_data(velocity);
+  compute_integral_data(velocity, temperature);
+
+  // Stream the values to the file or update column's values
+  if (time_series_writer)
+  {
+    time_series_writer->add_row({time,
+                                 static_cast<double>(step_number),
+                                 velocity_at_p1[0],
+                                 velocity_at_p1[1],
+                                 temperature_at_p1,
+                                 skewness_metric,
+                                 pressure_differences[0],
+                                 pressure_differences[1],
+                                 pressure_differences[2],
+                                 nusselt_numbers.first,
+                                 nusselt_numbers.second,
+                                 average_velocity_metric,
+                                 average_vorticity_metric});
+    return;
+  }
 
-  // Update column's values
   data.add_value("time", time);
   data.add_value("step", step_number);
   data.add_value("velocity_x_1", velocity_at_p1[0]);
@@ -303,6 +360,48 @@ void MIT<dim>::update
 
 
 
+template <int dim>
+void MIT<dim>::stream_to_file
+(const std::string                           &file_name,
+ const RunTimeParameters::BenchmarkDataFormat format,
+ const unsigned int                           flush_frequency,
+ const MPI_Comm                               mpi_communicator,
+ const unsigned int                           resume_step)
+{
+  time_series_writer =
+    std::make_unique<TimeSeriesWriter>(
+      file_name,
+      std::vector<std::string>{
+       "time",
+       "step",
+       "velocity_x_1",
+       "velocity_y_1",
+       "temperature_1",
+       "skewness",
+       "dpressure_14",
+       "dpressure_51",
+       "dpressure_35",
+       "Nu_left_wall",
+       "Nu_right_wall",
+       "average_velocity_metric",
+       "average_vorticity_metric"},
+      format,
+      flush_frequency,
+      mpi_communicator,
+      resume_step);
+}
+
+
+
+template <int dim>
+void MIT<dim>::flush() const
+{
+  if (time_series_writer)
+    time_series_writer->flush();
+}
+
+
+
 template <int dim>
 void MIT<dim>::write_text(std::ostream &file) const
 {
@@ -310,6 +409,15 @@ void MIT<dim>::write_text(std::ostream &file) const
 }
 
 
+
+template <int dim>
+template <typename Archive>
+void MIT<dim>::serialize(Archive &ar, const unsigned int /* version */)
+{
+  ar & data;
+}
+
+
 template<typename Stream, int dim>
 Stream& operator<<(Stream &stream, const MIT<dim> &mit)
 {
@@ -363,156 +471,82 @@ void MIT<dim>::compute_point_data
 }
 
 template <int dim>
-void MIT<dim>::compute_wall_data(const Entities::FE_ScalarField<dim>  &temperature)
-{
-  // Quadrature formula
-  const QGauss<dim-1>   face_quadrature_formula(temperature.fe_degree() + 1);
-
-  // Finite element values
-  FEFaceValues<dim> face_fe_values(temperature.get_finite_element(),
-                                   face_quadrature_formula,
-                                   update_gradients |
-                                   update_JxW_values |
-                                   update_normal_vectors);
-
-  // Number of quadrature points
-  const unsigned int n_face_q_points = face_quadrature_formula.size();
-
-  // Vectors to stores the temperature gradients and normal vectors
-  // at the quadrature points
-  std::vector<Tensor<1, dim>> temperature_gradients(n_face_q_points);
-  std::vector<Tensor<1, dim>> normal_vectors(n_face_q_points);
-
-  // Initiate the local integral value and at each wall.
-  double local_boundary_integral = 0.0;
-  double left_boundary_integral  = 0.0;
-  double right_boundary_integral = 0.0;
-
-  for (const auto &cell : temperature.get_dof_handler().active_cell_iterators())
-    if (cell->is_locally_owned() && cell->at_boundary())
-      for (const auto &face : cell->face_iterators())
-        if (face->at_boundary())
-          if (face->boundary_id() == left_wall_boundary_id ||
-              face->boundary_id() == right_wall_boundary_id)
-          {
-            // Initialize the finite element values
-            face_fe_values.reinit(cell, face);
-
-            // Get the temperature gradients at the quadrature points
-            face_fe_values.get_function_gradients(temperature.solution,
-                                                  temperature_gradients);
-
-            // Get the normal vectors at the quadrature points
-            normal_vectors = face_fe_values.get_normal_vectors();
-
-            // Reset local face integral values
-            local_boundary_integral = 0.0;
-
-            // Numerical integration
-            for (unsigned int q = 0; q < n_face_q_points; ++q)
-              local_boundary_integral +=
-                temperature_gradients[q] *  // grad T
-                normal_vectors[q] *         // n
-                face_fe_values.JxW(q);      // da
-
-            // Add the local boundary integral to the respective
-            // global boundary integral
-            if (face->boundary_id() == left_wall_boundary_id)
-              left_boundary_integral   += local_boundary_integral;
-            else
-              right_boundary_integral  += local_boundary_integral;
-          }
-
-  // Gather the values of each processor
-  const Triangulation<dim>  &tria = temperature.get_triangulation();
-  const parallel::TriangulationBase<dim> *tria_ptr =
-      dynamic_cast<const parallel::TriangulationBase<dim> *>(&tria);
-  if (tria_ptr != nullptr)
-  {
-    left_boundary_integral   = Utilities::MPI::sum(left_boundary_integral,
-                                                   tria_ptr->get_communicator());
-    right_boundary_integral  = Utilities::MPI::sum(right_boundary_integral,
-                                                   tria_ptr->get_communicator());
-  }
-
-  // Compute and store the Nusselt numbers of the walls
-  nusselt_numbers = std::make_pair(left_boundary_integral/height,
-                                   right_boundary_integral/height);
-}
-
-template <int dim>
-void MIT<dim>::compute_global_data(const Entities::FE_VectorField<dim>  &velocity)
+void MIT<dim>::compute_integral_data
+(const Entities::FE_VectorField<dim>  &velocity,
+ const Entities::FE_ScalarField<dim>  &temperature)
 {
-   // Defining the type to contain the vorticity during assembly
-  using CurlType = typename FEValuesViews::Vector< dim >::curl_type;
-
-  // Initiate the average velocity and vorticity metrics
-  average_velocity_metric   = 0.0;
-  average_vorticity_metric  = 0.0;
-
-  // Quadrature formula
-  const QGauss<dim>   quadrature_formula(velocity.fe_degree() + 1);
-
-  // Finite element values
-  FEValues<dim> fe_values(velocity.get_finite_element(),
-                          quadrature_formula,
-                          update_values|
-                          update_gradients|
-                          update_JxW_values);
-
-  // Number of quadrature points
-  const unsigned int n_q_points = quadrature_formula.size();
+  // The walls and the cavity are straight. Hence, a linear mapping
+  // suffices.
+  IntegralDiagnostics<dim> diagnostics(StaticMappingQ1<dim>::mapping);
+
+  const unsigned int velocity_index =
+    diagnostics.add_field(velocity, update_values|update_gradients);
+  const unsigned int temperature_index =
+    diagnostics.add_field(temperature, update_gradients);
+
+  // Integrals of the squared velocity and vorticity
+  const unsigned int global_integrals =
+    diagnostics.add_volume_integral(
+      2,
+      [velocity_index](const auto &data, double *integrals)
+      {
+        for (unsigned int q = 0; q < data.n_quadrature_points(); ++q)
+        {
+          const Vector<double>              &v  = data.values[velocity_index][q];
+          const std::vector<Tensor<1,dim>>  &dv = data.gradients[velocity_index][q];
+
+          double velocity_squared = 0.0;
+          for (unsigned int d = 0; d < dim; ++d)
+            velocity_squared += v[d] * v[d];
+
+          double vorticity_squared = 0.0;
+          if (dim == 2)
+            vorticity_squared = (dv[1][0] - dv[0][1]) * (dv[1][0] - dv[0][1]);
+          else
+            for (unsigned int d = 0; d < dim; ++d)
+            {
+              const unsigned int i = (d + 1) % dim;
+              const unsigned int j = (d + 2) % dim;
+
+              vorticity_squared += (dv[j][i] - dv[i][j]) * (dv[j][i] - dv[i][j]);
+            }
+
+          integrals[0] += velocity_squared * data.JxW[q];
+          integrals[1] += vorticity_squared * data.JxW[q];
+        }
+      });
 
-  // Vectors to stores the temperature gradients and normal vectors
-  // at the quadrature points
-  std::vector<Tensor<1, dim>> velocity_values(n_q_points);
-  std::vector<CurlType> vorticity_values(n_q_points);
+  // Integrals of the normal heat flux through the left and right walls
+  const types::boundary_id left_wall_id = left_wall_boundary_id;
 
-  for (const auto &cell : velocity.get_dof_handler().active_cell_iterators())
-    if (cell->is_locally_owned())
-    {
-      // Initialize the finite element values
-      fe_values.reinit(cell);
+  const unsigned int wall_integrals =
+    diagnostics.add_boundary_integral(
+      {left_wall_boundary_id, right_wall_boundary_id},
+      2,
+      [temperature_index, left_wall_id](const auto &data, double *integrals)
+      {
+        double boundary_integral = 0.0;
 
-      // Define the vector extractor
-      const FEValuesExtractors::Vector  velocities(0);
+        for (unsigned int q = 0; q < data.n_quadrature_points(); ++q)
+          boundary_integral +=
+            data.gradients[temperature_index][q][0] * // grad T
+            data.normal_vectors[q] *                  // n
+            data.JxW[q];                              // da
 
-      // Get the velocity and vorticity values at each quadrature
-      // point
-      fe_values[velocities].get_function_values(velocity.solution,
-                                                velocity_values);
-      fe_values[velocities].get_function_curls(velocity.solution,
-                                               vorticity_values);
+        integrals[data.boundary_id == left_wall_id ? 0 : 1] += boundary_integral;
+      });
 
-      // Numerical integration (Loop over all quadrature points)
-      for (unsigned int q = 0; q < n_q_points; ++q)
-      {
-        average_velocity_metric +=
-          velocity_values[q] *  // v
-          velocity_values[q] *  // v
-          fe_values.JxW(q);     // dv
-        average_vorticity_metric +=
-          vorticity_values[q] * // curl v
-          vorticity_values[q] * // curl v
-          fe_values.JxW(q);     // dv
-      }
-    }
+  diagnostics.evaluate();
 
-  // Gather the values of each processor
-  const Triangulation<dim>  &tria = velocity.get_triangulation();
-  const parallel::TriangulationBase<dim> *tria_ptr =
-      dynamic_cast<const parallel::TriangulationBase<dim> *>(&tria);
-  if (tria_ptr != nullptr)
-  {
-    average_velocity_metric = Utilities::MPI::sum(average_velocity_metric,
-                                                  tria_ptr->get_communicator());
-    average_vorticity_metric = Utilities::MPI::sum(average_vorticity_metric,
-                                                   tria_ptr->get_communicator());
-  }
+  // Compute and store the Nusselt numbers of the walls
+  nusselt_numbers = std::make_pair(diagnostics.get_integral(wall_integrals)/height,
+                                   diagnostics.get_integral(wall_integrals + 1)/height);
 
   // Compute the global averages
-  average_velocity_metric   = std::sqrt(average_velocity_metric/(2.0 * area));
-  average_vorticity_metric  = std::sqrt(average_vorticity_metric/(2.0 * area));
+  average_velocity_metric   =
+    std::sqrt(diagnostics.get_integral(global_integrals)/(2.0 * area));
+  average_vorticity_metric  =
+    std::sqrt(diagnostics.get_integral(global_integrals + 1)/(2.0 * area));
 }
 
 
@@ -571,7 +605,18 @@ void ChristensenBenchmark<dim>::update
   find_sampling_point(velocity, mapping);
   compute_point_data(velocity, temperature, mapping);
 
-  // Update column's values
+  // Stream the values to the file or update column's values
+  if (time_series_writer)
+  {
+    time_series_writer->add_row({time,
+                                 static_cast<double>(step_number),
+                                 mean_kinetic_energy_density,
+                                 sampling_longitude,
+                                 temperature_at_sampling_point,
+                                 azimuthal_velocity_at_sampling_point});
+    return;
+  }
+
   data.add_value("time", time);
   data.add_value("step", step_number);
   data.add_value("mean kinetic energy", mean_kinetic_energy_density);
@@ -582,6 +627,41 @@ void ChristensenBenchmark<dim>::update
 
 
 
+template <int dim>
+void ChristensenBenchmark<dim>::stream_to_file
+(const std::string                           &file_name,
+ const RunTimeParameters::BenchmarkDataFormat format,
+ const unsigned int                           flush_frequency,
+ const MPI_Comm                               mpi_communicator,
+ const unsigned int                           resume_step)
+{
+  time_series_writer =
+    std::make_unique<TimeSeriesWriter>(
+      file_name,
+      std::vector<std::string>{
+       "time",
+       "step",
+       "mean kinetic energy",
+       "longitude",
+       "temperature",
+       "azimuthal velocity"},
+      format,
+      flush_frequency,
+      mpi_communicator,
+      resume_step);
+}
+
+
+
+template <int dim>
+void ChristensenBenchmark<dim>::flush() const
+{
+  if (time_series_writer)
+    time_series_writer->flush();
+}
+
+
+
 template <int dim>
 void ChristensenBenchmark<dim>::write_text(std::ostream &file) const
 {
@@ -590,6 +670,17 @@ void ChristensenBenchmark<dim>::write_text(std::ostream &file) const
 
 
 
+template <int dim>
+template <typename Archive>
+void ChristensenBenchmark<dim>::serialize(Archive &ar, const unsigned int /* version */)
+{
+  ar & sampling_longitude;
+  ar & sampling_point;
+  ar & data;
+}
+
+
+
 template<typename Stream, int dim>
 Stream& operator<<(Stream &stream, const ChristensenBenchmark<dim> &christensen)
 {
@@ -634,63 +725,37 @@ void ChristensenBenchmark<dim>::compute_global_data
 (const Entities::FE_VectorField<dim> &velocity,
  const Mapping<dim>                  &mapping)
 {
-  // Reset the mean energy densities and the volume
-  mean_kinetic_energy_density   = 0.0;
-  discrete_volume               = 0.0;
-
-  // Quadrature formula
-  const QGauss<dim>   quadrature_formula(velocity.fe_degree() + 1);
-
-  // Finite element values
-  FEValues<dim> fe_values(mapping,
-                          velocity.get_finite_element(),
-                          quadrature_formula,
-                          update_values|update_JxW_values);
+  IntegralDiagnostics<dim> diagnostics(mapping);
 
-  // Number of quadrature points
-  const unsigned int n_q_points = quadrature_formula.size();
+  const unsigned int velocity_index =
+    diagnostics.add_field(velocity, update_values);
 
-  // Vectors to stores the temperature gradients and normal vectors
-  // at the quadrature points
-  std::vector<Tensor<1, dim>> velocity_values(n_q_points);
+  // Integrals of the squared velocity and of the volume
+  const unsigned int global_integrals =
+    diagnostics.add_volume_integral(
+      2,
+      [velocity_index](const auto &data, double *integrals)
+      {
+        for (unsigned int q = 0; q < data.n_quadrature_points(); ++q)
+        {
+          const Vector<double> &v = data.values[velocity_index][q];
 
-  // Define the vector extractor
-  const FEValuesExtractors::Vector  vector_extractor(0);
+          double velocity_squared = 0.0;
+          for (unsigned int d = 0; d < dim; ++d)
+            velocity_squared += v[d] * v[d];
 
-  // Integral value
-  double velocity_integral{0.0};
+          integrals[0] += velocity_squared * data.JxW[q];
+          integrals[1] += data.JxW[q];
+        }
+      });
 
-  for (const auto &cell : velocity.get_dof_handler().active_cell_iterators())
-    if (cell->is_locally_owned())
-    {
-      // Initialize the finite element values
-      fe_values.reinit(cell);
-      // Get the velocity values at each quadrature point
-      fe_values[vector_extractor].get_function_values(velocity.solution,
-                                                      velocity_values);
-      // Numerical integration (Loop over all quadrature points)
-      for (unsigned int q = 0; q < n_q_points; ++q)
-      {
-        velocity_integral += velocity_values[q] * velocity_values[q] *
-                             fe_values.JxW(q);
-        discrete_volume += fe_values.JxW(q);
-      }
-    }
+  diagnostics.evaluate();
 
-  // Gather the values of each processor
-  const Triangulation<dim>  &tria = velocity.get_triangulation();
-  const parallel::TriangulationBase<dim> *tria_ptr =
-      dynamic_cast<const parallel::TriangulationBase<dim> *>(&tria);
-  if (tria_ptr != nullptr)
-  {
-    velocity_integral = Utilities::MPI::sum(velocity_integral,
-                                            tria_ptr->get_communicator());
-    discrete_volume = Utilities::MPI::sum(discrete_volume,
-                                          tria_ptr->get_communicator());
-  }
+  discrete_volume = diagnostics.get_integral(global_integrals + 1);
 
   // Compute the mean values
-  mean_kinetic_energy_density = 0.5 * velocity_integral / discrete_volume;
+  mean_kinetic_energy_density =
+    0.5 * diagnostics.get_integral(global_integrals) / discrete_volume;
 }
 
 
@@ -703,358 +768,298 @@ void ChristensenBenchmark<dim>::find_sampling_point
 (const Entities::FE_VectorField<dim> &velocity,
  const Mapping<dim>                  &mapping)
 {
-  // Set the last known value of the sample point's longitude as initial guess
-  if (sampling_longitude > 0.)
+  const Triangulation<dim>  &triangulation = velocity.get_triangulation();
+  const DoFHandler<dim>     &dof_handler   = velocity.get_dof_handler();
+  const FiniteElement<dim>  &fe            = velocity.get_finite_element();
+
+  AssertThrow(fe.is_primitive(),
+              ExcMessage("The search of the sampling point only supports "
+                         "primitive finite elements."));
+
+  // The sampling circle lies in the plane z = r cos(theta) and its
+  // radius is given by r sin(theta)
+  const double circle_radius = sampling_radius * std::sin(sampling_colatitude);
+  const double circle_height = sampling_radius * std::cos(sampling_colatitude);
+
+  auto point_on_circle = [&](const double longitude)
+  {
+    Point<dim> point;
+    point[0] = circle_radius * std::cos(longitude);
+    point[1] = circle_radius * std::sin(longitude);
+    if constexpr(dim == 3)
+      point[2] = circle_height;
+    return (point);
+  };
+
+  // A cell is considered if the circle passes through the bounding box of
+  // its vertices in cylindrical coordinates enlarged by a margin which
+  // accounts for curved faces
+  auto intersects_circle = [&](const auto &cell)
   {
-    // Compute the derivative of the radial velocity w.r.t. the
-    // longitude. This value is needed for the boost's
-    // bracket_and_solve_root method.
-    const double gradient_at_trial_point =
-        compute_azimuthal_gradient_of_radial_velocity(sampling_radius,
-                                                      sampling_longitude,
-                                                      sampling_colatitude,
-                                                      velocity,
-                                                      mapping);
-
-    // Compute a root of the radial velocity w.r.t. the longitude
-    const double trial_longitude =
-        compute_zero_of_radial_velocity(sampling_longitude,
-                                        gradient_at_trial_point > 0.,
-                                        1e-6,
-                                        50,
-                                        velocity,
-                                        mapping);
-
-    // Compute the derivative of the radial velocity w.r.t. the longitude at
-    // the found root.
-    const double gradient_at_zero =
-        compute_azimuthal_gradient_of_radial_velocity(sampling_radius,
-                                                      trial_longitude,
-                                                      sampling_colatitude,
-                                                      velocity,
-                                                      mapping);
-
-    if(gradient_at_zero > 0. &&
-       trial_longitude >= 0. &&
-       trial_longitude <= 2. * numbers::PI)
+    const double margin = 0.25 * cell->diameter();
+
+    double min_radius = std::numeric_limits<double>::max();
+    double max_radius = 0.;
+    double min_height = std::numeric_limits<double>::max();
+    double max_height = std::numeric_limits<double>::lowest();
+
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
     {
-        sampling_longitude = trial_longitude;
+      const Point<dim> &vertex = cell->vertex(v);
+      const double radius = std::sqrt(vertex[0] * vertex[0] +
+                                      vertex[1] * vertex[1]);
+
+      min_radius = std::min(min_radius, radius);
+      max_radius = std::max(max_radius, radius);
+      min_height = std::min(min_height, vertex[dim-1]);
+      max_height = std::max(max_height, vertex[dim-1]);
+    }
 
-        // Compute the position vector of the sample point in cartesian
-        // coordinates.
-        std::array<double, dim> spherical_coordinates;
+    bool intersects = (min_radius - margin <= circle_radius &&
+                       circle_radius <= max_radius + margin);
+    if constexpr(dim == 3)
+      intersects = intersects && (min_height - margin <= circle_height &&
+                                  circle_height <= max_height + margin);
 
-        if constexpr(dim == 2)
-          spherical_coordinates = {sampling_radius,
-                                  sampling_longitude};
-        else if constexpr(dim == 3)
-          spherical_coordinates = {sampling_radius,
-                                  sampling_longitude,
-                                  sampling_colatitude};
+    return (intersects);
+  };
 
-        sampling_point = GeometricUtilities::Coordinates::from_spherical(spherical_coordinates);
+  // The range of longitudes of the vertices relative to the first one
+  // enlarged by the same margin. The range may extend below zero or
+  // beyond 2 pi.
+  auto longitude_range = [&](const auto &cell)
+  {
+    const double reference = std::atan2(cell->vertex(0)[1],
+                                        cell->vertex(0)[0]);
+    double lower = 0.;
+    double upper = 0.;
 
-        return;
+    for (unsigned int v = 1; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+    {
+      double difference = std::atan2(cell->vertex(v)[1],
+                                     cell->vertex(v)[0]) - reference;
+      if (difference > numbers::PI)
+        difference -= 2. * numbers::PI;
+      else if (difference < -numbers::PI)
+        difference += 2. * numbers::PI;
+
+      lower = std::min(lower, difference);
+      upper = std::max(upper, difference);
     }
-  }
 
-  // The initial guess was not computed or wasn't good enough. A set of
-  // trial points well be used to find the sample point.
-  const unsigned int n_trial_points = 16;
+    const double margin = 0.25 * cell->diameter() / circle_radius;
 
-  std::vector<double> trial_longitudes;
+    return (std::make_pair(reference + lower - margin,
+                           reference + upper + margin));
+  };
 
-  trial_longitudes.push_back(1e-3 * 2. * numbers::PI / static_cast<double>(n_trial_points));
+  // Evaluates the radial velocity at a point of the circle if the point
+  // lies inside the given cell. The cell only has to be locally owned or a
+  // ghost cell, i.e., no communication is involved.
+  std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
 
-  for (unsigned int i=1; i<n_trial_points; ++i)
-      trial_longitudes.push_back(i * 2. * numbers::PI / static_cast<double>(n_trial_points));
+  auto radial_velocity_in_cell =
+    [&](const typename DoFHandler<dim>::active_cell_iterator &cell,
+        const double                                          longitude,
+        double                                               &radial_velocity)
+  {
+    const Point<dim> point = point_on_circle(longitude);
 
-  bool            point_found = false;
+    Point<dim> unit_point;
+    try
+    {
+      unit_point = mapping.transform_real_to_unit_cell(cell, point);
+    }
+    catch (const typename Mapping<dim>::ExcTransformationFailed &)
+    {
+      return (false);
+    }
 
-  unsigned int    cnt = 0;
+    if (!GeometryInfo<dim>::is_inside_unit_cell(unit_point, 1e-10))
+      return (false);
 
-  while(cnt < n_trial_points && point_found == false)
-  {
-      const double gradient_at_trial_point =
-          compute_azimuthal_gradient_of_radial_velocity(sampling_radius,
-                                                        trial_longitudes[cnt],
-                                                        sampling_colatitude,
-                                                        velocity,
-                                                        mapping);
-
-      try
-      {
-          const double tentative_longitude =
-              compute_zero_of_radial_velocity(trial_longitudes[cnt],
-                                              gradient_at_trial_point > 0.,
-                                              1e-6,
-                                              50,
-                                              velocity,
-                                              mapping);
-
-          const double gradient_at_zero =
-              compute_azimuthal_gradient_of_radial_velocity(sampling_radius,
-                                                            tentative_longitude,
-                                                            sampling_colatitude,
-                                                            velocity,
-                                                            mapping);
-
-          if (gradient_at_zero > 0.)
-          {
-              point_found             = true;
-              sampling_longitude  = tentative_longitude;
-          }
-          ++cnt;
-      }
-      catch(ExcBoostNoConvergence &exc)
-      {
-          ++cnt;
-          continue;
-      }
-      catch (std::exception &exc)
-      {
-          std::cerr << std::endl << std::endl
-                    << "----------------------------------------------------"
-                    << std::endl;
-          std::cerr << "Exception on processing: " << std::endl
-                    << exc.what() << std::endl
-                    << "Aborting!" << std::endl
-                    << "----------------------------------------------------"
-                    << std::endl;
-          std::abort();
-      }
-      catch (...)
-      {
-          std::cerr << std::endl << std::endl
-                    << "----------------------------------------------------"
-                    << std::endl;
-          std::cerr << "Unknown exception!" << std::endl
-                    << "Aborting!" << std::endl
-                    << "----------------------------------------------------"
-                    << std::endl;
-          std::abort();
-      }
-  }
+    cell->get_dof_indices(dof_indices);
 
-  if (!point_found)
-  {
-      std::cerr << std::endl << std::endl
-                << "----------------------------------------------------"
-                << std::endl;
-      std::cerr << "Exception on find_sample_point!" << std::endl
-                << "The algorithm did not find a benchmark point using "
-                << n_trial_points << " trial points in [0,2*pi)."
-                << std::endl
-                << "Aborting!" << std::endl
-                << "----------------------------------------------------"
-                << std::endl;
-      std::abort();
-  }
-  if (sampling_longitude < 0. || sampling_longitude > 2. * numbers::PI)
-  {
-      std::cerr << std::endl << std::endl
-                << "----------------------------------------------------"
-                << std::endl;
-      std::cerr << "Exception on find_sample_point!" << std::endl
-                << "The algorithm did not find a point in [0,2*pi)."
-                << std::endl
-                << "Aborting!" << std::endl
-                << "----------------------------------------------------"
-                << std::endl;
-      std::abort();
-  }
+    Tensor<1,dim> local_velocity;
+    for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+      local_velocity[fe.system_to_component_index(j).first] +=
+        velocity.solution(dof_indices[j]) * fe.shape_value(j, unit_point);
 
-  // Compute the position vector of the sample point in cartesian
-  // coordinates.
-  std::array<double, dim> spherical_coordinates;
+    radial_velocity = local_velocity * point / point.norm();
 
-  if constexpr(dim == 2)
-    spherical_coordinates = {sampling_radius,
-                             sampling_longitude};
-  else if constexpr(dim == 3)
-    spherical_coordinates = {sampling_radius,
-                             sampling_longitude,
-                             sampling_colatitude};
+    return (true);
+  };
 
-  sampling_point = GeometricUtilities::Coordinates::from_spherical(spherical_coordinates);
-}
+  // The circle is sampled at equidistant longitudes whose spacing is
+  // smaller than the arc length of the finest cells divided by the
+  // polynomial degree. As the coarse mesh is known to all processes and
+  // the number of global levels is a global quantity, all processes use
+  // the same samples without communicating.
+  unsigned int n_coarse_cells = 0;
+  for (const auto &cell: triangulation.cell_iterators_on_level(0))
+    if (intersects_circle(cell))
+      ++n_coarse_cells;
+
+  const unsigned int n_samples =
+    std::max(n_coarse_cells, 4u) * (fe.degree + 1) *
+    (1u << (triangulation.n_global_levels() - 1));
+
+  const double spacing = 2. * numbers::PI / n_samples;
+
+  // Evaluate the radial velocity at the samples inside the locally owned
+  // and the ghost cells. Samples at the interface of two cells are
+  // preferably assigned to a locally owned one.
+  struct Sample
+  {
+    typename DoFHandler<dim>::active_cell_iterator  cell;
 
+    double                                          radial_velocity;
 
+    bool                                            found = false;
+  };
 
-template <int dim>
-double ChristensenBenchmark<dim>::compute_radial_velocity
-(const double radius,
- const double azimuthal_angle,
- const double polar_angle,
- const Entities::FE_VectorField<dim> &velocity,
- const Mapping<dim>                  &mapping) const
-{
-  using namespace  GeometryExceptions;
-
-  AssertThrow(radius > 0.,
-              ExcNegativeRadius(radius));
-  AssertThrow((polar_angle >= 0. && polar_angle <= numbers::PI),
-              ExcPolarAngleRange(polar_angle));
-
-  // The boost's bracket_and_solve_root may produce test for values
-  // outside the admissible range of the dealii's from_spherical method.
-  // To this end, a temporary angle is introduced and shifted to its
-  // admissible value.
-  double tmp_azimuthal_angle = azimuthal_angle;
-
-  if (azimuthal_angle < 0.)
-      tmp_azimuthal_angle += 2. * numbers::PI;
-  else if (azimuthal_angle > 2. * numbers::PI)
-      tmp_azimuthal_angle -= 2. * numbers::PI;
-
-  // Define the position vector in cartesian coordinates from the
-  // spherical ones.
-  std::array<double, dim> spherical_coordinates;
+  std::vector<Sample> samples(n_samples);
 
-  if constexpr(dim == 2)
+  for (const auto &cell: dof_handler.active_cell_iterators())
   {
-    (void)polar_angle;
-    spherical_coordinates = {radius, tmp_azimuthal_angle};
-  }
-  else if constexpr(dim == 3)
-    spherical_coordinates = {radius, tmp_azimuthal_angle, polar_angle};
+    if (cell->is_artificial() || !intersects_circle(cell))
+      continue;
 
-  const Point<dim> point = GeometricUtilities::Coordinates::from_spherical(spherical_coordinates);
+    const std::pair<double, double> range = longitude_range(cell);
 
-  // Compute the radial velocity at the given spherical coordinates.
-  const Tensor<1,dim> local_velocity = velocity.point_value(point, mapping);
+    for (int k = static_cast<int>(std::ceil(range.first / spacing));
+         k <= static_cast<int>(std::floor(range.second / spacing));
+         ++k)
+    {
+      const unsigned int i = (k % static_cast<int>(n_samples) + n_samples) % n_samples;
 
-  return local_velocity * point / radius;
-}
+      if (samples[i].found &&
+          (samples[i].cell->is_locally_owned() || !cell->is_locally_owned()))
+        continue;
 
+      double radial_velocity;
+      if (radial_velocity_in_cell(cell, i * spacing, radial_velocity))
+      {
+        samples[i].cell             = cell;
+        samples[i].radial_velocity  = radial_velocity;
+        samples[i].found            = true;
+      }
+    }
+  }
 
+  // A root with a positive azimuthal derivative lies between two
+  // consecutive samples where the radial velocity changes from a negative
+  // to a non-negative value. The interval is processed by the owner of the
+  // cell of its first sample. Since the spacing is smaller than the cells,
+  // the second sample lies in the same cell or in a neighboring one, i.e.,
+  // in a locally owned or a ghost cell.
+  //
+  // Each process proposes the root closest to the last sampling longitude
+  // or, if there is none, the one with the smallest longitude.
+  double proposal[2] = {std::numeric_limits<double>::max(), 0.};
+
+  for (unsigned int i = 0; i < n_samples; ++i)
+  {
+    const Sample &first   = samples[i];
+    const Sample &second  = samples[(i + 1) % n_samples];
 
-template<int dim>
-double ChristensenBenchmark<dim>::compute_zero_of_radial_velocity
-(const double         phi_guess,
- const bool           local_slope,
- const double         tol,
- const unsigned int   max_iter,
- const Entities::FE_VectorField<dim> &velocity,
- const Mapping<dim>                  &mapping) const
-{
-  using namespace boost::math::tools;
-  using namespace GeometryExceptions;
+    if (!first.found || !second.found || !first.cell->is_locally_owned())
+      continue;
 
-  Assert(tol > 0.0, ExcLowerRangeType<double>(tol, 0));
-  Assert(max_iter > 0, ExcLowerRange(max_iter, 0));
+    if (!(first.radial_velocity < 0. && second.radial_velocity >= 0.))
+      continue;
 
-  Assert((phi_guess < 0.?
-         (phi_guess >= -numbers::PI && phi_guess <= numbers::PI):
-         (phi_guess >= 0. && phi_guess <= 2. * numbers::PI)),
-         ExcAzimuthalAngleRange(phi_guess));
+    const double lower_longitude = i * spacing;
+    const double upper_longitude = (i + 1) * spacing;
 
-  auto boost_max_iter = boost::numeric_cast<boost::uintmax_t>(max_iter);
+    // The root is refined with the cells of both samples. Points which lie
+    // in neither cell are linearly interpolated.
+    auto function = [&](const double longitude)
+    {
+      double radial_velocity;
 
-  const double radius = sampling_radius;
-  const double theta  = sampling_colatitude;
+      if (radial_velocity_in_cell(first.cell, longitude, radial_velocity) ||
+          radial_velocity_in_cell(second.cell, longitude, radial_velocity))
+        return (radial_velocity);
 
-  // Declare lambda functions for the boost's
-  // root bracket_and_solve_root method
-  auto function = [this, radius, theta, &velocity, &mapping](const double &x)
-  {
-      return this->compute_radial_velocity(radius, x, theta, velocity, mapping);
-  };
-  auto tolerance_criterion = [tol, &function](const double &a, const double &b)
-  {
-      return std::abs(function(a)) <= tol && std::abs(function(b)) <= tol;
-  };
+      return (first.radial_velocity +
+              (second.radial_velocity - first.radial_velocity) *
+              (longitude - lower_longitude) / spacing);
+    };
 
-  // @attention Why initialize phi to this value?
-  double phi = -2. * numbers::PI;
+    boost::uintmax_t max_iterations = 50;
 
-  // Find a root of the radial velocity w.r.t. the longitude
-  try
-  {
-      auto phi_interval
-      = bracket_and_solve_root(function,
-                               phi_guess,
-                               1.05,
-                               local_slope,
-                               tolerance_criterion,
-                               boost_max_iter);
-      phi = 0.5 * (phi_interval.first + phi_interval.second);
-  }
-  catch (std::exception &exc)
-  {
-      throw ExcBoostNoConvergence();
-  }
-  catch (...)
-  {
-      std::cerr << std::endl << std::endl
-                << "----------------------------------------------------"
-                << std::endl;
-      std::cerr << "Unknown exception!" << std::endl
-                << "Aborting!" << std::endl
-                << "----------------------------------------------------"
-                << std::endl;
-      std::abort();
+    const std::pair<double, double> interval =
+      boost::math::tools::toms748_solve(function,
+                                        lower_longitude,
+                                        upper_longitude,
+                                        first.radial_velocity,
+                                        second.radial_velocity,
+                                        boost::math::tools::eps_tolerance<double>(40),
+                                        max_iterations);
+
+    const double root =
+      std::fmod(0.5 * (interval.first + interval.second), 2. * numbers::PI);
+
+    double key = root;
+    if (sampling_longitude > 0.)
+    {
+      key = std::abs(root - sampling_longitude);
+      key = std::min(key, 2. * numbers::PI - key);
+    }
+
+    if (key < proposal[0])
+    {
+      proposal[0] = key;
+      proposal[1] = root;
+    }
   }
 
-  // The found root may be outside the internal allowed range.
-  // The following if scope corrects it by shifting the value inside
-  // the range.
-  if (phi < 0.)
-      phi += 2. * numbers::PI;
-  else if (phi > 2. * numbers::PI)
-      phi -= 2. * numbers::PI;
+  // A single reduction selects the proposal with the smallest key
+  const MPI_Comm mpi_communicator = triangulation.get_communicator();
 
-  return (phi);
-}
+  MPI_Datatype  proposal_type;
+  MPI_Op        minimum_key;
 
+  int ierr = MPI_Type_contiguous(2, MPI_DOUBLE, &proposal_type);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Type_commit(&proposal_type);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Op_create(&minimum_proposal, 1, &minimum_key);
+  AssertThrowMPI(ierr);
 
+  ierr = MPI_Allreduce(MPI_IN_PLACE,
+                       proposal,
+                       1,
+                       proposal_type,
+                       minimum_key,
+                       mpi_communicator);
+  AssertThrowMPI(ierr);
 
-template <int dim>
-double ChristensenBenchmark<dim>::compute_azimuthal_gradient_of_radial_velocity
-(const double radius,
- const double azimuthal_angle,
- const double polar_angle,
- const Entities::FE_VectorField<dim> &velocity,
- const Mapping<dim>                  &mapping) const
-{
-  AssertThrow(radius > 0.,
-              GeometryExceptions::ExcNegativeRadius(radius));
-  AssertThrow((polar_angle >= 0. && polar_angle <= numbers::PI),
-              GeometryExceptions::ExcPolarAngleRange(polar_angle));
-  AssertThrow((azimuthal_angle >= 0. && azimuthal_angle < 2. * numbers::PI),
-              GeometryExceptions::ExcAzimuthalAngleRange(azimuthal_angle));
-
-  // Define the local basis vectors and the spherical coordinates
-  Tensor<1,dim> local_radial_basis_vector;
-  local_radial_basis_vector[0] = sin(polar_angle) * cos(azimuthal_angle);
-  local_radial_basis_vector[1] = sin(polar_angle) * sin(azimuthal_angle);
+  ierr = MPI_Op_free(&minimum_key);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Type_free(&proposal_type);
+  AssertThrowMPI(ierr);
 
-  Tensor<1,dim> local_azimuthal_basis_vector;
-  local_azimuthal_basis_vector[0] = -sin(azimuthal_angle);
-  local_azimuthal_basis_vector[1] = cos(azimuthal_angle);
+  AssertThrow(proposal[0] < std::numeric_limits<double>::max(),
+              ExcMessage("The radial velocity has no root with a positive "
+                         "azimuthal derivative on the sampling circle."));
+
+  sampling_longitude = proposal[1];
 
+  // Compute the position vector of the sample point in cartesian
+  // coordinates.
   std::array<double, dim> spherical_coordinates;
 
   if constexpr(dim == 2)
-    spherical_coordinates = {radius, azimuthal_angle};
+    spherical_coordinates = {sampling_radius,
+                             sampling_longitude};
   else if constexpr(dim == 3)
-  {
-    spherical_coordinates = {radius, azimuthal_angle, polar_angle};
-
-    local_radial_basis_vector[2] = cos(polar_angle);
-  }
-
-  // Compute the derivative of the radial velocity w.r.t. the
-  // longitude at the given spherical coordinates.
-  const Point<dim> point = GeometricUtilities::Coordinates::from_spherical(spherical_coordinates);
-
-  const Tensor<1,dim> local_velocity          = velocity.point_value(point, mapping);
-  const Tensor<2,dim> local_velocity_gradient = velocity.point_gradient(point, mapping);
+    spherical_coordinates = {sampling_radius,
+                             sampling_longitude,
+                             sampling_colatitude};
 
-  return (sin(polar_angle) *
-          (radius * local_radial_basis_vector * local_velocity_gradient * local_azimuthal_basis_vector
-           +
-           local_velocity * local_azimuthal_basis_vector));
+  sampling_point = GeometricUtilities::Coordinates::from_spherical(spherical_coordinates);
 }
 
 
@@ -1106,3 +1111,22 @@ template dealii::ConditionalOStream & RMHD::BenchmarkData::operator<<
 (dealii::ConditionalOStream &, const RMHD::BenchmarkData::ChristensenBenchmark<2> &);
 template dealii::ConditionalOStream & RMHD::BenchmarkData::operator<<
 (dealii::ConditionalOStream &, const RMHD::BenchmarkData::ChristensenBenchmark<3> &);
+
+template void RMHD::BenchmarkData::DFGBechmarkRequests<2>::serialize
+(boost::archive::binary_oarchive &, const unsigned int);
+template void RMHD::BenchmarkData::DFGBechmarkRequests<2>::serialize
+(boost::archive::binary_iarchive &, const unsigned int);
+
+template void RMHD::BenchmarkData::MIT<2>::serialize
+(boost::archive::binary_oarchive &, const unsigned int);
+template void RMHD::BenchmarkData::MIT<2>::serialize
+(boost::archive::binary_iarchive &, const unsigned int);
+
+template void RMHD::BenchmarkData::ChristensenBenchmark<2>::serialize
+(boost::archive::binary_oarchive &, const unsigned int);
+template void RMHD::BenchmarkData::ChristensenBenchmark<2>::serialize
+(boost::archive::binary_iarchive &, const unsigned int);
+template void RMHD::BenchmarkData::ChristensenBenchmark<3>::serialize
+(boost::archive::binary_oarchive &, const unsigned int);
+template void RMHD::BenchmarkData::ChristensenBenchmark<3>::serialize
+(boost::archive::binary_iarchive &, const unsigned int);
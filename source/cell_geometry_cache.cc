@@ -0,0 +1,387 @@
+#include <rotatingMHD/cell_geometry_cache.h>
+#include <rotatingMHD/global.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/grid/filtered_iterator.h>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+template <int dim>
+CellGeometryCache<dim>::CellGeometryCache
+(const Mapping<dim>      &mapping,
+ const DoFHandler<dim>   &dof_handler,
+ const Quadrature<dim>   &quadrature,
+ const UpdateFlags        update_flags,
+ const std::size_t        memory_budget)
+:
+mapping(&mapping),
+fe(&dof_handler.get_fe()),
+quadrature(quadrature),
+update_flags(update_flags),
+n_q_points(quadrature.size()),
+n_dofs_per_cell(dof_handler.get_fe().dofs_per_cell),
+shape_components(n_dofs_per_cell),
+shape_values(n_q_points * n_dofs_per_cell),
+reference_shape_gradients(n_q_points * n_dofs_per_cell),
+cell_positions(dof_handler.get_triangulation().n_active_cells(),
+               numbers::invalid_unsigned_int)
+{
+  AssertThrow(fe->is_primitive(),
+              ExcMessage("The cell geometry cache only supports primitive "
+                         "finite elements."));
+
+  // The values and the reference gradients of the shape functions are
+  // independent of the cell
+  for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+    shape_components[i] = fe->system_to_component_index(i).first;
+
+  for (unsigned int q = 0; q < n_q_points; ++q)
+    for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+    {
+      shape_values[q * n_dofs_per_cell + i] =
+        fe->shape_value_component(i, quadrature.point(q), shape_components[i]);
+      reference_shape_gradients[q * n_dofs_per_cell + i] =
+        fe->shape_grad_component(i, quadrature.point(q), shape_components[i]);
+    }
+
+  // Number the locally owned cells
+  using CellFilter =
+    FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>;
+
+  const CellFilter begin_cell(IteratorFilters::LocallyOwnedCell(),
+                              dof_handler.begin_active());
+  const CellFilter end_cell(IteratorFilters::LocallyOwnedCell(),
+                            dof_handler.end());
+
+  unsigned int n_cells = 0;
+  for (auto cell = begin_cell; cell != end_cell; ++cell)
+    cell_positions[cell->active_cell_index()] = n_cells++;
+
+  // The shape gradients are only stored if they were requested and the
+  // whole cache fits into the memory budget. Otherwise, the cache is
+  // limited to the geometry.
+  const std::size_t n_entries = std::size_t(n_cells) * n_q_points;
+
+  const std::size_t geometry_memory =
+    n_entries * (sizeof(double) + sizeof(Tensor<2,dim>));
+
+  const std::size_t gradient_memory =
+    n_entries * n_dofs_per_cell * sizeof(Tensor<1,dim>);
+
+  const bool store_shape_gradients =
+    (update_flags & update_gradients) &&
+    (geometry_memory + gradient_memory <= memory_budget);
+
+  JxW_values.resize(n_entries);
+  inverse_jacobians.resize(n_entries);
+  if (store_shape_gradients)
+    shape_gradients.resize(n_entries * n_dofs_per_cell);
+
+  UpdateFlags fe_values_update_flags = update_JxW_values|
+                                       update_inverse_jacobians;
+  if (store_shape_gradients)
+    fe_values_update_flags |= update_gradients;
+
+  FEValues<dim> fe_values(mapping,
+                          *fe,
+                          quadrature,
+                          fe_values_update_flags);
+
+  for (auto cell = begin_cell; cell != end_cell; ++cell)
+  {
+    fe_values.reinit(cell);
+
+    const std::size_t offset =
+      std::size_t(cell_positions[cell->active_cell_index()]) * n_q_points;
+
+    for (unsigned int q = 0; q < n_q_points; ++q)
+    {
+      JxW_values[offset + q] = fe_values.JxW(q);
+      inverse_jacobians[offset + q] =
+        static_cast<Tensor<2,dim>>(fe_values.inverse_jacobian(q));
+
+      if (store_shape_gradients)
+        for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+          shape_gradients[(offset + q) * n_dofs_per_cell + i] =
+            fe_values.shape_grad_component(i, q, shape_components[i]);
+    }
+  }
+}
+
+
+
+template <int dim>
+bool CellGeometryCache<dim>::matches
+(const Mapping<dim>     &other_mapping,
+ const Quadrature<dim>  &other_quadrature,
+ const UpdateFlags       other_update_flags) const
+{
+  return (&other_mapping == mapping &&
+          other_update_flags == update_flags &&
+          other_quadrature == quadrature);
+}
+
+
+
+template <int dim>
+std::size_t CellGeometryCache<dim>::memory_consumption() const
+{
+  return (sizeof(*this) +
+          MemoryConsumption::memory_consumption(quadrature) +
+          MemoryConsumption::memory_consumption(shape_components) +
+          MemoryConsumption::memory_consumption(shape_values) +
+          MemoryConsumption::memory_consumption(reference_shape_gradients) +
+          MemoryConsumption::memory_consumption(cell_positions) +
+          MemoryConsumption::memory_consumption(JxW_values) +
+          MemoryConsumption::memory_consumption(inverse_jacobians) +
+          MemoryConsumption::memory_consumption(shape_gradients));
+}
+
+
+
+template <int dim>
+CachedFEValues<dim>::CachedFEValues(const CellGeometryCache<dim> &cache)
+:
+cache(&cache),
+q_offset(0),
+current_shape_gradients(nullptr),
+cell_shape_gradients(cache.stores_shape_gradients()
+                     ? 0
+                     : cache.n_q_points * cache.n_dofs_per_cell),
+local_dof_values(cache.n_dofs_per_cell)
+{}
+
+
+
+template <int dim>
+CachedFEValues<dim>::CachedFEValues(const CachedFEValues<dim> &data)
+:
+CachedFEValues<dim>(*data.cache)
+{}
+
+
+
+template <int dim>
+void CachedFEValues<dim>::reinit
+(const typename DoFHandler<dim>::active_cell_iterator &new_cell)
+{
+  Assert(new_cell->is_locally_owned(),
+         ExcMessage("The cell is not locally owned."));
+  AssertIndexRange(new_cell->active_cell_index(), cache->cell_positions.size());
+
+  const unsigned int position =
+    cache->cell_positions[new_cell->active_cell_index()];
+
+  Assert(position != numbers::invalid_unsigned_int,
+         ExcMessage("The cell is not contained in the cache. Is the cache "
+                    "outdated?"));
+
+  cell = new_cell;
+  q_offset = position * cache->n_q_points;
+
+  const unsigned int n_dofs = cache->n_dofs_per_cell;
+
+  if (cache->stores_shape_gradients())
+    current_shape_gradients =
+      &cache->shape_gradients[std::size_t(q_offset) * n_dofs];
+  else
+  {
+    // The gradients are transformed covariantly, i.e.,
+    // grad(phi) = J^{-T} grad_ref(phi)
+    for (unsigned int q = 0; q < cache->n_q_points; ++q)
+    {
+      const Tensor<2,dim> &inverse_jacobian =
+        cache->inverse_jacobians[q_offset + q];
+
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        cell_shape_gradients[q * n_dofs + i] =
+          cache->reference_shape_gradients[q * n_dofs + i] *
+          inverse_jacobian;
+    }
+
+    current_shape_gradients = cell_shape_gradients.data();
+  }
+}
+
+
+
+template <int dim>
+template <typename VectorType>
+void CachedFEValues<dim>::get_function_values
+(const VectorType    &vector,
+ std::vector<double> &values)
+{
+  AssertDimension(values.size(), cache->n_q_points);
+
+  cell->get_dof_values(vector, local_dof_values);
+
+  for (unsigned int q = 0; q < cache->n_q_points; ++q)
+  {
+    values[q] = 0.0;
+    for (unsigned int i = 0; i < cache->n_dofs_per_cell; ++i)
+      values[q] += local_dof_values[i] * shape_value(i, q);
+  }
+}
+
+
+
+template <int dim>
+template <typename VectorType>
+void CachedFEValues<dim>::get_function_gradients
+(const VectorType            &vector,
+ std::vector<Tensor<1,dim>>  &gradients)
+{
+  AssertDimension(gradients.size(), cache->n_q_points);
+
+  cell->get_dof_values(vector, local_dof_values);
+
+  for (unsigned int q = 0; q < cache->n_q_points; ++q)
+  {
+    gradients[q] = 0;
+    for (unsigned int i = 0; i < cache->n_dofs_per_cell; ++i)
+      gradients[q] += local_dof_values[i] * shape_grad(i, q);
+  }
+}
+
+
+
+template <int dim>
+template <typename VectorType>
+void CachedFEValues<dim>::get_function_values
+(const VectorType            &vector,
+ std::vector<Tensor<1,dim>>  &values)
+{
+  AssertDimension(values.size(), cache->n_q_points);
+
+  cell->get_dof_values(vector, local_dof_values);
+
+  for (unsigned int q = 0; q < cache->n_q_points; ++q)
+  {
+    values[q] = 0;
+    for (unsigned int i = 0; i < cache->n_dofs_per_cell; ++i)
+    {
+      const unsigned int component = shape_component(i);
+      if (component < dim)
+        values[q][component] += local_dof_values[i] * shape_value(i, q);
+    }
+  }
+}
+
+
+
+template <int dim>
+template <typename VectorType>
+void CachedFEValues<dim>::get_function_gradients
+(const VectorType            &vector,
+ std::vector<Tensor<2,dim>>  &gradients)
+{
+  AssertDimension(gradients.size(), cache->n_q_points);
+
+  cell->get_dof_values(vector, local_dof_values);
+
+  for (unsigned int q = 0; q < cache->n_q_points; ++q)
+  {
+    gradients[q] = 0;
+    for (unsigned int i = 0; i < cache->n_dofs_per_cell; ++i)
+    {
+      const unsigned int component = shape_component(i);
+      if (component < dim)
+        gradients[q][component] += local_dof_values[i] * shape_grad(i, q);
+    }
+  }
+}
+
+
+
+template <int dim>
+template <typename VectorType>
+void CachedFEValues<dim>::get_function_divergences
+(const VectorType    &vector,
+ std::vector<double> &divergences)
+{
+  AssertDimension(divergences.size(), cache->n_q_points);
+
+  cell->get_dof_values(vector, local_dof_values);
+
+  for (unsigned int q = 0; q < cache->n_q_points; ++q)
+  {
+    divergences[q] = 0.0;
+    for (unsigned int i = 0; i < cache->n_dofs_per_cell; ++i)
+    {
+      const unsigned int component = shape_component(i);
+      if (component < dim)
+        divergences[q] += local_dof_values[i] * shape_grad(i, q)[component];
+    }
+  }
+}
+
+
+
+template <int dim>
+template <typename VectorType>
+void CachedFEValues<dim>::get_function_curls
+(const VectorType        &vector,
+ std::vector<curl_type>  &curls)
+{
+  AssertDimension(curls.size(), cache->n_q_points);
+
+  std::vector<Tensor<2,dim>>  gradients(cache->n_q_points);
+
+  get_function_gradients(vector, gradients);
+
+  for (unsigned int q = 0; q < cache->n_q_points; ++q)
+    curls[q] = compute_curl(gradients[q]);
+}
+
+
+
+template <int dim>
+typename CachedFEValues<dim>::curl_type
+CachedFEValues<dim>::compute_curl(const Tensor<2,dim> &gradient)
+{
+  curl_type curl;
+
+  if constexpr (dim == 2)
+    curl[0] = gradient[1][0] - gradient[0][1];
+  else if constexpr (dim == 3)
+  {
+    curl[0] = gradient[2][1] - gradient[1][2];
+    curl[1] = gradient[0][2] - gradient[2][0];
+    curl[2] = gradient[1][0] - gradient[0][1];
+  }
+
+  return (curl);
+}
+
+} // namespace RMHD
+
+// explicit instantiations
+template class RMHD::CellGeometryCache<2>;
+template class RMHD::CellGeometryCache<3>;
+
+template class RMHD::CachedFEValues<2>;
+template class RMHD::CachedFEValues<3>;
+
+#define INSTANTIATE_FUNCTION_EVALUATION(dim, VectorType)                       \
+template void RMHD::CachedFEValues<dim>::get_function_values                   \
+(const VectorType &, std::vector<double> &);                                   \
+template void RMHD::CachedFEValues<dim>::get_function_gradients                \
+(const VectorType &, std::vector<dealii::Tensor<1,dim>> &);                    \
+template void RMHD::CachedFEValues<dim>::get_function_values                   \
+(const VectorType &, std::vector<dealii::Tensor<1,dim>> &);                    \
+template void RMHD::CachedFEValues<dim>::get_function_gradients                \
+(const VectorType &, std::vector<dealii::Tensor<2,dim>> &);                    \
+template void RMHD::CachedFEValues<dim>::get_function_divergences              \
+(const VectorType &, std::vector<double> &);                                   \
+template void RMHD::CachedFEValues<dim>::get_function_curls                    \
+(const VectorType &, std::vector<typename RMHD::CachedFEValues<dim>::curl_type> &);
+
+INSTANTIATE_FUNCTION_EVALUATION(2, RMHD::LinearAlgebra::MPI::Vector)
+INSTANTIATE_FUNCTION_EVALUATION(3, RMHD::LinearAlgebra::MPI::Vector)
+INSTANTIATE_FUNCTION_EVALUATION(2, dealii::Vector<double>)
+INSTANTIATE_FUNCTION_EVALUATION(3, dealii::Vector<double>)
+
+#undef INSTANTIATE_FUNCTION_EVALUATION
@@ -1,5 +1,6 @@
 #include <rotatingMHD/convection_diffusion_solver.h>
 #include <rotatingMHD/time_discretization.h>
+#include <rotatingMHD/utility.h>
 
 #include <deal.II/fe/mapping_q.h>
 #include <cmath>
@@ -17,10 +18,12 @@ ConvectionDiffusionSolver<dim>::ConvectionDiffusionSolver
  const std::shared_ptr<TimerOutput>               external_timer)
 :
 parameters(parameters),
-mpi_communicator(MPI_COMM_WORLD),
+mpi_communicator(get_mpi_communicator(temperature->get_triangulation())),
 time_stepping(time_stepping),
 temperature(temperature),
-flag_matrices_were_updated(true)
+n_iterations(0),
+flag_matrices_were_updated(true),
+flag_mesh_was_modified(true)
 {
   Assert(temperature.get() != nullptr,
          ExcMessage("The temperature's shared pointer has not be"
@@ -57,6 +60,14 @@ flag_matrices_were_updated(true)
   source_term_ptr       = nullptr;
   velocity_function_ptr = nullptr;
   this->velocity        = nullptr;
+
+  // The solver is set up again once the triangulation changes.
+  mesh_modification_connection =
+    temperature->get_triangulation().signals.any_change.connect(
+      [this]()
+      {
+        this->flag_mesh_was_modified = true;
+      });
 }
 
 template <int dim>
@@ -70,11 +81,13 @@ ConvectionDiffusionSolver<dim>::ConvectionDiffusionSolver
  const std::shared_ptr<TimerOutput>               external_timer)
 :
 parameters(parameters),
-mpi_communicator(MPI_COMM_WORLD),
+mpi_communicator(get_mpi_communicator(temperature->get_triangulation())),
 time_stepping(time_stepping),
 temperature(temperature),
 velocity(velocity),
-flag_matrices_were_updated(true)
+n_iterations(0),
+flag_matrices_were_updated(true),
+flag_mesh_was_modified(true)
 {
   Assert(temperature.get() != nullptr,
          ExcMessage("The temperature's shared pointer has not be"
@@ -113,6 +126,14 @@ flag_matrices_were_updated(true)
   // Explicitly set the shared_ptr's to zero.
   source_term_ptr       = nullptr;
   velocity_function_ptr = nullptr;
+
+  // The solver is set up again once the triangulation changes.
+  mesh_modification_connection =
+    temperature->get_triangulation().signals.any_change.connect(
+      [this]()
+      {
+        this->flag_mesh_was_modified = true;
+      });
 }
 
 template <int dim>
@@ -126,11 +147,13 @@ ConvectionDiffusionSolver<dim>::ConvectionDiffusionSolver
  const std::shared_ptr<TimerOutput>               external_timer)
 :
 parameters(parameters),
-mpi_communicator(MPI_COMM_WORLD),
+mpi_communicator(get_mpi_communicator(temperature->get_triangulation())),
 time_stepping(time_stepping),
 temperature(temperature),
 velocity_function_ptr(velocity),
-flag_matrices_were_updated(true)
+n_iterations(0),
+flag_matrices_were_updated(true),
+flag_mesh_was_modified(true)
 {
   Assert(temperature.get() != nullptr,
          ExcMessage("The temperature's shared pointer has not be"
@@ -169,6 +192,42 @@ flag_matrices_were_updated(true)
   // Explicitly set the shared_ptr's to zero.
   source_term_ptr = nullptr;
   this->velocity  = nullptr;
+
+  // The solver is set up again once the triangulation changes.
+  mesh_modification_connection =
+    temperature->get_triangulation().signals.any_change.connect(
+      [this]()
+      {
+        this->flag_mesh_was_modified = true;
+      });
+}
+
+
+
+template <int dim>
+MemoryReport ConvectionDiffusionSolver<dim>::get_memory_report() const
+{
+  MemoryReport report;
+
+  report.add("System matrix", system_matrix.memory_consumption());
+  report.add("Mass matrix", mass_matrix.memory_consumption());
+  report.add("Stiffness matrix", stiffness_matrix.memory_consumption());
+  report.add("Mass plus stiffness matrix",
+             mass_plus_stiffness_matrix.memory_consumption());
+  report.add("Advection matrix", advection_matrix.memory_consumption());
+  report.add("Right-hand side vector", rhs.memory_consumption());
+  report.add("Preconditioner",
+             preconditioner_memory_consumption(preconditioner));
+
+  return (report);
+}
+
+
+
+template <int dim>
+std::size_t ConvectionDiffusionSolver<dim>::memory_consumption() const
+{
+  return (get_memory_report().total());
 }
 
 }  // namespace RMHD
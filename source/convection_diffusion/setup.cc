@@ -22,6 +22,12 @@ void ConvectionDiffusionSolver<dim>::setup()
   setup_vectors();
 
   assemble_constant_matrices();
+
+  // The preconditioner refers to the previous mesh. It is rebuilt on its
+  // first use.
+  preconditioner.reset();
+
+  flag_mesh_was_modified = false;
 }
 
 
@@ -138,6 +144,19 @@ void ConvectionDiffusionSolver<dim>::set_source_term(Function<dim> &source_term)
 }
 
 
+
+template <int dim>
+void ConvectionDiffusionSolver<dim>::reset_for_new_run()
+{
+  preconditioner.reset();
+
+  rhs_norm      = 0.0;
+  n_iterations  = 0;
+
+  flag_matrices_were_updated = true;
+}
+
+
 } // namespace RMHD
 
 // explicit instantiations
@@ -152,3 +171,6 @@ template void RMHD::ConvectionDiffusionSolver<3>::setup_vectors();
 
 template void RMHD::ConvectionDiffusionSolver<2>::set_source_term(Function<2> &);
 template void RMHD::ConvectionDiffusionSolver<3>::set_source_term(Function<3> &);
+
+template void RMHD::ConvectionDiffusionSolver<2>::reset_for_new_run();
+template void RMHD::ConvectionDiffusionSolver<3>::reset_for_new_run();
@@ -1,4 +1,5 @@
 #include <rotatingMHD/convection_diffusion_solver.h>
+#include <rotatingMHD/linear_solvers.h>
 #include <rotatingMHD/utility.h>
 
 namespace RMHD
@@ -7,7 +8,8 @@ namespace RMHD
 template <int dim>
 void ConvectionDiffusionSolver<dim>::solve()
 {
-  if (temperature->solution.size() != mass_matrix.m())
+  if (flag_mesh_was_modified ||
+      temperature->solution.size() != mass_matrix.m())
   {
     setup();
     flag_matrices_were_updated = true;
@@ -86,7 +88,9 @@ void ConvectionDiffusionSolver<dim>::solve_linear_system(const bool reinit_preco
   const typename RunTimeParameters::LinearSolverParameters &solver_parameters
     = parameters.solver_parameters;
 
-  if (reinit_preconditioner)
+  // The preconditioner is built lazily, i.e., also if it was released by
+  // setup().
+  if (reinit_preconditioner || preconditioner == nullptr)
   {
     build_preconditioner(preconditioner,
                          *system_matrix_ptr,
@@ -110,10 +114,19 @@ void ConvectionDiffusionSolver<dim>::solve_linear_system(const bool reinit_preco
 
   try
   {
-    solver.solve(*system_matrix_ptr,
-                 distributed_temperature,
-                 rhs,
-                 *preconditioner);
+    if (solver_parameters.solver_type == RunTimeParameters::SolverType::pipelined_Krylov)
+    {
+      PipelinedGMRES pipelined_solver(solver_control);
+      pipelined_solver.solve(*system_matrix_ptr,
+                             distributed_temperature,
+                             rhs,
+                             *preconditioner);
+    }
+    else
+      solver.solve(*system_matrix_ptr,
+                   distributed_temperature,
+                   rhs,
+                   *preconditioner);
   }
   catch (std::exception &exc)
   {
@@ -143,6 +156,8 @@ void ConvectionDiffusionSolver<dim>::solve_linear_system(const bool reinit_preco
 
   temperature->solution = distributed_temperature;
 
+  n_iterations = solver_control.last_step();
+
   if (parameters.verbose)
     *pcout << " done!" << std::endl
            << "    Number of GMRES iterations: "
@@ -7,7 +7,13 @@
 
 #include <deal.II/numerics/vector_tools.h>
 #include <rotatingMHD/convergence_test.h>
+#include <rotatingMHD/vector_tools.h>
 
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <string.h>
 
 namespace RMHD
@@ -15,13 +21,36 @@ namespace RMHD
 
 using namespace dealii;
 
+template <int dim>
+template <class Archive>
+void ConvergenceAnalysisData<dim>::Row::serialize
+(Archive &ar,
+ const unsigned int /* version */)
+{
+  ar & level;
+  ar & time_step;
+  ar & n_cells;
+  ar & n_dofs;
+  ar & h_max;
+  ar & L2_error;
+  ar & H1_error;
+  ar & Linfty_error;
+}
+
 template <int dim>
 ConvergenceAnalysisData<dim>::ConvergenceAnalysisData
 (const std::shared_ptr<Entities::FE_FieldBase<dim>> &entity,
  const Function<dim>             &exact_solution)
 :
+flag_spatial_convergence(false),
 entity(entity),
 exact_solution(exact_solution)
+{
+  declare_columns();
+}
+
+template <int dim>
+void ConvergenceAnalysisData<dim>::declare_columns()
 {
   convergence_table.declare_column("level");
   convergence_table.declare_column("dt");
@@ -52,90 +81,51 @@ void ConvergenceAnalysisData<dim>::update_table
  const double       time_step,
  const bool         flag_spatial_convergence)
 {
+  this->flag_spatial_convergence = flag_spatial_convergence;
+
   /*
    * Add new entries to the columns describing the spatio-temporal
    * discretization.
    */
-  convergence_table.add_value("level", level);
-  convergence_table.add_value("dt", time_step);
-  convergence_table.add_value("cells", entity->get_triangulation().n_global_active_cells());
-  convergence_table.add_value("dofs", entity->n_dofs());
-  convergence_table.add_value("hmax", GridTools::maximal_cell_diameter(entity->get_triangulation()));
+  Row row;
+  row.level     = level;
+  row.time_step = time_step;
+  row.n_cells   = entity->get_triangulation().n_global_active_cells();
+  row.n_dofs    = entity->n_dofs();
+  row.h_max     = GridTools::maximal_cell_diameter(entity->get_triangulation());
 
-  {
-    // Initialize vector of cell-wise errors
-    Vector<double> cellwise_difference(
-      entity->get_triangulation().n_active_cells());
+  // All norms of the error are computed in a single loop over the cells
+  const std::map<typename VectorTools::NormType, double> error_map =
+    RMHD::VectorTools::compute_error(*entity, exact_solution);
 
-    {
-      // Compute the error in the L2-norm.
-      const QGauss<dim>    quadrature_formula(entity->fe_degree() + 1);
-
-      VectorTools::integrate_difference
-      (entity->get_dof_handler(),
-       entity->solution,
-       exact_solution,
-       cellwise_difference,
-       quadrature_formula,
-       VectorTools::L2_norm);
-
-      const double L2_error =
-        VectorTools::compute_global_error(entity->get_triangulation(),
-                                          cellwise_difference,
-                                          VectorTools::L2_norm);
-      convergence_table.add_value("L2", L2_error);
-
-      // Compute the error in the H1-norm.
-      VectorTools::integrate_difference
-      (entity->get_dof_handler(),
-       entity->solution,
-       exact_solution,
-       cellwise_difference,
-       quadrature_formula,
-       VectorTools::H1_norm);
-
-      const double H1_error =
-        VectorTools::compute_global_error(entity->get_triangulation(),
-                                          cellwise_difference,
-                                          VectorTools::H1_norm);
-      convergence_table.add_value("H1", H1_error);
-    }
+  row.L2_error      = error_map.at(VectorTools::NormType::L2_norm);
+  row.H1_error      = error_map.at(VectorTools::NormType::H1_norm);
+  row.Linfty_error  = error_map.at(VectorTools::NormType::Linfty_norm);
 
-    /*
-     * For the infinity norm, the quadrature rule is designed such that the
-     * quadrature points coincide with the support points. For a polynomial degree
-     * less than three, the approach pursued here works, because the support
-     * points of the finite element discretization are equidistantly spaced on
-     * the reference element. Otherwise, the quadrature might be inappropriate.
-     *
-     * In other words, we simply sample the solution at the support points, i.e.,
-     * the nodes.
-     *
-     */
-    {
-      const QTrapez<1>     trapezoidal_rule;
-      const QIterated<dim> linfty_quadrature_rule(trapezoidal_rule,
-                                                  entity->fe_degree());
-
-      // Compute the error in the Linfty-norm.
-      VectorTools::integrate_difference
-      (entity->get_dof_handler(),
-       entity->solution,
-       exact_solution,
-       cellwise_difference,
-       linfty_quadrature_rule,
-       VectorTools::Linfty_norm);
-
-      const double Linfty_error =
-        VectorTools::compute_global_error(entity->get_triangulation(),
-                                          cellwise_difference,
-                                          VectorTools::Linfty_norm);
-
-      convergence_table.add_value("Linfty", Linfty_error);
-    }
-  }
+  rows.push_back(row);
+
+  add_row(row);
 
   // Compute convergence rates
+  evaluate_convergence_rates();
+}
+
+template <int dim>
+void ConvergenceAnalysisData<dim>::add_row(const Row &row)
+{
+  convergence_table.add_value("level", row.level);
+  convergence_table.add_value("dt", row.time_step);
+  convergence_table.add_value("cells", row.n_cells);
+  convergence_table.add_value("dofs", row.n_dofs);
+  convergence_table.add_value("hmax", row.h_max);
+  convergence_table.add_value("L2", row.L2_error);
+  convergence_table.add_value("H1", row.H1_error);
+  convergence_table.add_value("Linfty", row.Linfty_error);
+}
+
+template <int dim>
+void ConvergenceAnalysisData<dim>::evaluate_convergence_rates()
+{
   const std::string reference_column = (flag_spatial_convergence) ?
                                   "hmax" : "dt";
 
@@ -158,6 +148,53 @@ void ConvergenceAnalysisData<dim>::update_table
    1);
 }
 
+template <int dim>
+void ConvergenceAnalysisData<dim>::gather
+(const ConvergenceTest::CycleDistribution &cycle_distribution)
+{
+  if (!cycle_distribution.is_concurrent())
+    return;
+
+  // Only the first process of each group contributes its rows
+  std::vector<Row> local_rows;
+  if (Utilities::MPI::this_mpi_process(cycle_distribution.get_communicator()) == 0)
+    local_rows = rows;
+
+  const std::vector<std::vector<Row>> gathered_rows =
+    Utilities::MPI::gather(cycle_distribution.get_world_communicator(),
+                           local_rows);
+
+  if (!cycle_distribution.is_world_root())
+    return;
+
+  rows.clear();
+  for (const auto &group_rows: gathered_rows)
+    rows.insert(rows.end(), group_rows.begin(), group_rows.end());
+
+  // The rows are sorted in the order in which the cycles are run serially
+  if (flag_spatial_convergence)
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const Row &a, const Row &b)
+                     {
+                       return (a.level < b.level);
+                     });
+  else
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const Row &a, const Row &b)
+                     {
+                       return (a.time_step > b.time_step);
+                     });
+
+  convergence_table.clear();
+
+  declare_columns();
+
+  for (const auto &row: rows)
+    add_row(row);
+
+  evaluate_convergence_rates();
+}
+
 template<typename Stream, int dim>
 Stream& operator<<(Stream &stream,
                    const ConvergenceAnalysisData<dim> &data)
@@ -251,7 +288,8 @@ ConvergenceTestParameters::ConvergenceTestParameters()
 test_type(ConvergenceTestType::temporal),
 n_spatial_cycles(2),
 step_size_reduction_factor(0.5),
-n_temporal_cycles(2)
+n_temporal_cycles(2),
+concurrent_cycles(false)
 {}
 
 
@@ -309,6 +347,10 @@ void ConvergenceTestParameters::declare_parameters(ParameterHandler &prm)
     prm.declare_entry("Number of temporal convergence cycles",
                       "2",
                       Patterns::Integer(1));
+
+    prm.declare_entry("Concurrent cycles",
+                      "false",
+                      Patterns::Bool());
   }
   prm.leave_subsection();
 }
@@ -365,6 +407,8 @@ void ConvergenceTestParameters::parse_parameters(ParameterHandler &prm)
       AssertThrow(false,
                   ExcMessage("Unexpected identifier for the type of"
                              " of convergence test."));
+
+    concurrent_cycles = prm.get_bool("Concurrent cycles");
   }
   prm.leave_subsection();
 }
@@ -404,12 +448,161 @@ Stream& operator<<(Stream &stream, const ConvergenceTestParameters &prm)
                      "Time-step reduction factor",
                      prm.step_size_reduction_factor);
 
+  if (prm.concurrent_cycles)
+    internal::add_line(stream, "Concurrent cycles", "true");
+
   internal::add_header(stream);
 
   return (stream);
 }
 
 
+CycleDistribution::CycleDistribution
+(const ConvergenceTestParameters &prm,
+ const unsigned int               dim,
+ const MPI_Comm                  &world_communicator)
+:
+world_communicator(world_communicator),
+communicator(world_communicator),
+n_cycle_groups(1)
+{
+  AssertThrow(prm.test_type == ConvergenceTestType::spatial ||
+              prm.test_type == ConvergenceTestType::temporal,
+              ExcNotImplemented());
+
+  const bool flag_spatial_test = (prm.test_type == ConvergenceTestType::spatial);
+
+  const unsigned int n_cycles = (flag_spatial_test ?
+                                 prm.n_spatial_cycles :
+                                 prm.n_temporal_cycles);
+
+  const unsigned int n_mpi_processes =
+    Utilities::MPI::n_mpi_processes(world_communicator);
+  const unsigned int this_mpi_process =
+    Utilities::MPI::this_mpi_process(world_communicator);
+
+  if (!prm.concurrent_cycles || n_mpi_processes == 1 || n_cycles == 1)
+  {
+    cycles.resize(n_cycles);
+    std::iota(cycles.begin(), cycles.end(), 0);
+    return;
+  }
+
+  // The cost of a cycle is estimated by its number of degrees of freedom
+  // or by its number of time steps.
+  std::vector<double> costs(n_cycles);
+  for (unsigned int i = 0; i < n_cycles; ++i)
+    costs[i] = (flag_spatial_test ?
+                std::pow(2.0, dim * i) :
+                std::pow(prm.step_size_reduction_factor, -static_cast<double>(i)));
+
+  unsigned int color = 0;
+
+  if (n_mpi_processes >= n_cycles)
+  {
+    // Each cycle is run by its own group, whose size is proportional to
+    // the cost of the cycle. Each group consists of at least one process
+    // and the remaining processes are assigned according to the largest
+    // deviation from the proportional share.
+    const double total_cost = std::accumulate(costs.begin(), costs.end(), 0.0);
+
+    std::vector<double>       shares(n_cycles);
+    std::vector<unsigned int> group_sizes(n_cycles);
+    for (unsigned int i = 0; i < n_cycles; ++i)
+    {
+      shares[i]       = n_mpi_processes * costs[i] / total_cost;
+      group_sizes[i]  = std::max(1U, static_cast<unsigned int>(shares[i]));
+    }
+
+    unsigned int n_assigned_processes =
+      std::accumulate(group_sizes.begin(), group_sizes.end(), 0U);
+
+    while (n_assigned_processes > n_mpi_processes)
+    {
+      unsigned int group = numbers::invalid_unsigned_int;
+      for (unsigned int i = 0; i < n_cycles; ++i)
+        if (group_sizes[i] > 1 &&
+            (group == numbers::invalid_unsigned_int ||
+             group_sizes[i] - shares[i] > group_sizes[group] - shares[group]))
+          group = i;
+
+      --group_sizes[group];
+      --n_assigned_processes;
+    }
+
+    while (n_assigned_processes < n_mpi_processes)
+    {
+      unsigned int group = 0;
+      for (unsigned int i = 1; i < n_cycles; ++i)
+        if (shares[i] - group_sizes[i] > shares[group] - group_sizes[group])
+          group = i;
+
+      ++group_sizes[group];
+      ++n_assigned_processes;
+    }
+
+    unsigned int first_process = 0;
+    for (unsigned int i = 0; i < n_cycles; ++i)
+    {
+      if (this_mpi_process >= first_process &&
+          this_mpi_process < first_process + group_sizes[i])
+      {
+        color = i;
+        cycles.push_back(i);
+      }
+      first_process += group_sizes[i];
+    }
+
+    n_cycle_groups = n_cycles;
+  }
+  else
+  {
+    // Each process forms a group. The cycles are assigned in the order of
+    // decreasing cost to the group with the smallest load.
+    std::vector<unsigned int> sorted_cycles(n_cycles);
+    std::iota(sorted_cycles.begin(), sorted_cycles.end(), 0);
+    std::stable_sort(sorted_cycles.begin(), sorted_cycles.end(),
+                     [&costs](const unsigned int a, const unsigned int b)
+                     {
+                       return (costs[a] > costs[b]);
+                     });
+
+    std::vector<double> loads(n_mpi_processes, 0.0);
+    for (const auto cycle: sorted_cycles)
+    {
+      const unsigned int group =
+        std::min_element(loads.begin(), loads.end()) - loads.begin();
+
+      loads[group] += costs[cycle];
+
+      if (group == this_mpi_process)
+        cycles.push_back(cycle);
+    }
+
+    std::sort(cycles.begin(), cycles.end());
+
+    color = this_mpi_process;
+
+    n_cycle_groups = n_mpi_processes;
+  }
+
+  const int ierr = MPI_Comm_split(world_communicator,
+                                  color,
+                                  this_mpi_process,
+                                  &communicator);
+  AssertThrowMPI(ierr);
+}
+
+
+
+CycleDistribution::~CycleDistribution()
+{
+  if (is_concurrent())
+    Utilities::MPI::free_communicator(communicator);
+}
+
+
+
 ConvergenceTestData::ConvergenceTestData(const ConvergenceTestType &type)
 :
 type(type),
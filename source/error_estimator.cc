@@ -0,0 +1,475 @@
+#include <rotatingMHD/error_estimator.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/work_stream.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/numerics/derivative_approximation.h>
+
+#include <cmath>
+#include <memory>
+
+namespace RMHD
+{
+
+namespace
+{
+
+/*!
+ * @brief Scratch data of the loop over the faces. It contains the face
+ * values of each field on both sides of a face.
+ */
+template <int dim>
+struct JumpScratch
+{
+  JumpScratch(const Mapping<dim>                                     &mapping,
+              const std::vector<const Entities::FE_FieldBase<dim> *> &fields);
+
+  JumpScratch(const JumpScratch<dim> &data);
+
+  const Mapping<dim>                                     &mapping;
+
+  const std::vector<const Entities::FE_FieldBase<dim> *> &fields;
+
+  std::vector<std::unique_ptr<FEFaceValues<dim>>>         fe_face_values;
+
+  std::vector<std::unique_ptr<FEFaceValues<dim>>>         neighbor_fe_face_values;
+
+  std::vector<std::unique_ptr<FESubfaceValues<dim>>>      fe_subface_values;
+
+  std::vector<std::unique_ptr<FESubfaceValues<dim>>>      neighbor_fe_subface_values;
+
+  std::vector<std::vector<std::vector<Tensor<1,dim>>>>    gradients;
+
+  std::vector<std::vector<std::vector<Tensor<1,dim>>>>    neighbor_gradients;
+};
+
+
+
+template <int dim>
+JumpScratch<dim>::JumpScratch
+(const Mapping<dim>                                     &mapping,
+ const std::vector<const Entities::FE_FieldBase<dim> *> &fields)
+:
+mapping(mapping),
+fields(fields)
+{
+  const UpdateFlags face_update_flags = update_gradients|
+                                        update_normal_vectors|
+                                        update_JxW_values;
+
+  for (const auto field: fields)
+  {
+    const FiniteElement<dim> &fe = field->get_finite_element();
+
+    const QGauss<dim-1> face_quadrature_formula(field->fe_degree() + 1);
+
+    fe_face_values.emplace_back(
+      std::make_unique<FEFaceValues<dim>>(mapping,
+                                          fe,
+                                          face_quadrature_formula,
+                                          face_update_flags));
+    neighbor_fe_face_values.emplace_back(
+      std::make_unique<FEFaceValues<dim>>(mapping,
+                                          fe,
+                                          face_quadrature_formula,
+                                          update_gradients));
+    fe_subface_values.emplace_back(
+      std::make_unique<FESubfaceValues<dim>>(mapping,
+                                             fe,
+                                             face_quadrature_formula,
+                                             face_update_flags));
+    neighbor_fe_subface_values.emplace_back(
+      std::make_unique<FESubfaceValues<dim>>(mapping,
+                                             fe,
+                                             face_quadrature_formula,
+                                             update_gradients));
+
+    gradients.emplace_back(face_quadrature_formula.size(),
+                           std::vector<Tensor<1,dim>>(fe.n_components()));
+    neighbor_gradients.emplace_back(face_quadrature_formula.size(),
+                                    std::vector<Tensor<1,dim>>(fe.n_components()));
+  }
+}
+
+
+
+template <int dim>
+JumpScratch<dim>::JumpScratch(const JumpScratch<dim> &data)
+:
+JumpScratch<dim>(data.mapping, data.fields)
+{}
+
+
+
+/*!
+ * @brief Copy data of the loop over the faces. It contains the face
+ * integrals of the squared jumps of each field, which are added to the
+ * cell given by its active cell index.
+ */
+struct JumpCopy
+{
+  std::vector<std::pair<unsigned int, std::vector<double>>> contributions;
+};
+
+
+
+/*!
+ * @brief Returns the integral of the squared jump of the normal
+ * derivative over a face. The normal vectors and the weights are taken
+ * from @p fe_values.
+ */
+template <int dim>
+double integrate_squared_jump
+(const FEFaceValuesBase<dim>               &fe_values,
+ const std::vector<std::vector<Tensor<1,dim>>> &gradients,
+ const std::vector<std::vector<Tensor<1,dim>>> &neighbor_gradients)
+{
+  double integral = 0.0;
+
+  for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+    for (unsigned int c = 0; c < gradients[q].size(); ++c)
+    {
+      const double jump = (gradients[q][c] - neighbor_gradients[q][c]) *
+                          fe_values.normal_vector(q);
+
+      integral += jump * jump * fe_values.JxW(q);
+    }
+
+  return (integral);
+}
+
+
+
+/*!
+ * @brief Returns the iterator of the DoFHandler @p dof_handler pointing
+ * to the same cell as @p cell.
+ */
+template <int dim>
+typename DoFHandler<dim>::active_cell_iterator
+dof_cell_iterator(const typename Triangulation<dim>::cell_iterator &cell,
+                  const DoFHandler<dim>                            &dof_handler)
+{
+  return (typename DoFHandler<dim>::active_cell_iterator(&cell->get_triangulation(),
+                                                         cell->level(),
+                                                         cell->index(),
+                                                         &dof_handler));
+}
+
+} // namespace
+
+
+
+template <int dim>
+MultiFieldErrorEstimator<dim>::MultiFieldErrorEstimator
+(const Mapping<dim> &mapping)
+:
+mapping(mapping)
+{}
+
+
+
+template <int dim>
+void MultiFieldErrorEstimator<dim>::add_field
+(const Entities::FE_FieldBase<dim> &field,
+ const double                       weight)
+{
+  AssertThrow(weight >= 0.0,
+              ExcLowerRangeType<double>(weight, 0.0));
+
+  if (!fields.empty())
+    AssertThrow(&field.get_triangulation() == &fields.front()->get_triangulation(),
+                ExcMessage("The fields do not share the same triangulation."));
+
+  fields.push_back(&field);
+  weights.push_back(weight);
+}
+
+
+
+template <int dim>
+void MultiFieldErrorEstimator<dim>::clear()
+{
+  fields.clear();
+  weights.clear();
+}
+
+
+
+template <int dim>
+void MultiFieldErrorEstimator<dim>::estimate
+(Vector<float>                              &estimated_error_per_cell,
+ const RunTimeParameters::ErrorIndicatorType type,
+ const bool                                  normalize) const
+{
+  AssertThrow(!fields.empty(),
+              ExcMessage("No field was added to the error estimator."));
+
+  const Triangulation<dim> &triangulation = fields.front()->get_triangulation();
+
+  std::vector<Vector<float>>  indicators(fields.size(),
+                                         Vector<float>(triangulation.n_active_cells()));
+
+  switch (type)
+  {
+    case RunTimeParameters::ErrorIndicatorType::Kelly:
+      compute_jump_indicators(indicators);
+      break;
+    case RunTimeParameters::ErrorIndicatorType::gradient_recovery:
+      compute_gradient_indicators(indicators);
+      break;
+    default:
+      AssertThrow(false, ExcMessage("Unexpected type identifier for the error indicator."));
+      break;
+  }
+
+  // Scaling factor of each field given by its weight and, optionally, by
+  // the inverse of the global norm of its indicator
+  std::vector<double> scaling_factors(weights);
+
+  if (normalize)
+  {
+    std::vector<double> norms(fields.size());
+    for (unsigned int i = 0; i < fields.size(); ++i)
+      norms[i] = indicators[i].norm_sqr();
+
+    Utilities::MPI::sum(norms, triangulation.get_communicator(), norms);
+
+    for (unsigned int i = 0; i < fields.size(); ++i)
+      if (norms[i] > 0.0)
+        scaling_factors[i] /= std::sqrt(norms[i]);
+  }
+
+  double sum_of_weights = 0.0;
+  for (const auto weight: weights)
+    sum_of_weights += weight;
+
+  AssertThrow(sum_of_weights > 0.0,
+              ExcMessage("The sum of the weights of the fields is zero."));
+
+  estimated_error_per_cell.reinit(triangulation.n_active_cells());
+
+  for (unsigned int i = 0; i < fields.size(); ++i)
+    estimated_error_per_cell.add(scaling_factors[i] / sum_of_weights,
+                                 indicators[i]);
+}
+
+
+
+template <int dim>
+void MultiFieldErrorEstimator<dim>::compute_jump_indicators
+(std::vector<Vector<float>> &indicators) const
+{
+  const Triangulation<dim> &triangulation = fields.front()->get_triangulation();
+
+  const unsigned int n_fields = fields.size();
+
+  // Computes the face integrals of all fields on the faces of a cell.
+  // Each face is visited once: faces between two locally owned cells are
+  // handled by the coarser cell or, on the same level, by the cell with
+  // the smaller active cell index.
+  auto worker =
+    [&](const typename Triangulation<dim>::active_cell_iterator &cell,
+        JumpScratch<dim>                                         &scratch,
+        JumpCopy                                                 &data)
+    {
+      data.contributions.clear();
+
+      std::vector<double> cell_integrals(n_fields, 0.0);
+
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      {
+        if (cell->face(f)->at_boundary())
+          continue;
+
+        const typename Triangulation<dim>::cell_iterator neighbor = cell->neighbor(f);
+
+        if (cell->face(f)->has_children())
+        {
+          // The neighbor is finer. The face is split into subfaces.
+          const unsigned int neighbor_face_no = cell->neighbor_of_neighbor(f);
+
+          for (unsigned int subface_no = 0;
+               subface_no < cell->face(f)->n_children(); ++subface_no)
+          {
+            const typename Triangulation<dim>::active_cell_iterator
+            neighbor_child = cell->neighbor_child_on_subface(f, subface_no);
+
+            std::vector<double> neighbor_integrals(n_fields);
+
+            for (unsigned int i = 0; i < n_fields; ++i)
+            {
+              const DoFHandler<dim> &dof_handler = fields[i]->get_dof_handler();
+
+              scratch.fe_subface_values[i]->reinit(dof_cell_iterator(cell, dof_handler),
+                                                   f,
+                                                   subface_no);
+              scratch.neighbor_fe_face_values[i]->reinit(dof_cell_iterator(neighbor_child, dof_handler),
+                                                         neighbor_face_no);
+
+              scratch.fe_subface_values[i]->get_function_gradients(
+                fields[i]->solution, scratch.gradients[i]);
+              scratch.neighbor_fe_face_values[i]->get_function_gradients(
+                fields[i]->solution, scratch.neighbor_gradients[i]);
+
+              neighbor_integrals[i] =
+                integrate_squared_jump(*scratch.fe_subface_values[i],
+                                       scratch.gradients[i],
+                                       scratch.neighbor_gradients[i]);
+
+              cell_integrals[i] += neighbor_integrals[i];
+            }
+
+            if (neighbor_child->is_locally_owned())
+              data.contributions.emplace_back(neighbor_child->active_cell_index(),
+                                              neighbor_integrals);
+          }
+        }
+        else if (cell->neighbor_is_coarser(f))
+        {
+          // A locally owned coarser neighbor handles the face
+          if (neighbor->is_locally_owned())
+            continue;
+
+          const std::pair<unsigned int, unsigned int> neighbor_face_subface =
+            cell->neighbor_of_coarser_neighbor(f);
+
+          for (unsigned int i = 0; i < n_fields; ++i)
+          {
+            const DoFHandler<dim> &dof_handler = fields[i]->get_dof_handler();
+
+            scratch.fe_face_values[i]->reinit(dof_cell_iterator(cell, dof_handler),
+                                              f);
+            scratch.neighbor_fe_subface_values[i]->reinit(dof_cell_iterator(neighbor, dof_handler),
+                                                          neighbor_face_subface.first,
+                                                          neighbor_face_subface.second);
+
+            scratch.fe_face_values[i]->get_function_gradients(
+              fields[i]->solution, scratch.gradients[i]);
+            scratch.neighbor_fe_subface_values[i]->get_function_gradients(
+              fields[i]->solution, scratch.neighbor_gradients[i]);
+
+            cell_integrals[i] +=
+              integrate_squared_jump(*scratch.fe_face_values[i],
+                                     scratch.gradients[i],
+                                     scratch.neighbor_gradients[i]);
+          }
+        }
+        else
+        {
+          // A locally owned neighbor on the same level with a smaller
+          // index handles the face
+          if (neighbor->is_locally_owned() &&
+              neighbor->active_cell_index() < cell->active_cell_index())
+            continue;
+
+          const unsigned int neighbor_face_no = cell->neighbor_of_neighbor(f);
+
+          std::vector<double> neighbor_integrals(n_fields);
+
+          for (unsigned int i = 0; i < n_fields; ++i)
+          {
+            const DoFHandler<dim> &dof_handler = fields[i]->get_dof_handler();
+
+            scratch.fe_face_values[i]->reinit(dof_cell_iterator(cell, dof_handler),
+                                              f);
+            scratch.neighbor_fe_face_values[i]->reinit(dof_cell_iterator(neighbor, dof_handler),
+                                                       neighbor_face_no);
+
+            scratch.fe_face_values[i]->get_function_gradients(
+              fields[i]->solution, scratch.gradients[i]);
+            scratch.neighbor_fe_face_values[i]->get_function_gradients(
+              fields[i]->solution, scratch.neighbor_gradients[i]);
+
+            neighbor_integrals[i] =
+              integrate_squared_jump(*scratch.fe_face_values[i],
+                                     scratch.gradients[i],
+                                     scratch.neighbor_gradients[i]);
+
+            cell_integrals[i] += neighbor_integrals[i];
+          }
+
+          if (neighbor->is_locally_owned())
+            data.contributions.emplace_back(neighbor->active_cell_index(),
+                                            neighbor_integrals);
+        }
+      }
+
+      data.contributions.emplace_back(cell->active_cell_index(),
+                                      cell_integrals);
+    };
+
+  auto copier =
+    [&](const JumpCopy &data)
+    {
+      for (const auto &contribution: data.contributions)
+        for (unsigned int i = 0; i < n_fields; ++i)
+          indicators[i](contribution.first) += contribution.second[i];
+    };
+
+  using CellFilter =
+    FilteredIterator<typename Triangulation<dim>::active_cell_iterator>;
+
+  WorkStream::run
+  (CellFilter(IteratorFilters::LocallyOwnedCell(),
+              triangulation.begin_active()),
+   CellFilter(IteratorFilters::LocallyOwnedCell(),
+              triangulation.end()),
+   worker,
+   copier,
+   JumpScratch<dim>(mapping, fields),
+   JumpCopy());
+
+  // Scale the sums of the face integrals by the cell diameter
+  for (const auto &cell: triangulation.active_cell_iterators())
+    if (cell->is_locally_owned())
+      for (unsigned int i = 0; i < n_fields; ++i)
+        indicators[i](cell->active_cell_index()) =
+          std::sqrt(cell->diameter() / 24.0 *
+                    indicators[i](cell->active_cell_index()));
+}
+
+
+
+template <int dim>
+void MultiFieldErrorEstimator<dim>::compute_gradient_indicators
+(std::vector<Vector<float>> &indicators) const
+{
+  const Triangulation<dim> &triangulation = fields.front()->get_triangulation();
+
+  Vector<float> component_gradient(triangulation.n_active_cells());
+
+  for (unsigned int i = 0; i < fields.size(); ++i)
+  {
+    // The squared norms of the gradients of all components are summed
+    for (unsigned int c = 0; c < fields[i]->get_finite_element().n_components(); ++c)
+    {
+      component_gradient = 0.;
+
+      DerivativeApproximation::approximate_gradient(mapping,
+                                                    fields[i]->get_dof_handler(),
+                                                    fields[i]->solution,
+                                                    component_gradient,
+                                                    c);
+
+      for (const auto &cell: triangulation.active_cell_iterators())
+        if (cell->is_locally_owned())
+          indicators[i](cell->active_cell_index()) +=
+            component_gradient(cell->active_cell_index()) *
+            component_gradient(cell->active_cell_index());
+    }
+
+    for (const auto &cell: triangulation.active_cell_iterators())
+      if (cell->is_locally_owned())
+        indicators[i](cell->active_cell_index()) =
+          std::pow(cell->diameter(), 1.0 + dim / 2.0) *
+          std::sqrt(indicators[i](cell->active_cell_index()));
+  }
+}
+
+} // namespace RMHD
+
+// explicit instantiations
+template class RMHD::MultiFieldErrorEstimator<2>;
+template class RMHD::MultiFieldErrorEstimator<3>;
@@ -11,6 +11,7 @@
 #include <rotatingMHD/finite_element_field.h>
 
 #include <algorithm>
+#include <limits>
 #include <type_traits>
 
 namespace RMHD
@@ -30,7 +31,8 @@ name(name),
 flag_child_entity(false),
 flag_setup_dofs(true),
 triangulation(triangulation),
-dof_handler(std::make_shared<DoFHandler<dim>>())
+dof_handler(std::make_shared<DoFHandler<dim>>()),
+cell_geometry_cache_memory_budget(std::numeric_limits<std::size_t>::max())
 {}
 
 
@@ -45,7 +47,8 @@ flag_child_entity(true),
 flag_setup_dofs(entity.flag_setup_dofs),
 triangulation(entity.get_triangulation()),
 dof_handler(entity.dof_handler),
-finite_element(entity.finite_element)
+finite_element(entity.finite_element),
+cell_geometry_cache_memory_budget(entity.cell_geometry_cache_memory_budget)
 {}
 
 template <int dim, typename VectorType>
@@ -122,6 +125,8 @@ void FE_FieldBase<2, Vector<double>>::clear()
   locally_owned_dofs.clear();
   locally_relevant_dofs.clear();
 
+  cell_geometry_caches.clear();
+
   if (!flag_child_entity)
     dof_handler->clear();
 
@@ -146,6 +151,8 @@ void FE_FieldBase<3, Vector<double>>::clear()
   locally_owned_dofs.clear();
   locally_relevant_dofs.clear();
 
+  cell_geometry_caches.clear();
+
   if (!flag_child_entity)
     dof_handler->clear();
 
@@ -169,6 +176,8 @@ void FE_FieldBase<dim, VectorType>::clear()
   locally_owned_dofs.clear();
   locally_relevant_dofs.clear();
 
+  cell_geometry_caches.clear();
+
   if (!flag_child_entity)
     dof_handler->clear();
 
@@ -289,9 +298,85 @@ void FE_FieldBase<dim, VectorType>::send_point_data_vector
 
 
 
+template <int dim, typename VectorType>
+const CellGeometryCache<dim> &
+FE_FieldBase<dim, VectorType>::get_cell_geometry_cache
+(const Mapping<dim>     &mapping,
+ const Quadrature<dim>  &quadrature,
+ const UpdateFlags       update_flags) const
+{
+  AssertThrow(!flag_setup_dofs, ExcMessage("Setup dofs was not called."));
+
+  for (const auto &cache: cell_geometry_caches)
+    if (cache->matches(mapping, quadrature, update_flags))
+      return (*cache);
+
+  // The memory of the existing caches is deducted from the budget
+  std::size_t memory_budget = cell_geometry_cache_memory_budget;
+  for (const auto &cache: cell_geometry_caches)
+    memory_budget -= std::min(memory_budget, cache->memory_consumption());
+
+  cell_geometry_caches.push_back(
+    std::make_unique<CellGeometryCache<dim>>(mapping,
+                                             *dof_handler,
+                                             quadrature,
+                                             update_flags,
+                                             memory_budget));
+
+  return (*cell_geometry_caches.back());
+}
+
+
+
+template <int dim, typename VectorType>
+MemoryReport FE_FieldBase<dim, VectorType>::get_memory_report() const
+{
+  MemoryReport report;
+
+  if (flag_child_entity)
+    report.add("DoF handler", 0);
+  else
+    report.add("DoF handler",
+               dof_handler->memory_consumption() +
+               finite_element->memory_consumption());
+
+  report.add("Constraints",
+             hanging_node_constraints.memory_consumption() +
+             constraints.memory_consumption() +
+             locally_owned_dofs.memory_consumption() +
+             locally_relevant_dofs.memory_consumption());
+
+  report.add("Solution vectors",
+             solution.memory_consumption() +
+             old_solution.memory_consumption() +
+             old_old_solution.memory_consumption() +
+             distributed_vector.memory_consumption());
+
+  std::size_t memory = 0;
+  for (const auto &cache: cell_geometry_caches)
+    memory += cache->memory_consumption();
+
+  report.add("Cell geometry caches", memory);
+
+  return (report);
+}
+
+
+
+template <int dim, typename VectorType>
+std::size_t FE_FieldBase<dim, VectorType>::memory_consumption() const
+{
+  return (get_memory_report().total());
+}
+
+
+
 template <int dim, typename VectorType>
 void FE_FieldBase<dim, VectorType>::setup_dofs()
 {
+  // The cached geometry refers to the old cells
+  cell_geometry_caches.clear();
+
   if (flag_child_entity)
   {
     AssertThrow(finite_element != nullptr,
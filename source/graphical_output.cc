@@ -0,0 +1,761 @@
+#include <rotatingMHD/graphical_output.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/lac/vector.h>
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+namespace RMHD
+{
+
+using namespace dealii;
+
+template <int dim>
+GraphicalOutput<dim>::GraphicalOutput
+(const RunTimeParameters::OutputControlParameters &prm,
+ parallel::distributed::Triangulation<dim>        &triangulation,
+ const std::shared_ptr<Mapping<dim>>              &mapping)
+:
+prm(prm),
+mpi_communicator(triangulation.get_communicator()),
+n_mpi_processes(Utilities::MPI::n_mpi_processes(mpi_communicator)),
+this_mpi_process(Utilities::MPI::this_mpi_process(mpi_communicator)),
+triangulation(triangulation),
+mapping(mapping),
+n_subdivisions(1),
+curved_cell_region(DataOut<dim>::no_curved_cells),
+n_outputs(0),
+n_meshes(0),
+flag_mesh_changed(true)
+{
+  patch_cache.valid = false;
+
+  // The mesh file and the cached patches are updated once the
+  // triangulation changes.
+  mesh_change_connection =
+    triangulation.signals.any_change.connect(
+      [this]()
+      {
+        this->flag_mesh_changed = true;
+        this->patch_cache.valid = false;
+      });
+
+  // The background threads access the triangulation. Hence, the pending
+  // outputs are completed before it is modified.
+  pre_refinement_connection =
+    triangulation.signals.pre_refinement.connect(
+      [this]()
+      {
+        this->finalize();
+      });
+  clear_connection =
+    triangulation.signals.clear.connect(
+      [this]()
+      {
+        this->finalize();
+      });
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::add_field
+(const Entities::FE_FieldBase<dim> &field,
+ const std::string                 &name)
+{
+  fields.push_back({&field, (name.empty() ? field.name : name), nullptr});
+
+  patch_cache.valid = false;
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::add_field
+(const Entities::FE_FieldBase<dim>               &field,
+ const std::shared_ptr<DataPostprocessor<dim>>   &postprocessor)
+{
+  Assert(postprocessor != nullptr,
+         ExcMessage("The postprocessor is not initialized."));
+
+  fields.push_back({&field, field.name, postprocessor});
+
+  patch_cache.valid = false;
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::set_patch_parameters
+(const unsigned int                             n_subdivisions,
+ const typename DataOut<dim>::CurvedCellRegion  curved_cell_region)
+{
+  AssertThrow(n_subdivisions > 0,
+              ExcLowerRangeType<unsigned int>(n_subdivisions, 1));
+
+  this->n_subdivisions      = n_subdivisions;
+  this->curved_cell_region  = curved_cell_region;
+
+  patch_cache.valid = false;
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::finalize()
+{
+  while (!pending_outputs.empty())
+    complete_pending_output();
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::clear()
+{
+  finalize();
+
+  fields.clear();
+
+  patch_cache.valid = false;
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::write(const double time)
+{
+  AssertThrow(!fields.empty(),
+              ExcMessage("No field was added to the graphical output."));
+
+  const bool flag_asynchronous = (prm.graphical_output_queue_depth > 0);
+
+  PendingOutput output;
+
+  output.index  = n_outputs++;
+  output.time   = time;
+
+  // The work which may be done by the background thread
+  std::function<void()> build;
+
+  if (!patch_cache_is_applicable())
+  {
+    // The solution vectors are copied as the time loop continues to
+    // modify them.
+    if (flag_asynchronous)
+      for (const auto &output_field: fields)
+        output.snapshots.push_back(
+          std::make_unique<LinearAlgebra::MPI::Vector>(output_field.field->solution));
+
+    auto data_out = std::make_unique<PatchBuilder>();
+
+    add_data_vectors(*data_out, output.snapshots);
+
+    build = [this, data_out = data_out.get()]()
+            {
+              this->build_patches(*data_out);
+            };
+
+    output.data = std::move(data_out);
+  }
+  else if (!patch_cache.valid)
+  {
+    // The patches built from scratch already contain the current
+    // solution.
+    update_patch_cache();
+
+    output.data =
+      std::make_unique<PatchCollection>(patch_cache.patch_collection);
+  }
+  else
+  {
+    std::vector<const LinearAlgebra::MPI::Vector *> vectors;
+
+    for (const auto &output_field: fields)
+      if (flag_asynchronous)
+      {
+        output.snapshots.push_back(
+          std::make_unique<LinearAlgebra::MPI::Vector>(output_field.field->solution));
+        vectors.push_back(output.snapshots.back().get());
+      }
+      else
+        vectors.push_back(&output_field.field->solution);
+
+    auto patch_collection = std::make_unique<PatchCollection>();
+
+    patch_collection->dataset_names =
+      patch_cache.patch_collection.dataset_names;
+    patch_collection->nonscalar_data_ranges =
+      patch_cache.patch_collection.nonscalar_data_ranges;
+
+    build = [this,
+             patches = &patch_collection->patches,
+             vectors]()
+            {
+              *patches = this->patch_cache.patch_collection.patches;
+
+              this->interpolate_onto_patches(vectors, *patches);
+            };
+
+    output.data = std::move(patch_collection);
+  }
+
+  // Synchronous output
+  if (!flag_asynchronous)
+  {
+    if (build)
+      build();
+
+    switch (prm.graphical_output_format)
+    {
+      case RunTimeParameters::GraphicalOutputFormat::vtu:
+        write_vtu(*output.data, output.index);
+        break;
+      case RunTimeParameters::GraphicalOutputFormat::hdf5:
+        write_hdf5(*output.data, output.time, output.index);
+        break;
+      default:
+        Assert(false, ExcNotImplemented());
+        break;
+    }
+
+    return;
+  }
+
+  // Asynchronous output
+  const bool flag_write_vtu =
+    (prm.graphical_output_format == RunTimeParameters::GraphicalOutputFormat::vtu);
+
+  output.task =
+    std::async(std::launch::async,
+               [this,
+                build,
+                data = output.data.get(),
+                index = output.index,
+                flag_write_vtu]()
+               {
+                 if (build)
+                   build();
+
+                 if (flag_write_vtu)
+                   this->write_vtu_locally(*data, index);
+               });
+
+  pending_outputs.push_back(std::move(output));
+
+  // All processes pass through here in the same order. Hence, the
+  // collective write of the HDF5 format is done in the same order.
+  while (pending_outputs.size() > prm.graphical_output_queue_depth)
+    complete_pending_output();
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::complete_pending_output()
+{
+  Assert(!pending_outputs.empty(), ExcInternalError());
+
+  PendingOutput &output = pending_outputs.front();
+
+  // Rethrows any exception of the background thread
+  output.task.get();
+
+  if (prm.graphical_output_format == RunTimeParameters::GraphicalOutputFormat::hdf5)
+    write_hdf5(*output.data, output.time, output.index);
+
+  pending_outputs.pop_front();
+}
+
+
+
+template <int dim>
+std::vector<DataOutBase::Patch<dim, dim>>
+GraphicalOutput<dim>::get_patches(const bool use_cache)
+{
+  AssertThrow(!fields.empty(),
+              ExcMessage("No field was added to the graphical output."));
+
+  if (use_cache && patch_cache_is_applicable())
+  {
+    if (!patch_cache.valid)
+      update_patch_cache();
+
+    std::vector<const LinearAlgebra::MPI::Vector *> vectors;
+    for (const auto &output_field: fields)
+      vectors.push_back(&output_field.field->solution);
+
+    std::vector<DataOutBase::Patch<dim, dim>> patches =
+      patch_cache.patch_collection.patches;
+
+    interpolate_onto_patches(vectors, patches);
+
+    return (patches);
+  }
+
+  PatchBuilder  data_out;
+
+  add_data_vectors(data_out, {});
+
+  build_patches(data_out);
+
+  return (data_out.get_patches());
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::add_data_vectors
+(DataOut<dim>                                                   &data_out,
+ const std::vector<std::unique_ptr<LinearAlgebra::MPI::Vector>> &snapshots) const
+{
+  Assert(snapshots.empty() || snapshots.size() == fields.size(),
+         ExcDimensionMismatch(snapshots.size(), fields.size()));
+
+  for (unsigned int i = 0; i < fields.size(); ++i)
+  {
+    const Entities::FE_FieldBase<dim> &field = *fields[i].field;
+
+    const LinearAlgebra::MPI::Vector  &vector =
+      (snapshots.empty() ? field.solution : *snapshots[i]);
+
+    if (fields[i].postprocessor != nullptr)
+      data_out.add_data_vector(field.get_dof_handler(),
+                               vector,
+                               *fields[i].postprocessor);
+    else if (field.n_components() > 1)
+    {
+      const std::vector<std::string> names(field.n_components(),
+                                           fields[i].name);
+      const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+        component_interpretation(field.n_components(),
+                                 DataComponentInterpretation::component_is_part_of_vector);
+
+      data_out.add_data_vector(field.get_dof_handler(),
+                               vector,
+                               names,
+                               component_interpretation);
+    }
+    else
+      data_out.add_data_vector(field.get_dof_handler(),
+                               vector,
+                               fields[i].name);
+  }
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::build_patches(DataOut<dim> &data_out) const
+{
+  data_out.build_patches(*mapping,
+                         n_subdivisions,
+                         curved_cell_region);
+}
+
+
+
+template <int dim>
+bool GraphicalOutput<dim>::patch_cache_is_applicable() const
+{
+  const UpdateFlags supported_flags =
+    update_values | update_gradients | update_quadrature_points;
+
+  for (const auto &output_field: fields)
+  {
+    if (!output_field.field->get_dof_handler().get_fe().is_primitive())
+      return (false);
+
+    if (output_field.postprocessor != nullptr &&
+        (output_field.postprocessor->get_needed_update_flags() & ~supported_flags))
+      return (false);
+  }
+
+  return (true);
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::update_patch_cache()
+{
+  // The pending outputs read the cache
+  finalize();
+
+  PatchBuilder  data_out;
+
+  add_data_vectors(data_out, {});
+
+  build_patches(data_out);
+
+  patch_cache.patch_collection.patches = data_out.get_patches();
+  patch_cache.patch_collection.dataset_names = data_out.get_dataset_names();
+  patch_cache.patch_collection.nonscalar_data_ranges =
+    data_out.get_nonscalar_data_ranges();
+
+  // The patches are built in the order of the locally owned active cells
+  patch_cache.cells.clear();
+  for (const auto &cell: triangulation.active_cell_iterators())
+    if (cell->is_locally_owned())
+      patch_cache.cells.push_back(cell);
+
+  AssertDimension(patch_cache.cells.size(),
+                  patch_cache.patch_collection.patches.size());
+
+  // The subdivision points used by DataOut::build_patches
+  const QIterated<dim> patch_points(QTrapez<1>(), n_subdivisions);
+
+  patch_cache.n_points = patch_points.size();
+
+  // The values of the shape functions and the first data row of each
+  // field
+  UpdateFlags   mapping_flags = update_default;
+  unsigned int  data_row      = 0;
+
+  patch_cache.shape_data.resize(fields.size());
+
+  for (unsigned int f = 0; f < fields.size(); ++f)
+  {
+    const FiniteElement<dim> &fe = fields[f].field->get_dof_handler().get_fe();
+
+    const bool flag_gradients =
+      (fields[f].postprocessor != nullptr &&
+       (fields[f].postprocessor->get_needed_update_flags() & update_gradients));
+
+    if (fields[f].postprocessor != nullptr)
+      mapping_flags |= fields[f].postprocessor->get_needed_update_flags();
+
+    ShapeData &shape_data = patch_cache.shape_data[f];
+
+    shape_data.first_data_row = data_row;
+    shape_data.shape_components.resize(fe.dofs_per_cell);
+    shape_data.shape_values.reinit(fe.dofs_per_cell, patch_cache.n_points);
+    shape_data.shape_gradients.reinit(flag_gradients ? fe.dofs_per_cell : 0,
+                                      flag_gradients ? patch_cache.n_points : 0);
+
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+    {
+      const unsigned int component = fe.system_to_component_index(i).first;
+
+      shape_data.shape_components[i] = component;
+
+      for (unsigned int q = 0; q < patch_cache.n_points; ++q)
+      {
+        shape_data.shape_values(i, q) =
+          fe.shape_value_component(i, patch_points.point(q), component);
+
+        if (flag_gradients)
+          shape_data.shape_gradients(i, q) =
+            fe.shape_grad_component(i, patch_points.point(q), component);
+      }
+    }
+
+    data_row += (fields[f].postprocessor != nullptr ?
+                 fields[f].postprocessor->get_names().size() :
+                 fe.n_components());
+  }
+
+  // The geometric data required by the postprocessors
+  patch_cache.evaluation_points.clear();
+  patch_cache.covariant_transformations.clear();
+
+  if (mapping_flags & (update_gradients | update_quadrature_points))
+  {
+    FEValues<dim> fe_values(*mapping,
+                            fields.front().field->get_dof_handler().get_fe(),
+                            patch_points,
+                            update_quadrature_points |
+                            update_inverse_jacobians);
+
+    patch_cache.evaluation_points.reserve(patch_cache.cells.size() *
+                                          patch_cache.n_points);
+    patch_cache.covariant_transformations.reserve(patch_cache.cells.size() *
+                                                  patch_cache.n_points);
+
+    for (const auto &cell: patch_cache.cells)
+    {
+      fe_values.reinit(cell);
+
+      for (unsigned int q = 0; q < patch_cache.n_points; ++q)
+      {
+        patch_cache.evaluation_points.push_back(fe_values.quadrature_point(q));
+        patch_cache.covariant_transformations.push_back(
+          transpose(Tensor<2, dim>(fe_values.inverse_jacobian(q))));
+      }
+    }
+  }
+
+  patch_cache.valid = true;
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::interpolate_onto_patches
+(const std::vector<const LinearAlgebra::MPI::Vector *> &vectors,
+ std::vector<DataOutBase::Patch<dim, dim>>             &patches) const
+{
+  AssertDimension(vectors.size(), fields.size());
+  AssertDimension(patches.size(), patch_cache.cells.size());
+
+  const unsigned int n_points = patch_cache.n_points;
+
+  Vector<double>  local_values;
+
+  Vector<double>  point_values;
+
+  std::vector<Vector<double>>             computed_quantities(n_points);
+
+  DataPostprocessorInputs::Vector<dim>    vector_inputs;
+  DataPostprocessorInputs::Scalar<dim>    scalar_inputs;
+
+  for (unsigned int c = 0; c < patch_cache.cells.size(); ++c)
+  {
+    const auto &cell = patch_cache.cells[c];
+
+    Table<2, float> &patch_data = patches[c].data;
+
+    for (unsigned int f = 0; f < fields.size(); ++f)
+    {
+      const DoFHandler<dim>     &dof_handler = fields[f].field->get_dof_handler();
+      const FiniteElement<dim>  &fe = dof_handler.get_fe();
+      const ShapeData           &shape_data = patch_cache.shape_data[f];
+      const unsigned int         n_components = fe.n_components();
+
+      const typename DoFHandler<dim>::active_cell_iterator
+      dof_cell(&triangulation, cell->level(), cell->index(), &dof_handler);
+
+      local_values.reinit(fe.dofs_per_cell);
+      dof_cell->get_dof_values(*vectors[f], local_values);
+
+      const DataPostprocessor<dim> *postprocessor =
+        fields[f].postprocessor.get();
+
+      // Plain fields are interpolated directly into the patch. As in
+      // DataOut, the values are summed in double precision.
+      if (postprocessor == nullptr)
+      {
+        point_values.reinit(n_components);
+
+        for (unsigned int q = 0; q < n_points; ++q)
+        {
+          point_values = 0.;
+
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            point_values(shape_data.shape_components[i]) +=
+              local_values(i) * shape_data.shape_values(i, q);
+
+          for (unsigned int k = 0; k < n_components; ++k)
+            patch_data(shape_data.first_data_row + k, q) = point_values(k);
+        }
+
+        continue;
+      }
+
+      // Values and gradients at the subdivision points
+      const bool flag_gradients = (shape_data.shape_gradients.n_rows() > 0);
+
+      vector_inputs.solution_values.assign(n_points, Vector<double>(n_components));
+      vector_inputs.solution_gradients.assign(
+        n_points,
+        std::vector<Tensor<1, dim>>(flag_gradients ? n_components : 0));
+
+      for (unsigned int q = 0; q < n_points; ++q)
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        {
+          const unsigned int k = shape_data.shape_components[i];
+
+          vector_inputs.solution_values[q](k) +=
+            local_values(i) * shape_data.shape_values(i, q);
+
+          if (flag_gradients)
+            vector_inputs.solution_gradients[q][k] +=
+              local_values(i) *
+              (patch_cache.covariant_transformations[c * n_points + q] *
+               shape_data.shape_gradients(i, q));
+        }
+
+      if (!patch_cache.evaluation_points.empty())
+        vector_inputs.evaluation_points.assign(
+          patch_cache.evaluation_points.begin() + c * n_points,
+          patch_cache.evaluation_points.begin() + (c + 1) * n_points);
+
+      const unsigned int n_quantities = postprocessor->get_names().size();
+
+      for (auto &quantities: computed_quantities)
+        quantities.reinit(n_quantities);
+
+      if (n_components == 1)
+      {
+        scalar_inputs.solution_values.resize(n_points);
+        scalar_inputs.solution_gradients.resize(flag_gradients ? n_points : 0);
+
+        for (unsigned int q = 0; q < n_points; ++q)
+        {
+          scalar_inputs.solution_values[q] = vector_inputs.solution_values[q](0);
+          if (flag_gradients)
+            scalar_inputs.solution_gradients[q] = vector_inputs.solution_gradients[q][0];
+        }
+
+        scalar_inputs.evaluation_points = vector_inputs.evaluation_points;
+
+        postprocessor->evaluate_scalar_field(scalar_inputs, computed_quantities);
+      }
+      else
+        postprocessor->evaluate_vector_field(vector_inputs, computed_quantities);
+
+      for (unsigned int q = 0; q < n_points; ++q)
+        for (unsigned int k = 0; k < n_quantities; ++k)
+          patch_data(shape_data.first_data_row + k, q) = computed_quantities[q](k);
+    }
+  }
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::write_vtu
+(const DataOutInterface<dim> &data_out,
+ const unsigned int           index) const
+{
+  data_out.write_vtu_with_pvtu_record(prm.graphical_output_directory,
+                                      "solution",
+                                      index,
+                                      mpi_communicator,
+                                      5);
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::write_vtu_locally
+(const DataOutInterface<dim> &data_out,
+ const unsigned int           index) const
+{
+  const std::filesystem::path directory{prm.graphical_output_directory};
+
+  const std::string base_name =
+    "solution_" + Utilities::int_to_string(index, 5);
+
+  auto piece_name =
+    [&base_name](const unsigned int rank)
+    {
+      return (base_name + "." + Utilities::int_to_string(rank, 4) + ".vtu");
+    };
+
+  {
+    std::ofstream file((directory / piece_name(this_mpi_process)).string());
+    data_out.write_vtu(file);
+
+    AssertThrow(file,
+                ExcMessage("The file \"" + piece_name(this_mpi_process) +
+                           "\" could not be written."));
+  }
+
+  // The names of the pieces are known beforehand. Hence, the record can
+  // be written without communication.
+  if (this_mpi_process == 0)
+  {
+    std::vector<std::string>  piece_names;
+    for (unsigned int rank = 0; rank < n_mpi_processes; ++rank)
+      piece_names.push_back(piece_name(rank));
+
+    std::ofstream file((directory / (base_name + ".pvtu")).string());
+    data_out.write_pvtu_record(file, piece_names);
+  }
+}
+
+
+
+template <int dim>
+void GraphicalOutput<dim>::write_hdf5
+(const DataOutInterface<dim> &data_out,
+ const double                 time,
+ const unsigned int           index)
+{
+  #ifdef DEAL_II_WITH_HDF5
+    // Duplicated vertices are merged such that the mesh file only depends
+    // on the triangulation and not on the values of the fields.
+    DataOutBase::DataOutFilter
+    data_filter(DataOutBase::DataOutFilterFlags(true, true));
+
+    data_out.write_filtered_data(data_filter);
+
+    const bool flag_write_mesh = flag_mesh_changed;
+
+    if (flag_write_mesh)
+    {
+      ++n_meshes;
+      flag_mesh_changed = false;
+    }
+
+    // The XDMF file references the HDF5 files relative to its own
+    // location
+    const std::string mesh_file_name =
+      "mesh-" + Utilities::int_to_string(n_meshes - 1, 5) + ".h5";
+    const std::string solution_file_name =
+      "solution-" + Utilities::int_to_string(index, 5) + ".h5";
+
+    const std::filesystem::path directory{prm.graphical_output_directory};
+
+    data_out.write_hdf5_parallel(data_filter,
+                                 flag_write_mesh,
+                                 (directory / mesh_file_name).string(),
+                                 (directory / solution_file_name).string(),
+                                 mpi_communicator);
+
+    xdmf_entries.push_back(data_out.create_xdmf_entry(data_filter,
+                                                      mesh_file_name,
+                                                      solution_file_name,
+                                                      time,
+                                                      mpi_communicator));
+
+    data_out.write_xdmf_file(xdmf_entries,
+                             (directory / "solution.xdmf").string(),
+                             mpi_communicator);
+  #else
+    (void)data_out;
+    (void)time;
+    (void)index;
+
+    AssertThrow(false,
+                ExcMessage("The HDF5 output requires deal.II to be "
+                           "configured with HDF5."));
+  #endif
+}
+
+template <int dim>
+const std::vector<DataOutBase::Patch<dim, dim>> &
+GraphicalOutput<dim>::PatchCollection::get_patches() const
+{
+  return (patches);
+}
+
+
+
+template <int dim>
+std::vector<std::string>
+GraphicalOutput<dim>::PatchCollection::get_dataset_names() const
+{
+  return (dataset_names);
+}
+
+
+
+template <int dim>
+typename GraphicalOutput<dim>::NonscalarDataRanges
+GraphicalOutput<dim>::PatchCollection::get_nonscalar_data_ranges() const
+{
+  return (nonscalar_data_ranges);
+}
+
+} // namespace RMHD
+
+// explicit instantiations
+template class RMHD::GraphicalOutput<2>;
+template class RMHD::GraphicalOutput<3>;
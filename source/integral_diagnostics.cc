@@ -0,0 +1,324 @@
+#include <rotatingMHD/integral_diagnostics.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/work_stream.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/grid/filtered_iterator.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace RMHD
+{
+
+namespace
+{
+
+/*!
+ * @brief Scratch data of the loop over the cells. It contains the cell
+ * and face values of each field and the evaluated fields.
+ */
+template <int dim>
+struct DiagnosticsScratch
+{
+  DiagnosticsScratch(const Mapping<dim>                                     &mapping,
+                     const std::vector<const Entities::FE_FieldBase<dim> *> &fields,
+                     const std::vector<UpdateFlags>                         &update_flags,
+                     const unsigned int                                      n_quadrature_points);
+
+  DiagnosticsScratch(const DiagnosticsScratch<dim> &data);
+
+  const Mapping<dim>                                     &mapping;
+
+  const std::vector<const Entities::FE_FieldBase<dim> *> &fields;
+
+  const std::vector<UpdateFlags>                         &update_flags;
+
+  const unsigned int                                      n_quadrature_points;
+
+  std::vector<std::unique_ptr<FEValues<dim>>>             fe_values;
+
+  std::vector<std::unique_ptr<FEFaceValues<dim>>>         fe_face_values;
+
+  typename IntegralDiagnostics<dim>::QuadraturePointData  cell_data;
+
+  typename IntegralDiagnostics<dim>::QuadraturePointData  face_data;
+};
+
+
+
+template <int dim>
+DiagnosticsScratch<dim>::DiagnosticsScratch
+(const Mapping<dim>                                     &mapping,
+ const std::vector<const Entities::FE_FieldBase<dim> *> &fields,
+ const std::vector<UpdateFlags>                         &update_flags,
+ const unsigned int                                      n_quadrature_points)
+:
+mapping(mapping),
+fields(fields),
+update_flags(update_flags),
+n_quadrature_points(n_quadrature_points)
+{
+  const QGauss<dim>   quadrature_formula(n_quadrature_points);
+  const QGauss<dim-1> face_quadrature_formula(n_quadrature_points);
+
+  for (unsigned int i = 0; i < fields.size(); ++i)
+  {
+    const FiniteElement<dim> &fe = fields[i]->get_finite_element();
+
+    // The geometric data is only taken from the first field
+    fe_values.emplace_back(
+      std::make_unique<FEValues<dim>>(mapping,
+                                      fe,
+                                      quadrature_formula,
+                                      update_flags[i] |
+                                      (i == 0 ? update_JxW_values :
+                                                update_default)));
+    fe_face_values.emplace_back(
+      std::make_unique<FEFaceValues<dim>>(mapping,
+                                          fe,
+                                          face_quadrature_formula,
+                                          update_flags[i] |
+                                          (i == 0 ? update_JxW_values |
+                                                    update_normal_vectors :
+                                                    update_default)));
+
+    for (auto *data: {&cell_data, &face_data})
+    {
+      const unsigned int n_q_points = (data == &cell_data ?
+                                       quadrature_formula.size() :
+                                       face_quadrature_formula.size());
+
+      data->values.emplace_back(
+        (update_flags[i] & update_values) ? n_q_points : 0,
+        Vector<double>(fe.n_components()));
+      data->gradients.emplace_back(
+        (update_flags[i] & update_gradients) ? n_q_points : 0,
+        std::vector<Tensor<1,dim>>(fe.n_components()));
+    }
+  }
+
+  cell_data.JxW.resize(quadrature_formula.size());
+  face_data.JxW.resize(face_quadrature_formula.size());
+  face_data.normal_vectors.resize(face_quadrature_formula.size());
+}
+
+
+
+template <int dim>
+DiagnosticsScratch<dim>::DiagnosticsScratch(const DiagnosticsScratch<dim> &data)
+:
+DiagnosticsScratch<dim>(data.mapping,
+                        data.fields,
+                        data.update_flags,
+                        data.n_quadrature_points)
+{}
+
+
+
+/*!
+ * @brief Evaluates the fields at the quadrature points of the last cell
+ * or face @p fe_values was reinitialized on.
+ */
+template <int dim>
+void evaluate_field
+(const FEValuesBase<dim>                                &fe_values,
+ const Entities::FE_FieldBase<dim>                      &field,
+ const UpdateFlags                                       update_flags,
+ const unsigned int                                      i,
+ typename IntegralDiagnostics<dim>::QuadraturePointData &data)
+{
+  if (update_flags & update_values)
+    fe_values.get_function_values(field.solution, data.values[i]);
+
+  if (update_flags & update_gradients)
+    fe_values.get_function_gradients(field.solution, data.gradients[i]);
+}
+
+
+
+/*!
+ * @brief Returns the iterator of the DoFHandler @p dof_handler pointing
+ * to the same cell as @p cell.
+ */
+template <int dim>
+typename DoFHandler<dim>::active_cell_iterator
+dof_cell_iterator(const typename Triangulation<dim>::active_cell_iterator &cell,
+                  const DoFHandler<dim>                                   &dof_handler)
+{
+  return (typename DoFHandler<dim>::active_cell_iterator(&cell->get_triangulation(),
+                                                         cell->level(),
+                                                         cell->index(),
+                                                         &dof_handler));
+}
+
+} // namespace
+
+
+
+template <int dim>
+IntegralDiagnostics<dim>::IntegralDiagnostics
+(const Mapping<dim> &mapping)
+:
+mapping(mapping)
+{}
+
+
+
+template <int dim>
+unsigned int IntegralDiagnostics<dim>::add_field
+(const Entities::FE_FieldBase<dim> &field,
+ const UpdateFlags                  flags)
+{
+  Assert((flags & ~(update_values | update_gradients)) == update_default,
+         ExcMessage("Only the values and the gradients of a field can be "
+                    "evaluated."));
+
+  if (!fields.empty())
+    AssertThrow(&field.get_triangulation() == &fields.front()->get_triangulation(),
+                ExcMessage("The fields do not share the same triangulation."));
+
+  fields.push_back(&field);
+  update_flags.push_back(flags);
+
+  return (fields.size() - 1);
+}
+
+
+
+template <int dim>
+unsigned int IntegralDiagnostics<dim>::add_volume_integral
+(const unsigned int  n_integrals,
+ const Kernel       &kernel)
+{
+  volume_kernels.push_back({kernel, static_cast<unsigned int>(integrals.size()), {}});
+
+  integrals.resize(integrals.size() + n_integrals, 0.0);
+
+  return (volume_kernels.back().first_integral);
+}
+
+
+
+template <int dim>
+unsigned int IntegralDiagnostics<dim>::add_boundary_integral
+(const std::set<types::boundary_id> &ids,
+ const unsigned int                  n_integrals,
+ const Kernel                       &kernel)
+{
+  boundary_kernels.push_back({kernel, static_cast<unsigned int>(integrals.size()), ids});
+
+  boundary_ids.insert(ids.begin(), ids.end());
+
+  integrals.resize(integrals.size() + n_integrals, 0.0);
+
+  return (boundary_kernels.back().first_integral);
+}
+
+
+
+template <int dim>
+void IntegralDiagnostics<dim>::evaluate()
+{
+  AssertThrow(!fields.empty(),
+              ExcMessage("No field was added to the diagnostics."));
+
+  const Triangulation<dim> &triangulation = fields.front()->get_triangulation();
+
+  unsigned int n_quadrature_points = 0;
+  for (const auto field: fields)
+    n_quadrature_points = std::max(n_quadrature_points, field->fe_degree() + 1);
+
+  auto worker =
+    [&](const typename Triangulation<dim>::active_cell_iterator &cell,
+        DiagnosticsScratch<dim>                                  &scratch,
+        std::vector<double>                                      &data)
+    {
+      std::fill(data.begin(), data.end(), 0.0);
+
+      if (!volume_kernels.empty())
+      {
+        for (unsigned int i = 0; i < fields.size(); ++i)
+        {
+          scratch.fe_values[i]->reinit(
+            dof_cell_iterator(cell, fields[i]->get_dof_handler()));
+
+          evaluate_field(*scratch.fe_values[i],
+                         *fields[i],
+                         update_flags[i],
+                         i,
+                         scratch.cell_data);
+        }
+
+        scratch.cell_data.JxW = scratch.fe_values[0]->get_JxW_values();
+
+        for (const auto &kernel_data: volume_kernels)
+          kernel_data.kernel(scratch.cell_data,
+                             data.data() + kernel_data.first_integral);
+      }
+
+      if (boundary_kernels.empty() || !cell->at_boundary())
+        return;
+
+      for (const auto &face : cell->face_iterators())
+        if (face->at_boundary() &&
+            boundary_ids.find(face->boundary_id()) != boundary_ids.end())
+        {
+          for (unsigned int i = 0; i < fields.size(); ++i)
+          {
+            const typename DoFHandler<dim>::active_cell_iterator
+            dof_cell = dof_cell_iterator(cell, fields[i]->get_dof_handler());
+
+            scratch.fe_face_values[i]->reinit(dof_cell, face);
+
+            evaluate_field(*scratch.fe_face_values[i],
+                           *fields[i],
+                           update_flags[i],
+                           i,
+                           scratch.face_data);
+          }
+
+          scratch.face_data.JxW             = scratch.fe_face_values[0]->get_JxW_values();
+          scratch.face_data.normal_vectors  = scratch.fe_face_values[0]->get_normal_vectors();
+          scratch.face_data.boundary_id     = face->boundary_id();
+
+          for (const auto &kernel_data: boundary_kernels)
+            if (kernel_data.boundary_ids.find(face->boundary_id()) !=
+                kernel_data.boundary_ids.end())
+              kernel_data.kernel(scratch.face_data,
+                                 data.data() + kernel_data.first_integral);
+        }
+    };
+
+  std::fill(integrals.begin(), integrals.end(), 0.0);
+
+  auto copier =
+    [&](const std::vector<double> &data)
+    {
+      for (unsigned int i = 0; i < integrals.size(); ++i)
+        integrals[i] += data[i];
+    };
+
+  using CellFilter =
+    FilteredIterator<typename Triangulation<dim>::active_cell_iterator>;
+
+  WorkStream::run
+  (CellFilter(IteratorFilters::LocallyOwnedCell(),
+              triangulation.begin_active()),
+   CellFilter(IteratorFilters::LocallyOwnedCell(),
+              triangulation.end()),
+   worker,
+   copier,
+   DiagnosticsScratch<dim>(mapping, fields, update_flags, n_quadrature_points),
+   std::vector<double>(integrals.size()));
+
+  // The integrals of all processes are summed up at once
+  Utilities::MPI::sum(integrals, triangulation.get_communicator(), integrals);
+}
+
+} // namespace RMHD
+
+// explicit instantiations
+template class RMHD::IntegralDiagnostics<2>;
+template class RMHD::IntegralDiagnostics<3>;
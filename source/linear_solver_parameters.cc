@@ -9,6 +9,8 @@
 
 #include <deal.II/base/conditional_ostream.h>
 
+#include <sstream>
+
 namespace RMHD
 {
 
@@ -148,6 +150,7 @@ void PreconditionRelaxationParameters::parse_parameters(const ParameterHandler &
       AssertThrow(omega <= 2.0, ExcLowerRangeType<double>(2.0, omega));
 
       overlap = prm.get_integer("Overlap");
+
       n_sweeps = prm.get_integer("Number of sweeps");
 
       // Print a warning if PETSc is used
@@ -198,7 +201,9 @@ PreconditionBaseParameters("ILU", PreconditionerType::ILU),
 relative_tolerance(1.0),
 absolute_tolerance(0.0),
 fill(1),
-overlap(1)
+overlap(1),
+mixed_precision(false),
+strengthen_diagonal(0.0)
 {
   #ifdef USE_PETSC_LA
     AssertThrow(Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD) == 1,
@@ -229,6 +234,14 @@ void PreconditionILUParameters::declare_parameters(ParameterHandler &prm)
   prm.declare_entry("Overlap",
                     "1",
                     Patterns::Integer());
+
+  prm.declare_entry("Mixed precision",
+                    "false",
+                    Patterns::Bool());
+
+  prm.declare_entry("Strengthen diagonal",
+                    "0.0",
+                    Patterns::Double());
 }
 
 
@@ -253,6 +266,27 @@ void PreconditionILUParameters::parse_parameters(const ParameterHandler &prm)
 
   overlap = prm.get_integer("Overlap");
 
+  mixed_precision = prm.get_bool("Mixed precision");
+  #ifdef USE_PETSC_LA
+    AssertThrow(!mixed_precision,
+                ExcMessage("The mixed precision ILU is only implemented for "
+                           "the Trilinos library."));
+  #endif
+
+  if (mixed_precision)
+  {
+    AssertThrow(fill == 0,
+                ExcMessage("The mixed precision ILU does not support fill-in. "
+                           "Please set the fill-in level to zero."));
+    AssertThrow(overlap == 0,
+                ExcMessage("The mixed precision ILU does not support an "
+                           "overlap. Please set the overlap to zero."));
+  }
+
+  strengthen_diagonal = prm.get_double("Strengthen diagonal");
+  AssertThrow(strengthen_diagonal >= 0.0,
+              ExcLowerRangeType<double>(strengthen_diagonal, 0.0));
+
   // Print a warning if PETSc is used
   #ifdef USE_PETSC_LA
     ConditionalOStream pcout(std::cout,
@@ -283,6 +317,11 @@ Stream& operator<<(Stream &stream, const PreconditionILUParameters &prm)
   internal::add_line(stream, "  Overlap", prm.overlap);
   internal::add_line(stream, "  Relative tolerance", prm.relative_tolerance);
   internal::add_line(stream, "  Absolute tolerance", prm.absolute_tolerance);
+  if (prm.mixed_precision)
+  {
+    internal::add_line(stream, "  Mixed precision", "true");
+    internal::add_line(stream, "  Strengthen diagonal", prm.strengthen_diagonal);
+  }
 
   return (stream);
 }
@@ -370,6 +409,8 @@ LinearSolverParameters::LinearSolverParameters(const std::string &name)
 relative_tolerance(1e-6),
 absolute_tolerance(1e-9),
 n_maximum_iterations(50),
+solver_type(SolverType::Krylov),
+n_deflation_vectors(8),
 preconditioner_parameters_ptr(nullptr),
 solver_name(name)
 {}
@@ -378,6 +419,14 @@ solver_name(name)
 
 void LinearSolverParameters::declare_parameters(ParameterHandler &prm)
 {
+  prm.declare_entry("Solver type",
+                    "Krylov",
+                    Patterns::Selection("Krylov|direct|deflated CG|pipelined Krylov"));
+
+  prm.declare_entry("Deflation space dimension",
+                    "8",
+                    Patterns::Integer(1));
+
   prm.declare_entry("Maximum number of iterations",
                     "50",
                     Patterns::Integer(1));
@@ -406,6 +455,25 @@ void LinearSolverParameters::declare_parameters(ParameterHandler &prm)
 
 void LinearSolverParameters::parse_parameters(ParameterHandler &prm)
 {
+  {
+    const std::string str_solver_type(prm.get("Solver type"));
+
+    if (str_solver_type == std::string("Krylov"))
+      solver_type = SolverType::Krylov;
+    else if (str_solver_type == std::string("direct"))
+      solver_type = SolverType::direct;
+    else if (str_solver_type == std::string("deflated CG"))
+      solver_type = SolverType::deflated_CG;
+    else if (str_solver_type == std::string("pipelined Krylov"))
+      solver_type = SolverType::pipelined_Krylov;
+    else
+      AssertThrow(false,
+                  ExcMessage("Unexpected string for the solver type."));
+  }
+
+  n_deflation_vectors = prm.get_integer("Deflation space dimension");
+  AssertThrow(n_deflation_vectors > 0, ExcLowerRange(n_deflation_vectors, 0));
+
   n_maximum_iterations = prm.get_integer("Maximum number of iterations");
   AssertThrow(n_maximum_iterations > 0, ExcLowerRange(n_maximum_iterations, 0));
 
@@ -471,6 +539,26 @@ Stream& operator<<(Stream &stream, const LinearSolverParameters &prm)
                                 " - " + prm.solver_name : ""));
   internal::add_header(stream);
 
+  switch (prm.solver_type)
+  {
+    case SolverType::Krylov:
+      internal::add_line(stream, "Solver type", "Krylov");
+      break;
+    case SolverType::direct:
+      internal::add_line(stream, "Solver type", "direct");
+      break;
+    case SolverType::deflated_CG:
+      internal::add_line(stream, "Solver type", "deflated CG");
+      internal::add_line(stream, "  Deflation space dimension", prm.n_deflation_vectors);
+      break;
+    case SolverType::pipelined_Krylov:
+      internal::add_line(stream, "Solver type", "pipelined Krylov");
+      break;
+    default:
+      AssertThrow(false, ExcMessage("Unexpected type identifier for the solver type."));
+      break;
+  }
+
   internal::add_line(stream,
                      "Maximum number of iterations",
                      prm.n_maximum_iterations);
@@ -508,6 +596,48 @@ Stream& operator<<(Stream &stream, const LinearSolverParameters &prm)
   return (stream);
 }
 
+
+
+bool have_same_preconditioner(const LinearSolverParameters &prm,
+                              const LinearSolverParameters &other_prm)
+{
+  const PreconditionBaseParameters &preconditioner_prm =
+      *prm.preconditioner_parameters_ptr;
+  const PreconditionBaseParameters &other_preconditioner_prm =
+      *other_prm.preconditioner_parameters_ptr;
+
+  if (preconditioner_prm.preconditioner_type !=
+      other_preconditioner_prm.preconditioner_type)
+    return (false);
+
+  // The parameters are compared through their string representation
+  std::ostringstream  stream, other_stream;
+
+  switch (preconditioner_prm.preconditioner_type)
+  {
+    case PreconditionerType::AMG:
+      stream << static_cast<const PreconditionAMGParameters &>(preconditioner_prm);
+      other_stream << static_cast<const PreconditionAMGParameters &>(other_preconditioner_prm);
+      break;
+    case PreconditionerType::ILU:
+      stream << static_cast<const PreconditionILUParameters &>(preconditioner_prm);
+      other_stream << static_cast<const PreconditionILUParameters &>(other_preconditioner_prm);
+      break;
+    case PreconditionerType::Jacobi:
+      stream << static_cast<const PreconditionJacobiParameters &>(preconditioner_prm);
+      other_stream << static_cast<const PreconditionJacobiParameters &>(other_preconditioner_prm);
+      break;
+    case PreconditionerType::SSOR:
+      stream << static_cast<const PreconditionSSORParameters &>(preconditioner_prm);
+      other_stream << static_cast<const PreconditionSSORParameters &>(other_preconditioner_prm);
+      break;
+    default:
+      return (false);
+  }
+
+  return (stream.str() == other_stream.str());
+}
+
 } // namespace RunTimeParameters
 
 } // namespace RMHD
@@ -0,0 +1,958 @@
+#include <rotatingMHD/linear_solvers.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#ifdef USE_PETSC_LA
+  #include <deal.II/lac/exceptions.h>
+  #include <petscvec.h>
+#else
+  #include <deal.II/lac/dynamic_sparsity_pattern.h>
+  #include <deal.II/lac/sparse_ilu.h>
+  #include <deal.II/lac/sparse_matrix.h>
+  #include <deal.II/lac/sparsity_pattern.h>
+
+  #include <Amesos.h>
+  #include <Epetra_Map.h>
+  #include <Epetra_MultiVector.h>
+  #include <Epetra_Operator.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace RMHD
+{
+
+namespace
+{
+
+/*!
+ * @brief Adds the locally owned contributions of the dot products of
+ * @p vector with each entry of @p other_vectors to @p dot_products.
+ *
+ * @details The global values are obtained through a reduction, which is
+ * left to the caller such that it can be done in a non-blocking manner.
+ */
+void add_local_dot_products
+(const LinearAlgebra::MPI::Vector                      &vector,
+ const std::vector<const LinearAlgebra::MPI::Vector *> &other_vectors,
+ double                                                *dot_products)
+{
+  #ifdef USE_PETSC_LA
+    PetscInt            n_local_entries;
+    const PetscScalar  *values;
+
+    PetscErrorCode ierr = VecGetLocalSize(vector, &n_local_entries);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    ierr = VecGetArrayRead(vector, &values);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+    for (unsigned int i = 0; i < other_vectors.size(); ++i)
+    {
+      const PetscScalar  *other_values;
+      ierr = VecGetArrayRead(*other_vectors[i], &other_values);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+      for (PetscInt k = 0; k < n_local_entries; ++k)
+        dot_products[i] += values[k] * other_values[k];
+
+      ierr = VecRestoreArrayRead(*other_vectors[i], &other_values);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+
+    ierr = VecRestoreArrayRead(vector, &values);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+  #else
+    const int     n_local_entries = vector.trilinos_vector().MyLength();
+    const double *values          = vector.trilinos_vector()[0];
+
+    for (unsigned int i = 0; i < other_vectors.size(); ++i)
+    {
+      const double *other_values = other_vectors[i]->trilinos_vector()[0];
+
+      for (int k = 0; k < n_local_entries; ++k)
+        dot_products[i] += values[k] * other_values[k];
+    }
+  #endif
+}
+
+
+
+#ifndef USE_PETSC_LA
+/*!
+ * @brief An Epetra operator whose inverse is the application of an ILU
+ * factorization of the locally owned diagonal block of a matrix stored
+ * in single precision.
+ *
+ * @details The ordering of the local entries of an Epetra vector
+ * coincides with the position of the global index inside the locally
+ * owned IndexSet. The latter is hence used to map the global indices of
+ * the matrix to the local ones of the block.
+ */
+class SinglePrecisionILUOperator : public Epetra_Operator
+{
+public:
+  SinglePrecisionILUOperator(const LinearAlgebra::MPI::SparseMatrix &matrix,
+                             const double strengthen_diagonal);
+
+  int SetUseTranspose(bool) override
+  {
+    return (-1);
+  }
+
+  int Apply(const Epetra_MultiVector &, Epetra_MultiVector &) const override
+  {
+    return (-1);
+  }
+
+  int ApplyInverse(const Epetra_MultiVector &src,
+                   Epetra_MultiVector       &dst) const override;
+
+  double NormInf() const override
+  {
+    return (0.0);
+  }
+
+  const char *Label() const override
+  {
+    return ("Single precision ILU");
+  }
+
+  bool UseTranspose() const override
+  {
+    return (false);
+  }
+
+  bool HasNormInf() const override
+  {
+    return (false);
+  }
+
+  const Epetra_Comm &Comm() const override
+  {
+    return (range_map.Comm());
+  }
+
+  const Epetra_Map &OperatorDomainMap() const override
+  {
+    return (domain_map);
+  }
+
+  const Epetra_Map &OperatorRangeMap() const override
+  {
+    return (range_map);
+  }
+
+  std::size_t memory_consumption() const
+  {
+    return (sparsity_pattern.memory_consumption() +
+            matrix.memory_consumption() +
+            ilu.memory_consumption() +
+            src_float.memory_consumption() +
+            dst_float.memory_consumption());
+  }
+
+private:
+  const Epetra_Map          domain_map;
+
+  const Epetra_Map          range_map;
+
+  SparsityPattern           sparsity_pattern;
+
+  SparseMatrix<float>       matrix;
+
+  SparseILU<float>          ilu;
+
+  mutable Vector<float>     src_float;
+
+  mutable Vector<float>     dst_float;
+};
+
+
+
+SinglePrecisionILUOperator::SinglePrecisionILUOperator
+(const LinearAlgebra::MPI::SparseMatrix &system_matrix,
+ const double                            strengthen_diagonal)
+:
+domain_map(system_matrix.trilinos_matrix().DomainMap()),
+range_map(system_matrix.trilinos_matrix().RangeMap())
+{
+  const IndexSet  locally_owned_rows = system_matrix.locally_owned_range_indices();
+  const unsigned int n_local_rows = locally_owned_rows.n_elements();
+
+  // Sparsity pattern of the locally owned diagonal block
+  {
+    DynamicSparsityPattern  dsp(n_local_rows, n_local_rows);
+
+    for (const auto row: locally_owned_rows)
+    {
+      const unsigned int local_row = locally_owned_rows.index_within_set(row);
+
+      dsp.add(local_row, local_row);
+
+      for (auto entry = system_matrix.begin(row);
+           entry != system_matrix.end(row); ++entry)
+        if (locally_owned_rows.is_element(entry->column()))
+          dsp.add(local_row,
+                  locally_owned_rows.index_within_set(entry->column()));
+    }
+
+    sparsity_pattern.copy_from(dsp);
+  }
+
+  // Single precision copy of the locally owned diagonal block
+  matrix.reinit(sparsity_pattern);
+
+  for (const auto row: locally_owned_rows)
+  {
+    const unsigned int local_row = locally_owned_rows.index_within_set(row);
+
+    for (auto entry = system_matrix.begin(row);
+         entry != system_matrix.end(row); ++entry)
+      if (locally_owned_rows.is_element(entry->column()))
+        matrix.set(local_row,
+                   locally_owned_rows.index_within_set(entry->column()),
+                   static_cast<float>(entry->value()));
+  }
+
+  ilu.initialize(matrix,
+                 SparseILU<float>::AdditionalData(strengthen_diagonal));
+
+  src_float.reinit(n_local_rows);
+  dst_float.reinit(n_local_rows);
+}
+
+
+
+int SinglePrecisionILUOperator::ApplyInverse
+(const Epetra_MultiVector &src,
+ Epetra_MultiVector       &dst) const
+{
+  AssertDimension(static_cast<unsigned int>(src.MyLength()), src_float.size());
+  AssertDimension(static_cast<unsigned int>(dst.MyLength()), dst_float.size());
+
+  for (int v = 0; v < src.NumVectors(); ++v)
+  {
+    for (unsigned int k = 0; k < src_float.size(); ++k)
+      src_float[k] = static_cast<float>(src[v][k]);
+
+    ilu.vmult(dst_float, src_float);
+
+    for (unsigned int k = 0; k < dst_float.size(); ++k)
+      dst[v][k] = static_cast<double>(dst_float[k]);
+  }
+
+  return (0);
+}
+#endif
+
+} // namespace
+
+
+
+DirectSolver::DirectSolver(const MPI_Comm &mpi_communicator)
+:
+mpi_communicator(mpi_communicator),
+solver_control(1, 0),
+solver(),
+matrix_ptr(nullptr)
+{}
+
+
+
+void DirectSolver::initialize(const LinearAlgebra::MPI::SparseMatrix &matrix)
+{
+  clear();
+
+  matrix_ptr = &matrix;
+
+  #ifdef USE_PETSC_LA
+    // The factorization is computed by PETSc during the first call of
+    // solve and it is kept for all subsequent calls.
+    solver = std::make_unique<LinearAlgebra::SolverDirect>(solver_control,
+                                                           mpi_communicator);
+    solver->set_symmetric_mode(false);
+  #else
+    // MUMPS is preferred as it is a distributed solver. If Trilinos was
+    // not configured with it, the serial KLU solver is used as fallback.
+    Amesos  factory;
+    const std::string solver_type(factory.Query("Amesos_Mumps") ?
+                                  "Amesos_Mumps" : "Amesos_Klu");
+
+    solver = std::make_unique<LinearAlgebra::SolverDirect>(
+      solver_control,
+      LinearAlgebra::SolverDirect::AdditionalData(false, solver_type));
+
+    solver->initialize(matrix);
+  #endif
+}
+
+
+
+void DirectSolver::solve
+(LinearAlgebra::MPI::Vector       &solution,
+ const LinearAlgebra::MPI::Vector &rhs)
+{
+  AssertThrow(is_initialized(),
+              ExcMessage("The factorization of the direct solver has not "
+                         "been computed."));
+
+  #ifdef USE_PETSC_LA
+    solver->solve(*matrix_ptr, solution, rhs);
+  #else
+    solver->solve(solution, rhs);
+  #endif
+}
+
+
+
+void DirectSolver::clear()
+{
+  solver.reset();
+  matrix_ptr = nullptr;
+}
+
+
+
+DeflatedCG::DeflatedCG(const unsigned int n_deflation_vectors)
+:
+n_deflation_vectors(n_deflation_vectors)
+{}
+
+
+
+void DeflatedCG::set_n_deflation_vectors(const unsigned int n_vectors)
+{
+  AssertThrow(n_vectors > 0, ExcLowerRange(n_vectors, 0));
+
+  if (n_vectors != n_deflation_vectors)
+  {
+    n_deflation_vectors = n_vectors;
+    clear();
+  }
+}
+
+
+
+void DeflatedCG::solve
+(SolverControl                           &solver_control,
+ const LinearAlgebra::MPI::SparseMatrix  &matrix,
+ LinearAlgebra::MPI::Vector              &solution,
+ const LinearAlgebra::MPI::Vector        &rhs,
+ const LinearAlgebra::PreconditionBase   &preconditioner)
+{
+  // The deflation space of a linear system of a different size is
+  // meaningless.
+  if (!deflation_vectors.empty() &&
+      deflation_vectors.front().size() != rhs.size())
+    clear();
+
+  search_directions.clear();
+  matrix_times_search_directions.clear();
+
+  LinearAlgebra::MPI::Vector  residual;
+  LinearAlgebra::MPI::Vector  preconditioned_residual;
+  LinearAlgebra::MPI::Vector  search_direction;
+  LinearAlgebra::MPI::Vector  matrix_times_search_direction;
+
+  residual.reinit(rhs);
+  preconditioned_residual.reinit(rhs);
+  search_direction.reinit(rhs);
+  matrix_times_search_direction.reinit(rhs);
+
+  matrix.vmult(residual, solution);
+  residual.sadd(-1., 1., rhs);
+
+  // The initial guess is corrected such that its residual is orthogonal
+  // to the deflation space. As the basis is A-orthonormal, the coarse
+  // matrix is the identity.
+  {
+    std::vector<double> coefficients(deflation_vectors.size());
+
+    for (unsigned int i = 0; i < deflation_vectors.size(); ++i)
+      coefficients[i] = deflation_vectors[i] * residual;
+
+    for (unsigned int i = 0; i < deflation_vectors.size(); ++i)
+    {
+      solution.add(coefficients[i], deflation_vectors[i]);
+      residual.add(-coefficients[i], matrix_times_deflation_vectors[i]);
+    }
+  }
+
+  unsigned int step = 0;
+
+  SolverControl::State state = solver_control.check(step, residual.l2_norm());
+
+  if (state == SolverControl::iterate)
+  {
+    preconditioner.vmult(preconditioned_residual, residual);
+
+    search_direction = preconditioned_residual;
+    deflate(search_direction, preconditioned_residual);
+
+    double residual_times_preconditioned_residual =
+      residual * preconditioned_residual;
+
+    while (state == SolverControl::iterate)
+    {
+      ++step;
+
+      matrix.vmult(matrix_times_search_direction, search_direction);
+
+      const double curvature = search_direction * matrix_times_search_direction;
+
+      AssertThrow(curvature > 0.,
+                  ExcMessage("The matrix of the deflated conjugate gradient "
+                             "method is not positive definite."));
+
+      const double alpha = residual_times_preconditioned_residual / curvature;
+
+      // The first search directions are stored for the update of the
+      // deflation space.
+      if (search_directions.size() < n_deflation_vectors)
+      {
+        search_directions.push_back(search_direction);
+        matrix_times_search_directions.push_back(matrix_times_search_direction);
+      }
+
+      solution.add(alpha, search_direction);
+      residual.add(-alpha, matrix_times_search_direction);
+
+      state = solver_control.check(step, residual.l2_norm());
+
+      if (state != SolverControl::iterate)
+        break;
+
+      preconditioner.vmult(preconditioned_residual, residual);
+
+      const double old_residual_times_preconditioned_residual =
+        residual_times_preconditioned_residual;
+
+      residual_times_preconditioned_residual = residual * preconditioned_residual;
+
+      const double beta = residual_times_preconditioned_residual /
+                          old_residual_times_preconditioned_residual;
+
+      search_direction.sadd(beta, 1., preconditioned_residual);
+      deflate(search_direction, preconditioned_residual);
+    }
+  }
+
+  AssertThrow(state == SolverControl::success,
+              SolverControl::NoConvergence(solver_control.last_step(),
+                                           solver_control.last_value()));
+
+  update_deflation_space();
+}
+
+
+
+void DeflatedCG::clear()
+{
+  deflation_vectors.clear();
+  matrix_times_deflation_vectors.clear();
+  search_directions.clear();
+  matrix_times_search_directions.clear();
+}
+
+
+
+std::size_t DeflatedCG::memory_consumption() const
+{
+  std::size_t memory = 0;
+
+  for (const auto *vectors: {&deflation_vectors,
+                             &matrix_times_deflation_vectors,
+                             &search_directions,
+                             &matrix_times_search_directions})
+    for (const auto &vector: *vectors)
+      memory += vector.memory_consumption();
+
+  return (memory);
+}
+
+
+
+void DeflatedCG::deflate
+(LinearAlgebra::MPI::Vector       &dst,
+ const LinearAlgebra::MPI::Vector &src) const
+{
+  for (unsigned int i = 0; i < deflation_vectors.size(); ++i)
+    dst.add(-(matrix_times_deflation_vectors[i] * src), deflation_vectors[i]);
+}
+
+
+
+void DeflatedCG::update_deflation_space()
+{
+  if (search_directions.empty())
+    return;
+
+  std::vector<const LinearAlgebra::MPI::Vector *> basis;
+  std::vector<const LinearAlgebra::MPI::Vector *> matrix_times_basis;
+
+  for (unsigned int i = 0; i < deflation_vectors.size(); ++i)
+  {
+    basis.push_back(&deflation_vectors[i]);
+    matrix_times_basis.push_back(&matrix_times_deflation_vectors[i]);
+  }
+  for (unsigned int i = 0; i < search_directions.size(); ++i)
+  {
+    basis.push_back(&search_directions[i]);
+    matrix_times_basis.push_back(&matrix_times_search_directions[i]);
+  }
+
+  const unsigned int n_vectors = basis.size();
+
+  // The basis vectors are scaled to unit length to improve the
+  // conditioning of the Gram matrix.
+  std::vector<double> scaling_factors(n_vectors);
+  for (unsigned int i = 0; i < n_vectors; ++i)
+    scaling_factors[i] = 1.0 / basis[i]->l2_norm();
+
+  LAPACKFullMatrix<double>  projected_matrix(n_vectors);
+  LAPACKFullMatrix<double>  gram_matrix(n_vectors);
+
+  for (unsigned int i = 0; i < n_vectors; ++i)
+    for (unsigned int j = 0; j <= i; ++j)
+    {
+      const double scaling = scaling_factors[i] * scaling_factors[j];
+
+      projected_matrix(i, j) = 0.5 * scaling *
+                               ((*basis[i]) * (*matrix_times_basis[j]) +
+                                (*basis[j]) * (*matrix_times_basis[i]));
+      projected_matrix(j, i) = projected_matrix(i, j);
+
+      gram_matrix(i, j) = scaling * ((*basis[i]) * (*basis[j]));
+      gram_matrix(j, i) = gram_matrix(i, j);
+    }
+
+  const unsigned int n_ritz_vectors = std::min(n_deflation_vectors, n_vectors);
+
+  std::vector<Vector<double>> eigenvectors(n_ritz_vectors);
+
+  // The stored search directions may be numerically linear dependent,
+  // e.g., if the solver converged in very few iterations. In this case
+  // the current deflation space is kept.
+  try
+  {
+    projected_matrix.compute_generalized_eigenvalues_symmetric(gram_matrix,
+                                                               eigenvectors);
+  }
+  catch (std::exception &)
+  {
+    search_directions.clear();
+    matrix_times_search_directions.clear();
+    return;
+  }
+
+  std::vector<LinearAlgebra::MPI::Vector> ritz_vectors;
+  std::vector<LinearAlgebra::MPI::Vector> matrix_times_ritz_vectors;
+
+  // The eigenvalues are sorted in ascending order. The Ritz vectors are
+  // orthonormal, i.e., scaling them by the inverse square root of their
+  // Ritz value makes them A-orthonormal.
+  for (unsigned int k = 0; k < n_ritz_vectors; ++k)
+  {
+    const double ritz_value = projected_matrix.eigenvalue(k).real();
+
+    if (!(ritz_value > 0.))
+      continue;
+
+    LinearAlgebra::MPI::Vector  ritz_vector(*basis.front());
+    LinearAlgebra::MPI::Vector  matrix_times_ritz_vector(*basis.front());
+
+    ritz_vector               = 0.;
+    matrix_times_ritz_vector  = 0.;
+
+    for (unsigned int j = 0; j < n_vectors; ++j)
+    {
+      const double coefficient = eigenvectors[k](j) * scaling_factors[j];
+
+      ritz_vector.add(coefficient, *basis[j]);
+      matrix_times_ritz_vector.add(coefficient, *matrix_times_basis[j]);
+    }
+
+    ritz_vector               *= 1.0 / std::sqrt(ritz_value);
+    matrix_times_ritz_vector  *= 1.0 / std::sqrt(ritz_value);
+
+    ritz_vectors.push_back(ritz_vector);
+    matrix_times_ritz_vectors.push_back(matrix_times_ritz_vector);
+  }
+
+  deflation_vectors.swap(ritz_vectors);
+  matrix_times_deflation_vectors.swap(matrix_times_ritz_vectors);
+
+  search_directions.clear();
+  matrix_times_search_directions.clear();
+}
+
+
+
+PipelinedCG::PipelinedCG(SolverControl &solver_control)
+:
+solver_control(solver_control)
+{}
+
+
+
+void PipelinedCG::solve
+(const LinearAlgebra::MPI::SparseMatrix  &matrix,
+ LinearAlgebra::MPI::Vector              &solution,
+ const LinearAlgebra::MPI::Vector        &rhs,
+ const LinearAlgebra::PreconditionBase   &preconditioner)
+{
+  const MPI_Comm mpi_communicator = rhs.get_mpi_communicator();
+
+  // The notation follows Algorithm 4 of Ghysels and Vanroose (2014).
+  LinearAlgebra::MPI::Vector  r, u, w, m, n, z, q, s, p;
+
+  r.reinit(rhs);
+  u.reinit(rhs);
+  w.reinit(rhs);
+  m.reinit(rhs);
+  n.reinit(rhs);
+  z.reinit(rhs);
+  q.reinit(rhs);
+  s.reinit(rhs);
+  p.reinit(rhs);
+
+  matrix.vmult(r, solution);
+  r.sadd(-1., 1., rhs);
+
+  preconditioner.vmult(u, r);
+  matrix.vmult(w, u);
+
+  double alpha  = 0.;
+  double gamma  = 0.;
+
+  std::vector<double> dot_products(3);
+
+  SolverControl::State state = SolverControl::iterate;
+
+  for (unsigned int step = 0; state == SolverControl::iterate; ++step)
+  {
+    // Local contributions of (r,u), (w,u) and (r,r)
+    std::fill(dot_products.begin(), dot_products.end(), 0.);
+    add_local_dot_products(u, {&r, &w}, dot_products.data());
+    add_local_dot_products(r, {&r}, dot_products.data() + 2);
+
+    MPI_Request request;
+    int ierr = MPI_Iallreduce(MPI_IN_PLACE,
+                              dot_products.data(),
+                              static_cast<int>(dot_products.size()),
+                              MPI_DOUBLE,
+                              MPI_SUM,
+                              mpi_communicator,
+                              &request);
+    AssertThrowMPI(ierr);
+
+    // The reduction is overlapped with the application of the
+    // preconditioner and the matrix-vector product.
+    preconditioner.vmult(m, w);
+    matrix.vmult(n, m);
+
+    ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+
+    state = solver_control.check(step, std::sqrt(dot_products[2]));
+
+    if (state != SolverControl::iterate)
+      break;
+
+    const double old_gamma  = gamma;
+    gamma                   = dot_products[0];
+    const double delta      = dot_products[1];
+
+    double beta = 0.;
+    if (step > 0)
+    {
+      beta  = gamma / old_gamma;
+      alpha = gamma / (delta - beta * gamma / alpha);
+    }
+    else
+      alpha = gamma / delta;
+
+    AssertThrow(alpha > 0. && std::isfinite(alpha),
+                ExcMessage("Breakdown of the pipelined conjugate gradient "
+                           "method. The matrix or the preconditioner might "
+                           "not be symmetric positive definite."));
+
+    z.sadd(beta, 1., n);
+    q.sadd(beta, 1., m);
+    s.sadd(beta, 1., w);
+    p.sadd(beta, 1., u);
+
+    solution.add(alpha, p);
+    r.add(-alpha, s);
+    u.add(-alpha, q);
+    w.add(-alpha, z);
+  }
+
+  AssertThrow(state == SolverControl::success,
+              SolverControl::NoConvergence(solver_control.last_step(),
+                                           solver_control.last_value()));
+}
+
+
+
+PipelinedGMRES::PipelinedGMRES
+(SolverControl      &solver_control,
+ const unsigned int  n_restart_vectors)
+:
+solver_control(solver_control),
+n_restart_vectors(n_restart_vectors)
+{
+  AssertThrow(n_restart_vectors > 0,
+              ExcLowerRange(n_restart_vectors, 0));
+}
+
+
+
+void PipelinedGMRES::solve
+(const LinearAlgebra::MPI::SparseMatrix  &matrix,
+ LinearAlgebra::MPI::Vector              &solution,
+ const LinearAlgebra::MPI::Vector        &rhs,
+ const LinearAlgebra::PreconditionBase   &preconditioner)
+{
+  const MPI_Comm mpi_communicator = rhs.get_mpi_communicator();
+
+  const unsigned int n_max = n_restart_vectors;
+
+  // The basis vectors v_i of the Krylov subspace and their images
+  // z_i = A M^{-1} v_i.
+  std::vector<LinearAlgebra::MPI::Vector> basis(n_max + 1);
+  std::vector<LinearAlgebra::MPI::Vector> images(n_max + 1);
+
+  LinearAlgebra::MPI::Vector  tmp;
+  tmp.reinit(rhs);
+
+  FullMatrix<double>  hessenberg_matrix(n_max + 1, n_max);
+  Vector<double>      givens_cosines(n_max);
+  Vector<double>      givens_sines(n_max);
+  Vector<double>      projected_rhs(n_max + 1);
+  Vector<double>      coefficients(n_max);
+
+  std::vector<const LinearAlgebra::MPI::Vector *> reduction_vectors;
+  std::vector<double>                             dot_products;
+
+  unsigned int step = 0;
+
+  SolverControl::State state = SolverControl::iterate;
+
+  while (state == SolverControl::iterate)
+  {
+    basis[0].reinit(rhs);
+    matrix.vmult(basis[0], solution);
+    basis[0].sadd(-1., 1., rhs);
+
+    const double residual_norm = basis[0].l2_norm();
+
+    state = solver_control.check(step, residual_norm);
+
+    if (state != SolverControl::iterate)
+      break;
+
+    basis[0] *= 1.0 / residual_norm;
+
+    images[0].reinit(rhs);
+    preconditioner.vmult(tmp, basis[0]);
+    matrix.vmult(images[0], tmp);
+
+    hessenberg_matrix = 0.;
+    projected_rhs     = 0.;
+    projected_rhs(0)  = residual_norm;
+
+    unsigned int j = 0;
+
+    for (; j < n_max && state == SolverControl::iterate; ++j)
+    {
+      ++step;
+
+      // Local contributions of (z_j, v_i) for i = 0,...,j and of (z_j, z_j)
+      reduction_vectors.clear();
+      for (unsigned int i = 0; i <= j; ++i)
+        reduction_vectors.push_back(&basis[i]);
+      reduction_vectors.push_back(&images[j]);
+
+      dot_products.assign(j + 2, 0.);
+      add_local_dot_products(images[j],
+                             reduction_vectors,
+                             dot_products.data());
+
+      MPI_Request request;
+      int ierr = MPI_Iallreduce(MPI_IN_PLACE,
+                                dot_products.data(),
+                                static_cast<int>(dot_products.size()),
+                                MPI_DOUBLE,
+                                MPI_SUM,
+                                mpi_communicator,
+                                &request);
+      AssertThrowMPI(ierr);
+
+      // The reduction is overlapped with the application of the
+      // preconditioned operator to the image z_j.
+      images[j + 1].reinit(rhs);
+      preconditioner.vmult(tmp, images[j]);
+      matrix.vmult(images[j + 1], tmp);
+
+      ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      double norm_squared = dot_products[j + 1];
+      for (unsigned int i = 0; i <= j; ++i)
+      {
+        hessenberg_matrix(i, j) = dot_products[i];
+        norm_squared           -= dot_products[i] * dot_products[i];
+      }
+
+      // v_{j+1} = z_j - sum_i h_ij v_i and z_{j+1} = A M^{-1} z_j - sum_i h_ij z_i
+      basis[j + 1] = images[j];
+      for (unsigned int i = 0; i <= j; ++i)
+      {
+        basis[j + 1].add(-dot_products[i], basis[i]);
+        images[j + 1].add(-dot_products[i], images[i]);
+      }
+
+      // If the norm suffers from cancellation, the orthogonality of the
+      // new basis vector is not guaranteed either. In this case a second
+      // orthogonalization pass with a blocking reduction is done.
+      if (norm_squared <= 1e-2 * dot_products[j + 1])
+      {
+        reduction_vectors.back() = &basis[j + 1];
+
+        dot_products.assign(j + 2, 0.);
+        add_local_dot_products(basis[j + 1],
+                               reduction_vectors,
+                               dot_products.data());
+
+        ierr = MPI_Allreduce(MPI_IN_PLACE,
+                             dot_products.data(),
+                             static_cast<int>(dot_products.size()),
+                             MPI_DOUBLE,
+                             MPI_SUM,
+                             mpi_communicator);
+        AssertThrowMPI(ierr);
+
+        norm_squared = dot_products[j + 1];
+        for (unsigned int i = 0; i <= j; ++i)
+        {
+          hessenberg_matrix(i, j) += dot_products[i];
+          norm_squared            -= dot_products[i] * dot_products[i];
+
+          basis[j + 1].add(-dot_products[i], basis[i]);
+          images[j + 1].add(-dot_products[i], images[i]);
+        }
+      }
+
+      const double norm = std::sqrt(std::max(norm_squared, 0.));
+
+      hessenberg_matrix(j + 1, j) = norm;
+
+      // Lucky breakdown, i.e., the Krylov subspace is invariant.
+      if (norm > 0.)
+      {
+        basis[j + 1]  *= 1.0 / norm;
+        images[j + 1] *= 1.0 / norm;
+      }
+
+      // Apply the previous Givens rotations to the new column...
+      for (unsigned int i = 0; i < j; ++i)
+      {
+        const double h_ij   = hessenberg_matrix(i, j);
+        const double h_i1j  = hessenberg_matrix(i + 1, j);
+
+        hessenberg_matrix(i, j)     =  givens_cosines(i) * h_ij + givens_sines(i) * h_i1j;
+        hessenberg_matrix(i + 1, j) = -givens_sines(i) * h_ij + givens_cosines(i) * h_i1j;
+      }
+
+      // ...and compute the one eliminating the subdiagonal entry.
+      const double denominator = std::sqrt(hessenberg_matrix(j, j) * hessenberg_matrix(j, j) +
+                                           hessenberg_matrix(j + 1, j) * hessenberg_matrix(j + 1, j));
+
+      AssertThrow(denominator > 0.,
+                  ExcMessage("Breakdown of the pipelined GMRES method."));
+
+      givens_cosines(j) = hessenberg_matrix(j, j) / denominator;
+      givens_sines(j)   = hessenberg_matrix(j + 1, j) / denominator;
+
+      hessenberg_matrix(j, j)     = denominator;
+      hessenberg_matrix(j + 1, j) = 0.;
+
+      projected_rhs(j + 1)  = -givens_sines(j) * projected_rhs(j);
+      projected_rhs(j)      =  givens_cosines(j) * projected_rhs(j);
+
+      state = solver_control.check(step, std::abs(projected_rhs(j + 1)));
+
+      if (norm == 0. && state == SolverControl::iterate)
+      {
+        ++j;
+        break;
+      }
+    }
+
+    // Solve the upper triangular system by backward substitution...
+    for (int k = j - 1; k >= 0; --k)
+    {
+      double value = projected_rhs(k);
+      for (unsigned int l = k + 1; l < j; ++l)
+        value -= hessenberg_matrix(k, l) * coefficients(l);
+      coefficients(k) = value / hessenberg_matrix(k, k);
+    }
+
+    // ...and update the solution, x = x + M^{-1} V y
+    basis[n_max].reinit(rhs);
+    LinearAlgebra::MPI::Vector &correction = basis[n_max];
+    for (unsigned int k = 0; k < j; ++k)
+      correction.add(coefficients(k), basis[k]);
+
+    preconditioner.vmult(tmp, correction);
+    solution += tmp;
+  }
+
+  AssertThrow(state == SolverControl::success,
+              SolverControl::NoConvergence(solver_control.last_step(),
+                                           solver_control.last_value()));
+}
+
+
+
+
+#ifndef USE_PETSC_LA
+PreconditionMixedPrecisionILU::AdditionalData::AdditionalData
+(const double strengthen_diagonal)
+:
+strengthen_diagonal(strengthen_diagonal)
+{}
+
+
+
+void PreconditionMixedPrecisionILU::initialize
+(const LinearAlgebra::MPI::SparseMatrix &matrix,
+ const AdditionalData                   &additional_data)
+{
+  AssertThrow(additional_data.strengthen_diagonal >= 0.0,
+              ExcLowerRangeType<double>(additional_data.strengthen_diagonal, 0.0));
+
+  clear();
+
+  preconditioner = Teuchos::rcp(
+    new SinglePrecisionILUOperator(matrix,
+                                   additional_data.strengthen_diagonal));
+}
+
+
+
+std::size_t PreconditionMixedPrecisionILU::memory_consumption() const
+{
+  const SinglePrecisionILUOperator *ilu_operator =
+    dynamic_cast<const SinglePrecisionILUOperator *>(preconditioner.get());
+
+  return (ilu_operator != nullptr ? ilu_operator->memory_consumption() : 0);
+}
+#endif
+
+} // namespace RMHD
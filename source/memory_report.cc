@@ -0,0 +1,129 @@
+#include <rotatingMHD/memory_report.h>
+
+#include <deal.II/base/conditional_ostream.h>
+
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+namespace RMHD
+{
+
+namespace internal
+{
+  constexpr char header[] = "+------------------------------------------------+"
+                            "------------+------------+------------+";
+
+  constexpr size_t column_width[2] = { 46, 10 };
+
+  template<typename Stream>
+  void add_line(Stream             &stream,
+                const std::string  &name,
+                const std::string  &min,
+                const std::string  &max,
+                const std::string  &sum)
+  {
+    stream << "| "
+           << std::left << std::setw(column_width[0]) << name
+           << std::right
+           << " | " << std::setw(column_width[1]) << min
+           << " | " << std::setw(column_width[1]) << max
+           << " | " << std::setw(column_width[1]) << sum
+           << " |"
+           << std::endl;
+  }
+
+  template<typename Stream>
+  void add_line(Stream                          &stream,
+                const std::string               &name,
+                const Utilities::MPI::MinMaxAvg &data)
+  {
+    std::stringstream min, max, sum;
+
+    min << std::fixed << std::setprecision(2) << data.min;
+    max << std::fixed << std::setprecision(2) << data.max;
+    sum << std::fixed << std::setprecision(2) << data.sum;
+
+    add_line(stream, name, min.str(), max.str(), sum.str());
+  }
+
+  template<typename Stream>
+  void add_header(Stream  &stream)
+  {
+    stream << std::left << header << std::endl;
+  }
+
+} // internal
+
+
+
+void MemoryReport::add(const std::string &name, const std::size_t memory)
+{
+  entries.emplace_back(name, memory);
+}
+
+
+
+void MemoryReport::add(const std::string &prefix, const MemoryReport &report)
+{
+  for (const auto &entry: report.entries)
+    entries.emplace_back(prefix + " - " + entry.first, entry.second);
+}
+
+
+
+std::size_t MemoryReport::total() const
+{
+  std::size_t memory = 0;
+
+  for (const auto &entry: entries)
+    memory += entry.second;
+
+  return (memory);
+}
+
+
+
+std::vector<Utilities::MPI::MinMaxAvg>
+MemoryReport::reduce(const MPI_Comm &mpi_communicator) const
+{
+  std::vector<double> memory(entries.size() + 1);
+
+  for (unsigned int i = 0; i < entries.size(); ++i)
+    memory[i] = entries[i].second / 1024.0 / 1024.0;
+  memory.back() = total() / 1024.0 / 1024.0;
+
+  std::vector<Utilities::MPI::MinMaxAvg> data(memory.size());
+
+  for (unsigned int i = 0; i < memory.size(); ++i)
+    data[i] = Utilities::MPI::min_max_avg(memory[i], mpi_communicator);
+
+  return (data);
+}
+
+
+
+template<typename Stream>
+void MemoryReport::print(Stream &stream, const MPI_Comm &mpi_communicator) const
+{
+  const std::vector<Utilities::MPI::MinMaxAvg> data = reduce(mpi_communicator);
+
+  internal::add_header(stream);
+  internal::add_line(stream, "Memory consumption (MB)", "Min", "Max", "Sum");
+  internal::add_header(stream);
+
+  for (unsigned int i = 0; i < entries.size(); ++i)
+    internal::add_line(stream, entries[i].first, data[i]);
+
+  internal::add_header(stream);
+  internal::add_line(stream, "Total", data.back());
+  internal::add_header(stream);
+}
+
+} // namespace RMHD
+
+// explicit instantiations
+template void RMHD::MemoryReport::print
+(std::ostream &, const MPI_Comm &) const;
+template void RMHD::MemoryReport::print
+(dealii::ConditionalOStream &, const MPI_Comm &) const;
@@ -1,8 +1,12 @@
 #include <rotatingMHD/navier_stokes_projection.h>
 #include <rotatingMHD/time_discretization.h>
+#include <rotatingMHD/utility.h>
 
 #include <deal.II/fe/mapping_q.h>
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
 namespace RMHD
 {
 
@@ -18,15 +22,26 @@ NavierStokesProjection<dim>::NavierStokesProjection
 :
 phi(std::make_shared<Entities::FE_ScalarField<dim>>(*pressure, "Phi")),
 parameters(parameters),
-mpi_communicator(MPI_COMM_WORLD),
+mpi_communicator(get_mpi_communicator(velocity->get_triangulation())),
 velocity(velocity),
 pressure(pressure),
 time_stepping(time_stepping),
+projection_step_direct_solver(mpi_communicator),
+correction_step_direct_solver(mpi_communicator),
+projection_step_deflated_solver(parameters.projection_step_solver_parameters.n_deflation_vectors),
+correction_step_deflated_solver(parameters.correction_step_solver_parameters.n_deflation_vectors),
 norm_diffusion_rhs(std::numeric_limits<double>::min()),
 norm_projection_rhs(std::numeric_limits<double>::min()),
+n_iterations_diffusion_step(0),
+n_iterations_projection_step(0),
+n_iterations_correction_step(0),
 flag_normalize_pressure(false),
 flag_setup_phi(true),
-flag_matrices_were_updated(true)
+flag_matrices_were_updated(true),
+flag_shared_laplace_matrix(false),
+flag_patch_phi_laplace_matrix(false),
+flag_mesh_was_modified(true),
+flag_new_run(false)
 {
   Assert(velocity.get() != nullptr,
          ExcMessage("The velocity's shared pointer has not be"
@@ -67,6 +82,14 @@ flag_matrices_were_updated(true)
   gravity_vector_ptr          = nullptr;
   angular_velocity_vector_ptr = nullptr;
   temperature                 = nullptr;
+
+  // The solver is set up again once the triangulation changes.
+  mesh_modification_connection =
+    velocity->get_triangulation().signals.any_change.connect(
+      [this]()
+      {
+        this->flag_mesh_was_modified = true;
+      });
 }
 
 template <int dim>
@@ -82,14 +105,25 @@ NavierStokesProjection<dim>::NavierStokesProjection
 :
 phi(std::make_shared<Entities::FE_ScalarField<dim>>(*pressure, "Phi")),
 parameters(parameters),
-mpi_communicator(MPI_COMM_WORLD),
+mpi_communicator(get_mpi_communicator(velocity->get_triangulation())),
 velocity(velocity),
 pressure(pressure),
 temperature(temperature),
 time_stepping(time_stepping),
+projection_step_direct_solver(mpi_communicator),
+correction_step_direct_solver(mpi_communicator),
+projection_step_deflated_solver(parameters.projection_step_solver_parameters.n_deflation_vectors),
+correction_step_deflated_solver(parameters.correction_step_solver_parameters.n_deflation_vectors),
+n_iterations_diffusion_step(0),
+n_iterations_projection_step(0),
+n_iterations_correction_step(0),
 flag_normalize_pressure(false),
 flag_setup_phi(true),
-flag_matrices_were_updated(true)
+flag_matrices_were_updated(true),
+flag_shared_laplace_matrix(false),
+flag_patch_phi_laplace_matrix(false),
+flag_mesh_was_modified(true),
+flag_new_run(false)
 {
   Assert(velocity.get() != nullptr,
          ExcMessage("The velocity's shared pointer has not be"
@@ -132,6 +166,14 @@ flag_matrices_were_updated(true)
   body_force_ptr              = nullptr;
   gravity_vector_ptr          = nullptr;
   angular_velocity_vector_ptr = nullptr;
+
+  // The solver is set up again once the triangulation changes.
+  mesh_modification_connection =
+    velocity->get_triangulation().signals.any_change.connect(
+      [this]()
+      {
+        this->flag_mesh_was_modified = true;
+      });
 }
 
 template <int dim>
@@ -146,6 +188,12 @@ void NavierStokesProjection<dim>::clear()
   projection_step_preconditioner.reset();
   poisson_prestep_preconditioner.reset();
 
+  // direct solvers
+  projection_step_direct_solver.clear();
+  correction_step_direct_solver.clear();
+  projection_step_deflated_solver.clear();
+  correction_step_deflated_solver.clear();
+
   // velocity matrices
   velocity_system_matrix.clear();
   velocity_mass_plus_laplace_matrix.clear();
@@ -172,10 +220,88 @@ void NavierStokesProjection<dim>::clear()
   norm_diffusion_rhs = 0.0;
   norm_projection_rhs = 0.0;
 
+  n_iterations_diffusion_step = 0;
+  n_iterations_projection_step = 0;
+  n_iterations_correction_step = 0;
+
   flag_setup_phi = true;
   flag_matrices_were_updated = true;
   flag_normalize_pressure = false;
+  flag_shared_laplace_matrix = false;
+  flag_patch_phi_laplace_matrix = false;
+  flag_mesh_was_modified = true;
+  flag_new_run = false;
+}
+
+
+
+template <int dim>
+MemoryReport NavierStokesProjection<dim>::get_memory_report() const
+{
+  MemoryReport report;
+
+  report.add("Velocity system matrix",
+             velocity_system_matrix.memory_consumption());
+  report.add("Velocity mass matrix",
+             velocity_mass_matrix.memory_consumption());
+  report.add("Velocity Laplace matrix",
+             velocity_laplace_matrix.memory_consumption());
+  report.add("Velocity mass plus Laplace matrix",
+             velocity_mass_plus_laplace_matrix.memory_consumption());
+  report.add("Velocity advection matrix",
+             velocity_advection_matrix.memory_consumption());
+  report.add("Projection mass matrix",
+             projection_mass_matrix.memory_consumption());
+  report.add("Pressure Laplace matrix",
+             pressure_laplace_matrix.memory_consumption());
+  report.add("Phi Laplace matrix",
+             phi_laplace_matrix.memory_consumption());
+
+  report.add("Right-hand side vectors",
+             diffusion_step_rhs.memory_consumption() +
+             projection_step_rhs.memory_consumption() +
+             poisson_prestep_rhs.memory_consumption() +
+             correction_step_rhs.memory_consumption());
+
+  report.add("Diffusion step preconditioner",
+             preconditioner_memory_consumption(diffusion_step_preconditioner));
+  report.add("Poisson pre-step preconditioner",
+             preconditioner_memory_consumption(poisson_prestep_preconditioner));
+  // The preconditioner of the Poisson pre-step may be reused in the
+  // projection step, in which case it is only reported once
+  report.add("Projection step preconditioner",
+             projection_step_preconditioner != poisson_prestep_preconditioner
+             ? preconditioner_memory_consumption(projection_step_preconditioner)
+             : 0);
+  report.add("Correction step preconditioner",
+             preconditioner_memory_consumption(correction_step_preconditioner));
 
+  report.add("Deflation spaces",
+             projection_step_deflated_solver.memory_consumption() +
+             correction_step_deflated_solver.memory_consumption());
+
+  return (report);
+}
+
+
+
+template <int dim>
+std::size_t NavierStokesProjection<dim>::memory_consumption() const
+{
+  return (get_memory_report().total());
+}
+
+
+
+template <int dim>
+template <typename Archive>
+void NavierStokesProjection<dim>::serialize
+(Archive &ar, const unsigned int /* version */)
+{
+  for (auto &alpha_zero: previous_alpha_zeros)
+    ar & alpha_zero;
+  for (auto &step_size: previous_step_sizes)
+    ar & step_size;
 }
 
 }  // namespace RMHD
@@ -184,3 +310,12 @@ void NavierStokesProjection<dim>::clear()
 template class RMHD::NavierStokesProjection<2>;
 template class RMHD::NavierStokesProjection<3>;
 
+template void RMHD::NavierStokesProjection<2>::serialize
+(boost::archive::binary_oarchive &, const unsigned int);
+template void RMHD::NavierStokesProjection<2>::serialize
+(boost::archive::binary_iarchive &, const unsigned int);
+template void RMHD::NavierStokesProjection<3>::serialize
+(boost::archive::binary_oarchive &, const unsigned int);
+template void RMHD::NavierStokesProjection<3>::serialize
+(boost::archive::binary_iarchive &, const unsigned int);
+
@@ -54,10 +54,9 @@ void NavierStokesProjection<dim>::assemble_velocity_advection_matrix()
               velocity->get_dof_handler().end()),
    worker,
    copier,
-   Scratch(*mapping,
-           quadrature_formula,
-           velocity->get_finite_element(),
-           advection_update_flags),
+   Scratch(velocity->get_cell_geometry_cache(*mapping,
+                                             quadrature_formula,
+                                             advection_update_flags)),
    Copy(velocity->get_finite_element().dofs_per_cell));
 
   // Compress global data
@@ -81,13 +80,11 @@ void NavierStokesProjection<dim>::assemble_local_velocity_advection_matrix
   // Velocity's cell data
   scratch.fe_values.reinit(cell);
 
-  const FEValuesExtractors::Vector  vector_extractor(0);
-
-  scratch.fe_values[vector_extractor].get_function_values(
+  scratch.fe_values.get_function_values(
     velocity->old_solution,
     scratch.old_velocity_values);
 
-  scratch.fe_values[vector_extractor].get_function_values(
+  scratch.fe_values.get_function_values(
     velocity->old_old_solution,
     scratch.old_old_velocity_values);
 
@@ -96,11 +93,11 @@ void NavierStokesProjection<dim>::assemble_local_velocity_advection_matrix
       (parameters.convective_term_weak_form ==
               RunTimeParameters::ConvectiveTermWeakForm::skewsymmetric))
   {
-    scratch.fe_values[vector_extractor].get_function_divergences(
+    scratch.fe_values.get_function_divergences(
       velocity->old_solution,
       scratch.old_velocity_divergences);
 
-    scratch.fe_values[vector_extractor].get_function_divergences(
+    scratch.fe_values.get_function_divergences(
       velocity->old_old_solution,
       scratch.old_old_velocity_divergences);
   }
@@ -108,10 +105,10 @@ void NavierStokesProjection<dim>::assemble_local_velocity_advection_matrix
   if (parameters.convective_term_weak_form ==
         RunTimeParameters::ConvectiveTermWeakForm::rotational)
   {
-    scratch.fe_values[vector_extractor].get_function_curls(
+    scratch.fe_values.get_function_curls(
       velocity->old_solution,
       scratch.old_velocity_curls);
-    scratch.fe_values[vector_extractor].get_function_curls(
+    scratch.fe_values.get_function_curls(
       velocity->old_old_solution,
       scratch.old_old_velocity_curls);
   }
@@ -128,12 +125,12 @@ void NavierStokesProjection<dim>::assemble_local_velocity_advection_matrix
     // Extract test function values at the quadrature points
     for (unsigned int i = 0; i < scratch.dofs_per_cell; ++i)
     {
-      scratch.phi[i]        = scratch.fe_values[vector_extractor].value(i, q);
-      scratch.grad_phi[i]   = scratch.fe_values[vector_extractor].gradient(i, q);
+      scratch.phi[i]        = scratch.fe_values.vector_shape_value(i, q);
+      scratch.grad_phi[i]   = scratch.fe_values.vector_shape_gradient(i, q);
       /*! @note As above, should I leave this if in? */
       if (parameters.convective_term_weak_form ==
         RunTimeParameters::ConvectiveTermWeakForm::rotational)
-        scratch.curl_phi[i] = scratch.fe_values[vector_extractor].curl(i,q);
+        scratch.curl_phi[i] = scratch.fe_values.vector_shape_curl(i, q);
     }
 
     const Tensor<1,dim> extrapolated_velocity_value =
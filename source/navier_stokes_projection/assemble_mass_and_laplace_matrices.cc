@@ -142,10 +142,15 @@ void NavierStokesProjection<dim>::assemble_pressure_matrices()
 
   TimerOutput::Scope  t(*computing_timer, "Navier Stokes: Constant matrices assembly - Pressure");
 
-  // Reset data
+  // Reset data. The Laplace matrix of phi is only assembled if it can
+  // not be obtained from the one of the pressure.
+  const bool assemble_phi_laplace_matrix =
+    !(flag_shared_laplace_matrix || flag_patch_phi_laplace_matrix);
+
   projection_mass_matrix  = 0.;
   pressure_laplace_matrix = 0.;
-  phi_laplace_matrix      = 0.;
+  if (assemble_phi_laplace_matrix)
+    phi_laplace_matrix    = 0.;
 
   // Initiate the quadrature formula for exact numerical integration
   const QGauss<dim>   quadrature_formula(pressure->fe_degree() + 1);
@@ -188,9 +193,13 @@ void NavierStokesProjection<dim>::assemble_pressure_matrices()
 
   // Compress global data
   pressure_laplace_matrix.compress(VectorOperation::add);
-  phi_laplace_matrix.compress(VectorOperation::add);
+  if (assemble_phi_laplace_matrix)
+    phi_laplace_matrix.compress(VectorOperation::add);
   projection_mass_matrix.compress(VectorOperation::add);
 
+  if (flag_patch_phi_laplace_matrix)
+    patch_phi_laplace_matrix();
+
   if (parameters.verbose)
     *pcout << " done!" << std::endl << std::endl;
 }
@@ -253,7 +262,8 @@ void NavierStokesProjection<dim>::copy_local_to_global_pressure_matrices
                                       data.local_stiffness_matrix,
                                       data.local_dof_indices,
                                       pressure_laplace_matrix);
-  phi->get_constraints().distribute_local_to_global(
+  if (!(flag_shared_laplace_matrix || flag_patch_phi_laplace_matrix))
+    phi->get_constraints().distribute_local_to_global(
                                       data.local_stiffness_matrix,
                                       data.local_dof_indices,
                                       phi_laplace_matrix);
@@ -263,6 +273,53 @@ void NavierStokesProjection<dim>::copy_local_to_global_pressure_matrices
                                       projection_mass_matrix);
 }
 
+template <int dim>
+void NavierStokesProjection<dim>::patch_phi_laplace_matrix()
+{
+  phi_laplace_matrix.copy_from(pressure_laplace_matrix);
+
+  const auto &pressure_constraints = pressure->get_constraints();
+  const auto &phi_constraints      = phi->get_constraints();
+
+  // Returns true if the degree of freedom is only constrained in the
+  // phi space. The constraint is a homogeneous Dirichlet one, see
+  // compare_laplace_matrix_constraints().
+  auto is_eliminated =
+    [&](const types::global_dof_index dof)
+    {
+      return (phi_constraints.is_constrained(dof) &&
+              !pressure_constraints.is_constrained(dof));
+    };
+
+  std::vector<types::global_dof_index>                column_indices;
+  std::vector<LinearAlgebra::MPI::Vector::value_type> zeros;
+
+  // Off-diagonal entries in the rows and the columns of the eliminated
+  // degrees of freedom are set to zero. Since the matrix is symmetric,
+  // the columns are found through the locally owned rows.
+  for (const auto row: phi->get_locally_owned_dofs())
+  {
+    const bool eliminate_row = is_eliminated(row);
+
+    column_indices.clear();
+
+    for (auto entry = pressure_laplace_matrix.begin(row);
+         entry != pressure_laplace_matrix.end(row); ++entry)
+      if (entry->column() != row &&
+          (eliminate_row || is_eliminated(entry->column())))
+        column_indices.push_back(entry->column());
+
+    if (column_indices.empty())
+      continue;
+
+    zeros.assign(column_indices.size(), 0.);
+
+    phi_laplace_matrix.set(row, column_indices, zeros);
+  }
+
+  phi_laplace_matrix.compress(VectorOperation::insert);
+}
+
 } // namespace Step35
 
 // explicit instantiations
@@ -301,3 +358,6 @@ template void RMHD::NavierStokesProjection<2>::copy_local_to_global_pressure_mat
 (const RMHD::AssemblyData::NavierStokesProjection::PressureConstantMatrices::Copy   &);
 template void RMHD::NavierStokesProjection<3>::copy_local_to_global_pressure_matrices
 (const RMHD::AssemblyData::NavierStokesProjection::PressureConstantMatrices::Copy   &);
+
+template void RMHD::NavierStokesProjection<2>::patch_phi_laplace_matrix();
+template void RMHD::NavierStokesProjection<3>::patch_phi_laplace_matrix();
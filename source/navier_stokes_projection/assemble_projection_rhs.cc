@@ -53,12 +53,12 @@ assemble_projection_step_rhs()
                pressure->get_dof_handler().end()),
     worker,
     copier,
-    Scratch(*mapping,
-            quadrature_formula,
-            velocity->get_finite_element(),
-            update_gradients,
-            pressure->get_finite_element(),
-            update_values|update_JxW_values),
+    Scratch(velocity->get_cell_geometry_cache(*mapping,
+                                              quadrature_formula,
+                                              update_gradients),
+            pressure->get_cell_geometry_cache(*mapping,
+                                              quadrature_formula,
+                                              update_values|update_JxW_values)),
     Copy(pressure->get_finite_element().dofs_per_cell));
 
   // Compress global data
@@ -104,9 +104,7 @@ void NavierStokesProjection<dim>::assemble_local_projection_step_rhs
 
   scratch.velocity_fe_values.reinit(velocity_cell);
 
-  const FEValuesExtractors::Vector  vector_extractor(0);
-
-  scratch.velocity_fe_values[vector_extractor].get_function_divergences(
+  scratch.velocity_fe_values.get_function_divergences(
     velocity->solution,
     scratch.velocity_divergences);
 
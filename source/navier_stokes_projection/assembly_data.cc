@@ -90,16 +90,11 @@ namespace AdvectionMatrix
 {
 
 template <int dim>
-Scratch<dim>::Scratch(
-  const Mapping<dim>        &mapping,
-  const Quadrature<dim>     &quadrature_formula,
-  const FiniteElement<dim>  &fe,
-  const UpdateFlags         update_flags)
+Scratch<dim>::Scratch(const CellGeometryCache<dim> &cache)
 :
-Generic::Matrix::Scratch<dim>(mapping,
-                              quadrature_formula,
-                              fe,
-                              update_flags),
+ScratchBase<dim>(cache.get_quadrature(),
+                 cache.get_fe()),
+fe_values(cache),
 old_velocity_values(this->n_q_points),
 old_old_velocity_values(this->n_q_points),
 old_velocity_divergences(this->n_q_points),
@@ -116,7 +111,8 @@ curl_phi(this->dofs_per_cell)
 template <int dim>
 Scratch<dim>::Scratch(const Scratch<dim> &data)
 :
-Generic::Matrix::Scratch<dim>(data),
+ScratchBase<dim>(data),
+fe_values(data.fe_values),
 old_velocity_values(data.n_q_points),
 old_old_velocity_values(data.n_q_points),
 old_velocity_divergences(data.n_q_points),
@@ -392,25 +388,13 @@ local_correction_step_rhs(dofs_per_cell)
 
 template <int dim>
 Scratch<dim>::Scratch
-(const Mapping<dim>        &mapping,
- const Quadrature<dim>     &quadrature_formula,
- const FiniteElement<dim>  &velocity_fe,
- const UpdateFlags         velocity_update_flags,
- const FiniteElement<dim>  &pressure_fe,
- const UpdateFlags         pressure_update_flags)
+(const CellGeometryCache<dim>  &velocity_cache,
+ const CellGeometryCache<dim>  &pressure_cache)
 :
-ScratchBase<dim>(quadrature_formula,
-                 pressure_fe),
-velocity_fe_values(
-  mapping,
-  velocity_fe,
-  quadrature_formula,
-  velocity_update_flags),
-pressure_fe_values(
-  mapping,
-  pressure_fe,
-  quadrature_formula,
-  pressure_update_flags),
+ScratchBase<dim>(pressure_cache.get_quadrature(),
+                 pressure_cache.get_fe()),
+velocity_fe_values(velocity_cache),
+pressure_fe_values(pressure_cache),
 velocity_divergences(this->n_q_points),
 phi(this->dofs_per_cell)
 {}
@@ -421,16 +405,8 @@ template <int dim>
 Scratch<dim>::Scratch(const Scratch<dim> &data)
 :
 ScratchBase<dim>(data),
-velocity_fe_values(
-  data.velocity_fe_values.get_mapping(),
-  data.velocity_fe_values.get_fe(),
-  data.velocity_fe_values.get_quadrature(),
-  data.velocity_fe_values.get_update_flags()),
-pressure_fe_values(
-  data.pressure_fe_values.get_mapping(),
-  data.pressure_fe_values.get_fe(),
-  data.pressure_fe_values.get_quadrature(),
-  data.pressure_fe_values.get_update_flags()),
+velocity_fe_values(data.velocity_fe_values),
+pressure_fe_values(data.pressure_fe_values),
 velocity_divergences(this->n_q_points),
 phi(this->dofs_per_cell)
 {}
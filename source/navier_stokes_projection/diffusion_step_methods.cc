@@ -67,7 +67,10 @@ solve_diffusion_step(const bool reinit_prec)
 
   const typename RunTimeParameters::LinearSolverParameters &solver_parameters
     = parameters.diffusion_step_solver_parameters;
-  if (reinit_prec)
+
+  // The preconditioner is built lazily, i.e., also if it was released by
+  // setup().
+  if (reinit_prec || diffusion_step_preconditioner == nullptr)
   {
     build_preconditioner(diffusion_step_preconditioner,
                          *system_matrix,
@@ -85,17 +88,26 @@ solve_diffusion_step(const bool reinit_prec)
 
   #ifdef USE_PETSC_LA
     LinearAlgebra::SolverGMRES solver(solver_control,
-                                      MPI_COMM_WORLD);
+                                      mpi_communicator);
   #else
     LinearAlgebra::SolverGMRES solver(solver_control);
   #endif
 
   try
   {
-    solver.solve(*system_matrix,
-                 distributed_velocity,
-                 diffusion_step_rhs,
-                 *diffusion_step_preconditioner);
+    if (solver_parameters.solver_type == RunTimeParameters::SolverType::pipelined_Krylov)
+    {
+      PipelinedGMRES pipelined_solver(solver_control);
+      pipelined_solver.solve(*system_matrix,
+                             distributed_velocity,
+                             diffusion_step_rhs,
+                             *diffusion_step_preconditioner);
+    }
+    else
+      solver.solve(*system_matrix,
+                   distributed_velocity,
+                   diffusion_step_rhs,
+                   *diffusion_step_preconditioner);
   }
   catch (std::exception &exc)
   {
@@ -125,6 +137,8 @@ solve_diffusion_step(const bool reinit_prec)
 
   velocity->solution = distributed_velocity;
 
+  n_iterations_diffusion_step = solver_control.last_step();
+
   if (parameters.verbose)
     *pcout << " done!" << std::endl
            << "    Number of GMRES iterations: "
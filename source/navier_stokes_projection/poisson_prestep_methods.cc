@@ -66,10 +66,19 @@ solve_poisson_prestep()
 
   try
   {
-    solver.solve(pressure_laplace_matrix,
-                 distributed_old_pressure,
-                 poisson_prestep_rhs,
-                 *poisson_prestep_preconditioner);
+    if (solver_parameters.solver_type == RunTimeParameters::SolverType::pipelined_Krylov)
+    {
+      PipelinedCG pipelined_solver(solver_control);
+      pipelined_solver.solve(pressure_laplace_matrix,
+                             distributed_old_pressure,
+                             poisson_prestep_rhs,
+                             *poisson_prestep_preconditioner);
+    }
+    else
+      solver.solve(pressure_laplace_matrix,
+                   distributed_old_pressure,
+                   poisson_prestep_rhs,
+                   *poisson_prestep_preconditioner);
   }
   catch (std::exception &exc)
   {
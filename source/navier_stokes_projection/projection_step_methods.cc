@@ -35,15 +35,48 @@ void NavierStokesProjection<dim>::solve_projection_step
 
   const typename RunTimeParameters::LinearSolverParameters &solver_parameters
     = parameters.projection_step_solver_parameters;
-  if (reinit_prec)
+
+  // The matrix only changes with the mesh, i.e., the factorization of
+  // the direct solver is computed once after each call of setup() and no
+  // preconditioner is needed.
+  const bool use_direct_solver =
+    (solver_parameters.solver_type == RunTimeParameters::SolverType::direct);
+
+  const LinearAlgebra::MPI::SparseMatrix &system_matrix = get_phi_laplace_matrix();
+
+  if (use_direct_solver && !projection_step_direct_solver.is_initialized())
   {
-    build_preconditioner(projection_step_preconditioner,
-                         phi_laplace_matrix,
-                         solver_parameters.preconditioner_parameters_ptr,
-                         (phi->fe_degree() > 1? true: false));
+    AssertThrow(!flag_normalize_pressure,
+                ExcMessage("A direct solver for the projection step requires "
+                           "Dirichlet boundary conditions on phi, otherwise "
+                           "its Laplace matrix is singular."));
+
+    TimerOutput::Scope  t(*computing_timer, "Navier Stokes: Setup - Factorization");
+
+    projection_step_direct_solver.initialize(system_matrix);
   }
 
-  AssertThrow(projection_step_preconditioner != nullptr,
+  // The preconditioner is built lazily, i.e., also if it was released
+  // by setup().
+  if ((reinit_prec || projection_step_preconditioner == nullptr) &&
+      !use_direct_solver)
+  {
+    // If the Laplace matrices of phi and the pressure coincide, the
+    // preconditioner of the Poisson pre-step is reused.
+    if (flag_shared_laplace_matrix &&
+        poisson_prestep_preconditioner != nullptr &&
+        RunTimeParameters::have_same_preconditioner(
+          solver_parameters,
+          parameters.poisson_prestep_solver_parameters))
+      projection_step_preconditioner = poisson_prestep_preconditioner;
+    else
+      build_preconditioner(projection_step_preconditioner,
+                           system_matrix,
+                           solver_parameters.preconditioner_parameters_ptr,
+                           (phi->fe_degree() > 1? true: false));
+  }
+
+  AssertThrow(use_direct_solver || projection_step_preconditioner != nullptr,
               ExcMessage("The pointer to the projection step's preconditioner has not being initialized."));
 
   SolverControl solver_control(
@@ -60,10 +93,35 @@ void NavierStokesProjection<dim>::solve_projection_step
 
   try
   {
-    solver.solve(phi_laplace_matrix,
-                 distributed_phi,
-                 projection_step_rhs,
-                 *projection_step_preconditioner);
+    switch (solver_parameters.solver_type)
+    {
+      case RunTimeParameters::SolverType::direct:
+        projection_step_direct_solver.solve(distributed_phi,
+                                            projection_step_rhs);
+        break;
+      case RunTimeParameters::SolverType::deflated_CG:
+        projection_step_deflated_solver.solve(solver_control,
+                                              system_matrix,
+                                              distributed_phi,
+                                              projection_step_rhs,
+                                              *projection_step_preconditioner);
+        break;
+      case RunTimeParameters::SolverType::pipelined_Krylov:
+        {
+          PipelinedCG pipelined_solver(solver_control);
+          pipelined_solver.solve(system_matrix,
+                                 distributed_phi,
+                                 projection_step_rhs,
+                                 *projection_step_preconditioner);
+        }
+        break;
+      default:
+        solver.solve(system_matrix,
+                     distributed_phi,
+                     projection_step_rhs,
+                     *projection_step_preconditioner);
+        break;
+    }
   }
   catch (std::exception &exc)
   {
@@ -93,6 +151,8 @@ void NavierStokesProjection<dim>::solve_projection_step
 
   phi->solution = distributed_phi;
 
+  n_iterations_projection_step = (use_direct_solver ? 0 : solver_control.last_step());
+
   if (flag_normalize_pressure)
   {
     const LinearAlgebra::MPI::Vector::value_type mean_value
@@ -106,11 +166,18 @@ void NavierStokesProjection<dim>::solve_projection_step
   }
 
   if (parameters.verbose)
-    *pcout << " done!" << std::endl
-           << "    Number of CG iterations: "
-           << solver_control.last_step()
-           << ", Final residual: " << solver_control.last_value() << "."
-           << std::endl;
+  {
+    *pcout << " done!" << std::endl;
+    if (!use_direct_solver)
+      *pcout << "    Number of CG iterations: "
+             << solver_control.last_step()
+             << ", Final residual: " << solver_control.last_value() << "."
+             << std::endl;
+    if (solver_parameters.solver_type == RunTimeParameters::SolverType::deflated_CG)
+      *pcout << "    Dimension of the deflation space: "
+             << projection_step_deflated_solver.size() << "."
+             << std::endl;
+  }
 }
 
 }
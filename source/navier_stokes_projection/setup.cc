@@ -32,10 +32,26 @@ void NavierStokesProjection<dim>::setup()
   if (phi->get_dirichlet_boundary_conditions().empty())
     flag_normalize_pressure = true;
 
+  // The deflation spaces of a previous mesh are meaningless.
+  projection_step_deflated_solver.clear();
+  correction_step_deflated_solver.clear();
+
+  // The preconditioners and factorizations refer to the previous mesh.
+  // They are rebuilt lazily, i.e., on their first use. The preconditioner
+  // of the Poisson pre-step may also be shared with the projection step.
+  diffusion_step_preconditioner.reset();
+  projection_step_preconditioner.reset();
+  correction_step_preconditioner.reset();
+  poisson_prestep_preconditioner.reset();
+  projection_step_direct_solver.clear();
+  correction_step_direct_solver.clear();
+
   // If the matrices and vector are assembled, the sum of the mass and
   // stiffness matrices has to be updated.
   flag_matrices_were_updated = true;
 
+  flag_mesh_was_modified = false;
+
   if (time_stepping.get_step_number() == 0)
     poisson_prestep();
 }
@@ -212,6 +228,26 @@ void NavierStokesProjection<dim>::setup_matrices()
   phi_laplace_matrix.clear();       // Used in the projection step
   projection_mass_matrix.clear();   // Used in the correction step
 
+  // The Laplace matrix of phi is only set up if it can not be obtained
+  // from the one of the pressure.
+  compare_laplace_matrix_constraints();
+
+  const bool assemble_phi_laplace_matrix =
+    !(flag_shared_laplace_matrix || flag_patch_phi_laplace_matrix);
+
+  // If the pressure is only subject to hanging node constraints, the
+  // sparsity pattern of its Laplace matrix is also the one of the mass
+  // matrix. The constraints contain the hanging node constraints, i.e.,
+  // it suffices to compare their number. The comparison is reduced over
+  // all processes, since it controls collective operations.
+  const bool local_share_pressure_sparsity_pattern =
+    (pressure->get_constraints().n_constraints() ==
+     pressure->get_hanging_node_constraints().n_constraints());
+
+  const bool share_pressure_sparsity_pattern =
+    (Utilities::MPI::min(local_share_pressure_sparsity_pattern ? 1 : 0,
+                         mpi_communicator) == 1);
+
   // Set ups the sparsity patterns and initiates all the matrices
   // related to the pressure.
   {
@@ -231,17 +267,19 @@ void NavierStokesProjection<dim>::setup_matrices()
                                       false,
                                       Utilities::MPI::this_mpi_process(mpi_communicator));
 
-      DoFTools::make_sparsity_pattern(phi->get_dof_handler(),
-                                      phi_sparsity_pattern,
-                                      phi->get_constraints(),
-                                      false,
-                                      Utilities::MPI::this_mpi_process(mpi_communicator));
+      if (assemble_phi_laplace_matrix)
+        DoFTools::make_sparsity_pattern(phi->get_dof_handler(),
+                                        phi_sparsity_pattern,
+                                        phi->get_constraints(),
+                                        false,
+                                        Utilities::MPI::this_mpi_process(mpi_communicator));
 
-      DoFTools::make_sparsity_pattern(pressure->get_dof_handler(),
-                                      projection_sparsity_pattern,
-                                      pressure->get_hanging_node_constraints(),
-                                      false,
-                                      Utilities::MPI::this_mpi_process(mpi_communicator));
+      if (!share_pressure_sparsity_pattern)
+        DoFTools::make_sparsity_pattern(pressure->get_dof_handler(),
+                                        projection_sparsity_pattern,
+                                        pressure->get_hanging_node_constraints(),
+                                        false,
+                                        Utilities::MPI::this_mpi_process(mpi_communicator));
 
 
       SparsityTools::distribute_sparsity_pattern
@@ -250,32 +288,36 @@ void NavierStokesProjection<dim>::setup_matrices()
        mpi_communicator,
        pressure->get_locally_relevant_dofs());
 
-      SparsityTools::distribute_sparsity_pattern
-      (phi_sparsity_pattern,
-       phi->get_locally_owned_dofs(),
-       mpi_communicator,
-       phi->locally_relevant_dofs);
+      if (assemble_phi_laplace_matrix)
+        SparsityTools::distribute_sparsity_pattern
+        (phi_sparsity_pattern,
+         phi->get_locally_owned_dofs(),
+         mpi_communicator,
+         phi->get_locally_relevant_dofs());
 
-      SparsityTools::distribute_sparsity_pattern
-      (projection_sparsity_pattern,
-       pressure->get_locally_owned_dofs(),
-       mpi_communicator,
-       pressure->get_locally_relevant_dofs());
+      if (!share_pressure_sparsity_pattern)
+        SparsityTools::distribute_sparsity_pattern
+        (projection_sparsity_pattern,
+         pressure->get_locally_owned_dofs(),
+         mpi_communicator,
+         pressure->get_locally_relevant_dofs());
 
       pressure_laplace_matrix.reinit
       (pressure->get_locally_owned_dofs(),
        pressure->get_locally_owned_dofs(),
        pressure_sparsity_pattern,
        mpi_communicator);
-      phi_laplace_matrix.reinit
-      (phi->get_locally_owned_dofs(),
-       phi->get_locally_owned_dofs(),
-       phi_sparsity_pattern,
-       mpi_communicator);
+      if (assemble_phi_laplace_matrix)
+        phi_laplace_matrix.reinit
+        (phi->get_locally_owned_dofs(),
+         phi->get_locally_owned_dofs(),
+         phi_sparsity_pattern,
+         mpi_communicator);
       projection_mass_matrix.reinit
       (pressure->get_locally_owned_dofs(),
        pressure->get_locally_owned_dofs(),
-       projection_sparsity_pattern,
+       (share_pressure_sparsity_pattern ?
+        pressure_sparsity_pattern : projection_sparsity_pattern),
        mpi_communicator);
 
 
@@ -304,25 +346,32 @@ void NavierStokesProjection<dim>::setup_matrices()
                                       false,
                                       Utilities::MPI::this_mpi_process(mpi_communicator));
 
-      DoFTools::make_sparsity_pattern(phi->get_dof_handler(),
-                                      phi_sparsity_pattern,
-                                      phi->get_constraints(),
-                                      false,
-                                      Utilities::MPI::this_mpi_process(mpi_communicator));
+      if (assemble_phi_laplace_matrix)
+        DoFTools::make_sparsity_pattern(phi->get_dof_handler(),
+                                        phi_sparsity_pattern,
+                                        phi->get_constraints(),
+                                        false,
+                                        Utilities::MPI::this_mpi_process(mpi_communicator));
 
-      DoFTools::make_sparsity_pattern(pressure->get_dof_handler(),
-                                      projection_sparsity_pattern,
-                                      pressure->get_hanging_node_constraints(),
-                                      false,
-                                      Utilities::MPI::this_mpi_process(mpi_communicator));
+      if (!share_pressure_sparsity_pattern)
+        DoFTools::make_sparsity_pattern(pressure->get_dof_handler(),
+                                        projection_sparsity_pattern,
+                                        pressure->get_hanging_node_constraints(),
+                                        false,
+                                        Utilities::MPI::this_mpi_process(mpi_communicator));
 
       pressure_sparsity_pattern.compress();
-      phi_sparsity_pattern.compress();
-      projection_sparsity_pattern.compress();
+      if (assemble_phi_laplace_matrix)
+        phi_sparsity_pattern.compress();
+      if (!share_pressure_sparsity_pattern)
+        projection_sparsity_pattern.compress();
 
       pressure_laplace_matrix.reinit(pressure_sparsity_pattern);
-      phi_laplace_matrix.reinit(phi_sparsity_pattern);
-      projection_mass_matrix.reinit(projection_sparsity_pattern);
+      if (assemble_phi_laplace_matrix)
+        phi_laplace_matrix.reinit(phi_sparsity_pattern);
+      projection_mass_matrix.reinit(share_pressure_sparsity_pattern ?
+                                    pressure_sparsity_pattern :
+                                    projection_sparsity_pattern);
     #endif
   }
 
@@ -332,6 +381,56 @@ void NavierStokesProjection<dim>::setup_matrices()
 
 
 
+template <int dim>
+void NavierStokesProjection<dim>::compare_laplace_matrix_constraints()
+{
+  const auto &pressure_constraints = pressure->get_constraints();
+  const auto &phi_constraints      = phi->get_constraints();
+
+  // Both fields share the DoFHandler, i.e., the constraints can be
+  // compared line by line. The inhomogeneities do not enter the matrices.
+  bool identical_constraints  = true;
+  bool additional_constraints = true;
+
+  for (const auto dof: pressure->get_locally_relevant_dofs())
+  {
+    const bool pressure_dof_is_constrained = pressure_constraints.is_constrained(dof);
+    const bool phi_dof_is_constrained      = phi_constraints.is_constrained(dof);
+
+    if (pressure_dof_is_constrained)
+    {
+      if (!phi_dof_is_constrained ||
+          *pressure_constraints.get_constraint_entries(dof) !=
+          *phi_constraints.get_constraint_entries(dof))
+      {
+        identical_constraints   = false;
+        additional_constraints  = false;
+        break;
+      }
+    }
+    else if (phi_dof_is_constrained)
+    {
+      identical_constraints = false;
+
+      // Only homogeneous Dirichlet constraints can be patched
+      if (!phi_constraints.get_constraint_entries(dof)->empty())
+      {
+        additional_constraints = false;
+        break;
+      }
+    }
+  }
+
+  flag_shared_laplace_matrix =
+    (Utilities::MPI::min(identical_constraints ? 1 : 0, mpi_communicator) == 1);
+
+  flag_patch_phi_laplace_matrix =
+    !flag_shared_laplace_matrix &&
+    (Utilities::MPI::min(additional_constraints ? 1 : 0, mpi_communicator) == 1);
+}
+
+
+
 template <int dim>
 void NavierStokesProjection<dim>::
 setup_vectors()
@@ -406,6 +505,12 @@ void NavierStokesProjection<dim>::clear()
   projection_step_preconditioner.reset();
   poisson_prestep_preconditioner.reset();
 
+  // Direct solvers
+  projection_step_direct_solver.clear();
+  correction_step_direct_solver.clear();
+  projection_step_deflated_solver.clear();
+  correction_step_deflated_solver.clear();
+
   // Velocity matrices
   velocity_system_matrix.clear();
   velocity_mass_plus_laplace_matrix.clear();
@@ -433,10 +538,19 @@ void NavierStokesProjection<dim>::clear()
   norm_diffusion_rhs  = std::numeric_limits<double>::min();
   norm_projection_rhs = std::numeric_limits<double>::min();
 
+  // Iteration counts
+  n_iterations_diffusion_step   = 0;
+  n_iterations_projection_step  = 0;
+  n_iterations_correction_step  = 0;
+
   // Internal flags
   flag_setup_phi              = true;
   flag_matrices_were_updated  = true;
   flag_normalize_pressure     = false;
+  flag_shared_laplace_matrix    = false;
+  flag_patch_phi_laplace_matrix = false;
+  flag_mesh_was_modified        = true;
+  flag_new_run                  = false;
 }
 
 
@@ -453,6 +567,10 @@ void NavierStokesProjection<dim>::reset_phi()
 template <int dim>
 void NavierStokesProjection<dim>::reset()
 {
+  projection_step_direct_solver.clear();
+  correction_step_direct_solver.clear();
+  projection_step_deflated_solver.clear();
+  correction_step_deflated_solver.clear();
   velocity_system_matrix.clear();
   velocity_mass_matrix.clear();
   velocity_laplace_matrix.clear();
@@ -467,8 +585,45 @@ void NavierStokesProjection<dim>::reset()
   correction_step_rhs.clear();
   norm_diffusion_rhs  = 0.;
   norm_projection_rhs = 0.;
+  n_iterations_diffusion_step   = 0;
+  n_iterations_projection_step  = 0;
+  n_iterations_correction_step  = 0;
   flag_setup_phi              = true;
   flag_matrices_were_updated  = true;
+  flag_shared_laplace_matrix    = false;
+  flag_patch_phi_laplace_matrix = false;
+  flag_mesh_was_modified        = true;
+  flag_new_run                  = false;
+}
+
+
+
+template <int dim>
+void NavierStokesProjection<dim>::reset_for_new_run()
+{
+  // The system matrix of the diffusion step depends on the time step
+  // size and so does its preconditioner. The remaining preconditioners,
+  // the factorizations and the deflation spaces only depend on the
+  // constant matrices and are kept.
+  diffusion_step_preconditioner.reset();
+
+  // Histories
+  phi->set_solution_vectors_to_zero();
+  previous_alpha_zeros = {1.0, 1.0};
+  previous_step_sizes  = {0.0, 0.0};
+
+  // Norms
+  norm_diffusion_rhs  = std::numeric_limits<double>::min();
+  norm_projection_rhs = std::numeric_limits<double>::min();
+
+  // Iteration counts
+  n_iterations_diffusion_step   = 0;
+  n_iterations_projection_step  = 0;
+  n_iterations_correction_step  = 0;
+
+  // Internal flags
+  flag_matrices_were_updated  = true;
+  flag_new_run                = true;
 }
 
 
@@ -498,6 +653,9 @@ template void RMHD::NavierStokesProjection<3>::setup();
 template void RMHD::NavierStokesProjection<2>::setup_matrices();
 template void RMHD::NavierStokesProjection<3>::setup_matrices();
 
+template void RMHD::NavierStokesProjection<2>::compare_laplace_matrix_constraints();
+template void RMHD::NavierStokesProjection<3>::compare_laplace_matrix_constraints();
+
 template void RMHD::NavierStokesProjection<2>::setup_vectors();
 template void RMHD::NavierStokesProjection<3>::setup_vectors();
 
@@ -516,6 +674,9 @@ template void RMHD::NavierStokesProjection<3>::set_angular_velocity_vector(RMHD:
 template void RMHD::NavierStokesProjection<2>::clear();
 template void RMHD::NavierStokesProjection<3>::clear();
 
+template void RMHD::NavierStokesProjection<2>::reset_for_new_run();
+template void RMHD::NavierStokesProjection<3>::reset_for_new_run();
+
 template void RMHD::NavierStokesProjection<2>::reset_phi();
 template void RMHD::NavierStokesProjection<3>::reset_phi();
 
@@ -9,20 +9,28 @@ namespace RMHD
 template <int dim>
 void NavierStokesProjection<dim>::solve()
 {
-  if (velocity->solution.size() != diffusion_step_rhs.size())
+  if (flag_mesh_was_modified ||
+      velocity->solution.size() != diffusion_step_rhs.size())
   {
+    // The preconditioners were released by setup() and are rebuilt on
+    // their first use.
     setup();
 
-    diffusion_step(true);
+    diffusion_step(false);
 
-    projection_step(true);
+    projection_step(false);
 
-    pressure_correction(true);
+    pressure_correction(false);
 
     flag_matrices_were_updated = false;
   }
   else
   {
+    // A new run on the same mesh starts with the Poisson pre-step as
+    // done by setup(). See reset_for_new_run().
+    if (flag_new_run && time_stepping.get_step_number() == 0)
+      poisson_prestep();
+
     diffusion_step(time_stepping.get_step_number() %
                    parameters.preconditioner_update_frequency == 0 ||
                    time_stepping.get_step_number() == 1);
@@ -30,8 +38,12 @@ void NavierStokesProjection<dim>::solve()
     projection_step(false);
 
     pressure_correction(false);
+
+    flag_matrices_were_updated = false;
   }
 
+  flag_new_run = false;
+
   phi->update_solution_vectors();
 
   previous_alpha_zeros[1] = previous_alpha_zeros[0];
@@ -121,7 +133,23 @@ void NavierStokesProjection<dim>::pressure_correction(const bool reinit_prec)
             std::max(solver_parameters.relative_tolerance *correction_step_rhs.l2_norm(),
                      solver_parameters.absolute_tolerance));
 
-          if (reinit_prec)
+          // The matrix only changes with the mesh, i.e., the
+          // factorization of the direct solver is computed once after
+          // each call of setup() and no preconditioner is needed.
+          const bool use_direct_solver =
+            (solver_parameters.solver_type == RunTimeParameters::SolverType::direct);
+
+          if (use_direct_solver && !correction_step_direct_solver.is_initialized())
+          {
+            TimerOutput::Scope  t(*computing_timer, "Navier Stokes: Setup - Factorization");
+
+            correction_step_direct_solver.initialize(projection_mass_matrix);
+          }
+
+          // The preconditioner is built lazily, i.e., also if it was
+          // released by setup().
+          if ((reinit_prec || correction_step_preconditioner == nullptr) &&
+              !use_direct_solver)
           {
             build_preconditioner(correction_step_preconditioner,
                                  projection_mass_matrix,
@@ -129,7 +157,7 @@ void NavierStokesProjection<dim>::pressure_correction(const bool reinit_prec)
                                  (pressure->fe_degree() > 1? true: false));
           }
 
-          AssertThrow(correction_step_preconditioner != nullptr,
+          AssertThrow(use_direct_solver || correction_step_preconditioner != nullptr,
                       ExcMessage("The pointer to the correction step's preconditioner has not being initialized."));
 
           #ifdef USE_PETSC_LA
@@ -141,10 +169,35 @@ void NavierStokesProjection<dim>::pressure_correction(const bool reinit_prec)
 
           try
           {
-            solver.solve(projection_mass_matrix,
-                         distributed_pressure,
-                         correction_step_rhs,
-                         *correction_step_preconditioner);
+            switch (solver_parameters.solver_type)
+            {
+              case RunTimeParameters::SolverType::direct:
+                correction_step_direct_solver.solve(distributed_pressure,
+                                                    correction_step_rhs);
+                break;
+              case RunTimeParameters::SolverType::deflated_CG:
+                correction_step_deflated_solver.solve(solver_control,
+                                                      projection_mass_matrix,
+                                                      distributed_pressure,
+                                                      correction_step_rhs,
+                                                      *correction_step_preconditioner);
+                break;
+              case RunTimeParameters::SolverType::pipelined_Krylov:
+                {
+                  PipelinedCG pipelined_solver(solver_control);
+                  pipelined_solver.solve(projection_mass_matrix,
+                                         distributed_pressure,
+                                         correction_step_rhs,
+                                         *correction_step_preconditioner);
+                }
+                break;
+              default:
+                solver.solve(projection_mass_matrix,
+                             distributed_pressure,
+                             correction_step_rhs,
+                             *correction_step_preconditioner);
+                break;
+            }
           }
           catch (std::exception &exc)
           {
@@ -172,6 +225,9 @@ void NavierStokesProjection<dim>::pressure_correction(const bool reinit_prec)
             std::abort();
           }
 
+          n_iterations_correction_step =
+            (use_direct_solver ? 0 : solver_control.last_step());
+
           // The projected divergence is scaled and the old pressure
           // is added to it
           distributed_pressure.sadd(parameters.C2 / parameters.C6,
@@ -208,11 +264,14 @@ void NavierStokesProjection<dim>::pressure_correction(const bool reinit_prec)
           }
 
           if (parameters.verbose)
-                  *pcout << " done!" << std::endl
-                         << "    Number of CG iterations: "
-                         << solver_control.last_step()
-                         << ", Final residual: " << solver_control.last_value() << "."
-                         << std::endl << std::endl;
+          {
+            *pcout << " done!" << std::endl;
+            if (!use_direct_solver)
+              *pcout << "    Number of CG iterations: "
+                     << solver_control.last_step()
+                     << ", Final residual: " << solver_control.last_value() << ".";
+            *pcout << std::endl << std::endl;
+          }
         }
         break;
       default:
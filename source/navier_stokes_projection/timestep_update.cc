@@ -39,7 +39,7 @@ get_cfl_number()
       }
 
   max_cfl_number =
-                Utilities::MPI::max(max_cfl_number, MPI_COMM_WORLD);
+                Utilities::MPI::max(max_cfl_number, mpi_communicator);
 
   return max_cfl_number;
 }
@@ -0,0 +1,475 @@
+#include <rotatingMHD/probe_network.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+namespace RMHD
+{
+
+namespace
+{
+
+/*!
+ * @brief Splits the definition of a probe set into its tokens, which are
+ * separated by colons.
+ */
+std::vector<std::string> split_definition(const std::string &definition,
+                                          const unsigned int n_tokens)
+{
+  const std::vector<std::string> tokens =
+    Utilities::split_string_list(definition, ':');
+
+  AssertThrow(tokens.size() == n_tokens,
+              ExcMessage("The definition \"" + definition + "\" of the "
+                         "probes has to consist of " +
+                         std::to_string(n_tokens) + " entries separated by "
+                         "colons."));
+
+  return (tokens);
+}
+
+
+
+/*!
+ * @brief Parses a point whose components are separated by commas.
+ */
+template <int dim>
+Point<dim> parse_point(const std::string &string)
+{
+  const std::vector<double> components =
+    Utilities::string_to_double(Utilities::split_string_list(string));
+
+  AssertThrow(components.size() == dim,
+              ExcMessage("The point \"" + string + "\" does not have " +
+                         std::to_string(dim) + " components."));
+
+  Point<dim> point;
+  for (unsigned int d = 0; d < dim; ++d)
+    point[d] = components[d];
+
+  return (point);
+}
+
+
+
+/*!
+ * @brief Parses a positive number of points.
+ */
+unsigned int parse_n_points(const std::string &string)
+{
+  const int n_points = Utilities::string_to_int(string);
+
+  AssertThrow(n_points > 0,
+              ExcMessage("The number of points of a probe set has to be "
+                         "larger than zero."));
+
+  return (n_points);
+}
+
+} // namespace
+
+
+
+template <int dim>
+ProbeNetwork<dim>::ProbeNetwork
+(const RunTimeParameters::ProbeParameters  &prm,
+ const std::string                         &output_directory,
+ parallel::distributed::Triangulation<dim> &triangulation,
+ const std::shared_ptr<Mapping<dim>>       &mapping)
+:
+prm(prm),
+output_directory(output_directory),
+mpi_communicator(triangulation.get_communicator()),
+triangulation(triangulation),
+mapping(mapping),
+sample_values(2, 0.0),
+resume_step(numbers::invalid_unsigned_int),
+flag_locate_probes(true)
+{
+  if (prm.sampling_frequency == 0)
+    return;
+
+  create_points();
+
+  mesh_change_connection =
+    triangulation.signals.any_change.connect(
+      [this]()
+      {
+        flag_locate_probes = true;
+      });
+}
+
+
+
+template <int dim>
+void ProbeNetwork<dim>::add_field(const Entities::FE_FieldBase<dim> &field)
+{
+  if (prm.sampling_frequency == 0)
+    return;
+
+  if (!prm.field_names.empty() &&
+      std::find(prm.field_names.begin(),
+                prm.field_names.end(),
+                field.name) == prm.field_names.end())
+    return;
+
+  FieldData field_data;
+  field_data.field        = &field;
+  field_data.first_column = sample_values.size();
+
+  fields.push_back(field_data);
+
+  sample_values.resize(sample_values.size() +
+                       field.n_components() * points.size(),
+                       0.0);
+
+  flag_locate_probes = true;
+}
+
+
+
+template <int dim>
+void ProbeNetwork<dim>::sample
+(const double       time,
+ const unsigned int step_number)
+{
+  if (prm.sampling_frequency == 0 ||
+      step_number % prm.sampling_frequency != 0 ||
+      fields.empty())
+    return;
+
+  if (flag_locate_probes)
+    locate_probes();
+
+  if (writer == nullptr)
+    create_writer();
+
+  std::fill(sample_values.begin(), sample_values.end(), 0.0);
+
+  for (const auto &field_data: fields)
+  {
+    const auto &solution = field_data.field->solution;
+
+    const unsigned int n_components   = field_data.field->n_components();
+    const unsigned int dofs_per_cell  = field_data.shape_components.size();
+
+    for (unsigned int k = 0; k < local_probes.size(); ++k)
+    {
+      double *values = &sample_values[field_data.first_column +
+                                      local_probes[k] * n_components];
+
+      const types::global_dof_index *dof_indices =
+        &field_data.dof_indices[k * dofs_per_cell];
+      const double *shape_values = &field_data.shape_values[k * dofs_per_cell];
+
+      for (unsigned int j = 0; j < dofs_per_cell; ++j)
+        values[field_data.shape_components[j]] +=
+          solution(dof_indices[j]) * shape_values[j];
+    }
+  }
+
+  // The values of all probes and fields are reduced to the root process
+  // at once. The first two entries are the time and the step number.
+  const int n_values = sample_values.size() - 2;
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+  {
+    const int ierr = MPI_Reduce(MPI_IN_PLACE,
+                                sample_values.data() + 2,
+                                n_values,
+                                MPI_DOUBLE,
+                                MPI_SUM,
+                                0,
+                                mpi_communicator);
+    AssertThrowMPI(ierr);
+
+    sample_values[0] = time;
+    sample_values[1] = step_number;
+  }
+  else
+  {
+    const int ierr = MPI_Reduce(sample_values.data() + 2,
+                                nullptr,
+                                n_values,
+                                MPI_DOUBLE,
+                                MPI_SUM,
+                                0,
+                                mpi_communicator);
+    AssertThrowMPI(ierr);
+  }
+
+  writer->add_row(sample_values);
+}
+
+
+
+template <int dim>
+void ProbeNetwork<dim>::flush()
+{
+  if (writer != nullptr)
+    writer->flush();
+}
+
+
+
+template <int dim>
+void ProbeNetwork<dim>::set_resume_step(const unsigned int step_number)
+{
+  Assert(writer == nullptr,
+         ExcMessage("The resume step has to be set before the first sample."));
+
+  resume_step = step_number;
+}
+
+
+
+template <int dim>
+void ProbeNetwork<dim>::create_points()
+{
+  points.clear();
+
+  for (const auto &definition: prm.points)
+    points.push_back(parse_point<dim>(definition));
+
+  for (const auto &definition: prm.lines)
+  {
+    const std::vector<std::string> tokens = split_definition(definition, 3);
+
+    const Point<dim>    start     = parse_point<dim>(tokens[0]);
+    const Point<dim>    end       = parse_point<dim>(tokens[1]);
+    const unsigned int  n_points  = parse_n_points(tokens[2]);
+
+    for (unsigned int i = 0; i < n_points; ++i)
+      points.push_back(start +
+                       (n_points > 1 ? double(i) / (n_points - 1) : 0.0) *
+                       (end - start));
+  }
+
+  for (const auto &definition: prm.rings)
+  {
+    const std::vector<std::string> tokens =
+      split_definition(definition, (dim == 2 ? 2 : 3));
+
+    const double        radius      = Utilities::string_to_double(tokens[0]);
+    const double        colatitude  =
+      (dim == 2 ? 0.5 * numbers::PI : Utilities::string_to_double(tokens[1]));
+    const unsigned int  n_points    = parse_n_points(tokens.back());
+
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+      const double longitude = 2.0 * numbers::PI * i / n_points;
+
+      Point<dim> point;
+      point[0] = radius * std::sin(colatitude) * std::cos(longitude);
+      point[1] = radius * std::sin(colatitude) * std::sin(longitude);
+      if (dim == 3)
+        point[dim - 1] = radius * std::cos(colatitude);
+
+      points.push_back(point);
+    }
+  }
+
+  for (const auto &definition: prm.grids)
+  {
+    const std::vector<std::string> tokens = split_definition(definition, 3);
+
+    const Point<dim>        lower_corner = parse_point<dim>(tokens[0]);
+    const Point<dim>        upper_corner = parse_point<dim>(tokens[1]);
+    const std::vector<int>  n_points     =
+      Utilities::string_to_int(Utilities::split_string_list(tokens[2]));
+
+    AssertThrow(n_points.size() == dim,
+                ExcMessage("The number of points of the grid \"" +
+                           definition + "\" has to be specified in each "
+                           "direction."));
+
+    unsigned int n_grid_points = 1;
+    for (const int n: n_points)
+    {
+      AssertThrow(n > 0,
+                  ExcMessage("The number of points of a probe set has to "
+                             "be larger than zero."));
+      n_grid_points *= n;
+    }
+
+    for (unsigned int i = 0; i < n_grid_points; ++i)
+    {
+      Point<dim> point;
+
+      for (unsigned int d = 0, index = i; d < dim; index /= n_points[d], ++d)
+        point[d] = lower_corner[d] +
+                   (n_points[d] > 1 ?
+                    double(index % n_points[d]) / (n_points[d] - 1) : 0.0) *
+                   (upper_corner[d] - lower_corner[d]);
+
+      points.push_back(point);
+    }
+  }
+}
+
+
+
+template <int dim>
+void ProbeNetwork<dim>::locate_probes()
+{
+  const unsigned int this_process =
+    Utilities::MPI::this_mpi_process(mpi_communicator);
+
+  GridTools::Cache<dim> cache(triangulation, *mapping);
+
+  std::vector<unsigned int> owners(points.size(), numbers::invalid_unsigned_int);
+
+  std::vector<std::pair<typename Triangulation<dim>::active_cell_iterator,
+                        Point<dim>>> cells_and_points(points.size());
+
+  // Consecutive probes of a set are close to each other. Hence, the cell
+  // of the previous probe is used as a hint.
+  typename Triangulation<dim>::active_cell_iterator cell_hint;
+
+  for (unsigned int i = 0; i < points.size(); ++i)
+  {
+    try
+    {
+      const auto cell_and_point =
+        GridTools::find_active_cell_around_point(cache, points[i], cell_hint);
+
+      if (cell_and_point.first.state() == IteratorState::valid &&
+          cell_and_point.first->is_locally_owned())
+      {
+        owners[i]           = this_process;
+        cells_and_points[i] = cell_and_point;
+        cell_hint           = cell_and_point.first;
+      }
+    }
+    catch (const GridTools::ExcPointNotFound<dim> &)
+    {
+      // ignore
+    }
+  }
+
+  // Probes at the interface between two partitions are assigned to the
+  // process with the lowest rank
+  Utilities::MPI::min(owners, mpi_communicator, owners);
+
+  local_probes.clear();
+
+  for (unsigned int i = 0; i < points.size(); ++i)
+  {
+    AssertThrow(owners[i] != numbers::invalid_unsigned_int,
+                ExcMessage("No process owns the probe at the point (" +
+                           Utilities::to_string(points[i][0]) + ", " +
+                           Utilities::to_string(points[i][1]) +
+                           (dim == 3 ?
+                            ", " + Utilities::to_string(points[i][dim - 1]) :
+                            "") +
+                           "). Does the probe lie outside of the domain?"));
+
+    if (owners[i] == this_process)
+      local_probes.push_back(i);
+  }
+
+  for (auto &field_data: fields)
+  {
+    const DoFHandler<dim>     &dof_handler = field_data.field->get_dof_handler();
+    const FiniteElement<dim>  &fe          = field_data.field->get_finite_element();
+
+    AssertThrow(fe.is_primitive(),
+                ExcMessage("The probes only support primitive finite elements."));
+
+    const unsigned int dofs_per_cell = fe.dofs_per_cell;
+
+    field_data.shape_components.resize(dofs_per_cell);
+    for (unsigned int j = 0; j < dofs_per_cell; ++j)
+      field_data.shape_components[j] = fe.system_to_component_index(j).first;
+
+    field_data.dof_indices.resize(local_probes.size() * dofs_per_cell);
+    field_data.shape_values.resize(local_probes.size() * dofs_per_cell);
+
+    std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+
+    for (unsigned int k = 0; k < local_probes.size(); ++k)
+    {
+      const auto &cell_and_point = cells_and_points[local_probes[k]];
+
+      const typename DoFHandler<dim>::active_cell_iterator
+      cell(&triangulation,
+           cell_and_point.first->level(),
+           cell_and_point.first->index(),
+           &dof_handler);
+
+      cell->get_dof_indices(dof_indices);
+
+      for (unsigned int j = 0; j < dofs_per_cell; ++j)
+      {
+        field_data.dof_indices[k * dofs_per_cell + j]  = dof_indices[j];
+        field_data.shape_values[k * dofs_per_cell + j] =
+          fe.shape_value(j, cell_and_point.second);
+      }
+    }
+  }
+
+  flag_locate_probes = false;
+}
+
+
+
+template <int dim>
+void ProbeNetwork<dim>::create_writer()
+{
+  std::vector<std::string> column_names{"time", "step"};
+
+  for (const auto &field_data: fields)
+  {
+    const unsigned int n_components = field_data.field->n_components();
+
+    for (unsigned int i = 0; i < points.size(); ++i)
+      for (unsigned int c = 0; c < n_components; ++c)
+        column_names.push_back(field_data.field->name + "_" +
+                               (n_components > 1 ?
+                                std::to_string(c) + "_" : "") +
+                               std::to_string(i));
+  }
+
+  AssertDimension(column_names.size(), sample_values.size());
+
+  const std::filesystem::path directory{output_directory};
+
+  writer =
+    std::make_unique<TimeSeriesWriter>(
+      (directory / "probes.bin").string(),
+      column_names,
+      RunTimeParameters::BenchmarkDataFormat::binary,
+      prm.n_buffered_samples,
+      mpi_communicator,
+      resume_step);
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+  {
+    std::ofstream file((directory / "probes.txt").string());
+
+    file << "# probe";
+    for (unsigned int d = 0; d < dim; ++d)
+      file << " x_" << d;
+    file << std::endl;
+
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (unsigned int i = 0; i < points.size(); ++i)
+      file << i << " " << points[i] << std::endl;
+  }
+}
+
+} // namespace RMHD
+
+// explicit instantiations
+template class RMHD::ProbeNetwork<2>;
+template class RMHD::ProbeNetwork<3>;
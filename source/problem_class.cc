@@ -2,9 +2,17 @@
 
 #include <deal.II/base/quadrature_lib.h>
 
+#include <boost/serialization/set.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <chrono>
+#include <cmath>
 #include <exception>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <string>
+#include <utility>
 
 namespace RMHD
 {
@@ -108,7 +116,8 @@ void SolutionTransferContainer<dim>::deserialize
 template<int dim>
 void SolutionTransferContainer<dim>::add_entity
 (Entities::FE_FieldBase<dim> &entity,
- bool flag)
+ bool                         flag,
+ const double                 weight)
 {
   const Triangulation<dim>  &tria{entity.get_triangulation()};
 
@@ -118,7 +127,11 @@ void SolutionTransferContainer<dim>::add_entity
     AssertThrow(&tria == &(*triangulation),
                 ExcMessage("Entities do not share the same triangulation."));
 
+  AssertThrow(weight >= 0.0,
+              ExcLowerRangeType<double>(weight, 0.0));
+
   entities.emplace_back(std::make_pair(&entity, flag));
+  error_weights.push_back(weight);
   if (flag)
     error_vector_size += 1;
 }
@@ -163,25 +176,99 @@ SolutionTransferContainer<dim>::get_transfer_vectors() const
 
 
 
+namespace internal
+{
+
+template <int dim>
+std::shared_ptr<Mapping<dim>>
+create_mapping(const RunTimeParameters::ProblemBaseParameters &prm)
+{
+  if (prm.mapping_cache)
+  {
+    #if DEAL_II_VERSION_GTE(9, 3, 0)
+      return (std::make_shared<MappingQCache<dim>>(prm.mapping_degree));
+    #else
+      AssertThrow(false,
+                  ExcMessage("The cached mapping requires deal.II 9.3.0 "
+                             "or newer."));
+    #endif
+  }
+
+  return (std::make_shared<MappingQ<dim>>(prm.mapping_degree,
+                                          prm.mapping_interior_cells));
+}
+
+} // namespace internal
+
+
+
 template<int dim>
-Problem<dim>::Problem(const RunTimeParameters::ProblemBaseParameters &prm_)
+Problem<dim>::Problem(const RunTimeParameters::ProblemBaseParameters &prm_,
+                      const MPI_Comm &mpi_communicator_)
 :
-mpi_communicator(MPI_COMM_WORLD),
+mpi_communicator(mpi_communicator_),
 prm(prm_),
 triangulation(mpi_communicator,
               typename Triangulation<dim>::MeshSmoothing(
               Triangulation<dim>::smoothing_on_refinement |
               Triangulation<dim>::smoothing_on_coarsening)),
-mapping(std::make_shared<MappingQ<dim>>(prm.mapping_degree,
-                                        prm.mapping_interior_cells)),
+mapping(internal::create_mapping<dim>(prm)),
 pcout(std::make_shared<ConditionalOStream>(std::cout,
       (Utilities::MPI::this_mpi_process(mpi_communicator) == 0))),
 computing_timer(
   std::make_shared<TimerOutput>(mpi_communicator,
                                 *pcout,
                                 (prm.verbose? TimerOutput::summary: TimerOutput::never),
-                                TimerOutput::wall_times))
+                                TimerOutput::wall_times)),
+graphical_output(prm, triangulation, mapping),
+probes(prm.probe_parameters,
+       prm.graphical_output_directory,
+       triangulation,
+       mapping),
+n_checkpoints(0),
+pending_checkpoint_step(0),
+pending_checkpoint_time(0.0),
+benchmark_timer(mpi_communicator, true),
+n_benchmark_steps(0),
+n_benchmark_dof_updates(0.0),
+flag_benchmark_window(false),
+flag_memory_report_due(true)
 {
+  // The partition of the mesh accounts for the estimated cost of each
+  // cell. The weights of the children are computed from the parent cell.
+  if (prm.spatial_discretization_parameters.cost_weighted_repartitioning)
+  {
+    auto cell_weight =
+      [this](const auto &cell, const auto /* status */) -> unsigned int
+      {
+        return (this->compute_cell_weight(cell));
+      };
+
+    #if DEAL_II_VERSION_GTE(9, 5, 0)
+      triangulation.signals.weight.connect(cell_weight);
+    #else
+      triangulation.signals.cell_weight.connect(cell_weight);
+    #endif
+  }
+
+  // The support points of the cached mapping are recomputed after each
+  // change of the mesh. The slots are connected after the ones of the
+  // triangulation itself, which invalidate the cache, and hence are
+  // called after them.
+  if (prm.mapping_cache)
+  {
+    auto update_mapping_cache =
+      [this]()
+      {
+        this->update_mapping_cache();
+      };
+
+    triangulation.signals.create.connect(update_mapping_cache);
+    triangulation.signals.post_distributed_refinement.connect(update_mapping_cache);
+    triangulation.signals.post_distributed_repartition.connect(update_mapping_cache);
+    triangulation.signals.post_distributed_load.connect(update_mapping_cache);
+  }
+
   if (!std::filesystem::exists(prm.graphical_output_directory) &&
       Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
   {
@@ -308,6 +395,9 @@ void Problem<dim>::adaptive_mesh_refinement()
   std::vector<typename SolutionTransferContainer<dim>::SolutionTransferType>
   transfer_objects = container.get_transfer_objects();
 
+  // The memory is reported again once the solvers were set up on the
+  // refined mesh
+  flag_memory_report_due = true;
 
   {
     TimerOutput::Scope t(*computing_timer,
@@ -316,50 +406,23 @@ void Problem<dim>::adaptive_mesh_refinement()
     *pcout << std::endl
            << " Preparing coarsening and refining..." << std::endl;
 
-    // Initiates the estimated error per cell of each entity, which
-    // is to be considered
-    std::vector<Vector<float>> estimated_errors_per_cell(
-      container.get_error_vector_size(),
-      Vector<float>(triangulation.n_active_cells()));
-
-    // Initiates the estimated error per cell used in the refinement.
-    // It is composed by the equally weighted sum of the estimated
-    // error per cell of each entity to be considered
+    // Computes the estimated error per cell used in the refinement.
+    // The jumps or the recovered gradients of all the pertinent
+    // entities are computed in a single loop over the cells and
+    // combined through the weights of the entities.
     Vector<float> estimated_error_per_cell(triangulation.n_active_cells());
 
-    unsigned int j = 0;
+    MultiFieldErrorEstimator<dim> error_estimator(*mapping);
 
-    // Computes the estimated error per cell of all the pertinent
-    // entities
-    for (unsigned int i = 0; i < container.get_field_collection().size(); ++i)
-    {
+    for (unsigned int i = 0; i < entities.size(); ++i)
       if (entities[i].second)
-      {
-        KellyErrorEstimator<dim>::estimate(
-          entities[i].first->get_dof_handler(),
-          QGauss<dim-1>(entities[i].first->fe_degree() + 1),
-          std::map<types::boundary_id, const Function<dim> *>(),
-          entities[i].first->solution,
-          estimated_errors_per_cell[j],
-          ComponentMask(),
-          nullptr,
-          0,
-          triangulation.locally_owned_subdomain());
-
-        j += 1;
-      }
-      else
-        continue;
-    }
-
-    // Reset the estimated error per cell and fills it with the
-    // equally weighted sum of the estimated error per cell of each
-    // entity to be considered
-    estimated_error_per_cell = 0.;
+        error_estimator.add_field(*entities[i].first,
+                                  container.get_error_weight(i));
 
-    for (auto const &error_vector: estimated_errors_per_cell)
-      estimated_error_per_cell.add(1.0 / container.get_error_vector_size(),
-                                   error_vector);
+    error_estimator.estimate(
+      estimated_error_per_cell,
+      prm.spatial_discretization_parameters.error_indicator_type,
+      prm.spatial_discretization_parameters.normalize_error_indicators);
 
     // Indicates which cells are to be refine/coarsen
     parallel::distributed::
@@ -394,6 +457,14 @@ void Problem<dim>::adaptive_mesh_refinement()
     *pcout << "   Number of cells set for refinement: " << global_cell_counts[0] << std::endl
            << "   Number of cells set for coarsening: " << global_cell_counts[1] << std::endl;
 
+    // If no cell is flagged, the triangulation, the entities and the
+    // solvers remain untouched.
+    if (global_cell_counts[0] == 0 && global_cell_counts[1] == 0)
+    {
+      *pcout << " The mesh remains unchanged." << std::endl << std::endl;
+      return;
+    }
+
     // Stores the current solutions into std::vector declared below
     // and prepare each entry for the solution transfer
     const std::vector<typename SolutionTransferContainer<dim>::TransferVectorType>
@@ -405,6 +476,11 @@ void Problem<dim>::adaptive_mesh_refinement()
     for (size_t i = 0; i < transfer_objects.size(); ++i)
       transfer_objects[i].prepare_for_coarsening_and_refinement(transfer_vectors[i]);
 
+    // Update the boundary ids used for the estimation of the cost of
+    // each cell during the repartitioning of the refined mesh
+    if (prm.spatial_discretization_parameters.cost_weighted_repartitioning)
+      dirichlet_boundary_ids = collect_dirichlet_boundary_ids();
+
     // Execute the mesh refinement/coarsening
     *pcout << " Executing coarsening and refining..." << std::endl;
     triangulation.execute_coarsening_and_refinement();
@@ -413,6 +489,10 @@ void Problem<dim>::adaptive_mesh_refinement()
   *pcout << "   Number of global active cells:      "
          << triangulation.n_global_active_cells() << std::endl;
 
+  if (prm.spatial_discretization_parameters.cost_weighted_repartitioning)
+    *pcout << "   Load imbalance (max/average cost):  "
+           << compute_load_imbalance() << std::endl;
+
   std::vector<types::global_cell_index> locally_active_cells(triangulation.n_global_levels());
   for (unsigned int level = 0; level < triangulation.n_levels(); ++level)
     for (auto cell: triangulation.active_cell_iterators_on_level(level))
@@ -494,6 +574,589 @@ void Problem<dim>::adaptive_mesh_refinement()
 }
 
 
+
+template <int dim>
+std::set<types::boundary_id>
+Problem<dim>::collect_dirichlet_boundary_ids() const
+{
+  std::set<types::boundary_id> boundary_ids;
+
+  for (const auto &entity: container.get_field_collection())
+    for (const auto &dirichlet_bc: entity.first->get_dirichlet_boundary_conditions())
+      boundary_ids.insert(dirichlet_bc.first);
+
+  return (boundary_ids);
+}
+
+
+
+template <int dim>
+bool Problem<dim>::update_dirichlet_boundary_ids()
+{
+  std::set<types::boundary_id> boundary_ids = collect_dirichlet_boundary_ids();
+
+  if (boundary_ids == dirichlet_boundary_ids)
+    return (false);
+
+  dirichlet_boundary_ids = std::move(boundary_ids);
+
+  if (!prm.spatial_discretization_parameters.cost_weighted_repartitioning ||
+      Utilities::MPI::n_mpi_processes(mpi_communicator) == 1)
+    return (false);
+
+  TimerOutput::Scope  t(*computing_timer, "Problem: Setup - Repartitioning");
+
+  triangulation.repartition();
+
+  *pcout << "   Load imbalance (max/average cost):  "
+         << compute_load_imbalance() << std::endl;
+
+  return (true);
+}
+
+
+
+template <int dim>
+double Problem<dim>::compute_cell_cost
+(const typename Triangulation<dim>::cell_iterator &cell) const
+{
+  const RunTimeParameters::SpatialDiscretizationParameters &parameters =
+    prm.spatial_discretization_parameters;
+
+  double cost = 1.0;
+
+  for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+    if (cell->face(f)->at_boundary())
+    {
+      if (dirichlet_boundary_ids.find(cell->face(f)->boundary_id()) !=
+          dirichlet_boundary_ids.end())
+        cost += parameters.dirichlet_boundary_face_weight;
+    }
+    else if (cell->face(f)->has_children() ||
+             (cell->is_active() && cell->neighbor_is_coarser(f)))
+      cost += parameters.hanging_node_face_weight;
+
+  return (cost);
+}
+
+
+
+template <int dim>
+void Problem<dim>::distribute_cell_geometry_cache_memory_budget()
+{
+  Assert(!container.empty(),
+         ExcMessage("The entities container is empty."));
+
+  const std::vector<typename SolutionTransferContainer<dim>::FE_Field>
+  &entities = container.get_field_collection();
+
+  const std::size_t memory_budget =
+    std::size_t(prm.cell_geometry_cache_memory_budget) * 1024 * 1024 /
+    entities.size();
+
+  for (const auto &entity: entities)
+    entity.first->set_cell_geometry_cache_memory_budget(memory_budget);
+}
+
+
+
+template <int dim>
+void Problem<dim>::update_mapping_cache()
+{
+  #if DEAL_II_VERSION_GTE(9, 3, 0)
+    auto mapping_cache = std::dynamic_pointer_cast<MappingQCache<dim>>(mapping);
+
+    if (mapping_cache == nullptr || triangulation.n_cells() == 0)
+      return;
+
+    TimerOutput::Scope  t(*computing_timer, "Problem: Mapping cache update");
+
+    mapping_cache->initialize(MappingQ<dim>(prm.mapping_degree,
+                                            prm.mapping_interior_cells),
+                              triangulation);
+  #endif
+}
+
+
+
+template <int dim>
+unsigned int Problem<dim>::compute_cell_weight
+(const typename Triangulation<dim>::cell_iterator &cell) const
+{
+  // The library assigns a weight of 1000 to each cell. Prior to
+  // version 9.5 the returned weight is added to it.
+  const double cost = compute_cell_cost(cell);
+
+  #if DEAL_II_VERSION_GTE(9, 5, 0)
+    return (static_cast<unsigned int>(std::round(1000.0 * cost)));
+  #else
+    return (static_cast<unsigned int>(std::round(1000.0 * (cost - 1.0))));
+  #endif
+}
+
+
+
+template <int dim>
+double Problem<dim>::compute_load_imbalance() const
+{
+  double local_cost = 0.0;
+
+  for (const auto &cell: triangulation.active_cell_iterators())
+    if (cell->is_locally_owned())
+      local_cost += compute_cell_cost(cell);
+
+  const Utilities::MPI::MinMaxAvg cost_statistics =
+    Utilities::MPI::min_max_avg(local_cost, mpi_communicator);
+
+  return (cost_statistics.avg > 0.0 ?
+          cost_statistics.max / cost_statistics.avg : 1.0);
+}
+
+
+
+template <int dim>
+void Problem<dim>::checkpoint
+(const TimeDiscretization::VSIMEXMethod &time_stepping)
+{
+  if (prm.checkpoint_frequency == 0 &&
+      prm.checkpoint_wall_time_interval == 0.0)
+    return;
+
+  // The wall time and the completion of the pending checkpoint require a
+  // collective operation. Hence, they are only checked every few steps.
+  const unsigned int n_steps_between_checks = 10;
+
+  const bool flag_collective_check =
+    (time_stepping.get_step_number() % n_steps_between_checks == 0);
+
+  // Marks the pending checkpoint as complete once all processes finished
+  // writing. The check is non-blocking.
+  if (flag_collective_check && checkpoint_writer.valid())
+  {
+    const bool flag_finished =
+      (checkpoint_writer.wait_for(std::chrono::seconds(0)) ==
+       std::future_status::ready);
+
+    if (Utilities::MPI::min(flag_finished ? 1u : 0u, mpi_communicator) == 1)
+      commit_checkpoint();
+  }
+
+  // The processes have to agree on whether a checkpoint is due
+  bool flag_checkpoint_is_due =
+    (prm.checkpoint_frequency > 0 &&
+     time_stepping.get_step_number() % prm.checkpoint_frequency == 0);
+
+  if (flag_collective_check && prm.checkpoint_wall_time_interval > 0.0)
+    flag_checkpoint_is_due |=
+      (Utilities::MPI::max(checkpoint_timer.wall_time(), mpi_communicator) >=
+       60.0 * prm.checkpoint_wall_time_interval);
+
+  if (!flag_checkpoint_is_due)
+    return;
+
+  // The previous checkpoint has to be complete before a new one is
+  // started
+  if (checkpoint_writer.valid())
+    commit_checkpoint();
+
+  write_checkpoint(time_stepping);
+}
+
+
+
+template <int dim>
+void Problem<dim>::finalize_checkpoint()
+{
+  if (checkpoint_writer.valid())
+    commit_checkpoint();
+}
+
+
+
+template <int dim>
+void Problem<dim>::benchmark_step
+(const TimeDiscretization::DiscreteTime &time_stepping)
+{
+  if (!prm.benchmark_mode)
+    return;
+
+  if (!flag_benchmark_window)
+  {
+    if (time_stepping.get_step_number() < prm.benchmark_n_warm_up_steps)
+      return;
+
+    // The timed window starts after the last warm-up step
+    *pcout << "Benchmark mode: " << time_stepping.get_step_number()
+           << " warm-up steps completed, starting the timed steps..."
+           << std::endl;
+
+    pcout->set_condition(false);
+
+    computing_timer->reset();
+
+    n_benchmark_steps       = 0;
+    n_benchmark_dof_updates = 0.0;
+    flag_benchmark_window   = true;
+
+    benchmark_timer.restart();
+
+    return;
+  }
+
+  ++n_benchmark_steps;
+
+  for (const auto &entity: container.get_field_collection())
+    if (!entity.first->is_child_entity())
+      n_benchmark_dof_updates += entity.first->n_dofs();
+}
+
+
+
+template <int dim>
+void Problem<dim>::finalize_benchmark()
+{
+  if (!prm.benchmark_mode)
+    return;
+
+  benchmark_timer.stop();
+
+  pcout->set_condition(Utilities::MPI::this_mpi_process(mpi_communicator) == 0);
+
+  if (n_benchmark_steps == 0)
+  {
+    *pcout << "Benchmark mode: The time loop ended before a step was "
+              "timed. Increase the number of steps." << std::endl;
+    return;
+  }
+
+  const double wall_time = benchmark_timer.wall_time();
+
+  *pcout << std::endl
+         << "Benchmark mode: " << n_benchmark_steps << " timed steps"
+         << std::endl
+         << std::setw(60) << " Wall time [s]" << " = "
+         << wall_time << std::endl
+         << std::setw(60) << " Degree of freedom updates per second" << " = "
+         << n_benchmark_dof_updates / wall_time << std::endl
+         << std::setw(60) << " Steps per hour" << " = "
+         << 3600.0 * n_benchmark_steps / wall_time << std::endl
+         << std::setw(60) << " Wall time per step [s]" << " = "
+         << wall_time / n_benchmark_steps << std::endl;
+
+  computing_timer->print_summary();
+
+  flag_benchmark_window = false;
+}
+
+
+
+template <int dim>
+MemoryReport Problem<dim>::get_memory_report() const
+{
+  MemoryReport report;
+
+  report.add("Triangulation", triangulation.memory_consumption());
+
+  for (const auto &entity: container.get_field_collection())
+    report.add(entity.first->name, entity.first->get_memory_report());
+
+  return (report);
+}
+
+
+
+template <int dim>
+void Problem<dim>::report_memory_consumption()
+{
+  if (!prm.memory_report || !flag_memory_report_due)
+    return;
+
+  flag_memory_report_due = false;
+
+  get_memory_report().print(*pcout, mpi_communicator);
+}
+
+
+
+template <int dim>
+void Problem<dim>::write_checkpoint
+(const TimeDiscretization::VSIMEXMethod &time_stepping)
+{
+  TimerOutput::Scope  t(*computing_timer, "Problem: Checkpoint");
+
+  const std::string slot =
+    "checkpoint-" + std::to_string(n_checkpoints % prm.n_checkpoint_slots);
+
+  const std::filesystem::path directory =
+    std::filesystem::path(prm.checkpoint_directory) / slot;
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+    std::filesystem::create_directories(directory);
+
+  MPI_Barrier(mpi_communicator);
+
+  // The counters of the graphical output are only consistent once all
+  // pending outputs are written
+  graphical_output.finalize();
+
+  // The samples of the probes up to the checkpoint have to be on disk
+  probes.flush();
+
+  // The triangulation is written collectively
+  triangulation.save((directory / "triangulation").string());
+
+  // Serialize the state of this process into memory
+  std::ostringstream  stream;
+  {
+    boost::archive::binary_oarchive archive(stream);
+
+    const unsigned int n_processes =
+      Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+    archive << n_processes;
+    archive << dirichlet_boundary_ids;
+    archive << time_stepping;
+
+    for (const auto &entity: container.get_field_collection())
+    {
+      const IndexSet &locally_owned_dofs =
+        entity.first->get_locally_owned_dofs();
+
+      std::vector<double> values(locally_owned_dofs.n_elements());
+
+      for (const LinearAlgebra::MPI::Vector *vector:
+           {&entity.first->solution,
+            &entity.first->old_solution,
+            &entity.first->old_old_solution})
+      {
+        unsigned int i = 0;
+        for (const auto index: locally_owned_dofs)
+          values[i++] = (*vector)(index);
+
+        archive << values;
+      }
+    }
+
+    archive << graphical_output;
+
+    save_checkpoint_data(archive);
+  }
+
+  const std::string file_name =
+    (directory /
+     ("data-" +
+      Utilities::int_to_string(Utilities::MPI::this_mpi_process(mpi_communicator), 4) +
+      ".bin")).string();
+
+  // The file is written by a background thread. It is first written to a
+  // temporary file such that an incomplete file is never read.
+  checkpoint_writer =
+    std::async(std::launch::async,
+               [file_name, buffer = stream.str()]() -> bool
+               {
+                 const std::string tmp_file_name = file_name + ".tmp";
+
+                 std::ofstream file(tmp_file_name, std::ios::binary);
+                 file.write(buffer.data(), buffer.size());
+                 file.close();
+
+                 if (!file)
+                   return (false);
+
+                 std::error_code error_code;
+                 std::filesystem::rename(tmp_file_name, file_name, error_code);
+
+                 return (!error_code);
+               });
+
+  pending_checkpoint_slot = slot;
+  pending_checkpoint_step = time_stepping.get_step_number();
+  pending_checkpoint_time = time_stepping.get_current_time();
+
+  ++n_checkpoints;
+
+  checkpoint_timer.restart();
+}
+
+
+
+template <int dim>
+void Problem<dim>::commit_checkpoint()
+{
+  const bool flag_success = checkpoint_writer.get();
+
+  if (Utilities::MPI::min(flag_success ? 1u : 0u, mpi_communicator) == 0)
+  {
+    *pcout << " The checkpoint of step " << pending_checkpoint_step
+           << " could not be written." << std::endl;
+    return;
+  }
+
+  // The file pointing to the last complete checkpoint is replaced
+  // atomically
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+  {
+    const std::filesystem::path path{prm.checkpoint_directory};
+
+    {
+      std::ofstream file((path / "checkpoint.info.tmp").string());
+      file << pending_checkpoint_slot << " "
+           << pending_checkpoint_step << " "
+           << std::setprecision(16) << pending_checkpoint_time
+           << std::endl;
+    }
+
+    std::filesystem::rename(path / "checkpoint.info.tmp",
+                            path / "checkpoint.info");
+  }
+
+  *pcout << " Checkpoint of step " << pending_checkpoint_step
+         << " written to \"" << pending_checkpoint_slot << "\"."
+         << std::endl;
+}
+
+
+
+template <int dim>
+void Problem<dim>::load_checkpoint_triangulation
+(TimeDiscretization::VSIMEXMethod &time_stepping)
+{
+  TimerOutput::Scope  t(*computing_timer, "Problem: Restart");
+
+  const std::filesystem::path path{prm.checkpoint_directory};
+
+  std::string   slot;
+  unsigned int  step_number;
+  double        time;
+  {
+    std::ifstream file((path / "checkpoint.info").string());
+
+    AssertThrow(file,
+                ExcMessage("No complete checkpoint was found in \"" +
+                           prm.checkpoint_directory + "\"."));
+
+    file >> slot >> step_number >> time;
+  }
+
+  *pcout << "Restarting from the checkpoint of step " << step_number
+         << " at t = " << time << " in \"" << slot << "\"..." << std::endl;
+
+  const std::filesystem::path directory = path / slot;
+
+  AssertThrow(triangulation.n_levels() == 1,
+              ExcMessage("The triangulation has to contain the coarse mesh "
+                         "only."));
+
+  triangulation.load((directory / "triangulation").string());
+
+  // Read the file of this process
+  {
+    const std::string file_name =
+      (directory /
+       ("data-" +
+        Utilities::int_to_string(Utilities::MPI::this_mpi_process(mpi_communicator), 4) +
+        ".bin")).string();
+
+    std::ifstream file(file_name, std::ios::binary);
+
+    AssertThrow(file,
+                ExcMessage("The checkpoint file \"" + file_name +
+                           "\" could not be opened."));
+
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+
+    restart_stream = std::make_unique<std::istringstream>(buffer.str());
+    restart_archive =
+      std::make_unique<boost::archive::binary_iarchive>(*restart_stream);
+  }
+
+  unsigned int n_processes;
+  *restart_archive >> n_processes;
+
+  AssertThrow(n_processes == Utilities::MPI::n_mpi_processes(mpi_communicator),
+              ExcMessage("The checkpoint was written with " +
+                         std::to_string(n_processes) + " processes. A "
+                         "restart requires the same number of processes."));
+
+  // The partition has to coincide with the one of the checkpoint. The
+  // weights of the cells depend on the Dirichlet boundaries.
+  *restart_archive >> dirichlet_boundary_ids;
+
+  if (prm.spatial_discretization_parameters.cost_weighted_repartitioning)
+    triangulation.repartition();
+
+  *restart_archive >> time_stepping;
+
+  // The samples written after the checkpoint are discarded
+  probes.set_resume_step(time_stepping.get_step_number());
+
+  *pcout << "   Number of global active cells:      "
+         << triangulation.n_global_active_cells() << std::endl;
+}
+
+
+
+template <int dim>
+void Problem<dim>::load_checkpoint_fields()
+{
+  AssertThrow(restart_archive != nullptr,
+              ExcMessage("No checkpoint was opened."));
+
+  TimerOutput::Scope  t(*computing_timer, "Problem: Restart");
+
+  for (const auto &entity: container.get_field_collection())
+  {
+    const IndexSet &locally_owned_dofs =
+      entity.first->get_locally_owned_dofs();
+
+    LinearAlgebra::MPI::Vector  distributed_vector(entity.first->distributed_vector);
+
+    for (LinearAlgebra::MPI::Vector *vector:
+         {&entity.first->solution,
+          &entity.first->old_solution,
+          &entity.first->old_old_solution})
+    {
+      std::vector<double> values;
+      *restart_archive >> values;
+
+      AssertThrow(values.size() == locally_owned_dofs.n_elements(),
+                  ExcMessage("The partition of the \"" + entity.first->name +
+                             "\" entity differs from the one of the "
+                             "checkpoint."));
+
+      unsigned int i = 0;
+      for (const auto index: locally_owned_dofs)
+        distributed_vector(index) = values[i++];
+
+      distributed_vector.compress(VectorOperation::insert);
+
+      *vector = distributed_vector;
+    }
+  }
+
+  *restart_archive >> graphical_output;
+
+  load_checkpoint_data(*restart_archive);
+
+  restart_archive.reset();
+  restart_stream.reset();
+}
+
+
+
+template <int dim>
+void Problem<dim>::save_checkpoint_data
+(boost::archive::binary_oarchive &/* archive */) const
+{}
+
+
+
+template <int dim>
+void Problem<dim>::load_checkpoint_data
+(boost::archive::binary_iarchive &/* archive */)
+{}
+
 } // namespace RMHD
 
 template struct RMHD::SolutionTransferContainer<2>;
@@ -9,6 +9,7 @@
 
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
 
 #include <fstream>
 
@@ -20,6 +21,13 @@ using namespace dealii;
 namespace RunTimeParameters
 {
 
+namespace
+{
+  // The memory budget of the cell geometry caches is only printed if it
+  // deviates from this default value
+  constexpr unsigned int default_cell_geometry_cache_memory_budget = 1024;
+}
+
 SpatialDiscretizationParameters::SpatialDiscretizationParameters()
 :
 adaptive_mesh_refinement(false),
@@ -30,7 +38,12 @@ n_maximum_levels(5),
 n_minimum_levels(1),
 n_initial_adaptive_refinements(0),
 n_initial_global_refinements(0),
-n_initial_boundary_refinements(0)
+n_initial_boundary_refinements(0),
+cost_weighted_repartitioning(false),
+dirichlet_boundary_face_weight(0.5),
+hanging_node_face_weight(0.25),
+error_indicator_type(ErrorIndicatorType::Kelly),
+normalize_error_indicators(false)
 {}
 
 
@@ -75,6 +88,26 @@ void SpatialDiscretizationParameters::declare_parameters(ParameterHandler &prm)
     prm.declare_entry("Number of initial boundary refinements",
                       "0",
                       Patterns::Integer(0));
+
+    prm.declare_entry("Cost-weighted repartitioning",
+                      "false",
+                      Patterns::Bool());
+
+    prm.declare_entry("Dirichlet boundary face weight",
+                      "0.5",
+                      Patterns::Double(0.));
+
+    prm.declare_entry("Hanging node face weight",
+                      "0.25",
+                      Patterns::Double(0.));
+
+    prm.declare_entry("Error indicator",
+                      "Kelly",
+                      Patterns::Selection("Kelly|gradient recovery"));
+
+    prm.declare_entry("Normalize error indicators",
+                      "false",
+                      Patterns::Bool());
   }
   prm.leave_subsection();
 }
@@ -110,6 +143,18 @@ void SpatialDiscretizationParameters::parse_parameters(ParameterHandler &prm)
 
       cell_fraction_to_refine = prm.get_double("Fraction of cells set to refine");
 
+      const std::string str_error_indicator(prm.get("Error indicator"));
+
+      if (str_error_indicator == std::string("Kelly"))
+        error_indicator_type = ErrorIndicatorType::Kelly;
+      else if (str_error_indicator == std::string("gradient recovery"))
+        error_indicator_type = ErrorIndicatorType::gradient_recovery;
+      else
+        AssertThrow(false,
+                    ExcMessage("Unexpected string for the error indicator."));
+
+      normalize_error_indicators = prm.get_bool("Normalize error indicators");
+
       const double total_cell_fraction_to_modify =
         cell_fraction_to_coarsen + cell_fraction_to_refine;
 
@@ -136,6 +181,19 @@ void SpatialDiscretizationParameters::parse_parameters(ParameterHandler &prm)
       AssertThrow(n_minimum_levels <= n_initial_refinements,
                   ExcMessage("Number of initial refinements must be larger "
                              "equal than the minimum number of levels."));
+
+    cost_weighted_repartitioning = prm.get_bool("Cost-weighted repartitioning");
+
+    if (cost_weighted_repartitioning)
+    {
+      dirichlet_boundary_face_weight = prm.get_double("Dirichlet boundary face weight");
+      AssertThrow(dirichlet_boundary_face_weight >= 0.0,
+                  ExcLowerRangeType<double>(dirichlet_boundary_face_weight, 0.0));
+
+      hanging_node_face_weight = prm.get_double("Hanging node face weight");
+      AssertThrow(hanging_node_face_weight >= 0.0,
+                  ExcLowerRangeType<double>(hanging_node_face_weight, 0.0));
+    }
   }
   prm.leave_subsection();
 }
@@ -166,6 +224,21 @@ Stream& operator<<(Stream &stream, const SpatialDiscretizationParameters &prm)
                        "Maximum number of levels", prm.n_maximum_levels);
     internal::add_line(stream,
                        "Minimum number of levels", prm.n_minimum_levels);
+    switch (prm.error_indicator_type)
+    {
+      case ErrorIndicatorType::Kelly:
+        internal::add_line(stream, "Error indicator", "Kelly");
+        break;
+      case ErrorIndicatorType::gradient_recovery:
+        internal::add_line(stream, "Error indicator", "gradient recovery");
+        break;
+      default:
+        AssertThrow(false, ExcMessage("Unexpected type identifier for the error indicator."));
+        break;
+    }
+    internal::add_line(stream,
+                       "Normalize error indicators",
+                       (prm.normalize_error_indicators ? "True": "False"));
   }
   internal::add_line(stream,
                      "Number of initial adapt. refinements",
@@ -176,6 +249,17 @@ Stream& operator<<(Stream &stream, const SpatialDiscretizationParameters &prm)
   internal::add_line(stream,
                      "Number of initial boundary refinements",
                      prm.n_initial_boundary_refinements);
+  if (prm.cost_weighted_repartitioning)
+  {
+    internal::add_line(stream,
+                       "Cost-weighted repartitioning", "True");
+    internal::add_line(stream,
+                       "  Dirichlet boundary face weight",
+                       prm.dirichlet_boundary_face_weight);
+    internal::add_line(stream,
+                       "  Hanging node face weight",
+                       prm.hanging_node_face_weight);
+  }
 
   internal::add_header(stream);
 
@@ -184,11 +268,115 @@ Stream& operator<<(Stream &stream, const SpatialDiscretizationParameters &prm)
 
 
 
+ProbeParameters::ProbeParameters()
+:
+sampling_frequency(0),
+n_buffered_samples(100),
+field_names(),
+points(),
+lines(),
+rings(),
+grids()
+{}
+
+
+
+void ProbeParameters::declare_parameters(ParameterHandler &prm)
+{
+  prm.enter_subsection("Probe parameters");
+  {
+    prm.declare_entry("Sampling frequency",
+                      "0",
+                      Patterns::Integer(0));
+
+    prm.declare_entry("Number of buffered samples",
+                      "100",
+                      Patterns::Integer(1));
+
+    prm.declare_entry("Fields",
+                      "",
+                      Patterns::List(Patterns::Anything()));
+
+    prm.declare_entry("Points",
+                      "",
+                      Patterns::Anything());
+
+    prm.declare_entry("Lines",
+                      "",
+                      Patterns::Anything());
+
+    prm.declare_entry("Rings",
+                      "",
+                      Patterns::Anything());
+
+    prm.declare_entry("Grids",
+                      "",
+                      Patterns::Anything());
+  }
+  prm.leave_subsection();
+}
+
+
+
+void ProbeParameters::parse_parameters(ParameterHandler &prm)
+{
+  prm.enter_subsection("Probe parameters");
+  {
+    sampling_frequency = prm.get_integer("Sampling frequency");
+
+    n_buffered_samples = prm.get_integer("Number of buffered samples");
+
+    field_names = Utilities::split_string_list(prm.get("Fields"));
+
+    points  = Utilities::split_string_list(prm.get("Points"), ';');
+    lines   = Utilities::split_string_list(prm.get("Lines"), ';');
+    rings   = Utilities::split_string_list(prm.get("Rings"), ';');
+    grids   = Utilities::split_string_list(prm.get("Grids"), ';');
+
+    AssertThrow(sampling_frequency == 0 ||
+                !(points.empty() && lines.empty() &&
+                  rings.empty() && grids.empty()),
+                ExcMessage("The probes are enabled but no probes are defined."));
+  }
+  prm.leave_subsection();
+}
+
+
+
+template<typename Stream>
+Stream& operator<<(Stream &stream, const ProbeParameters &prm)
+{
+  internal::add_line(stream,
+                     "Probes - Sampling frequency",
+                     prm.sampling_frequency);
+  internal::add_line(stream,
+                     "Probes - Number of buffered samples",
+                     prm.n_buffered_samples);
+  internal::add_line(stream,
+                     "Probes - Number of point sets",
+                     static_cast<unsigned int>(prm.points.size() +
+                                               prm.lines.size() +
+                                               prm.rings.size() +
+                                               prm.grids.size()));
+
+  return (stream);
+}
+
+
+
 OutputControlParameters::OutputControlParameters()
 :
 graphical_output_frequency(100),
 terminal_output_frequency(100),
-graphical_output_directory("./")
+graphical_output_directory("./"),
+graphical_output_format(GraphicalOutputFormat::vtu),
+graphical_output_queue_depth(0),
+benchmark_data_format(BenchmarkDataFormat::text),
+benchmark_data_flush_frequency(100),
+checkpoint_frequency(0),
+checkpoint_wall_time_interval(0.0),
+n_checkpoint_slots(2),
+checkpoint_directory("./checkpoints/")
 {}
 
 
@@ -207,6 +395,40 @@ void OutputControlParameters::declare_parameters(ParameterHandler &prm)
     prm.declare_entry("Graphical output directory",
                       "./",
                       Patterns::DirectoryName());
+
+    prm.declare_entry("Graphical output format",
+                      "vtu",
+                      Patterns::Selection("vtu|hdf5"));
+
+    prm.declare_entry("Graphical output queue depth",
+                      "0",
+                      Patterns::Integer(0));
+
+    prm.declare_entry("Benchmark data format",
+                      "text",
+                      Patterns::Selection("text|csv|binary"));
+
+    prm.declare_entry("Benchmark data flush frequency",
+                      "100",
+                      Patterns::Integer(1));
+
+    ProbeParameters::declare_parameters(prm);
+
+    prm.declare_entry("Checkpoint frequency",
+                      "0",
+                      Patterns::Integer(0));
+
+    prm.declare_entry("Checkpoint wall time interval",
+                      "0.0",
+                      Patterns::Double(0.));
+
+    prm.declare_entry("Number of checkpoint slots",
+                      "2",
+                      Patterns::Integer(2));
+
+    prm.declare_entry("Checkpoint directory",
+                      "./checkpoints/",
+                      Patterns::DirectoryName());
   }
   prm.leave_subsection();
 }
@@ -227,6 +449,61 @@ void OutputControlParameters::parse_parameters(ParameterHandler &prm)
            ExcMessage("The terminal output frequency must larger than zero."));
 
     graphical_output_directory = prm.get("Graphical output directory");
+
+    const std::string str_graphical_output_format(prm.get("Graphical output format"));
+
+    if (str_graphical_output_format == std::string("vtu"))
+      graphical_output_format = GraphicalOutputFormat::vtu;
+    else if (str_graphical_output_format == std::string("hdf5"))
+    {
+      #ifdef DEAL_II_WITH_HDF5
+        graphical_output_format = GraphicalOutputFormat::hdf5;
+      #else
+        AssertThrow(false,
+                    ExcMessage("The HDF5 output requires deal.II to be "
+                               "configured with HDF5."));
+      #endif
+    }
+    else
+      AssertThrow(false,
+                  ExcMessage("Unexpected identifier for the graphical output format."));
+
+    graphical_output_queue_depth = prm.get_integer("Graphical output queue depth");
+    #ifdef USE_PETSC_LA
+      AssertThrow(graphical_output_queue_depth == 0,
+                  ExcMessage("The asynchronous graphical output is only "
+                             "implemented for the Trilinos library, since "
+                             "PETSc is not thread-safe. Please set the "
+                             "graphical output queue depth to zero."));
+    #endif
+
+    const std::string str_benchmark_data_format(prm.get("Benchmark data format"));
+
+    if (str_benchmark_data_format == std::string("text"))
+      benchmark_data_format = BenchmarkDataFormat::text;
+    else if (str_benchmark_data_format == std::string("csv"))
+      benchmark_data_format = BenchmarkDataFormat::csv;
+    else if (str_benchmark_data_format == std::string("binary"))
+      benchmark_data_format = BenchmarkDataFormat::binary;
+    else
+      AssertThrow(false,
+                  ExcMessage("Unexpected identifier for the benchmark data format."));
+
+    benchmark_data_flush_frequency = prm.get_integer("Benchmark data flush frequency");
+
+    probe_parameters.parse_parameters(prm);
+
+    checkpoint_frequency = prm.get_integer("Checkpoint frequency");
+
+    checkpoint_wall_time_interval = prm.get_double("Checkpoint wall time interval");
+    AssertThrow(checkpoint_wall_time_interval >= 0.0,
+                ExcLowerRangeType<double>(checkpoint_wall_time_interval, 0.0));
+
+    n_checkpoint_slots = prm.get_integer("Number of checkpoint slots");
+    AssertThrow(n_checkpoint_slots > 1,
+                ExcMessage("At least two checkpoint slots are required."));
+
+    checkpoint_directory = prm.get("Checkpoint directory");
   }
   prm.leave_subsection();
 }
@@ -249,6 +526,41 @@ Stream& operator<<(Stream &stream, const OutputControlParameters &prm)
   internal::add_line(stream,
                      "Graphical output directory",
                      prm.graphical_output_directory);
+  if (prm.graphical_output_format == GraphicalOutputFormat::hdf5)
+    internal::add_line(stream,
+                       "Graphical output format",
+                       "hdf5");
+  if (prm.graphical_output_queue_depth > 0)
+    internal::add_line(stream,
+                       "Graphical output queue depth",
+                       prm.graphical_output_queue_depth);
+  if (prm.benchmark_data_format != BenchmarkDataFormat::text)
+  {
+    internal::add_line(stream,
+                       "Benchmark data format",
+                       (prm.benchmark_data_format == BenchmarkDataFormat::csv
+                        ? "csv" : "binary"));
+    internal::add_line(stream,
+                       "Benchmark data flush frequency",
+                       prm.benchmark_data_flush_frequency);
+  }
+  if (prm.probe_parameters.sampling_frequency > 0)
+    stream << prm.probe_parameters;
+  if (prm.checkpoint_frequency > 0 || prm.checkpoint_wall_time_interval > 0.0)
+  {
+    internal::add_line(stream,
+                       "Checkpoint frequency",
+                       prm.checkpoint_frequency);
+    internal::add_line(stream,
+                       "Checkpoint wall time interval",
+                       prm.checkpoint_wall_time_interval);
+    internal::add_line(stream,
+                       "Number of checkpoint slots",
+                       prm.n_checkpoint_slots);
+    internal::add_line(stream,
+                       "Checkpoint directory",
+                       prm.checkpoint_directory);
+  }
 
   internal::add_header(stream);
 
@@ -669,6 +981,12 @@ void NavierStokesParameters::parse_parameters(ParameterHandler &prm)
     }
     prm.leave_subsection();
 
+    AssertThrow(diffusion_step_solver_parameters.solver_type == SolverType::Krylov ||
+                diffusion_step_solver_parameters.solver_type == SolverType::pipelined_Krylov,
+                ExcMessage("Only a (pipelined) Krylov solver is supported for "
+                           "the diffusion step as its matrix is non-symmetric "
+                           "and changes every time step."));
+
     prm.enter_subsection("Linear solver parameters - Projection step");
     {
       projection_step_solver_parameters.parse_parameters(prm);
@@ -686,6 +1004,11 @@ void NavierStokesParameters::parse_parameters(ParameterHandler &prm)
       poisson_prestep_solver_parameters.parse_parameters(prm);
     }
     prm.leave_subsection();
+
+    AssertThrow(poisson_prestep_solver_parameters.solver_type == SolverType::Krylov ||
+                poisson_prestep_solver_parameters.solver_type == SolverType::pipelined_Krylov,
+                ExcMessage("Only a (pipelined) Krylov solver is supported for "
+                           "the Poisson pre-step as it is only solved once."));
   }
   prm.leave_subsection();
 }
@@ -889,6 +1212,12 @@ void HeatEquationParameters::parse_parameters(ParameterHandler &prm)
       solver_parameters.parse_parameters(prm);
     }
     prm.leave_subsection();
+
+    AssertThrow(solver_parameters.solver_type == SolverType::Krylov ||
+                solver_parameters.solver_type == SolverType::pipelined_Krylov,
+                ExcMessage("Only a (pipelined) Krylov solver is supported for "
+                           "the heat equation as its matrix is non-symmetric "
+                           "and changes every time step."));
   }
   prm.leave_subsection();
 }
@@ -957,6 +1286,12 @@ OutputControlParameters(),
 dim(2),
 mapping_degree(1),
 mapping_interior_cells(false),
+mapping_cache(false),
+cell_geometry_cache_memory_budget(default_cell_geometry_cache_memory_budget),
+benchmark_mode(false),
+benchmark_skip_postprocessing(false),
+benchmark_n_warm_up_steps(10),
+memory_report(false),
 verbose(false),
 spatial_discretization_parameters(),
 time_discretization_parameters()
@@ -978,6 +1313,30 @@ void ProblemBaseParameters::declare_parameters(ParameterHandler &prm)
                     "false",
                     Patterns::Bool());
 
+  prm.declare_entry("Mapping - Cache support points",
+                    "false",
+                    Patterns::Bool());
+
+  prm.declare_entry("Cell geometry cache - Memory budget (MB)",
+                    std::to_string(default_cell_geometry_cache_memory_budget),
+                    Patterns::Integer(0));
+
+  prm.declare_entry("Benchmark mode",
+                    "false",
+                    Patterns::Bool());
+
+  prm.declare_entry("Benchmark mode - Skip postprocessing",
+                    "false",
+                    Patterns::Bool());
+
+  prm.declare_entry("Benchmark mode - Warm-up steps",
+                    "10",
+                    Patterns::Integer(1));
+
+  prm.declare_entry("Memory report",
+                    "false",
+                    Patterns::Bool());
+
   prm.declare_entry("Verbose",
                     "false",
                     Patterns::Bool());
@@ -1004,6 +1363,22 @@ void ProblemBaseParameters::parse_parameters(ParameterHandler &prm)
 
   mapping_interior_cells = prm.get_bool("Mapping - Apply to interior cells");
 
+  mapping_cache = prm.get_bool("Mapping - Cache support points");
+
+  cell_geometry_cache_memory_budget =
+    prm.get_integer("Cell geometry cache - Memory budget (MB)");
+
+  benchmark_mode = prm.get_bool("Benchmark mode");
+
+  benchmark_skip_postprocessing =
+    prm.get_bool("Benchmark mode - Skip postprocessing");
+
+  benchmark_n_warm_up_steps = prm.get_integer("Benchmark mode - Warm-up steps");
+  AssertThrow(benchmark_n_warm_up_steps > 0,
+              ExcLowerRange(benchmark_n_warm_up_steps, 1));
+
+  memory_report = prm.get_bool("Memory report");
+
   verbose = prm.get_bool("Verbose");
 
   OutputControlParameters::parse_parameters(prm);
@@ -1027,7 +1402,8 @@ Stream& operator<<(Stream &stream, const ProblemBaseParameters &prm)
   {
     std::stringstream strstream;
 
-    strstream << "MappingQ<" << std::to_string(prm.dim) << ">"
+    strstream << (prm.mapping_cache ? "MappingQCache<" : "MappingQ<")
+              << std::to_string(prm.dim) << ">"
               << "(" << std::to_string(prm.mapping_degree) << ")";
     internal::add_line(stream, "Mapping", strstream.str().c_str());
   }
@@ -1037,6 +1413,26 @@ Stream& operator<<(Stream &stream, const ProblemBaseParameters &prm)
                      (prm.mapping_interior_cells ? "true" : "false"));
 
 
+  if (prm.cell_geometry_cache_memory_budget !=
+      default_cell_geometry_cache_memory_budget)
+    internal::add_line(stream,
+                       "Cell geometry cache - Memory budget (MB)",
+                       prm.cell_geometry_cache_memory_budget);
+
+  if (prm.benchmark_mode)
+  {
+    internal::add_line(stream, "Benchmark mode", "true");
+    internal::add_line(stream,
+                       "Benchmark mode - Skip postprocessing",
+                       (prm.benchmark_skip_postprocessing ? "true" : "false"));
+    internal::add_line(stream,
+                       "Benchmark mode - Warm-up steps",
+                       prm.benchmark_n_warm_up_steps);
+  }
+
+  if (prm.memory_report)
+    internal::add_line(stream, "Memory report", "true");
+
   internal::add_line(stream, "Verbose", (prm.verbose? "true": "false"));
 
   stream << static_cast<const OutputControlParameters &>(prm);
@@ -1607,7 +2003,8 @@ Stream& operator<<(Stream &stream, const ProblemParameters &prm)
   {
     std::stringstream strstream;
 
-    strstream << "MappingQ<" << std::to_string(prm.dim) << ">"
+    strstream << (prm.mapping_cache ? "MappingQCache<" : "MappingQ<")
+              << std::to_string(prm.dim) << ">"
               << "(" << std::to_string(prm.mapping_degree) << ")";
     internal::add_line(stream, "Mapping", strstream.str().c_str());
   }
@@ -1632,6 +2029,26 @@ Stream& operator<<(Stream &stream, const ProblemParameters &prm)
                        fe_temperature);
   }
 
+  if (prm.cell_geometry_cache_memory_budget !=
+      default_cell_geometry_cache_memory_budget)
+    internal::add_line(stream,
+                       "Cell geometry cache - Memory budget (MB)",
+                       prm.cell_geometry_cache_memory_budget);
+
+  if (prm.benchmark_mode)
+  {
+    internal::add_line(stream, "Benchmark mode", "true");
+    internal::add_line(stream,
+                       "Benchmark mode - Skip postprocessing",
+                       (prm.benchmark_skip_postprocessing ? "true" : "false"));
+    internal::add_line(stream,
+                       "Benchmark mode - Warm-up steps",
+                       prm.benchmark_n_warm_up_steps);
+  }
+
+  if (prm.memory_report)
+    internal::add_line(stream, "Memory report", "true");
+
   internal::add_line(stream, "Verbose", (prm.verbose? "true": "false"));
 
   stream << static_cast<const OutputControlParameters &>(prm);
@@ -1704,6 +2121,11 @@ template std::ostream & RMHD::RunTimeParameters::operator<<
 template dealii::ConditionalOStream  & RMHD::RunTimeParameters::operator<<
 (dealii::ConditionalOStream &, const RMHD::RunTimeParameters::SpatialDiscretizationParameters &);
 
+template std::ostream & RMHD::RunTimeParameters::operator<<
+(std::ostream &, const RMHD::RunTimeParameters::ProbeParameters &);
+template dealii::ConditionalOStream  & RMHD::RunTimeParameters::operator<<
+(dealii::ConditionalOStream &, const RMHD::RunTimeParameters::ProbeParameters &);
+
 template std::ostream & RMHD::RunTimeParameters::operator<<
 (std::ostream &, const RMHD::RunTimeParameters::OutputControlParameters &);
 template dealii::ConditionalOStream  & RMHD::RunTimeParameters::operator<<
@@ -0,0 +1,351 @@
+#include <rotatingMHD/time_series_writer.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace RMHD
+{
+
+namespace
+{
+
+/*!
+ * @brief The magic string at the beginning of the binary format.
+ */
+constexpr char binary_magic[] = "RMHDTS1\n";
+
+/*!
+ * @brief The size of the magic string without the terminating null
+ * character.
+ */
+constexpr std::size_t binary_magic_size = sizeof(binary_magic) - 1;
+
+
+
+/*!
+ * @brief Splits a line of the CSV format into its fields.
+ */
+std::vector<std::string> split_csv_line(const std::string &line)
+{
+  std::vector<std::string>  fields;
+  std::stringstream         stream(line);
+  std::string               field;
+
+  while (std::getline(stream, field, ','))
+    fields.push_back(field);
+
+  return (fields);
+}
+
+} // namespace
+
+
+
+TimeSeriesWriter::TimeSeriesWriter
+(const std::string                             &file_name,
+ const std::vector<std::string>                &column_names,
+ const RunTimeParameters::BenchmarkDataFormat   format,
+ const unsigned int                             flush_frequency,
+ const MPI_Comm                                 mpi_communicator,
+ const unsigned int                             resume_step)
+:
+file_name(file_name),
+column_names(column_names),
+format(format),
+flush_frequency(flush_frequency),
+flag_root_process(Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+{
+  AssertThrow(format != RunTimeParameters::BenchmarkDataFormat::text,
+              ExcMessage("The time series writer only supports the CSV and "
+                         "the binary format."));
+  AssertThrow(!column_names.empty(),
+              ExcMessage("The time series requires at least one column."));
+  AssertThrow(flush_frequency > 0,
+              ExcLowerRange(flush_frequency, 1));
+
+  if (!flag_root_process)
+    return;
+
+  buffer.reserve(flush_frequency * column_names.size());
+
+  if (resume_step == numbers::invalid_unsigned_int ||
+      !std::filesystem::exists(file_name))
+  {
+    create_file();
+    return;
+  }
+
+  if (format == RunTimeParameters::BenchmarkDataFormat::binary)
+    truncate_binary_file(resume_step);
+  else
+    truncate_csv_file(resume_step);
+
+  file.open(file_name, std::ios::binary | std::ios::app);
+
+  AssertThrow(file.good(),
+              ExcMessage("The file " + file_name + " could not be opened."));
+}
+
+
+
+TimeSeriesWriter::~TimeSeriesWriter()
+{
+  if (!flag_root_process)
+    return;
+
+  // An exception must not leave the destructor, as it might be called
+  // during stack unwinding
+  try
+  {
+    flush();
+  }
+  catch (std::exception &exc)
+  {
+    std::cerr << std::endl << std::endl
+              << "----------------------------------------------------"
+              << std::endl;
+    std::cerr << "Exception in the destructor of the time series writer: "
+              << std::endl
+              << exc.what() << std::endl
+              << "The buffered rows of " << file_name << " are lost!"
+              << std::endl
+              << "----------------------------------------------------"
+              << std::endl;
+  }
+  catch (...)
+  {
+    std::cerr << std::endl << std::endl
+              << "----------------------------------------------------"
+              << std::endl;
+    std::cerr << "Unknown exception in the destructor of the time series "
+                 "writer!" << std::endl
+              << "The buffered rows of " << file_name << " are lost!"
+              << std::endl
+              << "----------------------------------------------------"
+              << std::endl;
+  }
+}
+
+
+
+void TimeSeriesWriter::add_row(const std::vector<double> &values)
+{
+  AssertDimension(values.size(), column_names.size());
+
+  if (!flag_root_process)
+    return;
+
+  buffer.insert(buffer.end(), values.begin(), values.end());
+
+  if (buffer.size() >= flush_frequency * column_names.size())
+    flush();
+}
+
+
+
+void TimeSeriesWriter::flush()
+{
+  if (!flag_root_process || buffer.empty())
+    return;
+
+  switch (format)
+  {
+    case RunTimeParameters::BenchmarkDataFormat::binary:
+      file.write(reinterpret_cast<const char *>(buffer.data()),
+                 buffer.size() * sizeof(double));
+      break;
+    case RunTimeParameters::BenchmarkDataFormat::csv:
+      file << std::setprecision(std::numeric_limits<double>::max_digits10);
+      for (std::size_t i = 0; i < buffer.size(); ++i)
+        file << buffer[i]
+             << ((i + 1) % column_names.size() == 0 ? '\n' : ',');
+      break;
+    default:
+      Assert(false, ExcNotImplemented());
+      break;
+  }
+
+  file.flush();
+
+  AssertThrow(file.good(),
+              ExcMessage("The time series could not be written to the file " +
+                         file_name + "."));
+
+  buffer.clear();
+}
+
+
+
+void TimeSeriesWriter::create_file()
+{
+  file.open(file_name, std::ios::binary | std::ios::trunc);
+
+  AssertThrow(file.good(),
+              ExcMessage("The file " + file_name + " could not be created."));
+
+  if (format == RunTimeParameters::BenchmarkDataFormat::csv)
+  {
+    for (unsigned int i = 0; i < column_names.size(); ++i)
+      file << column_names[i]
+           << (i + 1 < column_names.size() ? ',' : '\n');
+  }
+  else
+  {
+    std::string names;
+
+    for (const auto &name: column_names)
+    {
+      names += name;
+      names += '\0';
+    }
+
+    const std::uint64_t n_columns = column_names.size();
+
+    std::uint64_t data_offset =
+      binary_magic_size + 2 * sizeof(std::uint64_t) + names.size();
+    data_offset += (8 - data_offset % 8) % 8;
+
+    names.resize(data_offset - binary_magic_size - 2 * sizeof(std::uint64_t),
+                 '\0');
+
+    file.write(binary_magic, binary_magic_size);
+    file.write(reinterpret_cast<const char *>(&n_columns), sizeof(n_columns));
+    file.write(reinterpret_cast<const char *>(&data_offset), sizeof(data_offset));
+    file.write(names.data(), names.size());
+  }
+
+  file.flush();
+}
+
+
+
+void TimeSeriesWriter::truncate_binary_file(const unsigned int resume_step) const
+{
+  const unsigned int step_column = get_step_column();
+
+  std::ifstream input(file_name, std::ios::binary);
+
+  char          magic[binary_magic_size];
+  std::uint64_t n_columns   = 0;
+  std::uint64_t data_offset = 0;
+
+  input.read(magic, binary_magic_size);
+  input.read(reinterpret_cast<char *>(&n_columns), sizeof(n_columns));
+  input.read(reinterpret_cast<char *>(&data_offset), sizeof(data_offset));
+
+  AssertThrow(input.good() &&
+              std::memcmp(magic, binary_magic, binary_magic_size) == 0,
+              ExcMessage("The file " + file_name + " is not a binary time "
+                         "series."));
+  AssertThrow(n_columns == column_names.size(),
+              ExcMessage("The number of columns of the file " + file_name +
+                         " does not match the one of the time series."));
+
+  std::string names(data_offset - binary_magic_size - 2 * sizeof(std::uint64_t),
+                    '\0');
+  input.read(&names[0], names.size());
+
+  {
+    std::size_t position = 0;
+
+    for (const auto &name: column_names)
+    {
+      AssertThrow(names.compare(position, name.size() + 1,
+                                name + '\0') == 0,
+                  ExcMessage("The columns of the file " + file_name +
+                             " do not match the ones of the time series."));
+      position += name.size() + 1;
+    }
+  }
+
+  // Only complete rows are considered, i.e., a row which was partially
+  // written before the simulation was aborted is removed as well.
+  const std::uint64_t row_size  = n_columns * sizeof(double);
+  const std::uint64_t n_rows    =
+    (std::filesystem::file_size(file_name) - data_offset) / row_size;
+
+  std::uint64_t n_kept_rows = 0;
+  std::vector<double> row(n_columns);
+
+  for (; n_kept_rows < n_rows; ++n_kept_rows)
+  {
+    input.read(reinterpret_cast<char *>(row.data()), row_size);
+
+    if (!input.good() || row[step_column] > resume_step)
+      break;
+  }
+
+  input.close();
+
+  std::filesystem::resize_file(file_name, data_offset + n_kept_rows * row_size);
+}
+
+
+
+void TimeSeriesWriter::truncate_csv_file(const unsigned int resume_step) const
+{
+  const unsigned int step_column = get_step_column();
+
+  std::ifstream input(file_name);
+
+  std::string line;
+
+  std::getline(input, line);
+
+  AssertThrow(split_csv_line(line) == column_names,
+              ExcMessage("The columns of the file " + file_name +
+                         " do not match the ones of the time series."));
+
+  const std::string tmp_file_name = file_name + ".tmp";
+
+  {
+    std::ofstream output(tmp_file_name, std::ios::binary | std::ios::trunc);
+
+    output << line << '\n';
+
+    // A line without a trailing newline was only partially written before
+    // the simulation was aborted and is therefore removed.
+    while (std::getline(input, line) && !input.eof())
+    {
+      const std::vector<std::string> fields = split_csv_line(line);
+
+      if (fields.size() != column_names.size() ||
+          std::stod(fields[step_column]) > resume_step)
+        break;
+
+      output << line << '\n';
+    }
+
+    AssertThrow(output.good(),
+                ExcMessage("The file " + tmp_file_name + " could not be "
+                           "written."));
+  }
+
+  input.close();
+
+  std::filesystem::rename(tmp_file_name, file_name);
+}
+
+
+
+unsigned int TimeSeriesWriter::get_step_column() const
+{
+  const auto it = std::find(column_names.begin(), column_names.end(), "step");
+
+  AssertThrow(it != column_names.end(),
+              ExcMessage("A time series can only be resumed if it contains "
+                         "a column named \"step\"."));
+
+  return (std::distance(column_names.begin(), it));
+}
+
+} // namespace RMHD
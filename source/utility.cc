@@ -1,6 +1,8 @@
+#include <rotatingMHD/linear_solvers.h>
 #include <rotatingMHD/utility.h>
 
 #include <deal.II/base/mpi.h>
+#include <deal.II/distributed/tria_base.h>
 
 namespace RMHD
 {
@@ -24,7 +26,7 @@ void build_preconditioner
     case (PreconditionerType::ILU):
     {
       #ifdef USE_PETSC_LA
-        AssertThrow(Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD) == 1,
+        AssertThrow(Utilities::MPI::n_mpi_processes(matrix.get_mpi_communicator()) == 1,
                     ExcMessage("PreconditionILU using the PETSc library "
                                 "only works in serial. Please choose a different"
                                 " preconditioner."));
@@ -44,6 +46,21 @@ void build_preconditioner
         preconditioner_data.ilu_atol = preconditioner_parameters->absolute_tolerance;
       #endif
 
+      #ifndef USE_PETSC_LA
+        if (preconditioner_parameters->mixed_precision)
+        {
+          preconditioner =
+              std::make_shared<PreconditionMixedPrecisionILU>();
+
+          static_cast<PreconditionMixedPrecisionILU*>(preconditioner.get())
+              ->initialize(matrix,
+                           PreconditionMixedPrecisionILU::AdditionalData(
+                             preconditioner_parameters->strengthen_diagonal));
+
+          break;
+        }
+      #endif
+
       preconditioner =
           std::make_shared<LinearAlgebra::MPI::PreconditionILU>();
 
@@ -134,6 +151,41 @@ void build_preconditioner
   }
 }
 
+
+
+std::size_t preconditioner_memory_consumption
+(const std::shared_ptr<LinearAlgebra::PreconditionBase> &preconditioner)
+{
+  if (!preconditioner)
+    return (0);
+
+  #ifndef USE_PETSC_LA
+    if (const auto *amg =
+          dynamic_cast<const LinearAlgebra::MPI::PreconditionAMG *>(preconditioner.get()))
+      return (amg->memory_consumption());
+
+    if (const auto *ilu =
+          dynamic_cast<const PreconditionMixedPrecisionILU *>(preconditioner.get()))
+      return (ilu->memory_consumption());
+  #endif
+
+  return (0);
+}
+
+
+
+template <int dim>
+MPI_Comm get_mpi_communicator(const dealii::Triangulation<dim> &triangulation)
+{
+  const parallel::TriangulationBase<dim> *tria_ptr =
+      dynamic_cast<const parallel::TriangulationBase<dim> *>(&triangulation);
+
+  if (tria_ptr != nullptr)
+    return (tria_ptr->get_communicator());
+
+  return (MPI_COMM_WORLD);
+}
+
 }  // namespace RMD
 
 // explicit instantiations
@@ -143,3 +195,8 @@ template void RMHD::build_preconditioner<RMHD::LinearAlgebra::MPI::SparseMatrix>
  const std::shared_ptr<RunTimeParameters::PreconditionBaseParameters> &,
  const bool ,
  const bool );
+
+template MPI_Comm RMHD::get_mpi_communicator<2>
+(const dealii::Triangulation<2> &);
+template MPI_Comm RMHD::get_mpi_communicator<3>
+(const dealii::Triangulation<3> &);
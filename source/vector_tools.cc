@@ -1,5 +1,16 @@
 #include <rotatingMHD/vector_tools.h>
 
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/work_stream.h>
+#include <deal.II/distributed/tria_base.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/grid/filtered_iterator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 namespace RMHD
 {
 
@@ -7,6 +18,179 @@ namespace VectorTools
 {
 
 
+namespace
+{
+
+/*!
+ * @brief Scratch data of the loop over the cells of @ref compute_error. It
+ * contains the values of the finite element field and the exact solution
+ * at the quadrature points of the L2- and H1-norms and at the support
+ * points of the Linfty-norm.
+ */
+template <int dim>
+struct ErrorScratch
+{
+  ErrorScratch(const Mapping<dim>        &mapping,
+               const FiniteElement<dim>  &fe,
+               const Quadrature<dim>     &quadrature_formula,
+               const Quadrature<dim>     &linfty_quadrature_formula);
+
+  ErrorScratch(const ErrorScratch<dim> &data);
+
+  FEValues<dim>                             fe_values;
+
+  FEValues<dim>                             linfty_fe_values;
+
+  const unsigned int                        n_components;
+
+  std::vector<double>                       scalar_values;
+
+  std::vector<Tensor<1,dim>>                scalar_gradients;
+
+  std::vector<Vector<double>>               exact_values;
+
+  std::vector<std::vector<Tensor<1,dim>>>   exact_gradients;
+
+  std::vector<Vector<double>>               values;
+
+  std::vector<std::vector<Tensor<1,dim>>>   gradients;
+
+  std::vector<Vector<double>>               linfty_exact_values;
+
+  std::vector<Vector<double>>               linfty_values;
+
+  std::vector<double>                       psi_scalar;
+};
+
+
+
+template <int dim>
+ErrorScratch<dim>::ErrorScratch
+(const Mapping<dim>        &mapping,
+ const FiniteElement<dim>  &fe,
+ const Quadrature<dim>     &quadrature_formula,
+ const Quadrature<dim>     &linfty_quadrature_formula)
+:
+fe_values(mapping,
+          fe,
+          quadrature_formula,
+          update_values|
+          update_gradients|
+          update_quadrature_points|
+          update_JxW_values),
+linfty_fe_values(mapping,
+                 fe,
+                 linfty_quadrature_formula,
+                 update_values|
+                 update_quadrature_points),
+n_components(fe.n_components()),
+scalar_values(std::max(quadrature_formula.size(),
+                       linfty_quadrature_formula.size())),
+scalar_gradients(quadrature_formula.size()),
+exact_values(quadrature_formula.size(), Vector<double>(n_components)),
+exact_gradients(quadrature_formula.size(),
+                std::vector<Tensor<1,dim>>(n_components)),
+values(quadrature_formula.size(), Vector<double>(n_components)),
+gradients(quadrature_formula.size(),
+          std::vector<Tensor<1,dim>>(n_components)),
+linfty_exact_values(linfty_quadrature_formula.size(),
+                    Vector<double>(n_components)),
+linfty_values(linfty_quadrature_formula.size(),
+              Vector<double>(n_components)),
+psi_scalar(quadrature_formula.size())
+{}
+
+
+
+template <int dim>
+ErrorScratch<dim>::ErrorScratch(const ErrorScratch<dim> &data)
+:
+ErrorScratch<dim>(data.fe_values.get_mapping(),
+                  data.fe_values.get_fe(),
+                  data.fe_values.get_quadrature(),
+                  data.linfty_fe_values.get_quadrature())
+{}
+
+
+
+/*!
+ * @brief The errors of a single cell in the L2-norm, the H1-seminorm, the
+ * H1-norm and the Linfty-norm.
+ */
+struct ErrorCopy
+{
+  unsigned int  cell_index;
+
+  double        L2_error;
+
+  double        H1_seminorm_error;
+
+  double        H1_error;
+
+  double        Linfty_error;
+};
+
+
+
+/*!
+ * @brief Evaluates the exact solution at the quadrature points of
+ * @p fe_values.
+ *
+ * @details The scalar variant of the function's interface is used for a
+ * single component, which avoids a virtual function call per component.
+ */
+template <int dim>
+void evaluate_exact_solution
+(const Function<dim>          &exact_solution,
+ const FEValues<dim>          &fe_values,
+ std::vector<double>          &scalar_values,
+ std::vector<Vector<double>>  &values)
+{
+  const unsigned int n_q_points = fe_values.n_quadrature_points;
+
+  if (exact_solution.n_components == 1)
+  {
+    scalar_values.resize(n_q_points);
+    exact_solution.value_list(fe_values.get_quadrature_points(),
+                              scalar_values);
+    for (unsigned int q = 0; q < n_q_points; ++q)
+      values[q](0) = scalar_values[q];
+  }
+  else
+    exact_solution.vector_value_list(fe_values.get_quadrature_points(),
+                                     values);
+}
+
+
+
+/*!
+ * @brief Evaluates the finite element field @p solution at the quadrature
+ * points of @p fe_values.
+ */
+template <int dim, typename VectorType>
+void evaluate_solution
+(const VectorType             &solution,
+ const FEValues<dim>          &fe_values,
+ std::vector<double>          &scalar_values,
+ std::vector<Vector<double>>  &values)
+{
+  const unsigned int n_q_points = fe_values.n_quadrature_points;
+
+  if (fe_values.get_fe().n_components() == 1)
+  {
+    scalar_values.resize(n_q_points);
+    fe_values.get_function_values(solution, scalar_values);
+    for (unsigned int q = 0; q < n_q_points; ++q)
+      values[q](0) = scalar_values[q];
+  }
+  else
+    fe_values.get_function_values(solution, values);
+}
+
+} // namespace
+
+
+
 template <int dim, typename VectorType>
 std::map<NormType, double>
 compute_error
@@ -23,52 +207,178 @@ compute_error
   AssertThrow(n_components == exact_solution.n_components,
               ExcDimensionMismatch(n_components, exact_solution.n_components));
 
-  Vector<double>  cellwise_error(tria.n_active_cells());
-
-  auto compute_error
-  = [&mapping, &tria, &cellwise_error, &dof_handler, &fe_field]
-     (const Quadrature<dim>&quadrature,
-      const Function<dim>  &exact_solution,
-      const NormType        norm_type)
-  ->
-  double
-  {
-    dealii::VectorTools::integrate_difference(mapping,
-                                              dof_handler,
-                                              fe_field.solution,
-                                              exact_solution,
-                                              cellwise_error,
-                                              quadrature,
-                                              norm_type);
-    return (dealii::VectorTools::compute_global_error(tria,
-                                                      cellwise_error,
-                                                      norm_type));
-  };
-
   const QGauss<dim> quadrature_formula(fe_degree + 1);
 
-  NormType norm_type;
+  /*
+   * For the infinity norm, the quadrature rule is designed such that the
+   * quadrature points coincide with the support points of an element with
+   * equidistantly spaced support points, i.e., the solution is sampled at
+   * the nodes.
+   */
+  const QTrapez<1>     trapezoidal_rule;
+  const QIterated<dim> linfty_quadrature_formula(trapezoidal_rule,
+                                                 fe_degree);
 
-  std::map<NormType, double> error_map;
+  /*
+   * All norms are computed in a single loop over the cells. The exact
+   * solution and its gradient are evaluated once per quadrature point and
+   * shared by the L2-norm, the H1-seminorm and the H1-norm. The cell-wise
+   * errors are computed in the same way as by
+   * dealii::VectorTools::integrate_difference.
+   */
+  auto worker =
+    [&](const typename DoFHandler<dim>::active_cell_iterator &cell,
+        ErrorScratch<dim>                                    &scratch,
+        ErrorCopy                                            &data)
+    {
+      const unsigned int n_q_points = scratch.fe_values.n_quadrature_points;
+
+      scratch.fe_values.reinit(cell);
+
+      evaluate_exact_solution(exact_solution,
+                              scratch.fe_values,
+                              scratch.scalar_values,
+                              scratch.exact_values);
+      evaluate_solution(fe_field.solution,
+                        scratch.fe_values,
+                        scratch.scalar_values,
+                        scratch.values);
+
+      if (n_components == 1)
+      {
+        exact_solution.gradient_list(scratch.fe_values.get_quadrature_points(),
+                                     scratch.scalar_gradients);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          scratch.exact_gradients[q][0] = scratch.scalar_gradients[q];
+
+        scratch.fe_values.get_function_gradients(fe_field.solution,
+                                                 scratch.scalar_gradients);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          scratch.gradients[q][0] = scratch.scalar_gradients[q];
+      }
+      else
+      {
+        exact_solution.vector_gradient_list(scratch.fe_values.get_quadrature_points(),
+                                            scratch.exact_gradients);
+        scratch.fe_values.get_function_gradients(fe_field.solution,
+                                                 scratch.gradients);
+      }
+
+      const std::vector<double> &JxW_values = scratch.fe_values.get_JxW_values();
+
+      // Square of the error in the L2-norm
+      for (unsigned int q = 0; q < n_q_points; ++q)
+      {
+        scratch.exact_values[q] -= scratch.values[q];
+        scratch.psi_scalar[q] = scratch.exact_values[q].norm_sqr();
+      }
+      const double L2_error_square =
+        std::inner_product(scratch.psi_scalar.begin(),
+                           scratch.psi_scalar.end(),
+                           JxW_values.begin(),
+                           0.0);
+
+      // Square of the error in the H1-seminorm
+      for (unsigned int q = 0; q < n_q_points; ++q)
+      {
+        scratch.psi_scalar[q] = 0.0;
+        for (unsigned int k = 0; k < n_components; ++k)
+          scratch.psi_scalar[q] += (scratch.exact_gradients[q][k] -
+                                    scratch.gradients[q][k]).norm_square();
+      }
+      const double H1_seminorm_error_square =
+        std::inner_product(scratch.psi_scalar.begin(),
+                           scratch.psi_scalar.end(),
+                           JxW_values.begin(),
+                           0.0);
+
+      data.cell_index         = cell->active_cell_index();
+      data.L2_error           = std::sqrt(L2_error_square);
+      data.H1_seminorm_error  = std::sqrt(H1_seminorm_error_square);
+      data.H1_error           = std::sqrt(L2_error_square +
+                                          H1_seminorm_error_square);
+
+      // Maximum error at the support points
+      scratch.linfty_fe_values.reinit(cell);
+
+      evaluate_exact_solution(exact_solution,
+                              scratch.linfty_fe_values,
+                              scratch.scalar_values,
+                              scratch.linfty_exact_values);
+      evaluate_solution(fe_field.solution,
+                        scratch.linfty_fe_values,
+                        scratch.scalar_values,
+                        scratch.linfty_values);
+
+      data.Linfty_error = 0.0;
+      for (unsigned int q = 0; q < scratch.linfty_fe_values.n_quadrature_points; ++q)
+      {
+        scratch.linfty_exact_values[q] -= scratch.linfty_values[q];
+        data.Linfty_error = std::max(data.Linfty_error,
+                                     scratch.linfty_exact_values[q].linfty_norm());
+      }
+    };
+
+  Vector<double>  cellwise_L2_error(tria.n_active_cells());
+  Vector<double>  cellwise_H1_seminorm_error(tria.n_active_cells());
+  Vector<double>  cellwise_H1_error(tria.n_active_cells());
+  Vector<double>  cellwise_Linfty_error(tria.n_active_cells());
+
+  auto copier =
+    [&](const ErrorCopy &data)
+    {
+      cellwise_L2_error(data.cell_index)          = data.L2_error;
+      cellwise_H1_seminorm_error(data.cell_index) = data.H1_seminorm_error;
+      cellwise_H1_error(data.cell_index)          = data.H1_error;
+      cellwise_Linfty_error(data.cell_index)      = data.Linfty_error;
+    };
+
+  using CellFilter =
+    FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>;
+
+  WorkStream::run
+  (CellFilter(IteratorFilters::LocallyOwnedCell(),
+              dof_handler.begin_active()),
+   CellFilter(IteratorFilters::LocallyOwnedCell(),
+              dof_handler.end()),
+   worker,
+   copier,
+   ErrorScratch<dim>(mapping,
+                     fe_field.get_finite_element(),
+                     quadrature_formula,
+                     linfty_quadrature_formula),
+   ErrorCopy());
+
+  /*
+   * The cell-wise errors are reduced in the same way as by
+   * dealii::VectorTools::compute_global_error, but with a single
+   * collective operation for all norms.
+   */
+  std::vector<double> local_errors{cellwise_L2_error.norm_sqr(),
+                                   cellwise_H1_seminorm_error.norm_sqr(),
+                                   cellwise_H1_error.norm_sqr(),
+                                   cellwise_Linfty_error.linfty_norm()};
+
+  std::vector<double> global_errors(local_errors);
+
+  if (const auto *tria_ptr =
+        dynamic_cast<const parallel::TriangulationBase<dim> *>(&tria))
+  {
+    const std::vector<Utilities::MPI::MinMaxAvg> reduced_errors =
+      Utilities::MPI::min_max_avg(local_errors, tria_ptr->get_communicator());
 
-  norm_type = NormType::L2_norm;
-  error_map[norm_type] = compute_error(quadrature_formula,
-                                       exact_solution,
-                                       norm_type);
+    for (unsigned int i = 0; i < 3; ++i)
+      global_errors[i] = reduced_errors[i].sum;
+    global_errors[3] = reduced_errors[3].max;
+  }
 
-  norm_type = NormType::H1_norm;
-  error_map[norm_type] = compute_error(quadrature_formula,
-                                       exact_solution,
-                                       norm_type);
+  std::map<NormType, double> error_map;
 
-  const QTrapez<1>     trapezoidal_rule;
-  const QIterated<dim> linfty_quadrature_formula(trapezoidal_rule,
-                                                 fe_degree);
+  error_map[NormType::L2_norm]      = std::sqrt(global_errors[0]);
+  error_map[NormType::H1_seminorm]  = std::sqrt(global_errors[1]);
+  error_map[NormType::H1_norm]      = std::sqrt(global_errors[2]);
+  error_map[NormType::Linfty_norm]  = global_errors[3];
 
-  norm_type = NormType::Linfty_norm;
-  error_map[norm_type] = compute_error(linfty_quadrature_formula,
-                                       exact_solution,
-                                       norm_type);
   return (error_map);
 }
 
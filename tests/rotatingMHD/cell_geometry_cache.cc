@@ -0,0 +1,221 @@
+#include <rotatingMHD/cell_geometry_cache.h>
+#include <rotatingMHD/finite_element_field.h>
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Test of the class CachedFEValues against FEValues on a curved mesh with
+// and without stored shape gradients
+
+using namespace dealii;
+using namespace RMHD;
+
+template <int dim>
+class VectorFunction : public Function<dim>
+{
+public:
+  VectorFunction()
+  :
+  Function<dim>(dim)
+  {}
+
+  virtual double value(const Point<dim>   &point,
+                       const unsigned int  component) const override
+  {
+    return (std::sin(point[(component + 1) % dim]) * point[component]);
+  }
+};
+
+
+
+template <int dim>
+void test(const std::size_t memory_budget)
+{
+  Triangulation<dim>  tria;
+
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.0);
+  tria.refine_global(1);
+
+  const MappingQ<dim> mapping(3);
+
+  Entities::FE_VectorField<dim, Vector<double>> velocity(2, tria, "Velocity");
+  Entities::FE_ScalarField<dim, Vector<double>> pressure(1, tria, "Pressure");
+
+  velocity.set_cell_geometry_cache_memory_budget(memory_budget);
+  pressure.set_cell_geometry_cache_memory_budget(memory_budget);
+
+  velocity.setup_dofs();
+  velocity.setup_vectors();
+  pressure.setup_dofs();
+  pressure.setup_vectors();
+
+  dealii::VectorTools::interpolate(mapping,
+                                   velocity.get_dof_handler(),
+                                   VectorFunction<dim>(),
+                                   velocity.solution);
+  dealii::VectorTools::interpolate(mapping,
+                                   pressure.get_dof_handler(),
+                                   Functions::CosineFunction<dim>(),
+                                   pressure.solution);
+
+  const QGauss<dim>   quadrature_formula(3);
+
+  const UpdateFlags   update_flags = update_values|
+                                     update_gradients|
+                                     update_JxW_values;
+
+  const CellGeometryCache<dim> &velocity_cache =
+    velocity.get_cell_geometry_cache(mapping, quadrature_formula, update_flags);
+  const CellGeometryCache<dim> &pressure_cache =
+    pressure.get_cell_geometry_cache(mapping, quadrature_formula, update_flags);
+
+  std::cout << "Dimension " << dim
+            << ", shape gradients stored: " << std::boolalpha
+            << velocity_cache.stores_shape_gradients()
+            << std::endl;
+
+  std::cout << "Cache reused: "
+            << (&velocity_cache ==
+                &velocity.get_cell_geometry_cache(mapping,
+                                                  quadrature_formula,
+                                                  update_flags))
+            << std::endl;
+
+  FEValues<dim> velocity_fe_values(mapping,
+                                   velocity.get_finite_element(),
+                                   quadrature_formula,
+                                   update_flags);
+  FEValues<dim> pressure_fe_values(mapping,
+                                   pressure.get_finite_element(),
+                                   quadrature_formula,
+                                   update_flags);
+
+  CachedFEValues<dim> velocity_cached_values(velocity_cache);
+  CachedFEValues<dim> pressure_cached_values(pressure_cache);
+
+  const unsigned int n_q_points = quadrature_formula.size();
+
+  const FEValuesExtractors::Vector  vector_extractor(0);
+
+  using curl_type = typename CachedFEValues<dim>::curl_type;
+
+  std::vector<Tensor<1,dim>>  velocity_values(n_q_points), cached_velocity_values(n_q_points);
+  std::vector<Tensor<2,dim>>  velocity_gradients(n_q_points), cached_velocity_gradients(n_q_points);
+  std::vector<double>         velocity_divergences(n_q_points), cached_velocity_divergences(n_q_points);
+  std::vector<curl_type>      velocity_curls(n_q_points), cached_velocity_curls(n_q_points);
+  std::vector<double>         pressure_values(n_q_points), cached_pressure_values(n_q_points);
+  std::vector<Tensor<1,dim>>  pressure_gradients(n_q_points), cached_pressure_gradients(n_q_points);
+
+  double max_error = 0.0;
+
+  for (const auto &cell: velocity.get_dof_handler().active_cell_iterators())
+  {
+    typename DoFHandler<dim>::active_cell_iterator
+    pressure_cell(&tria,
+                  cell->level(),
+                  cell->index(),
+                  &pressure.get_dof_handler());
+
+    velocity_fe_values.reinit(cell);
+    pressure_fe_values.reinit(pressure_cell);
+    velocity_cached_values.reinit(cell);
+    pressure_cached_values.reinit(pressure_cell);
+
+    velocity_fe_values[vector_extractor].get_function_values(velocity.solution, velocity_values);
+    velocity_fe_values[vector_extractor].get_function_gradients(velocity.solution, velocity_gradients);
+    velocity_fe_values[vector_extractor].get_function_divergences(velocity.solution, velocity_divergences);
+    velocity_fe_values[vector_extractor].get_function_curls(velocity.solution, velocity_curls);
+    pressure_fe_values.get_function_values(pressure.solution, pressure_values);
+    pressure_fe_values.get_function_gradients(pressure.solution, pressure_gradients);
+
+    velocity_cached_values.get_function_values(velocity.solution, cached_velocity_values);
+    velocity_cached_values.get_function_gradients(velocity.solution, cached_velocity_gradients);
+    velocity_cached_values.get_function_divergences(velocity.solution, cached_velocity_divergences);
+    velocity_cached_values.get_function_curls(velocity.solution, cached_velocity_curls);
+    pressure_cached_values.get_function_values(pressure.solution, cached_pressure_values);
+    pressure_cached_values.get_function_gradients(pressure.solution, cached_pressure_gradients);
+
+    for (unsigned int q = 0; q < n_q_points; ++q)
+    {
+      max_error = std::max(max_error,
+                           std::abs(velocity_fe_values.JxW(q) -
+                                    velocity_cached_values.JxW(q)));
+      max_error = std::max(max_error,
+                           (velocity_values[q] - cached_velocity_values[q]).norm());
+      max_error = std::max(max_error,
+                           (velocity_gradients[q] - cached_velocity_gradients[q]).norm());
+      max_error = std::max(max_error,
+                           std::abs(velocity_divergences[q] - cached_velocity_divergences[q]));
+      max_error = std::max(max_error,
+                           (velocity_curls[q] - cached_velocity_curls[q]).norm());
+      max_error = std::max(max_error,
+                           std::abs(pressure_values[q] - cached_pressure_values[q]));
+      max_error = std::max(max_error,
+                           (pressure_gradients[q] - cached_pressure_gradients[q]).norm());
+
+      for (unsigned int i = 0; i < velocity_cache.dofs_per_cell(); ++i)
+      {
+        max_error = std::max(max_error,
+                             (velocity_fe_values[vector_extractor].value(i, q) -
+                              velocity_cached_values.vector_shape_value(i, q)).norm());
+        max_error = std::max(max_error,
+                             (velocity_fe_values[vector_extractor].gradient(i, q) -
+                              velocity_cached_values.vector_shape_gradient(i, q)).norm());
+        max_error = std::max(max_error,
+                             (velocity_fe_values[vector_extractor].curl(i, q) -
+                              velocity_cached_values.vector_shape_curl(i, q)).norm());
+      }
+    }
+  }
+
+  std::cout << "Difference < 1e-12 ? "
+            << std::boolalpha
+            << bool(max_error < 1e-12)
+            << std::endl;
+}
+
+
+
+int main(void)
+{
+  try
+  {
+    dealii::deallog.depth_console(0);
+
+    test<2>(std::numeric_limits<std::size_t>::max());
+    test<2>(0);
+    test<3>(std::numeric_limits<std::size_t>::max());
+    test<3>(0);
+  }
+  catch(std::exception & exc)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Exception on processing: " << std::endl
+              << exc.what() << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+  catch(...)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Unknown exception!" << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/mpi.h>
+
+#include <rotatingMHD/convergence_test.h>
+
+#include <iostream>
+#include <vector>
+
+// Test of the class ConvergenceTest::CycleDistribution, i.e., of the
+// distribution of the cycles of a convergence test over groups of processes
+
+using namespace dealii;
+using namespace RMHD;
+
+void print(ConditionalOStream                              &pcout,
+           const ConvergenceTest::ConvergenceTestParameters &prm,
+           const unsigned int                                dim)
+{
+  const ConvergenceTest::CycleDistribution cycle_distribution(prm, dim);
+
+  const unsigned int group_size =
+    Utilities::MPI::n_mpi_processes(cycle_distribution.get_communicator());
+
+  const std::vector<unsigned int> group_sizes =
+    Utilities::MPI::gather(MPI_COMM_WORLD, group_size);
+  const std::vector<std::vector<unsigned int>> cycles =
+    Utilities::MPI::gather(MPI_COMM_WORLD, cycle_distribution.get_cycles());
+
+  pcout << "Number of groups: " << cycle_distribution.n_groups() << std::endl;
+
+  for (unsigned int i = 0; i < cycles.size(); ++i)
+  {
+    pcout << "  Process " << i
+          << ": group size = " << group_sizes[i]
+          << ", cycles =";
+    for (const auto cycle: cycles[i])
+      pcout << " " << cycle;
+    pcout << std::endl;
+  }
+}
+
+
+
+void test(ConditionalOStream &pcout)
+{
+  ConvergenceTest::ConvergenceTestParameters prm;
+
+  prm.concurrent_cycles = true;
+  prm.step_size_reduction_factor = 0.5;
+
+  pcout << "Spatial test with 3 cycles" << std::endl;
+  prm.test_type = ConvergenceTest::ConvergenceTestType::spatial;
+  prm.n_spatial_cycles = 3;
+  print(pcout, prm, 2);
+
+  pcout << "Temporal test with 3 cycles" << std::endl;
+  prm.test_type = ConvergenceTest::ConvergenceTestType::temporal;
+  prm.n_temporal_cycles = 3;
+  print(pcout, prm, 2);
+
+  pcout << "Temporal test with 6 cycles" << std::endl;
+  prm.n_temporal_cycles = 6;
+  print(pcout, prm, 2);
+
+  pcout << "Temporal test with 6 cycles run one after another" << std::endl;
+  prm.concurrent_cycles = false;
+  print(pcout, prm, 2);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    Utilities::MPI::MPI_InitFinalize  mpi_initialization(argc, argv, 1);
+    deallog.depth_console(0);
+
+    ConditionalOStream  pcout(std::cout,
+                              Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0);
+
+    test(pcout);
+  }
+  catch(std::exception & exc)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Exception on processing: " << std::endl
+              << exc.what() << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+  catch(...)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Unknown exception!" << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
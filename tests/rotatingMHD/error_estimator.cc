@@ -0,0 +1,190 @@
+#include <rotatingMHD/error_estimator.h>
+#include <rotatingMHD/finite_element_field.h>
+#include <rotatingMHD/vector_tools.h>
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/numerics/error_estimator.h>
+
+#include <algorithm>
+#include <cmath>
+
+// Test of the indicator of Kelly type of the MultiFieldErrorEstimator with
+// a single field of weight one against the KellyErrorEstimator on a mesh
+// with hanging nodes
+
+using namespace dealii;
+using namespace RMHD;
+
+template <int dim>
+class VectorFunction : public Function<dim>
+{
+public:
+  VectorFunction()
+  :
+  Function<dim>(dim)
+  {}
+
+  virtual double value(const Point<dim>   &point,
+                       const unsigned int  component) const override
+  {
+    return (std::sin(point[(component + 1) % dim]) * std::exp(point[component]));
+  }
+};
+
+
+
+template <int dim>
+void compare_indicators(const Entities::FE_FieldBase<dim> &field,
+                        ConditionalOStream                &pcout)
+{
+  const Triangulation<dim> &tria = field.get_triangulation();
+
+  const MappingQ1<dim>  mapping;
+
+  Vector<float> estimated_error_per_cell(tria.n_active_cells());
+
+  MultiFieldErrorEstimator<dim> error_estimator(mapping);
+  error_estimator.add_field(field, 1.0);
+  error_estimator.estimate(estimated_error_per_cell,
+                           RunTimeParameters::ErrorIndicatorType::Kelly,
+                           false);
+
+  Vector<float> reference_error_per_cell(tria.n_active_cells());
+
+  KellyErrorEstimator<dim>::estimate(
+    mapping,
+    field.get_dof_handler(),
+    QGauss<dim-1>(field.fe_degree() + 1),
+    std::map<types::boundary_id, const Function<dim> *>(),
+    field.solution,
+    reference_error_per_cell,
+    ComponentMask(),
+    nullptr,
+    numbers::invalid_unsigned_int,
+    tria.locally_owned_subdomain());
+
+  double local_difference = 0.0;
+  double local_reference  = 0.0;
+
+  for (const auto &cell: tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+    {
+      const unsigned int index = cell->active_cell_index();
+
+      local_difference = std::max(local_difference,
+                                  std::abs(double(estimated_error_per_cell(index)) -
+                                           double(reference_error_per_cell(index))));
+      local_reference  = std::max(local_reference,
+                                  std::abs(double(reference_error_per_cell(index))));
+    }
+
+  const double difference = Utilities::MPI::max(local_difference,
+                                                tria.get_communicator());
+  const double reference  = Utilities::MPI::max(local_reference,
+                                                tria.get_communicator());
+
+  pcout << "  " << field.name << " matches KellyErrorEstimator: "
+        << (reference > 0.0 && difference <= 1e-5 * reference ? "true" : "false")
+        << std::endl;
+}
+
+
+
+template <int dim>
+void test(ConditionalOStream &pcout)
+{
+  parallel::distributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+
+  GridGenerator::hyper_cube(tria, 0.0, 1.0, true);
+  tria.refine_global(2);
+
+  // Creates hanging nodes
+  for (const auto &cell: tria.active_cell_iterators())
+    if (cell->is_locally_owned() && cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  Entities::FE_VectorField<dim> velocity(2, tria, "Velocity");
+  Entities::FE_ScalarField<dim> temperature(1, tria, "Temperature");
+
+  const std::shared_ptr<Function<dim>> velocity_function =
+    std::make_shared<VectorFunction<dim>>();
+  const std::shared_ptr<Function<dim>> temperature_function =
+    std::make_shared<Functions::CosineFunction<dim>>();
+
+  velocity.setup_dofs();
+  velocity.setup_vectors();
+  temperature.setup_dofs();
+  temperature.setup_vectors();
+
+  velocity.setup_boundary_conditions();
+  temperature.setup_boundary_conditions();
+  for (types::boundary_id boundary_id = 0;
+       boundary_id < GeometryInfo<dim>::faces_per_cell; ++boundary_id)
+  {
+    velocity.set_dirichlet_boundary_condition(boundary_id, velocity_function);
+    temperature.set_dirichlet_boundary_condition(boundary_id, temperature_function);
+  }
+  velocity.close_boundary_conditions(false);
+  velocity.apply_boundary_conditions(false);
+  temperature.close_boundary_conditions(false);
+  temperature.apply_boundary_conditions(false);
+
+  RMHD::VectorTools::interpolate(velocity,
+                                 *velocity_function,
+                                 velocity.solution);
+  RMHD::VectorTools::interpolate(temperature,
+                                 *temperature_function,
+                                 temperature.solution);
+
+  pcout << "Dimension " << dim << std::endl;
+
+  compare_indicators(velocity, pcout);
+  compare_indicators(temperature, pcout);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    Utilities::MPI::MPI_InitFinalize  mpi_initialization(argc, argv, 1);
+    deallog.depth_console(0);
+
+    ConditionalOStream  pcout(std::cout,
+                              Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0);
+
+    test<2>(pcout);
+    test<3>(pcout);
+  }
+  catch(std::exception & exc)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Exception on processing: " << std::endl
+              << exc.what() << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+  catch(...)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Unknown exception!" << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,188 @@
+#include <rotatingMHD/data_postprocessors.h>
+#include <rotatingMHD/finite_element_field.h>
+#include <rotatingMHD/graphical_output.h>
+#include <rotatingMHD/run_time_parameters.h>
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+// Test of the patches which the graphical output interpolates onto its
+// cache against the patches built from scratch by DataOut on a curved mesh
+
+using namespace dealii;
+using namespace RMHD;
+
+template <int dim>
+class VectorFunction : public Function<dim>
+{
+public:
+  VectorFunction()
+  :
+  Function<dim>(dim)
+  {}
+
+  virtual double value(const Point<dim>   &point,
+                       const unsigned int  component) const override
+  {
+    return (std::sin(point[(component + 1) % dim]) * std::exp(point[component]));
+  }
+};
+
+
+
+template <int dim>
+void test(ConditionalOStream &pcout)
+{
+  parallel::distributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.0);
+  tria.refine_global(1);
+
+  const std::shared_ptr<Mapping<dim>> mapping =
+    std::make_shared<MappingQ<dim>>(3);
+
+  Entities::FE_VectorField<dim> velocity(2, tria, "Velocity");
+  Entities::FE_ScalarField<dim> temperature(1, tria, "Temperature");
+
+  velocity.setup_dofs();
+  velocity.setup_vectors();
+  temperature.setup_dofs();
+  temperature.setup_vectors();
+
+  dealii::VectorTools::interpolate(*mapping,
+                                   velocity.get_dof_handler(),
+                                   VectorFunction<dim>(),
+                                   velocity.distributed_vector);
+  velocity.solution = velocity.distributed_vector;
+
+  dealii::VectorTools::interpolate(*mapping,
+                                   temperature.get_dof_handler(),
+                                   Functions::CosineFunction<dim>(),
+                                   temperature.distributed_vector);
+  temperature.solution = temperature.distributed_vector;
+
+  const RunTimeParameters::OutputControlParameters  prm;
+
+  GraphicalOutput<dim>  graphical_output(prm, tria, mapping);
+
+  graphical_output.add_field(velocity);
+  graphical_output.add_field(
+    velocity,
+    std::make_shared<SphericalPostprocessorVectorField<dim>>("Velocity"));
+  graphical_output.add_field(temperature);
+  graphical_output.set_patch_parameters(2, DataOut<dim>::curved_inner_cells);
+
+  // The first call builds the cache. The solution is modified afterwards
+  // such that the second call only interpolates the new values onto the
+  // cached patches.
+  graphical_output.get_patches(true);
+
+  velocity.distributed_vector *= 2.0;
+  velocity.solution = velocity.distributed_vector;
+  temperature.distributed_vector *= 2.0;
+  temperature.solution = temperature.distributed_vector;
+
+  const std::vector<DataOutBase::Patch<dim, dim>> scratch_patches =
+    graphical_output.get_patches(false);
+  const std::vector<DataOutBase::Patch<dim, dim>> cached_patches =
+    graphical_output.get_patches(true);
+
+  unsigned int  local_mismatches = 0;
+  double        local_difference = 0.0;
+  double        local_magnitude  = 0.0;
+
+  if (scratch_patches.size() != cached_patches.size())
+    ++local_mismatches;
+  else
+    for (unsigned int p = 0; p < scratch_patches.size(); ++p)
+    {
+      const DataOutBase::Patch<dim, dim> &scratch_patch = scratch_patches[p];
+      const DataOutBase::Patch<dim, dim> &cached_patch  = cached_patches[p];
+
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        if (scratch_patch.vertices[v] != cached_patch.vertices[v])
+          ++local_mismatches;
+
+      if (scratch_patch.n_subdivisions != cached_patch.n_subdivisions ||
+          scratch_patch.points_are_available != cached_patch.points_are_available ||
+          scratch_patch.data.n_rows() != cached_patch.data.n_rows() ||
+          scratch_patch.data.n_cols() != cached_patch.data.n_cols())
+      {
+        ++local_mismatches;
+        continue;
+      }
+
+      for (unsigned int i = 0; i < scratch_patch.data.n_rows(); ++i)
+        for (unsigned int j = 0; j < scratch_patch.data.n_cols(); ++j)
+        {
+          local_difference = std::max(local_difference,
+                                      double(std::abs(scratch_patch.data(i, j) -
+                                                      cached_patch.data(i, j))));
+          local_magnitude  = std::max(local_magnitude,
+                                      double(std::abs(scratch_patch.data(i, j))));
+        }
+    }
+
+  const unsigned int mismatches =
+    Utilities::MPI::sum(local_mismatches, MPI_COMM_WORLD);
+  const double difference =
+    Utilities::MPI::max(local_difference, MPI_COMM_WORLD);
+  const double magnitude =
+    Utilities::MPI::max(local_magnitude, MPI_COMM_WORLD);
+
+  pcout << "Dimension " << dim << std::endl
+        << "  Patch geometry identical: "
+        << (mismatches == 0 ? "true" : "false") << std::endl
+        << "  Patch data identical:     "
+        << (magnitude > 0.0 && difference <= 1e-6 * magnitude ? "true" : "false")
+        << std::endl;
+}
+
+
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    Utilities::MPI::MPI_InitFinalize  mpi_initialization(argc, argv, 1);
+    deallog.depth_console(0);
+
+    ConditionalOStream  pcout(std::cout,
+                              Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0);
+
+    test<2>(pcout);
+    test<3>(pcout);
+  }
+  catch(std::exception & exc)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Exception on processing: " << std::endl
+              << exc.what() << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+  catch(...)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Unknown exception!" << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
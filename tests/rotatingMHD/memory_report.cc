@@ -0,0 +1,76 @@
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/mpi.h>
+
+#include <rotatingMHD/memory_report.h>
+
+#include <iostream>
+
+// Test of the class MemoryReport, i.e., of the nesting of the reports and
+// of the reduction of the entries over the processes
+
+using namespace dealii;
+using namespace RMHD;
+
+void test(ConditionalOStream &pcout)
+{
+  const std::size_t megabyte = 1024 * 1024;
+
+  const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  MemoryReport solver_report;
+  solver_report.add("Preconditioner", 2 * rank * megabyte);
+
+  MemoryReport report;
+  report.add("Matrix", (rank + 1) * megabyte);
+  report.add("Vector", megabyte / 2);
+  report.add("Solver", solver_report);
+
+  pcout << "Entries:" << std::endl;
+  for (const auto &entry: report.get_entries())
+    pcout << "  " << entry.first << std::endl;
+
+  pcout << "Total memory of the first process (MB): "
+        << static_cast<double>(report.total()) / megabyte
+        << std::endl;
+
+  report.print(pcout, MPI_COMM_WORLD);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    Utilities::MPI::MPI_InitFinalize  mpi_initialization(argc, argv, 1);
+    deallog.depth_console(0);
+
+    ConditionalOStream  pcout(std::cout,
+                              Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0);
+
+    test(pcout);
+  }
+  catch(std::exception & exc)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Exception on processing: " << std::endl
+              << exc.what() << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+  catch(...)
+  {
+    std::cerr << std::endl
+              << std::endl
+              << "----------------------------------------------------" << std::endl;
+    std::cerr << "Unknown exception!" << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -1,15 +1,90 @@
 #include <deal.II/base/function_lib.h>
 #include <deal.II/base/tensor_function.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/fe/mapping_q1.h>
 #include <deal.II/grid/grid_generator.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/numerics/vector_tools.h>
 
 #include <rotatingMHD/finite_element_field.h>
 #include <rotatingMHD/vector_tools.h>
 
+#include <cmath>
+
 using namespace dealii;
 using namespace RMHD;
 
 // Testing methods inside namespace VectorTools in serial
 
+/*
+ * Compares the errors computed in a single pass over the cells with the
+ * ones computed by dealii::VectorTools::integrate_difference and
+ * dealii::VectorTools::compute_global_error, using the same mapping and
+ * quadrature formulas. The field is overwritten by the L2-projection of a
+ * non-polynomial function, such that all errors are discretization
+ * errors and not round-off.
+ */
+template<int dim>
+void check_errors(Entities::FE_FieldBase<dim, Vector<double>> &fe_field)
+{
+  using NormType = RMHD::VectorTools::NormType;
+
+  const MappingQ1<dim>  mapping;
+  const QGauss<dim>     quadrature_formula(fe_field.fe_degree() + 1);
+  const QIterated<dim>  linfty_quadrature_formula(QTrapez<1>(),
+                                                  fe_field.fe_degree());
+
+  const Functions::CosineFunction<dim>  exact_solution(fe_field.n_components());
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  dealii::VectorTools::project(mapping,
+                               fe_field.get_dof_handler(),
+                               constraints,
+                               quadrature_formula,
+                               exact_solution,
+                               fe_field.distributed_vector);
+  fe_field.solution = fe_field.distributed_vector;
+
+  const std::map<NormType, double> errors =
+      RMHD::VectorTools::compute_error(fe_field, exact_solution);
+
+  Vector<double>  cellwise_error(fe_field.get_triangulation().n_active_cells());
+
+  const std::vector<std::pair<NormType, std::string>> norms
+  {{NormType::L2_norm, "L2"},
+   {NormType::H1_seminorm, "H1-seminorm"},
+   {NormType::H1_norm, "H1"},
+   {NormType::Linfty_norm, "Linfty"}};
+
+  for (const auto &norm: norms)
+  {
+    dealii::VectorTools::integrate_difference
+    (mapping,
+     fe_field.get_dof_handler(),
+     fe_field.solution,
+     exact_solution,
+     cellwise_error,
+     norm.first == NormType::Linfty_norm ? linfty_quadrature_formula
+                                         : quadrature_formula,
+     norm.first);
+
+    const double reference_error =
+      dealii::VectorTools::compute_global_error(fe_field.get_triangulation(),
+                                                cellwise_error,
+                                                norm.first);
+
+    std::cout << norm.second << " error matches integrate_difference: "
+              << (reference_error > 0.0 &&
+                  std::abs(errors.at(norm.first) - reference_error) <=
+                  1e-10 * reference_error ? "true" : "false")
+              << std::endl;
+  }
+}
+
+
+
 template<int dim>
 void test_vector_field()
 {
@@ -57,6 +132,8 @@ void test_vector_field()
   std::cout << "L2 error: " << errors.at(RMHD::VectorTools::NormType::L2_norm) << std::endl;
   std::cout << "H1 error: " << errors.at(RMHD::VectorTools::NormType::H1_norm) << std::endl;
   std::cout << "Linfty error: " << errors.at(RMHD::VectorTools::NormType::Linfty_norm) << std::endl;
+
+  check_errors(field_01);
 }
 
 
@@ -108,6 +185,8 @@ void test_scalar_field()
   std::cout << "L2 error: " << errors.at(RMHD::VectorTools::NormType::L2_norm) << std::endl;
   std::cout << "H1 error: " << errors.at(RMHD::VectorTools::NormType::H1_norm) << std::endl;
   std::cout << "Linfty error: " << errors.at(RMHD::VectorTools::NormType::Linfty_norm) << std::endl;
+
+  check_errors(field_01);
 }
 
 